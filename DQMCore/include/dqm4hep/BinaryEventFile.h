@@ -0,0 +1,86 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics 
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_BINARYEVENTFILE_H
+#define DQM4HEP_BINARYEVENTFILE_H
+
+// -- std headers
+#include <cstdint>
+#include <cstring>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  BinaryEventFileHeader struct
+     *
+     *  Header of the binary event files written by the BinaryEventWriter 
+     *  and read by the BinaryEventReader plugins. The file layout is:
+     *  - the header (64 bytes)
+     *  - the event frames: a uint32 frame size followed by the EventStreamer bytes
+     *  - the event index: one uint64 file offset per frame, aligned on 8 bytes
+     *  - the run info, as a json string
+     *  - the event source table (name to id), as a json string (version >= 2).
+     *    Event frames only hold the source id, see EventHeader
+     *
+     *  The index, run info and source table are written when the file is closed. A file with 
+     *  a null index offset was not properly closed and its index has to be 
+     *  rebuilt by scanning the frames.
+     *  All the header fields are stored in host byte order, see m_byteOrder.
+     */
+    struct BinaryEventFileHeader {
+      static constexpr uint32_t     currentVersion = 2;                    ///< The current file format version
+      static constexpr uint32_t     minVersion = 1;                        ///< The oldest readable file format version
+      static constexpr uint32_t     hostByteOrder = 0x01020304;            ///< The byte order marker
+
+      /**
+       *  @brief  Constructor
+       */
+      BinaryEventFileHeader() {
+        memcpy(m_magic, magic(), sizeof(m_magic));
+      }
+
+      /**
+       *  @brief  Get the file magic string (8 characters, not null terminated in the file)
+       */
+      static const char *magic() {
+        return "DQM4HEPE";
+      }
+
+      /**
+       *  @brief  Whether the header identifies a valid file for this host
+       */
+      bool valid() const {
+        return (0 == memcmp(m_magic, magic(), sizeof(m_magic))) 
+          && (minVersion <= m_version && currentVersion >= m_version) 
+          && (hostByteOrder == m_byteOrder)
+          && (sizeof(BinaryEventFileHeader) == m_headerSize);
+      }
+
+      char                  m_magic[8];                                    ///< The file magic string
+      uint32_t              m_version = {currentVersion};                  ///< The file format version
+      uint32_t              m_headerSize = {sizeof(BinaryEventFileHeader)};///< The header size
+      uint32_t              m_byteOrder = {hostByteOrder};                 ///< The byte order marker
+      uint32_t              m_flags = {0};                                 ///< Reserved flags
+      uint64_t              m_nEvents = {0};                               ///< The number of events
+      uint64_t              m_indexOffset = {0};                           ///< The index offset, 0 if not written
+      uint64_t              m_runInfoOffset = {0};                         ///< The run info offset, 0 if not written
+      uint64_t              m_runInfoSize = {0};                           ///< The run info size
+      uint64_t              m_sourceTableSize = {0};                       ///< The source table size, written after the run info
+    };
+
+    static_assert(64 == sizeof(BinaryEventFileHeader), "BinaryEventFileHeader must be 64 bytes long");
+
+  }
+
+}
+
+#endif  //  DQM4HEP_BINARYEVENTFILE_H
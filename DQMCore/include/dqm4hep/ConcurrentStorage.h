@@ -0,0 +1,691 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_CONCURRENTSTORAGE_H
+#define DQM4HEP_CONCURRENTSTORAGE_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+
+// -- std headers
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /** ConcurrentStorage class.
+     *
+     *  A thread safe variant of Storage: a tree of directories holding objects, that can be
+     *  filled, booked and read from several threads. The objects must provide a name() method.
+     *
+     *  The contents and sub-directories of a directory are immutable snapshots, updated by copy
+     *  on write: a writer locks the directory, copies the current snapshot, modifies the copy and
+     *  publishes it atomically. Readers never lock a directory: they take the current snapshot
+     *  and use it while the writers go on. Thus iterate() and dump() neither copy the directory
+     *  contents nor block the writers, and see each directory as it was when they reached it.
+     *  Booking an object costs a copy of the directory contents, looking up and filling it doesn't.
+     *
+     *  A hash index of the directories and objects by full path ("/dir/subdir/name") is used for
+     *  lookups by name. It is split in shards with their own lock to limit the contention.
+     *  There is no current directory: the paths are always resolved from the root directory.
+     *  Only the storage structure is protected, the access to the objects themselves from
+     *  several threads has to be synchronized by the caller
+     */
+    template <typename T>
+    class ConcurrentStorage {
+    public:
+      typedef std::shared_ptr<T> ObjectPtr;
+      typedef std::vector<ObjectPtr> ObjectList;
+      typedef std::shared_ptr<const ObjectList> ObjectListPtr;
+
+      ConcurrentStorage();
+      ~ConcurrentStorage();
+      ConcurrentStorage(const ConcurrentStorage&) = delete;
+      ConcurrentStorage& operator=(const ConcurrentStorage&) = delete;
+
+      /** Create a directory and its parents if they don't exist
+       */
+      StatusCode mkdir(const std::string &dirName);
+
+      /** Whether the directory exists
+       */
+      bool dirExists(const std::string &dirName) const;
+
+      /** Remove a directory, its sub-directories and their contents
+       */
+      StatusCode rmdir(const std::string &dirName);
+
+      /** Add an object in a directory, created if it doesn't exist
+       */
+      StatusCode add(const std::string &dirName, ObjectPtr object);
+
+      /** Remove the first object of a directory for which function(object) returns true
+       */
+      template <typename F>
+      StatusCode remove(const std::string &dirName, F function);
+
+      /** Find the first object of a directory for which function(object) returns true
+       */
+      template <typename F>
+      ObjectPtr findObject(const std::string &dirName, F function) const;
+
+      /** Find an object by name in a directory, using the index
+       */
+      ObjectPtr findObjectByName(const std::string &dirName, const std::string &name) const;
+
+      /** Get a snapshot of the directory contents. nullptr if the directory doesn't exist
+       */
+      ObjectListPtr contents(const std::string &dirName) const;
+
+      /** Iterate over the objects, calling function(dirPath, object) until it returns false
+       */
+      template <typename F>
+      void iterate(F function) const;
+
+      /** Get all the objects of the storage
+       */
+      template <typename U>
+      void getObjects(std::vector<std::shared_ptr<U>> &objectList) const;
+
+      /** Remove all the directories and objects
+       */
+      void clear();
+
+      /** Print the storage tree, function(object) returning the string to print for an object
+       */
+      template <typename F>
+      void dump(F function) const;
+
+    private:
+      class Node;
+      typedef std::shared_ptr<Node> NodePtr;
+      typedef std::vector<NodePtr> NodeList;
+      typedef std::shared_ptr<const NodeList> NodeListPtr;
+
+      /** Node class.
+       *  A directory of the storage tree. The snapshots are only accessed with
+       *  std::atomic_load and std::atomic_store, the writers lock the mutex
+       */
+      class Node {
+      public:
+        Node(const std::string &fullPath, const std::string &name, unsigned int depth);
+        const std::string           m_fullPath;         ///< The directory full path
+        const std::string           m_name;             ///< The directory name
+        const unsigned int          m_depth;            ///< The number of parent directories
+        ObjectListPtr               m_contents;         ///< The contents snapshot
+        NodeListPtr                 m_subdirs;          ///< The sub-directories snapshot
+        bool                        m_removed;          ///< Whether the directory was removed (mutex protected)
+        std::mutex                  m_mutex;            ///< The writer mutex
+      };
+
+      /** ShardedIndex class.
+       *  A hash map split in shards, each with its own lock
+       */
+      template <typename V>
+      class ShardedIndex {
+      public:
+        /** Find a value. nullptr if not found
+         */
+        V find(const std::string &key) const;
+
+        /** Insert or replace a value
+         */
+        void set(const std::string &key, const V &value);
+
+        /** Replace a value only if it is the expected one. A nullptr value erases the key
+         */
+        void replace(const std::string &key, const V &expected, const V &value);
+
+        /** Remove all the values
+         */
+        void clear();
+
+      private:
+        struct Shard {
+          mutable std::mutex                    m_mutex;      ///< The shard mutex
+          std::unordered_map<std::string, V>    m_map;        ///< The shard map
+        };
+        static const std::size_t nShards = 16;
+
+        Shard &shard(const std::string &key) const;
+        mutable std::array<Shard, nShards> m_shards;
+      };
+
+      template <typename F>
+      bool iterate(const NodePtr &directory, F function) const;
+
+      template <typename F>
+      void dump(const NodePtr &directory, F function) const;
+
+      /** Get the full path of a directory, resolving the "." and ".." components
+       */
+      static StatusCode fullPath(const std::string &dirName, std::string &dirPath);
+
+      /** Get the index key of an object
+       */
+      static std::string indexKey(const std::string &dirPath, const std::string &name);
+
+      /** Create a directory from its full path and get it
+       */
+      StatusCode mkdir(const std::string &dirPath, NodePtr &directory);
+
+      /** Find a directory
+       */
+      NodePtr find(const std::string &dirName) const;
+
+      /** Mark a directory and its sub-directories as removed, and remove them from the index
+       */
+      void teardown(const NodePtr &directory);
+
+    private:
+      const NodePtr             m_rootDirectory;          ///< The root directory
+      ShardedIndex<ObjectPtr>   m_objectIndex;            ///< The objects by full path
+      ShardedIndex<NodePtr>     m_directoryIndex;         ///< The directories by full path
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline ConcurrentStorage<T>::Node::Node(const std::string &fullPath, const std::string &name, unsigned int depth) :
+      m_fullPath(fullPath), m_name(name), m_depth(depth),
+      m_contents(std::make_shared<const ObjectList>()), m_subdirs(std::make_shared<const NodeList>()),
+      m_removed(false), m_mutex() {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename V>
+    inline V ConcurrentStorage<T>::ShardedIndex<V>::find(const std::string &key) const {
+      Shard &keyShard(this->shard(key));
+      std::lock_guard<std::mutex> lock(keyShard.m_mutex);
+      auto findIter = keyShard.m_map.find(key);
+      return (keyShard.m_map.end() == findIter) ? nullptr : findIter->second;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename V>
+    inline void ConcurrentStorage<T>::ShardedIndex<V>::set(const std::string &key, const V &value) {
+      Shard &keyShard(this->shard(key));
+      std::lock_guard<std::mutex> lock(keyShard.m_mutex);
+      keyShard.m_map[key] = value;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename V>
+    inline void ConcurrentStorage<T>::ShardedIndex<V>::replace(const std::string &key, const V &expected, const V &value) {
+      Shard &keyShard(this->shard(key));
+      std::lock_guard<std::mutex> lock(keyShard.m_mutex);
+      auto findIter = keyShard.m_map.find(key);
+
+      if (keyShard.m_map.end() == findIter || expected != findIter->second)
+        return;
+
+      if (nullptr == value)
+        keyShard.m_map.erase(findIter);
+      else
+        findIter->second = value;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename V>
+    inline void ConcurrentStorage<T>::ShardedIndex<V>::clear() {
+      for (auto &keyShard : m_shards) {
+        std::lock_guard<std::mutex> lock(keyShard.m_mutex);
+        keyShard.m_map.clear();
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename V>
+    inline typename ConcurrentStorage<T>::template ShardedIndex<V>::Shard &ConcurrentStorage<T>::ShardedIndex<V>::shard(const std::string &key) const {
+      return m_shards[std::hash<std::string>()(key) % nShards];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline ConcurrentStorage<T>::ConcurrentStorage() :
+      m_rootDirectory(std::make_shared<Node>("/", "", 0)), m_objectIndex(), m_directoryIndex() {
+      m_directoryIndex.set(m_rootDirectory->m_fullPath, m_rootDirectory);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline ConcurrentStorage<T>::~ConcurrentStorage() = default;
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StatusCode ConcurrentStorage<T>::mkdir(const std::string &dirName) {
+      if (dirName.empty())
+        return STATUS_CODE_INVALID_PARAMETER;
+
+      std::string dirPath;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, fullPath(dirName, dirPath));
+      NodePtr directory;
+      return this->mkdir(dirPath, directory);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool ConcurrentStorage<T>::dirExists(const std::string &dirName) const {
+      return (nullptr != this->find(dirName));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StatusCode ConcurrentStorage<T>::rmdir(const std::string &dirName) {
+      if (dirName.empty())
+        return STATUS_CODE_NOT_ALLOWED;
+
+      std::string dirPath;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, fullPath(dirName, dirPath));
+
+      if (m_rootDirectory->m_fullPath == dirPath)
+        return STATUS_CODE_NOT_ALLOWED;
+
+      const size_t pos = dirPath.rfind('/');
+      NodePtr parent = m_directoryIndex.find(0 == pos ? std::string("/") : dirPath.substr(0, pos));
+
+      if (nullptr == parent)
+        return STATUS_CODE_NOT_FOUND;
+
+      NodePtr directory;
+      {
+        std::lock_guard<std::mutex> lock(parent->m_mutex);
+
+        if (parent->m_removed)
+          return STATUS_CODE_NOT_FOUND;
+
+        NodeListPtr subdirs = std::atomic_load(&parent->m_subdirs);
+        auto findIter = std::find_if(subdirs->begin(), subdirs->end(), [&dirPath](const NodePtr &subdir) {
+          return (subdir->m_fullPath == dirPath);
+        });
+
+        if (subdirs->end() == findIter)
+          return STATUS_CODE_NOT_FOUND;
+
+        directory = *findIter;
+        auto newSubdirs = std::make_shared<NodeList>();
+        newSubdirs->reserve(subdirs->size() - 1);
+        std::copy_if(subdirs->begin(), subdirs->end(), std::back_inserter(*newSubdirs), [&directory](const NodePtr &subdir) {
+          return (subdir != directory);
+        });
+        std::atomic_store(&parent->m_subdirs, NodeListPtr(std::move(newSubdirs)));
+        m_directoryIndex.replace(dirPath, directory, nullptr);
+      }
+
+      this->teardown(directory);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StatusCode ConcurrentStorage<T>::add(const std::string &dirName, ObjectPtr object) {
+      if (nullptr == object)
+        return STATUS_CODE_INVALID_PTR;
+
+      std::string dirPath;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, fullPath(dirName, dirPath));
+      NodePtr directory;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->mkdir(dirPath, directory));
+
+      std::lock_guard<std::mutex> lock(directory->m_mutex);
+
+      // removed by an other thread in the mean time
+      if (directory->m_removed)
+        return STATUS_CODE_NOT_FOUND;
+
+      // the directory is only scanned when an other object has the same name
+      const std::string key(indexKey(dirPath, object->name()));
+      ObjectPtr indexed = m_objectIndex.find(key);
+      ObjectListPtr contents = std::atomic_load(&directory->m_contents);
+
+      if (nullptr != indexed && (object == indexed || contents->end() != std::find(contents->begin(), contents->end(), object)))
+        return STATUS_CODE_ALREADY_PRESENT;
+
+      auto newContents = std::make_shared<ObjectList>();
+      newContents->reserve(contents->size() + 1);
+      newContents->insert(newContents->end(), contents->begin(), contents->end());
+      newContents->push_back(object);
+      std::atomic_store(&directory->m_contents, ObjectListPtr(std::move(newContents)));
+
+      if (nullptr == indexed)
+        m_objectIndex.set(key, object);
+
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename F>
+    inline StatusCode ConcurrentStorage<T>::remove(const std::string &dirName, F function) {
+      NodePtr directory = this->find(dirName);
+
+      if (nullptr == directory)
+        return STATUS_CODE_NOT_FOUND;
+
+      std::lock_guard<std::mutex> lock(directory->m_mutex);
+
+      if (directory->m_removed)
+        return STATUS_CODE_NOT_FOUND;
+
+      ObjectListPtr contents = std::atomic_load(&directory->m_contents);
+      auto findIter = std::find_if(contents->begin(), contents->end(), function);
+
+      if (contents->end() == findIter)
+        return STATUS_CODE_NOT_FOUND;
+
+      ObjectPtr object = *findIter;
+      auto newContents = std::make_shared<ObjectList>();
+      newContents->reserve(contents->size() - 1);
+      newContents->insert(newContents->end(), contents->begin(), findIter);
+      newContents->insert(newContents->end(), findIter + 1, contents->end());
+
+      // an other object with the same name in the directory takes its place in the index
+      const std::string name(object->name());
+      auto otherIter = std::find_if(newContents->begin(), newContents->end(), [&name](const ObjectPtr &other) {
+        return (other->name() == name);
+      });
+      m_objectIndex.replace(indexKey(directory->m_fullPath, name), object, newContents->end() == otherIter ? nullptr : *otherIter);
+      std::atomic_store(&directory->m_contents, ObjectListPtr(std::move(newContents)));
+
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename F>
+    inline typename ConcurrentStorage<T>::ObjectPtr ConcurrentStorage<T>::findObject(const std::string &dirName, F function) const {
+      ObjectListPtr contents = this->contents(dirName);
+
+      if (nullptr == contents)
+        return nullptr;
+
+      auto findIter = std::find_if(contents->begin(), contents->end(), function);
+      return (contents->end() == findIter) ? nullptr : *findIter;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline typename ConcurrentStorage<T>::ObjectPtr ConcurrentStorage<T>::findObjectByName(const std::string &dirName, const std::string &name) const {
+      std::string dirPath;
+
+      if (STATUS_CODE_SUCCESS != fullPath(dirName, dirPath))
+        return nullptr;
+
+      return m_objectIndex.find(indexKey(dirPath, name));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline typename ConcurrentStorage<T>::ObjectListPtr ConcurrentStorage<T>::contents(const std::string &dirName) const {
+      NodePtr directory = this->find(dirName);
+      return (nullptr == directory) ? nullptr : std::atomic_load(&directory->m_contents);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename F>
+    inline void ConcurrentStorage<T>::iterate(F function) const {
+      this->iterate(m_rootDirectory, function);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename U>
+    inline void ConcurrentStorage<T>::getObjects(std::vector<std::shared_ptr<U>> &objectList) const {
+      this->iterate([&](const std::string &/*dirPath*/, const ObjectPtr &object) {
+        objectList.push_back(std::dynamic_pointer_cast<U>(object));
+        return true;
+      });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void ConcurrentStorage<T>::clear() {
+      NodeListPtr subdirs;
+      {
+        std::lock_guard<std::mutex> lock(m_rootDirectory->m_mutex);
+        subdirs = std::atomic_load(&m_rootDirectory->m_subdirs);
+        ObjectListPtr contents = std::atomic_load(&m_rootDirectory->m_contents);
+        std::atomic_store(&m_rootDirectory->m_subdirs, std::make_shared<const NodeList>());
+        std::atomic_store(&m_rootDirectory->m_contents, std::make_shared<const ObjectList>());
+
+        for (const auto &subdir : *subdirs)
+          m_directoryIndex.replace(subdir->m_fullPath, subdir, nullptr);
+
+        for (const auto &object : *contents)
+          m_objectIndex.replace(indexKey(m_rootDirectory->m_fullPath, object->name()), object, nullptr);
+      }
+
+      for (const auto &subdir : *subdirs)
+        this->teardown(subdir);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename F>
+    inline void ConcurrentStorage<T>::dump(F function) const {
+      this->dump(m_rootDirectory, function);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename F>
+    inline bool ConcurrentStorage<T>::iterate(const NodePtr &directory, F function) const {
+      ObjectListPtr contents = std::atomic_load(&directory->m_contents);
+
+      for (const auto &object : *contents)
+        if (!function(directory->m_fullPath, object))
+          return false;
+
+      NodeListPtr subdirs = std::atomic_load(&directory->m_subdirs);
+
+      for (const auto &subdir : *subdirs)
+        if (!this->iterate(subdir, function))
+          return false;
+
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename F>
+    inline void ConcurrentStorage<T>::dump(const NodePtr &directory, F function) const {
+      const std::string indent(directory->m_depth*2, ' ');
+      dqm_info( "{0}+ {1}", indent, (m_rootDirectory == directory) ? "/" : directory->m_name+"/" );
+      ObjectListPtr contents = std::atomic_load(&directory->m_contents);
+
+      for (const auto &object : *contents) {
+        std::string objectStr = function(object);
+        dqm_info( "{0}|- {1}", indent, objectStr );
+      }
+
+      NodeListPtr subdirs = std::atomic_load(&directory->m_subdirs);
+
+      for (const auto &subdir : *subdirs)
+        this->dump(subdir, function);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StatusCode ConcurrentStorage<T>::fullPath(const std::string &dirName, std::string &dirPath) {
+      dirPath = "/";
+      size_t pos = 0;
+
+      while (pos < dirName.size()) {
+        size_t end = dirName.find('/', pos);
+
+        if (std::string::npos == end)
+          end = dirName.size();
+
+        const size_t length = end - pos;
+
+        if (2 == length && 0 == dirName.compare(pos, length, "..")) {
+          if (1 == dirPath.size())
+            return STATUS_CODE_FAILURE;
+
+          dirPath.erase(std::max<size_t>(dirPath.rfind('/'), 1));
+        }
+        else if (0 != length && !(1 == length && '.' == dirName.at(pos))) {
+          if ('/' != dirPath.back())
+            dirPath += '/';
+
+          dirPath.append(dirName, pos, length);
+        }
+
+        pos = end + 1;
+      }
+
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline std::string ConcurrentStorage<T>::indexKey(const std::string &dirPath, const std::string &name) {
+      std::string key;
+      key.reserve(dirPath.size() + name.size() + 1);
+      key = dirPath;
+
+      if (key.empty() || '/' != key.back())
+        key += '/';
+
+      key += name;
+      return key;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StatusCode ConcurrentStorage<T>::mkdir(const std::string &dirPath, NodePtr &directory) {
+      // already existing directory
+      directory = m_directoryIndex.find(dirPath);
+
+      if (nullptr != directory)
+        return STATUS_CODE_SUCCESS;
+
+      directory = m_rootDirectory;
+      size_t pos = 1;
+
+      while (pos < dirPath.size()) {
+        size_t end = dirPath.find('/', pos);
+
+        if (std::string::npos == end)
+          end = dirPath.size();
+
+        const std::string subdirPath(dirPath, 0, end);
+        NodePtr subdir = m_directoryIndex.find(subdirPath);
+
+        if (nullptr == subdir) {
+          std::lock_guard<std::mutex> lock(directory->m_mutex);
+
+          // removed by an other thread in the mean time
+          if (directory->m_removed)
+            return STATUS_CODE_NOT_FOUND;
+
+          // check again, an other thread may have created it in the mean time
+          subdir = m_directoryIndex.find(subdirPath);
+
+          if (nullptr == subdir) {
+            subdir = std::make_shared<Node>(subdirPath, dirPath.substr(pos, end - pos), directory->m_depth + 1);
+            NodeListPtr subdirs = std::atomic_load(&directory->m_subdirs);
+            auto newSubdirs = std::make_shared<NodeList>();
+            newSubdirs->reserve(subdirs->size() + 1);
+            newSubdirs->insert(newSubdirs->end(), subdirs->begin(), subdirs->end());
+            newSubdirs->push_back(subdir);
+            std::atomic_store(&directory->m_subdirs, NodeListPtr(std::move(newSubdirs)));
+            m_directoryIndex.set(subdirPath, subdir);
+          }
+        }
+
+        directory = subdir;
+        pos = end + 1;
+      }
+
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline typename ConcurrentStorage<T>::NodePtr ConcurrentStorage<T>::find(const std::string &dirName) const {
+      std::string dirPath;
+
+      if (STATUS_CODE_SUCCESS != fullPath(dirName, dirPath))
+        return nullptr;
+
+      return m_directoryIndex.find(dirPath);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void ConcurrentStorage<T>::teardown(const NodePtr &directory) {
+      ObjectListPtr contents;
+      NodeListPtr subdirs;
+      {
+        // no object or sub-directory can be added once removed,
+        // so the snapshots taken here are the final ones
+        std::lock_guard<std::mutex> lock(directory->m_mutex);
+        directory->m_removed = true;
+        contents = std::atomic_load(&directory->m_contents);
+        subdirs = std::atomic_load(&directory->m_subdirs);
+      }
+
+      // the same paths may already have been re-created by an other thread:
+      // only remove the index entries pointing to the removed directory
+      for (const auto &object : *contents)
+        m_objectIndex.replace(indexKey(directory->m_fullPath, object->name()), object, nullptr);
+
+      m_directoryIndex.replace(directory->m_fullPath, directory, nullptr);
+
+      for (const auto &subdir : *subdirs)
+        this->teardown(subdir);
+    }
+  }
+}
+
+#endif //  DQM4HEP_CONCURRENTSTORAGE_H
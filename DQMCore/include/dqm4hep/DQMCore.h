@@ -12,9 +12,12 @@
 #define DQM4HEP_DQMCORE_H
 
 #include <dqm4hep/Archiver.h>
+#include <dqm4hep/ConcurrentStorage.h>
 #include <dqm4hep/DBInterface.h>
 #include <dqm4hep/Directory.h>
 #include <dqm4hep/Event.h>
+#include <dqm4hep/EventCompression.h>
+#include <dqm4hep/EventHeader.h>
 #include <dqm4hep/EventStreamer.h>
 #include <dqm4hep/GenericEvent.h>
 #include <dqm4hep/Internal.h>
@@ -31,6 +34,7 @@
 #include <dqm4hep/StatusCodes.h>
 #include <dqm4hep/Storage.h>
 #include <dqm4hep/Version.h>
+#include <dqm4hep/WorkerPool.h>
 #include <dqm4hep/XMLParser.h>
 #include <dqm4hep/XmlHelper.h>
 #include <dqm4hep/json.h>
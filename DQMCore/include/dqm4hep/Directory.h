@@ -20,6 +20,9 @@ namespace dqm4hep {
 
   namespace core {
 
+    template <typename T>
+    class Storage;
+
     /** Directory class.
      *
      *  A directory is the owner of its sub-directories.
@@ -30,6 +33,8 @@ namespace dqm4hep {
      */
     template <typename T>
     class Directory : public std::enable_shared_from_this<Directory<T>> {
+      friend class Storage<T>;
+
     public:
       typedef std::shared_ptr<T> ObjectPtr;
       typedef std::vector<ObjectPtr> ObjectList;
@@ -113,9 +118,10 @@ namespace dqm4hep {
        */
       void clear();
 
-      /** Get the full path name of the directory
+      /** Get the full path name of the directory.
+       *  Computed once at construction, directories can't be moved or renamed
        */
-      Path fullPath() const;
+      const Path &fullPath() const;
 
       /** Whether the directory is a root directory
        */
@@ -140,6 +146,7 @@ namespace dqm4hep {
 
     private:
       std::string m_name;
+      Path m_fullPath;
       DirectoryPtr m_parent;
       DirectoryList m_subdirs;
       ObjectList m_contents;
@@ -163,7 +170,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
-    inline Directory<T>::Directory() : m_name(""), m_parent(nullptr), m_subdirs(), m_contents() {
+    inline Directory<T>::Directory() : m_name(""), m_fullPath("/"), m_parent(nullptr), m_subdirs(), m_contents() {
       /* nop */
     }
 
@@ -171,7 +178,8 @@ namespace dqm4hep {
 
     template <typename T>
     inline Directory<T>::Directory(const std::string &dname, DirectoryPtr dparent)
-        : m_name(dname), m_parent(dparent), m_subdirs(), m_contents() {
+        : m_name(dname), m_fullPath((nullptr != dparent ? dparent->fullPath() : Path("/")) + Path(dname)), 
+          m_parent(dparent), m_subdirs(), m_contents() {
       /* nop */
     }
 
@@ -382,23 +390,8 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
-    inline Path Directory<T>::fullPath() const {
-      Path fPath = this->name();
-      DirectoryPtr dir = const_cast<Directory<T> *>(this)->shared_from_this();
-
-      while (true) {
-        DirectoryPtr parentDir = dir->parent();
-
-        if (nullptr != parentDir) {
-          fPath = parentDir->name() + fPath;
-          dir = parentDir;
-        } else {
-          fPath = Path("/") + fPath;
-          break;
-        }
-      }
-
-      return fPath;
+    inline const Path &Directory<T>::fullPath() const {
+      return m_fullPath;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -22,6 +22,7 @@ namespace dqm4hep {
   namespace core {
     
     class EventStreamer;
+    struct EventHeader;
 
     /** EventType enumerator
      */
@@ -81,6 +82,10 @@ namespace dqm4hep {
        */
       const std::string &getSource() const;
 
+      /** Get the event source id, see EventNameTable::sourceNames()
+       */
+      uint32_t getSourceId() const;
+
       /** Set the event time stamp
        */
       void setTimeStamp(const core::time::point &timeStamp);
@@ -118,6 +123,10 @@ namespace dqm4hep {
        */
       const std::string &getStreamerName() const;
 
+      /** Get the streamer id, see EventStreamerRegistry
+       */
+      uint32_t getStreamerId() const;
+
       /** Clear the event.
        *  Should call the real event implementation
        *  destructor if owned by the event wrapper
@@ -145,22 +154,28 @@ namespace dqm4hep {
        */
       void setEventSize(uint64_t eventSize);
       
-      /** Write the base event information in the xdrstream device
+      /** Fill the event header with the base event information
+       */
+      void writeHeader(EventHeader &header) const;
+
+      /** Set the base event information from the event header
        */
-      void writeBase(TBuffer &buffer) const;
+      void readHeader(const EventHeader &header);
 
-      /** Read the base event information from the xdrstream device
+      /** Read the base event information from the xdrstream device (older frame format)
        */
       void readBase(TBuffer &buffer);
 
     protected:
       EventType              m_type = {UNKNOWN_EVENT};       ///< The event type
-      std::string            m_source = {""};                ///< The event source
+      uint32_t               m_sourceId = {0};               ///< The event source id
+      const std::string     *m_source = {nullptr};           ///< The event source (interned)
       core::time::point      m_timeStamp = {};               ///< The event time stamp
       uint64_t               m_eventSize = {0};              ///< The serialized event size (unit bytes)
       uint32_t               m_eventNumber = {0};            ///< The event number
       uint32_t               m_runNumber = {0};              ///< The run number
-      std::string            m_streamerName = {""};
+      uint32_t               m_streamerId = {0};             ///< The streamer id
+      const std::string     *m_streamerName = {nullptr};     ///< The streamer name (interned)
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -249,14 +264,14 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
-    inline void Event::setSource(const std::string &sourceName) {
-      m_source = sourceName;
+    inline uint32_t Event::getSourceId() const {
+      return m_sourceId;
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    inline const std::string &Event::getSource() const {
-      return m_source;
+    inline uint32_t Event::getStreamerId() const {
+      return m_streamerId;
     }
 
     //-------------------------------------------------------------------------------------------------
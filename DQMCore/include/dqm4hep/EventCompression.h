@@ -0,0 +1,185 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_EVENTCOMPRESSION_H
+#define DQM4HEP_EVENTCOMPRESSION_H
+
+// -- dqm4hep headers
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/json.h>
+
+// -- std headers
+#include <string>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  EventCompression class.
+     *          Compression settings of the event payloads written by the EventStreamer,
+     *          using the ROOT compression algorithms (see R__zip). The payload is compressed
+     *          only if it is larger than the minimum size and if the compression actually
+     *          reduces its size, so that small or incompressible events don't pay for it.
+     *          The algorithm values match the ROOT ones, so that the settings written in
+     *          the event header (algorithm * 100 + level) are the ROOT compression settings.
+     */
+    class EventCompression {
+    public:
+      /**
+       *  @brief  Algorithm enum
+       */
+      enum Algorithm {
+        NONE = 0,       ///< No compression
+        ZLIB = 1,       ///< zlib
+        LZMA = 2,       ///< lzma
+        LZ4 = 4,        ///< lz4
+        ZSTD = 5        ///< zstd (ROOT >= 6.20)
+      };
+
+      /**
+       *  @brief  Whether the algorithm is supported by the ROOT version in use
+       *
+       *  @param  algorithm the algorithm to check
+       */
+      static bool isSupported(Algorithm algorithm);
+
+      /**
+       *  @brief  Get the algorithm name
+       *
+       *  @param  algorithm the algorithm
+       */
+      static std::string algorithmName(Algorithm algorithm);
+
+      /**
+       *  @brief  Get an algorithm from its name (case insensitive)
+       *
+       *  @param  name the algorithm name
+       *  @param  algorithm the algorithm to receive
+       */
+      static StatusCode algorithmFromName(const std::string &name, Algorithm &algorithm);
+
+      /**
+       *  @brief  Uncompress a payload written by compress()
+       *
+       *  @param  data the compressed payload
+       *  @param  size the compressed payload size
+       *  @param  rawSize the expected uncompressed payload size
+       *  @param  raw the uncompressed payload to receive
+       */
+      static StatusCode uncompress(const char *data, unsigned int size, unsigned int rawSize, std::vector<char> &raw);
+
+      /**
+       *  @brief  Default constructor. No compression
+       */
+      EventCompression() = default;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  algorithm the compression algorithm
+       *  @param  level the compression level (1 to 9)
+       *  @param  minSize the minimum payload size to compress (unit bytes)
+       */
+      EventCompression(Algorithm algorithm, unsigned int level, unsigned int minSize);
+
+      /**
+       *  @brief  Get the compression algorithm
+       */
+      Algorithm algorithm() const;
+
+      /**
+       *  @brief  Get the compression level
+       */
+      unsigned int level() const;
+
+      /**
+       *  @brief  Get the minimum payload size to compress (unit bytes)
+       */
+      unsigned int minSize() const;
+
+      /**
+       *  @brief  Whether the compression is enabled
+       */
+      bool enabled() const;
+
+      /**
+       *  @brief  Get the ROOT compression settings (algorithm * 100 + level), 0 if disabled
+       */
+      unsigned int settings() const;
+
+      /**
+       *  @brief  Compress a payload. Returns STATUS_CODE_UNCHANGED if the payload is smaller
+       *          than the minimum size or if the compressed payload is not smaller than the raw one
+       *
+       *  @param  data the raw payload
+       *  @param  size the raw payload size
+       *  @param  compressed the compressed payload to receive
+       */
+      StatusCode compress(const char *data, unsigned int size, std::vector<char> &compressed) const;
+
+      /**
+       *  @brief  Write the settings in a json object
+       *
+       *  @param  value the json object to receive
+       */
+      void toJson(json &value) const;
+
+      /**
+       *  @brief  Read the settings from a json object, as written by toJson()
+       *
+       *  @param  value the json object
+       *  @param  message an error message filled on failure
+       */
+      StatusCode fromJson(const json &value, std::string &message);
+
+    private:
+      Algorithm           m_algorithm = {NONE};        ///< The compression algorithm
+      unsigned int        m_level = {0};               ///< The compression level
+      unsigned int        m_minSize = {4096};          ///< The minimum payload size to compress
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    inline EventCompression::Algorithm EventCompression::algorithm() const {
+      return m_algorithm;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline unsigned int EventCompression::level() const {
+      return m_level;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline unsigned int EventCompression::minSize() const {
+      return m_minSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline bool EventCompression::enabled() const {
+      return (NONE != m_algorithm) && (0 != m_level);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline unsigned int EventCompression::settings() const {
+      return enabled() ? (m_algorithm * 100 + m_level) : 0;
+    }
+
+  }
+
+}
+
+#endif //  DQM4HEP_EVENTCOMPRESSION_H
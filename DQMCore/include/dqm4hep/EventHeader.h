@@ -0,0 +1,187 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_EVENTHEADER_H
+#define DQM4HEP_EVENTHEADER_H
+
+// -- dqm4hep headers
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/json.h>
+
+// -- std headers
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class TBuffer;
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  EventNameTable class.
+     *          Interned names (event sources, event streamers) identified by a 32 bits id.
+     *          The id is a hash of the name, so that all the processes and files agree on
+     *          the ids without a central authority. Names clashing with an already known
+     *          name id are refused. Interned names are never removed and can be referenced
+     *          for the lifetime of the process.
+     */
+    class EventNameTable {
+    public:
+      using Id = uint32_t;
+
+      /**
+       *  @brief  The id reserved for "no name"
+       */
+      static const Id invalidId = 0;
+
+      /**
+       *  @brief  Get the table of the event source names
+       */
+      static EventNameTable *sourceNames();
+
+      /**
+       *  @brief  Compute the id of a name. Never returns the invalid id
+       *
+       *  @param  name the name to hash
+       */
+      static Id hashName(const std::string &name);
+
+      /**
+       *  @brief  Constructor
+       */
+      EventNameTable() = default;
+      EventNameTable(const EventNameTable&) = delete;
+      EventNameTable& operator=(const EventNameTable&) = delete;
+
+      /**
+       *  @brief  Intern a name and get its id
+       *
+       *  @param  name the name to intern
+       *  @param  id the name id to receive
+       *  @param  internedName the interned name to receive
+       */
+      StatusCode intern(const std::string &name, Id &id, const std::string *&internedName);
+
+      /**
+       *  @brief  Get an interned name from its id, nullptr if unknown
+       *
+       *  @param  id the name id
+       */
+      const std::string *name(Id id) const;
+
+      /**
+       *  @brief  Write the table (name to id) in a json object
+       *
+       *  @param  table the json object to receive
+       */
+      void toJson(json &table) const;
+
+      /**
+       *  @brief  Intern the names of a table received from an other process or read from a file.
+       *          Names with an unexpected id or clashing with an other name id make the call fail
+       *
+       *  @param  table the json object (name to id)
+       *  @param  message an error message filled on failure
+       */
+      StatusCode fromJson(const json &table, std::string &message);
+
+    private:
+      mutable std::mutex                       m_mutex = {};      ///< Protects the name table
+      std::unordered_map<Id, std::string>      m_names = {};      ///< The interned names
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  EventHeader struct.
+     *          The fixed size header starting every event frame written by the EventStreamer.
+     *          The serialized layout (ROOT buffer byte order) is:
+     *            - marker (uint8, always 0, reads as an empty string for older frames)
+     *            - header version (uint8)
+     *            - event type (uint16)
+     *            - streamer id (uint32), see EventStreamerRegistry
+     *            - source id (uint32), see EventNameTable::sourceNames()
+     *            - event number (uint32)
+     *            - run number (uint32)
+     *            - time stamp (int64, nanoseconds since epoch)
+     *            - compression settings (uint32), see EventCompression
+     *            - raw payload size (uint32), the payload size before compression
+     *            - compression time (uint32), the time spent compressing the payload (unit us)
+     *            - payload size (uint32), the number of bytes following the header
+     *          Headers can be peeked from a raw frame without decoding the event payload.
+     */
+    struct EventHeader {
+      static constexpr uint8_t        currentVersion = 1;                        ///< The current header version
+      static constexpr unsigned int   size = 44;                                 ///< The serialized header size
+
+      /**
+       *  @brief  Write the header in the buffer
+       *
+       *  @param  buffer the buffer to write with
+       */
+      void write(TBuffer &buffer) const;
+
+      /**
+       *  @brief  Overwrite a header already written in the buffer,
+       *          e.g to set the payload size once the payload is written
+       *
+       *  @param  buffer the buffer to write with
+       *  @param  headerOffset the header offset in the buffer
+       */
+      void overwrite(TBuffer &buffer, unsigned int headerOffset) const;
+
+      /**
+       *  @brief  Read the header from the buffer.
+       *          Returns false if the buffer doesn't start with a compact header
+       *
+       *  @param  buffer the buffer to read with
+       */
+      bool read(TBuffer &buffer);
+
+      /**
+       *  @brief  Read the header of a raw event frame, without decoding the event payload
+       *
+       *  @param  buffer the raw event frame
+       *  @param  frameSize the raw event frame size
+       *  @param  header the header to receive
+       */
+      static bool peek(const char *buffer, unsigned int frameSize, EventHeader &header);
+
+      /**
+       *  @brief  Get the source name, empty if the source id is unknown in this process
+       */
+      const std::string &sourceName() const;
+
+      /**
+       *  @brief  Whether the payload is compressed
+       */
+      bool compressed() const;
+
+      uint8_t               m_version = {currentVersion};          ///< The header version
+      uint16_t              m_type = {0};                          ///< The event type
+      uint32_t              m_streamerId = {0};                    ///< The streamer id
+      uint32_t              m_sourceId = {0};                      ///< The source id
+      uint32_t              m_eventNumber = {0};                   ///< The event number
+      uint32_t              m_runNumber = {0};                     ///< The run number
+      int64_t               m_timeStamp = {0};                     ///< The time stamp (unit ns since epoch)
+      uint32_t              m_compression = {0};                   ///< The compression settings, 0 if not compressed
+      uint32_t              m_rawPayloadSize = {0};                ///< The payload size before compression (unit bytes)
+      uint32_t              m_compressionTime = {0};               ///< The compression time (unit us)
+      uint32_t              m_payloadSize = {0};                   ///< The payload size (unit bytes)
+    };
+
+  }
+
+}
+
+#endif //  DQM4HEP_EVENTHEADER_H
@@ -13,7 +13,10 @@
 
 // -- dqm4hep headers
 #include <dqm4hep/Event.h>
+#include <dqm4hep/EventCompression.h>
+#include <dqm4hep/EventHeader.h>
 #include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/json.h>
 
 class TBuffer;
 
@@ -22,7 +25,18 @@ namespace dqm4hep {
   namespace core {
 
     class Event;
+    class EventStreamerPlugin;
     
+    /**
+     *  @brief  EventStreamer class.
+     *          Write and read events with the streamer plugin set in the event.
+     *          An event frame starts with a fixed size EventHeader followed by the user event data,
+     *          optionally compressed (see EventCompression). Compressed frames are always readable,
+     *          whatever the compression settings of the reading streamer.
+     *          Frames starting with the streamer name (older format) are still readable.
+     *          Apart from the compression settings, the class holds no state and can be used 
+     *          from several threads
+     */
     class EventStreamer {
     public:
       /**
@@ -35,29 +49,131 @@ namespace dqm4hep {
        */
       ~EventStreamer() = default;
       
+      /**
+       *  @brief  Set the compression settings of the written events.
+       *          Must not be called while events are written from other threads
+       *          
+       *  @param  compression the compression settings
+       */
+      void setCompression(const EventCompression &compression);
+      
+      /**
+       *  @brief  Get the compression settings of the written events
+       */
+      const EventCompression &compression() const;
+      
       /**
        *  @brief  Write an event using an xdrstream device.
-       *          The streamer info is taken from Event::getStreamerName()
-       *          and from the plugin manager.
+       *          The streamer info is taken from Event::getStreamerId()
+       *          and from the streamer registry.
        *          
        *  @param  event the event to write
        *  @param  buffer the buffer to write with
        */
-      StatusCode writeEvent(EventPtr event, TBuffer &buffer);
+      StatusCode writeEvent(EventPtr event, TBuffer &buffer) const;
       
       /**
        *  @brief  Read an event using an xdrstream device.
-       *          The streamer info is read from the buffer
-       *          and the streamer if allocated from the plugin manager.
+       *          The streamer id is read from the event header
+       *          and the streamer is taken from the streamer registry.
        *          
        *  @param  event the event to read
        *  @param  buffer the buffer to read with
        */
-      StatusCode readEvent(EventPtr &event, TBuffer &buffer);
+      StatusCode readEvent(EventPtr &event, TBuffer &buffer) const;
+      
+    private:
+      EventCompression          m_compression = {};       ///< The compression settings of the written events
+    };
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    /**
+     *  @brief  EventStreamerRegistry class.
+     *          Map the event streamer plugin names to compact numeric ids written in event frames,
+     *          see EventNameTable for the id allocation. Event sources exchange their streamer 
+     *          table with the collectors at registration. 
+     *          Streamer plugin instances are cached once per id and per thread, as plugins may hold
+     *          scratch buffers and are not required to be thread safe.
+     */
+    class EventStreamerRegistry {
+    public:
+      using StreamerId = EventNameTable::Id;
+      
+      /**
+       *  @brief  The id reserved for "no streamer"
+       */
+      static const StreamerId invalidId = EventNameTable::invalidId;
+      
+      /**
+       *  @brief  Get the registry singleton
+       */
+      static EventStreamerRegistry *instance();
+      
+      EventStreamerRegistry(const EventStreamerRegistry&) = delete;
+      EventStreamerRegistry& operator=(const EventStreamerRegistry&) = delete;
+      
+      /**
+       *  @brief  Register a streamer plugin and get its id
+       *
+       *  @param  streamerName the streamer plugin name
+       *  @param  id the streamer id to receive
+       */
+      StatusCode registerStreamer(const std::string &streamerName, StreamerId &id);
+      
+      /**
+       *  @brief  Intern a streamer name, without checking the plugin availability
+       *
+       *  @param  streamerName the streamer plugin name
+       *  @param  id the streamer id to receive
+       *  @param  internedName the interned streamer name to receive
+       */
+      StatusCode internName(const std::string &streamerName, StreamerId &id, const std::string *&internedName);
+      
+      /**
+       *  @brief  Get the name of a streamer from its id. 
+       *          Unknown ids are looked up in the plugin manager
+       *
+       *  @param  id the streamer id
+       *  @param  streamerName the streamer plugin name to receive
+       */
+      StatusCode streamerName(StreamerId id, std::string &streamerName);
+      
+      /**
+       *  @brief  Get the streamer table (name to id) of the registered streamers
+       *
+       *  @param  table the json object to receive
+       */
+      void streamerTable(json &table);
+      
+      /**
+       *  @brief  Check a streamer table received from an other process against this registry.
+       *          Unknown streamers are registered, streamers with a different id or clashing 
+       *          with an other streamer id make the check fail
+       *
+       *  @param  table the json object (name to id)
+       *  @param  message an error message filled on failure
+       */
+      StatusCode checkStreamerTable(const json &table, std::string &message);
+      
+      /**
+       *  @brief  Get the streamer plugin instance of the calling thread for a streamer id
+       *
+       *  @param  id the streamer id
+       *  @param  streamerName the interned streamer plugin name to receive
+       *  @param  streamer the streamer plugin instance to receive
+       */
+      StatusCode findStreamer(StreamerId id, const std::string *&streamerName, EventStreamerPlugin *&streamer);
+      
+    private:
+      /**
+       *  @brief  Constructor
+       */
+      EventStreamerRegistry() = default;
       
     private:
-      std::string                  m_streamerName = {""};     ///< The current event streamer name in use
-      EventStreamerPluginPtr       m_streamer = {nullptr};    ///< The current event streamer in use
+      EventNameTable               m_names = {};      ///< The registered streamer names
     };
     
     //-------------------------------------------------------------------------------------------------
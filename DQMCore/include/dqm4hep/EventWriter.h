@@ -0,0 +1,80 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics 
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_EVENTWRITER_H
+#define DQM4HEP_EVENTWRITER_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/Run.h"
+#include "dqm4hep/Event.h"
+
+namespace dqm4hep {
+
+  namespace core {
+    
+    /**
+     *  @brief  EventWriter class
+     *
+     *  Implement the logic of writing events in a file, 
+     *  that can be read back by the corresponding EventReader.
+     *
+     *  Typical use of event writer:
+     *  @code{.cpp}
+     *  EventWriterPtr writer = PluginManager::instance()->create<EventWriter>("BinaryEventWriter");
+     *  writer->open("detector_I12548.dqm");
+     *  // for each event
+     *  writer->writeEvent(event);
+     *  // run info can be set at any time before closing
+     *  writer->setRunInfo(run);
+     *  writer->close();
+     *  @endcode
+     */
+    class EventWriter {
+    public:
+      /**
+       *  @brief  Destructor
+       */
+      virtual ~EventWriter();
+      
+      /**
+       *  @brief  Open a new file. Overwrite the file if it already exists
+       *
+       *  @param  fname the file name to open
+       */
+      virtual core::StatusCode open(const std::string &fname) = 0;
+      
+      /**
+       *  @brief  Set the run info to store in the file
+       * 
+       *  @param  run the run info
+       */
+      virtual core::StatusCode setRunInfo(const core::Run &run) = 0;
+      
+      /**
+       *  @brief  Write an event in the file
+       *
+       *  @param  event the event to write
+       */
+      virtual core::StatusCode writeEvent(core::EventPtr event) = 0;
+      
+      /**
+       *  @brief  Close the current file
+       */
+      virtual core::StatusCode close() = 0;
+    };
+    
+    typedef std::shared_ptr<EventWriter> EventWriterPtr;
+  }
+
+} 
+
+#endif  //  DQM4HEP_EVENTWRITER_H
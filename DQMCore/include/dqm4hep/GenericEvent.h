@@ -21,24 +21,95 @@ namespace dqm4hep {
   namespace core {
 
     class GenericEventStreamer;
+    class GenericEventColumnarStreamer;
+    
+    /** 
+     *  @brief  ArrayView class.
+     *          Read-only view on a contiguous array of values. 
+     *          The view doesn't own the values and is valid as long 
+     *          as the viewed storage is not modified or destroyed
+     */
+    template <typename T>
+    class ArrayView {
+    public:
+      typedef const T* const_iterator;
+      
+      /**
+       *  @brief  Default constructor. Empty view
+       */
+      ArrayView() = default;
+      
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  data the first element of the array
+       *  @param  size the number of elements in the array
+       */
+      ArrayView(const T *data, std::size_t size);
+      
+      /**
+       *  @brief  Get the first element of the array
+       */
+      const T *data() const;
+      
+      /**
+       *  @brief  Get the number of elements in the array
+       */
+      std::size_t size() const;
+      
+      /**
+       *  @brief  Whether the array is empty
+       */
+      bool empty() const;
+      
+      /**
+       *  @brief  Get the element at index (not checked)
+       */
+      const T &operator[](std::size_t index) const;
+      
+      /**
+       *  @brief  Iterator on the first element
+       */
+      const_iterator begin() const;
+      
+      /**
+       *  @brief  Iterator past the last element
+       */
+      const_iterator end() const;
+      
+    private:
+      const T           *m_data = {nullptr};      ///< The first element of the array
+      std::size_t        m_size = {0};            ///< The number of elements in the array
+    };
 
     /** GenericEvent class
      *
-     *  Basic event implementation with a list of vectors stored in maps.
+     *  Basic event implementation with a list of vectors identified by keys.
      *  See GenericEvent::setValues() and GenericEvent::getValues() to
-     *  respectively set and get values into these map.
+     *  respectively set and get values.
+     *  
+     *  The vectors are indexed by key and type in a flat open addressing
+     *  hash table. Keys are interned: a GenericEvent::Key handle resolves the key 
+     *  string and its hash once, so that a look-up with a handle costs a 
+     *  probe and a pointer comparison.
      *
      *  To get this kind of event within an analysis module, proceed like this :
      *
      *  \code
      *
+     *  StatusCode MyModule::initModule() {
+     *      // resolve the key once
+     *  	m_temperatureKey = GenericEvent::Key("Temperature");
+     *  	// ...
+     *  }
+     *
      *  StatusCode MyModule::processEvent(Event *pEvent) {
      *
      *  	GenericEvent *pGenericEvent = pEvent->getEvent<GenericEvent>();
      *
-     *      // Access contents via getValues()
-     *  	FloatVector temperatures;
-     *  	pGenericEvent->getValues("Temperature", temperatures);
+     *      // Access contents via getValues(), without copy
+     *  	ArrayView<float> temperatures;
+     *  	pGenericEvent->getValues(m_temperatureKey, temperatures);
      *  	// ...
      *  }
      *
@@ -46,6 +117,52 @@ namespace dqm4hep {
      */
     class GenericEvent {
     public:
+      /**
+       *  @brief  Key class.
+       *          Handle on an interned key. The key string is stored once for
+       *          the whole process and its hash is computed at construction.
+       *          The keys already resolved by the calling thread are found in a
+       *          per-thread cache, the process wide set is only locked for new keys.
+       *          Interned keys are never released: avoid dynamic key names.
+       *          Cheap to copy. Resolve keys once (e.g in initModule()) and 
+       *          re-use them for each event.
+       */
+      class Key {
+      public:
+        /**
+         *  @brief  Default constructor. Invalid key
+         */
+        Key() = default;
+        
+        /**
+         *  @brief  Constructor. Intern the key string (thread safe)
+         *
+         *  @param  name the key string
+         */
+        explicit Key(const std::string &name);
+        
+        /**
+         *  @brief  Get the key string
+         */
+        const std::string &name() const;
+        
+        /**
+         *  @brief  Get the key hash
+         */
+        std::size_t hash() const;
+        
+        /**
+         *  @brief  Whether the key handle has been resolved
+         */
+        bool valid() const;
+        
+      private:
+        const std::string     *m_name = {nullptr};    ///< The interned key string
+        std::size_t            m_hash = {0};          ///< The key hash
+        
+        friend class GenericEvent;
+      };
+      
       /**
        *  @brief  Allocate a shared pointer of EventPtr
        */
@@ -54,6 +171,8 @@ namespace dqm4hep {
       /** Constructor
        */
       GenericEvent();
+      GenericEvent(const GenericEvent&) = delete;
+      GenericEvent& operator=(const GenericEvent&) = delete;
 
       /** Destructor
        */
@@ -71,6 +190,12 @@ namespace dqm4hep {
        */
       template <typename T>
       StatusCode setValues(const std::string &key, const T &vals);
+      
+      /** Set a vector of values identified by a key handle.
+       *  Same as above, without resolving the key
+       */
+      template <typename T>
+      StatusCode setValues(const Key &key, const T &vals);
 
       /** Get a vector of values identified by key.
        *
@@ -84,21 +209,296 @@ namespace dqm4hep {
        */
       template <typename T>
       StatusCode getValues(const std::string &key, T &vals) const;
+      
+      /** Get a vector of values identified by a key handle.
+       *  Same as above, without resolving the key
+       */
+      template <typename T>
+      StatusCode getValues(const Key &key, T &vals) const;
+      
+      /** Get a read-only view on the values identified by key, without copy.
+       *  The view is valid as long as the values of this key are not modified 
+       *  and the event is alive.
+       *
+       *  Attention : Template interface restricted to the following types :
+       *    - int
+       *    - float
+       *    - double
+       *    - string
+       *  In case where an another parameter type is passed, the code will compile
+       *  but will do nothing and return failure.
+       */
+      template <typename T>
+      StatusCode getValues(const std::string &key, ArrayView<T> &view) const;
+      
+      /** Get a read-only view on the values identified by a key handle.
+       *  Same as above, without resolving the key
+       */
+      template <typename T>
+      StatusCode getValues(const Key &key, ArrayView<T> &view) const;
 
     private:
-      typedef std::map<std::string, IntVector> IntVectorMap;
-      typedef std::map<std::string, FloatVector> FloatVectorMap;
-      typedef std::map<std::string, DoubleVector> DoubleVectorMap;
-      typedef std::map<std::string, StringVector> StringVectorMap;
-
-      IntVectorMap m_intValues = {};
-      FloatVectorMap m_floatValues = {};
-      DoubleVectorMap m_doubleValues = {};
-      StringVectorMap m_stringValues = {};
+      /** ColumnType enumerator. The value types
+       */
+      enum ColumnType {
+        INT_COLUMN = 0,
+        FLOAT_COLUMN = 1,
+        DOUBLE_COLUMN = 2,
+        STRING_COLUMN = 3
+      };
+      
+      /** Entry struct. A slot of the hash table
+       */
+      struct Entry {
+        const std::string  *m_key = {nullptr};     ///< The interned key, nullptr for an empty slot
+        std::size_t         m_hash = {0};          ///< The key hash
+        ColumnType          m_type = {INT_COLUMN}; ///< The values type
+        int                 m_index = {-1};        ///< The index in the typed vector storage, -1 if not allocated
+        bool                m_column = {false};    ///< Whether the values are referenced in the columnar buffer
+        const char         *m_data = {nullptr};    ///< The first value in the columnar buffer
+        std::size_t         m_size = {0};          ///< The number of values in the columnar buffer
+      };
+      
+      /** Get the column type of a value type
+       */
+      template <typename T>
+      static ColumnType columnType();
+      
+      /** Get the typed vector storage
+       */
+      template <typename T>
+      std::vector<std::vector<T>> &storage();
+      
+      /** Get the typed vector storage
+       */
+      template <typename T>
+      const std::vector<std::vector<T>> &storage() const;
+      
+      /** Find the entry of a key handle and type. Return nullptr if not found
+       */
+      const Entry *findEntry(const Key &key, ColumnType type) const;
+      
+      /** Find the entry of a key string and type, without interning. Return nullptr if not found
+       */
+      const Entry *findEntry(const std::string &key, ColumnType type) const;
+      
+      /** Find or insert the entry of a key handle and type.
+       *  The hash table only grows when a new entry is inserted
+       */
+      Entry &insertEntry(const Key &key, ColumnType type);
+      
+      /** Get the vector of values of a key, inserted if needed. 
+       *  Values referenced in the columnar buffer are replaced by an empty vector
+       */
+      template <typename T>
+      std::vector<T> &values(const Key &key);
+      
+      /** Reference values in the columnar buffer (see GenericEventColumnarStreamer).
+       *  The vector previously holding the values of this key is released and its slot is kept
+       */
+      void addColumn(const Key &key, ColumnType type, const char *data, std::size_t size);
+      
+      /** Get a view on the values of an entry
+       */
+      template <typename T>
+      ArrayView<T> view(const Entry &entry) const;
+      
+      /** Call function(key, data, size) for each array of values of type T
+       */
+      template <typename T, typename F>
+      void visitValues(F function) const;
+      
+    private:
+      std::vector<Entry>            m_entries = {};                    ///< The hash table (power of 2 size)
+      std::size_t                   m_nEntries = {0};                  ///< The number of used slots
+      std::vector<IntVector>        m_intValues = {};                  ///< The int vectors
+      std::vector<FloatVector>      m_floatValues = {};                ///< The float vectors
+      std::vector<DoubleVector>     m_doubleValues = {};               ///< The double vectors
+      std::vector<StringVector>     m_stringValues = {};               ///< The string vectors
+      std::unique_ptr<uint64_t[]>   m_columnBuffer = {nullptr};        ///< The columnar buffer (see GenericEventColumnarStreamer)
 
       friend class GenericEventStreamer;
+      friend class GenericEventColumnarStreamer;
     };
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline ArrayView<T>::ArrayView(const T *d, std::size_t s) :
+      m_data(d),
+      m_size(s) {
+      /* nop */
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline const T *ArrayView<T>::data() const {
+      return m_data;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline std::size_t ArrayView<T>::size() const {
+      return m_size;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline bool ArrayView<T>::empty() const {
+      return (0 == m_size);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline const T &ArrayView<T>::operator[](std::size_t index) const {
+      return m_data[index];
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline typename ArrayView<T>::const_iterator ArrayView<T>::begin() const {
+      return m_data;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline typename ArrayView<T>::const_iterator ArrayView<T>::end() const {
+      return m_data + m_size;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline GenericEvent::ColumnType GenericEvent::columnType<int>() {
+      return INT_COLUMN;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline GenericEvent::ColumnType GenericEvent::columnType<float>() {
+      return FLOAT_COLUMN;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline GenericEvent::ColumnType GenericEvent::columnType<double>() {
+      return DOUBLE_COLUMN;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline GenericEvent::ColumnType GenericEvent::columnType<std::string>() {
+      return STRING_COLUMN;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline std::vector<std::vector<int>> &GenericEvent::storage<int>() {
+      return m_intValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline const std::vector<std::vector<int>> &GenericEvent::storage<int>() const {
+      return m_intValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline std::vector<std::vector<float>> &GenericEvent::storage<float>() {
+      return m_floatValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline const std::vector<std::vector<float>> &GenericEvent::storage<float>() const {
+      return m_floatValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline std::vector<std::vector<double>> &GenericEvent::storage<double>() {
+      return m_doubleValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline const std::vector<std::vector<double>> &GenericEvent::storage<double>() const {
+      return m_doubleValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline std::vector<std::vector<std::string>> &GenericEvent::storage<std::string>() {
+      return m_stringValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <>
+    inline const std::vector<std::vector<std::string>> &GenericEvent::storage<std::string>() const {
+      return m_stringValues;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline std::vector<T> &GenericEvent::values(const Key &key) {
+      Entry &entry(this->insertEntry(key, columnType<T>()));
+      std::vector<std::vector<T>> &vectors(this->storage<T>());
+      if(entry.m_column) {
+        entry.m_column = false;
+        entry.m_data = nullptr;
+        entry.m_size = 0;
+      }
+      if(entry.m_index < 0) {
+        entry.m_index = vectors.size();
+        vectors.push_back(std::vector<T>());
+      }
+      return vectors[entry.m_index];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline ArrayView<T> GenericEvent::view(const Entry &entry) const {
+      if(entry.m_column) {
+        return ArrayView<T>(reinterpret_cast<const T*>(entry.m_data), entry.m_size);
+      }
+      const std::vector<T> &vals(this->storage<T>()[entry.m_index]);
+      return ArrayView<T>(vals.data(), vals.size());
+    }
 
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T, typename F>
+    inline void GenericEvent::visitValues(F function) const {
+      const ColumnType type(columnType<T>());
+      for(const auto &entry : m_entries) {
+        if(nullptr != entry.m_key && entry.m_type == type) {
+          const ArrayView<T> vals(this->view<T>(entry));
+          function(*entry.m_key, vals.data(), vals.size());
+        }
+      }
+    }
   }
   
 }
@@ -233,6 +233,24 @@ namespace dqm4hep {
         return static_cast<int32_t>(asTime(p));
       }
       
+      /**
+       *  @brief  Convert the time point to a number of nanoseconds since epoch
+       * 
+       *  @param  p the time point to convert
+       */
+      static inline int64_t asNanoseconds(const point &p) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(p.time_since_epoch()).count();
+      }
+      
+      /**
+       *  @brief  Convert a number of nanoseconds since epoch to time point
+       * 
+       *  @param  nsec the number of nanoseconds to convert
+       */
+      static inline point fromNanoseconds(int64_t nsec) {
+        return point(std::chrono::duration_cast<duration>(std::chrono::nanoseconds(nsec)));
+      }
+      
       /**
        *  @brief  Convert a time pointto string. Format is HH:MM:SS
        * 
@@ -251,6 +269,7 @@ namespace dqm4hep {
     // event
     typedef type<Event>::ptr EventPtr;
     typedef type<Event>::ptr_deque EventQueue;
+    typedef type<Event>::ptr_vector EventList;
     typedef type<EventStreamerPlugin>::ptr EventStreamerPluginPtr;
 
     // plugin
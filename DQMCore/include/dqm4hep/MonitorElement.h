@@ -14,6 +14,7 @@
 // -- dqm4hep headers
 #include <dqm4hep/Internal.h>
 #include <dqm4hep/PtrHandler.h>
+#include <dqm4hep/QualityTest.h>
 #include <dqm4hep/StatusCodes.h>
 #include <dqm4hep/json.h>
 
@@ -203,6 +204,24 @@ namespace dqm4hep {
        *  @param  resetQtests whether to also reset the quality tests 
        */
       virtual void reset(bool resetQtests = true);
+
+      /**
+       *  @brief  Flag the monitor element as modified.
+       *          Only needed if the monitored object is modified in a way
+       *          that its fingerprint can't see (see generation())
+       */
+      void setModified();
+
+      /**
+       *  @brief  Get the modification generation of the monitor element.
+       *          The generation increases when the monitored object, the reference
+       *          or the quality tests are changed. Changes done directly on the ROOT
+       *          object are detected from a cheap fingerprint computed on call:
+       *          entries and statistics for histograms, number of points and last
+       *          point for graphs, text for scalars. Any other object type is
+       *          considered as modified on each call
+       */
+      unsigned long generation() const;
       
       /**
        *  @brief  Convert the monitor element to json
@@ -313,6 +332,24 @@ namespace dqm4hep {
        */
       virtual StatusCode runQualityTest(const std::string &name, QReport &report);
 
+      /** 
+       *  @brief  Receive the reports of all quality tests when they are run
+       *          by the monitor element manager on its worker pool, instead of
+       *          with runQualityTests()
+       *
+       *  @param  reports the quality test reports
+       */
+      virtual void setQualityReports(const QReportMap &reports);
+
+    private:
+      /**
+       *  @brief  Compute the fingerprint of the monitored object
+       *
+       *  @param  values the fingerprint values to receive
+       *  @return whether the monitored object type supports fingerprinting
+       */
+      bool fingerprint(std::vector<double> &values) const;
+
     private:
       /// The monitor element path
       std::string m_path = {""};
@@ -322,6 +359,16 @@ namespace dqm4hep {
       PtrHandler<TObject> m_referenceObject = {};
       /// The list of assigned quality tests
       QTestMap m_qualityTests = {};
+      /// The modification generation
+      mutable unsigned long m_generation = {1};
+      /// The monitored object fingerprint at the last generation() call
+      mutable std::vector<double> m_fingerprint = {};
+      /// The generation for which the last quality test reports were produced
+      unsigned long m_reportsGeneration = {0};
+      /// The last quality test reports, re-used while the element is not modified
+      QReportMap m_lastReports = {};
+      /// The generation of the last json export
+      mutable unsigned long m_exportGeneration = {0};
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include <dqm4hep/Directory.h>
 #include <dqm4hep/RootStyle.h>
 #include <dqm4hep/Archiver.h>
+#include <dqm4hep/WorkerPool.h>
 
 namespace dqm4hep {
 
@@ -287,8 +288,9 @@ namespace dqm4hep {
        *  @brief  Write all monitor elements in the storage to json
        *  
        *  @param  object the json object to receive
+       *  @param  modifiedOnly whether to only write the elements modified since the previous export
        */
-      void monitorElementsToJson(json &object) const;
+      void monitorElementsToJson(json &object, bool modifiedOnly = false) const;
       
       /**
        *  @brief  Add a reference file under the specified id
@@ -444,6 +446,28 @@ namespace dqm4hep {
        */
       StatusCode removeMonitorElement(const std::string &path, const std::string &name);
 
+      /** 
+       *  @brief  Rename a specific monitor element.
+       *          Use this function rather than MonitorElement::setName() for booked 
+       *          elements, so that they can still be found by name
+       *
+       *  @param  path the path to the monitor element
+       *  @param  name the name of the monitor element
+       *  @param  newName the new name of the monitor element
+       */
+      StatusCode renameMonitorElement(const std::string &path, const std::string &name, const std::string &newName);
+
+      /** 
+       *  @brief  Merge the monitor objects of an other manager into the monitor elements 
+       *          of this manager with the same path and name, and reset them in the other manager.
+       *          Histograms are merged using TH1::Add(), other objects using the Merge() and
+       *          ResetAfterMerge() functions of their ROOT class, if available. 
+       *          Monitor elements that don't match or can't be merged are skipped
+       *
+       *  @param  other the monitor element manager to merge in this one
+       */
+      StatusCode mergeMonitorElements(MonitorElementManager &other);
+
     public:
       /** 
        *  @brief  Create a quality test from the xml element.
@@ -475,7 +499,9 @@ namespace dqm4hep {
                                    const std::string &qualityTestName);
 
       /**
-       *  @brief  Run all quality tests for all monitor elements and receive qtest reports
+       *  @brief  Run all quality tests for all monitor elements and receive qtest reports.
+       *          The elements not modified since the previous call (see MonitorElement::generation())
+       *          are not tested again, their previous reports are re-used
        *
        *  @param  reports the quality test reports to receive
        */
@@ -501,6 +527,23 @@ namespace dqm4hep {
       StatusCode runQualityTest(const std::string &path, const std::string &name, const std::string &qualityTestName,
                                 QReportStorage &reports);
 
+      /**
+       *  @brief  Set the number of threads running the quality tests in runQualityTests(reports).
+       *          With more than one thread, the (monitor element, quality test) pairs are run
+       *          concurrently on a worker pool and the reports are merged at the end, in the
+       *          monitor element order. ROOT thread safety is then enabled. The quality tests
+       *          which are not thread safe (see QualityTest::threadSafe()) run in the calling thread.
+       *          Default is 1: the quality tests are run in the calling thread
+       *
+       *  @param  nThreads the number of threads, including the calling thread
+       */
+      void setQualityTestThreads(unsigned int nThreads);
+
+      /**
+       *  @brief  Get the number of threads running the quality tests
+       */
+      unsigned int qualityTestThreads() const;
+
     private:
       /**
        *  @brief  Check if the target class is compatible with the DQM4hep requirements.
@@ -584,6 +627,8 @@ namespace dqm4hep {
       RootStyle                    m_referenceStyle = {};
       /// The map of reference ROOT files currently handled
       ReferenceMap                 m_references = {};
+      /// The worker pool running the quality tests, if more than one thread
+      std::unique_ptr<WorkerPool>  m_qualityTestPool = {nullptr};
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -599,7 +644,7 @@ namespace dqm4hep {
     template <typename T>
     inline StatusCode MonitorElementManager::getMonitorElement(const std::string &name,
                                                         std::shared_ptr<T> &monitorElement) const {
-      monitorElement = std::dynamic_pointer_cast<T>(m_storage.findObject([&name](const MonitorElementPtr &elt) { return (elt->name() == name); }));
+      monitorElement = std::dynamic_pointer_cast<T>(m_storage.findObjectByName(name));
 
       if (nullptr == monitorElement)
         return STATUS_CODE_NOT_FOUND;
@@ -612,8 +657,7 @@ namespace dqm4hep {
     template <typename T>
     inline StatusCode MonitorElementManager::getMonitorElement(const std::string &dirName, const std::string &name,
                                                         std::shared_ptr<T> &monitorElement) const {
-      monitorElement = std::dynamic_pointer_cast<T>(
-          m_storage.findObject(dirName, [&name](const MonitorElementPtr &elt) { return (elt->name() == name); }));
+      monitorElement = std::dynamic_pointer_cast<T>(m_storage.findObjectByName(dirName, name));
 
       if (nullptr == monitorElement)
         return STATUS_CODE_NOT_FOUND;
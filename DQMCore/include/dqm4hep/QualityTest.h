@@ -73,6 +73,7 @@ namespace dqm4hep {
       std::string m_message = {""};
       QualityFlag m_qualityFlag = {UNDEFINED};
       float m_quality = {0.f};
+      double m_executionTime = {0.};  ///< The quality test wall time (unit ms)
       json m_extraInfos = {};
     };
 
@@ -176,7 +177,11 @@ namespace dqm4hep {
        */
       const std::string &description() const;
 
-      /** Perform the quality test result and fill the quality test report
+      /** Perform the quality test result and fill the quality test report.
+       *  The wall time of the test is recorded in the report.
+       *  Unless threadSafe() returns false, it may be called from several threads at the same time (see
+       *  MonitorElementManager::setQualityTestThreads()): the implementation must then modify neither
+       *  the quality test nor the monitor element while running
        */
       void run(MonitorElement* monitorElement, QualityTestReport &report);
 
@@ -195,6 +200,13 @@ namespace dqm4hep {
        */
       virtual bool enoughStatistics(MonitorElement* monitorElement) const;
 
+      /**
+       *  @brief  Whether the quality test can run on several monitor elements at the same time.
+       *          Tests which are not are run in the calling thread when the monitor element
+       *          manager runs the quality tests on a worker pool
+       */
+      virtual bool threadSafe() const;
+
       /**
        *  @brief  Set the warning and error limits on quality test result.
        *          The limits must be ordered as 0 < error < warning < 1, else throws an exception
@@ -234,6 +246,11 @@ namespace dqm4hep {
        */
       void fillBasicInfo(MonitorElement* monitorElement, QualityTestReport &report) const;
 
+    private:
+      /** Run the quality test, see run()
+       */
+      void runTest(MonitorElement* monitorElement, QualityTestReport &report);
+
     private:
       std::string          m_type = {""};  ///< Quality test type (usually class name)
       std::string          m_name = {""};  ///< Quality test name
@@ -277,6 +294,12 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    inline bool QualityTest::threadSafe() const {
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     inline QualityTestFactory::~QualityTestFactory() {
       /* nop */
     }
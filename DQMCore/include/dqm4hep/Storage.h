@@ -16,10 +16,21 @@
 #include <dqm4hep/Internal.h>
 #include <dqm4hep/StatusCodes.h>
 
+// -- std headers
+#include <unordered_map>
+
 namespace dqm4hep {
 
   namespace core {
 
+    /** Storage class.
+     *
+     *  A tree of directories holding objects. The objects must provide a name() method.
+     *  A hash index of the directories and objects by full path ("/dir/subdir/name") is
+     *  maintained alongside the tree, so that lookups by name don't scan the directories.
+     *  The index is kept in sync by the storage methods: the directories and objects 
+     *  must not be modified directly, and objects must be renamed using rename()
+     */
     template <typename T>
     class Storage {
     public:
@@ -52,6 +63,10 @@ namespace dqm4hep {
       ObjectPtr findObject(F function) const;
       template <typename F>
       ObjectPtr findObject(const std::string &dirName, F function) const;
+      ObjectPtr findObjectByName(const std::string &name) const;
+      ObjectPtr findObjectByName(const std::string &dirName, const std::string &name) const;
+      template <typename F>
+      StatusCode rename(const std::string &dirName, const std::string &name, const std::string &newName, F function);
       bool containsObject(const ObjectPtr &object) const;
       bool containsObject(const std::string &dirName, const ObjectPtr &object) const;
       template <typename F>
@@ -63,22 +78,54 @@ namespace dqm4hep {
       void dump(F function) const;
 
     private:
+      typedef std::unordered_map<std::string, ObjectPtr> ObjectIndex;
+      typedef std::unordered_map<std::string, DirectoryPtr> DirectoryIndex;
+      
       template <typename F>
       bool iterate(const DirectoryPtr &directory, F function) const;
       
       template <typename F>
       void dump(const DirectoryPtr &directory, F function) const;
+      
+      /** Get the full path of a directory without walking the tree.
+       *  Returns false if the path has to be resolved in the tree (".." components)
+       */
+      bool indexPath(const std::string &dirName, std::string &dirPath) const;
+      
+      /** Add an object to a directory and to the index
+       */
+      StatusCode add(const DirectoryPtr &directory, ObjectPtr object);
+      
+      /** Get the index key of an object
+       */
+      static std::string indexKey(const std::string &dirPath, const std::string &name);
+      
+      /** Add an object of a directory to the index
+       */
+      void index(const DirectoryPtr &directory, const ObjectPtr &object);
+      
+      /** Remove an object of a directory from the index
+       */
+      void unindex(const DirectoryPtr &directory, const ObjectPtr &object);
+      
+      /** Remove a directory, its sub-directories and their objects from the index
+       */
+      void unindex(const DirectoryPtr &directory);
 
     private:
       DirectoryPtr m_rootDirectory;
       DirectoryPtr m_currentDirectory;
+      ObjectIndex m_objectIndex;
+      DirectoryIndex m_directoryIndex;
     };
 
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
-    inline Storage<T>::Storage() : m_rootDirectory(Directory<T>::make_shared("")), m_currentDirectory(m_rootDirectory) {
+    inline Storage<T>::Storage() : m_rootDirectory(Directory<T>::make_shared("")), m_currentDirectory(m_rootDirectory), 
+      m_objectIndex(), m_directoryIndex() {
+      m_directoryIndex[m_rootDirectory->fullPath().getPath()] = m_rootDirectory;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -93,6 +140,11 @@ namespace dqm4hep {
       if (dirName.empty())
         return STATUS_CODE_INVALID_PARAMETER;
 
+      // already existing directory
+      std::string dirPath;
+      if (this->indexPath(dirName, dirPath) && m_directoryIndex.end() != m_directoryIndex.find(dirPath))
+        return STATUS_CODE_SUCCESS;
+
       Path path(dirName);
 
       if (!path.isValid())
@@ -116,8 +168,12 @@ namespace dqm4hep {
         }
 
         // if sub dir doesn't exists, create it
-        if (!directory->hasChild(dname))
-          directory->mkdir(dname);
+        if (!directory->hasChild(dname)) {
+          DirectoryPtr newDirectory = directory->mkdir(dname);
+          
+          if (nullptr != newDirectory)
+            m_directoryIndex[newDirectory->fullPath().getPath()] = newDirectory;
+        }
 
         // navigate forward
         RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, directory->find(dname, directory));
@@ -226,6 +282,7 @@ namespace dqm4hep {
       if (pos == 0 || pos != std::string::npos)
         return STATUS_CODE_FAILURE;
 
+      this->unindex(directory);
       RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, directory->parent()->rmdir(directory->name()));
 
       return STATUS_CODE_SUCCESS;
@@ -243,6 +300,18 @@ namespace dqm4hep {
         return STATUS_CODE_SUCCESS;
       }
 
+      // look in the index first
+      std::string dirPath;
+
+      if (this->indexPath(dirName, dirPath)) {
+        auto findIter = m_directoryIndex.find(dirPath);
+
+        if (m_directoryIndex.end() != findIter) {
+          directory = findIter->second;
+          return STATUS_CODE_SUCCESS;
+        }
+      }
+
       Path path(dirName);
 
       if (!path.isValid())
@@ -293,7 +362,7 @@ namespace dqm4hep {
 
     template <typename T>
     inline StatusCode Storage<T>::add(ObjectPtr object) {
-      return m_currentDirectory->add(object);
+      return this->add(m_currentDirectory, object);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -303,14 +372,14 @@ namespace dqm4hep {
       DirectoryPtr directory = nullptr;
       RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->mkdir(dirName));
       RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->find(dirName, directory));
-      return directory->add(object);
+      return this->add(directory, object);
     }
     
     //-------------------------------------------------------------------------------------------------
     
     template <typename T>
     inline StatusCode Storage<T>::add(ObjectPtr object, std::string &fullPath) {
-      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_currentDirectory->add(object));
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->add(m_currentDirectory, object));
       fullPath = m_currentDirectory->fullPath().getPath();
       return STATUS_CODE_SUCCESS;
     }
@@ -322,7 +391,7 @@ namespace dqm4hep {
       DirectoryPtr directory = nullptr;
       RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->mkdir(dirName));
       RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->find(dirName, directory));
-      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, directory->add(object));
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->add(directory, object));
       fullPath = directory->fullPath().getPath();
       return STATUS_CODE_SUCCESS;
     }
@@ -332,7 +401,13 @@ namespace dqm4hep {
     template <typename T>
     template <typename F>
     inline StatusCode Storage<T>::remove(F function) {
-      return m_currentDirectory->remove(function);
+      ObjectPtr object = m_currentDirectory->find(function);
+
+      if (nullptr == object)
+        return STATUS_CODE_NOT_FOUND;
+
+      this->unindex(m_currentDirectory, object);
+      return m_currentDirectory->remove(object);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -342,7 +417,13 @@ namespace dqm4hep {
     inline StatusCode Storage<T>::remove(const std::string &dirName, F function) {
       DirectoryPtr directory = nullptr;
       RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->find(dirName, directory));
-      return directory->remove(function);
+      ObjectPtr object = directory->find(function);
+
+      if (nullptr == object)
+        return STATUS_CODE_NOT_FOUND;
+
+      this->unindex(directory, object);
+      return directory->remove(object);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -368,6 +449,66 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    template <typename T>
+    inline typename Storage<T>::ObjectPtr Storage<T>::findObjectByName(const std::string &name) const {
+      auto findIter = m_objectIndex.find(indexKey(m_currentDirectory->fullPath().getPath(), name));
+      return (m_objectIndex.end() == findIter) ? nullptr : findIter->second;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline typename Storage<T>::ObjectPtr Storage<T>::findObjectByName(const std::string &dirName, const std::string &name) const {
+      std::string dirPath;
+
+      if (!this->indexPath(dirName, dirPath)) {
+        DirectoryPtr directory;
+
+        if (this->find(dirName, directory))
+          return nullptr;
+
+        dirPath = directory->fullPath().getPath();
+      }
+
+      auto findIter = m_objectIndex.find(indexKey(dirPath, name));
+      return (m_objectIndex.end() == findIter) ? nullptr : findIter->second;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename F>
+    inline StatusCode Storage<T>::rename(const std::string &dirName, const std::string &name, const std::string &newName, F function) {
+      if (name == newName)
+        return STATUS_CODE_UNCHANGED;
+
+      DirectoryPtr directory;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->find(dirName, directory));
+      const std::string &dirPath(directory->fullPath().getPath());
+      auto findIter = m_objectIndex.find(indexKey(dirPath, name));
+
+      if (m_objectIndex.end() == findIter)
+        return STATUS_CODE_NOT_FOUND;
+
+      if (m_objectIndex.end() != m_objectIndex.find(indexKey(dirPath, newName)))
+        return STATUS_CODE_ALREADY_PRESENT;
+
+      ObjectPtr object = findIter->second;
+      this->unindex(directory, object);
+
+      try {
+        function(object);
+      } catch (...) {
+        this->index(directory, object);
+        throw;
+      }
+
+      this->index(directory, object);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
     inline bool Storage<T>::containsObject(const ObjectPtr &object) const {
       return m_currentDirectory->containsObject(object);
@@ -430,6 +571,9 @@ namespace dqm4hep {
     inline void Storage<T>::clear() {
       m_rootDirectory->clear();
       m_currentDirectory = m_rootDirectory;
+      m_objectIndex.clear();
+      m_directoryIndex.clear();
+      m_directoryIndex[m_rootDirectory->fullPath().getPath()] = m_rootDirectory;
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -455,6 +599,123 @@ namespace dqm4hep {
         dump(dir, function);
       }
     }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline bool Storage<T>::indexPath(const std::string &dirName, std::string &dirPath) const {
+      const bool relative = (dirName.empty() || '/' != dirName.at(0));
+      dirPath = relative ? m_currentDirectory->fullPath().getPath() : "/";
+      size_t pos = 0;
+
+      while (pos < dirName.size()) {
+        size_t end = dirName.find('/', pos);
+
+        if (std::string::npos == end)
+          end = dirName.size();
+
+        const size_t length = end - pos;
+
+        // skip empty and "." components, ".." components need the tree
+        if (0 != length && !(1 == length && '.' == dirName.at(pos))) {
+          if (2 == length && '.' == dirName.at(pos) && '.' == dirName.at(pos+1))
+            return false;
+
+          if ('/' != dirPath.back())
+            dirPath += '/';
+
+          dirPath.append(dirName, pos, length);
+        }
+
+        pos = end + 1;
+      }
+
+      return true;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline StatusCode Storage<T>::add(const DirectoryPtr &directory, ObjectPtr object) {
+      if (nullptr == object)
+        return STATUS_CODE_INVALID_PTR;
+
+      // an object is found in the index by name, the directory is
+      // only scanned when an other object has the same name
+      std::string key(indexKey(directory->fullPath().getPath(), object->name()));
+      auto findIter = m_objectIndex.find(key);
+
+      if (m_objectIndex.end() != findIter) {
+        if (object == findIter->second || directory->containsObject(object))
+          return STATUS_CODE_ALREADY_PRESENT;
+
+        directory->m_contents.push_back(object);
+        return STATUS_CODE_SUCCESS;
+      }
+
+      directory->m_contents.push_back(object);
+      m_objectIndex.emplace(std::move(key), object);
+      return STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline std::string Storage<T>::indexKey(const std::string &dirPath, const std::string &name) {
+      std::string key;
+      key.reserve(dirPath.size() + name.size() + 1);
+      key = dirPath;
+
+      if (key.empty() || '/' != key.back())
+        key += '/';
+
+      key += name;
+      return key;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline void Storage<T>::index(const DirectoryPtr &directory, const ObjectPtr &object) {
+      // the first object with a given name is found, as when scanning the directory
+      m_objectIndex.emplace(indexKey(directory->fullPath().getPath(), object->name()), object);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline void Storage<T>::unindex(const DirectoryPtr &directory, const ObjectPtr &object) {
+      const std::string name(object->name());
+      auto findIter = m_objectIndex.find(indexKey(directory->fullPath().getPath(), name));
+
+      if (m_objectIndex.end() == findIter || object != findIter->second)
+        return;
+
+      // an other object with the same name in the directory takes its place
+      for (const auto &other : directory->contents()) {
+        if (other != object && other->name() == name) {
+          findIter->second = other;
+          return;
+        }
+      }
+
+      m_objectIndex.erase(findIter);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline void Storage<T>::unindex(const DirectoryPtr &directory) {
+      const std::string &dirPath(directory->fullPath().getPath());
+
+      for (const auto &object : directory->contents())
+        m_objectIndex.erase(indexKey(dirPath, object->name()));
+
+      for (const auto &subdir : directory->subdirs())
+        this->unindex(subdir);
+
+      m_directoryIndex.erase(dirPath);
+    }
   }
 }
 
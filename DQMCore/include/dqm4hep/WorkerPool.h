@@ -0,0 +1,102 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_WORKERPOOL_H
+#define DQM4HEP_WORKERPOOL_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/StatusCodes.h>
+
+// -- std headers
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  WorkerPool class.
+     *          A pool of threads running a batch of independent tasks, identified
+     *          by their index. The threads are started once and sleep between two
+     *          batches. The calling thread takes part in the processing and run()
+     *          returns when all the tasks of the batch are done, so the tasks can
+     *          write their result in a pre-allocated slot without locking.
+     */
+    class WorkerPool {
+    public:
+      typedef std::function<void(std::size_t)> Task;
+
+      /**
+       *  @brief  Constructor. Starts nThreads-1 worker threads, the calling thread being the last one
+       *
+       *  @param  nThreads the number of threads processing the tasks
+       */
+      WorkerPool(unsigned int nThreads);
+      WorkerPool(const WorkerPool&) = delete;
+      WorkerPool& operator=(const WorkerPool&) = delete;
+
+      /**
+       *  @brief  Destructor. Stops the worker threads
+       */
+      ~WorkerPool();
+
+      /**
+       *  @brief  Get the number of threads processing the tasks, including the calling thread
+       */
+      unsigned int nThreads() const;
+
+      /**
+       *  @brief  Run task(i) for i in [0, nTasks) and wait for completion.
+       *          If a task throws, the remaining tasks are still processed and
+       *          the first exception is re-thrown in the calling thread.
+       *          Must not be called concurrently or from a task
+       *
+       *  @param  nTasks the number of tasks
+       *  @param  task the task function
+       */
+      void run(std::size_t nTasks, const Task &task);
+
+    private:
+      /**
+       *  @brief  The worker thread function
+       */
+      void workerLoop();
+
+      /**
+       *  @brief  Process tasks of the current batch until none is left
+       */
+      void processTasks();
+
+    private:
+      std::vector<std::thread>          m_workers = {};              ///< The worker threads
+      std::mutex                        m_mutex = {};                ///< The mutex protecting the batch state
+      std::condition_variable           m_startCondition = {};       ///< The condition to wake up the workers
+      std::condition_variable           m_doneCondition = {};        ///< The condition to wake up the calling thread
+      const Task                       *m_task = {nullptr};          ///< The task function of the current batch
+      std::size_t                       m_nTasks = {0};              ///< The number of tasks of the current batch
+      std::atomic<std::size_t>          m_nextTask = {0};            ///< The next task to process
+      unsigned long                     m_batch = {0};               ///< The current batch number
+      unsigned int                      m_nBusyWorkers = {0};        ///< The number of workers processing the current batch
+      bool                              m_stopFlag = {false};        ///< Whether to stop the workers
+      std::exception_ptr                m_exception = {};            ///< The first exception thrown by a task
+    };
+
+  }
+
+}
+
+#endif  //  DQM4HEP_WORKERPOOL_H
@@ -177,6 +177,15 @@ int main(int argc, char *argv[]) {
     false);
   pCommandLine->add(compressArg);
 
+  TCLAP::ValueArg<unsigned int> threadsArg(
+    "t", 
+    "threads",
+    "The number of threads running the quality tests",
+    false, 
+    1, 
+    "unsigned int");
+  pCommandLine->add(threadsArg);
+
   // parse command line
   pCommandLine->parse(argc, argv);
 
@@ -200,6 +209,7 @@ int main(int argc, char *argv[]) {
     // create, configure and run quality tests
     QReportStorage reportStorage;
     THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, monitorElementMgr->parseStorage<MonitorElement>(storageElement));
+    monitorElementMgr->setQualityTestThreads(threadsArg.getValue());
     THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, monitorElementMgr->runQualityTests(reportStorage));
     
     const unsigned int qualityExit(qualityExitMap.find(qualityExitArg.getValue())->second);
@@ -10,6 +10,8 @@
 
 // -- dqm4hep headers
 #include <dqm4hep/Event.h>
+#include <dqm4hep/EventHeader.h>
+#include <dqm4hep/EventStreamer.h>
 
 // -- root headers
 #include <TBuffer.h>
@@ -18,55 +20,97 @@ namespace dqm4hep {
 
   namespace core {
 
+    /// The name returned for unset or unknown sources and streamers
+    static const std::string unknownName = "";
+
+    //-------------------------------------------------------------------------------------------------
+
     void Event::clear() {
       m_type = UNKNOWN_EVENT;
-      m_source = "unknwon";
+      m_sourceId = EventNameTable::invalidId;
+      m_source = nullptr;
       m_timeStamp = core::time::point();
       m_eventSize = 0;
       m_eventNumber = 0;
       m_runNumber = 0;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Event::setSource(const std::string &sourceName) {
+      EventNameTable::Id sourceId(EventNameTable::invalidId);
+      const std::string *internedName(nullptr);
+      if(STATUS_CODE_SUCCESS != EventNameTable::sourceNames()->intern(sourceName, sourceId, internedName)) {
+        return;
+      }
+      m_sourceId = sourceId;
+      m_source = internedName;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string &Event::getSource() const {
+      return (nullptr == m_source) ? unknownName : *m_source;
+    }
     
     //-------------------------------------------------------------------------------------------------
     
     void Event::setStreamerName(const std::string &name) {
-      m_streamerName = name;
+      EventStreamerRegistry::StreamerId streamerId(EventStreamerRegistry::invalidId);
+      const std::string *internedName(nullptr);
+      if(STATUS_CODE_SUCCESS != EventStreamerRegistry::instance()->internName(name, streamerId, internedName)) {
+        return;
+      }
+      m_streamerId = streamerId;
+      m_streamerName = internedName;
     }
     
     //-------------------------------------------------------------------------------------------------
 
     const std::string &Event::getStreamerName() const {
-      return m_streamerName;
+      return (nullptr == m_streamerName) ? unknownName : *m_streamerName;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Event::writeHeader(EventHeader &header) const {
+      header.m_type = static_cast<uint16_t>(m_type);
+      header.m_streamerId = m_streamerId;
+      header.m_sourceId = m_sourceId;
+      header.m_eventNumber = m_eventNumber;
+      header.m_runNumber = m_runNumber;
+      header.m_timeStamp = core::time::asNanoseconds(m_timeStamp);
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void Event::writeBase(TBuffer &buffer) const {
-      Int_t type(static_cast<Int_t>(m_type));
-      int32_t timeStamp = core::time::asTime(m_timeStamp);
-      buffer.WriteInt(type);
-      buffer.WriteStdString(&m_source);
-      buffer.WriteInt(timeStamp);
-      buffer.WriteLong64(m_eventSize);
-      buffer.WriteInt(m_eventNumber);
-      buffer.WriteInt(m_runNumber);
+    void Event::readHeader(const EventHeader &header) {
+      setType(static_cast<EventType>(header.m_type));
+      m_sourceId = header.m_sourceId;
+      m_source = EventNameTable::sourceNames()->name(header.m_sourceId);
+      m_timeStamp = core::time::fromNanoseconds(header.m_timeStamp);
+      m_eventSize = header.m_payloadSize;
+      m_eventNumber = header.m_eventNumber;
+      m_runNumber = header.m_runNumber;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     void Event::readBase(TBuffer &buffer) {
       Int_t type(0);
+      std::string source;
       int32_t timeStamp(0);
       Long64_t eventSize(0);
       Int_t eventNumber(0);
       Int_t runNumber(0);
       buffer.ReadInt(type);
-      buffer.ReadStdString(&m_source);
+      buffer.ReadStdString(&source);
       buffer.ReadInt(timeStamp);
       buffer.ReadLong64(eventSize);
       buffer.ReadInt(eventNumber);
       buffer.ReadInt(runNumber);
       setType(static_cast<EventType>(type));
+      setSource(source);
       setTimeStamp(core::time::asPoint(timeStamp));
       m_eventSize = eventSize;
       m_eventNumber = eventNumber;
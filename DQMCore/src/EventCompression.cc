@@ -0,0 +1,197 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/EventCompression.h>
+#include <dqm4hep/Logging.h>
+
+// -- root headers
+#include <Compression.h>
+#include <RVersion.h>
+#include <RZip.h>
+
+// -- std headers
+#include <algorithm>
+#include <cctype>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    namespace {
+
+      /// The size of the header written by R__zip in front of each compressed block
+      const int zipHeaderSize = 9;
+
+      /// The maximum number of bytes compressed by a single R__zip call
+      const int zipMaxBlockSize = 0xffffff;
+
+      /**
+       *  @brief  Compress a single block with the ROOT compression algorithms
+       */
+      int zipBlock(int level, int algorithm, int srcSize, const char *src, int tgtSize, char *tgt) {
+        int compressedSize(0);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 20, 0)
+        R__zipMultipleAlgorithm(level, &srcSize, const_cast<char*>(src), &tgtSize, tgt, &compressedSize,
+          static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(algorithm));
+#elif ROOT_VERSION_CODE >= ROOT_VERSION(6, 12, 0)
+        R__zipMultipleAlgorithm(level, &srcSize, const_cast<char*>(src), &tgtSize, tgt, &compressedSize,
+          static_cast<ROOT::ECompressionAlgorithm>(algorithm));
+#else
+        R__zipMultipleAlgorithm(level, &srcSize, const_cast<char*>(src), &tgtSize, tgt, &compressedSize, algorithm);
+#endif
+        return compressedSize;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventCompression::isSupported(Algorithm algorithm) {
+      switch(algorithm) {
+        case NONE:
+        case ZLIB:
+        case LZMA:
+          return true;
+        case LZ4:
+          return (ROOT_VERSION_CODE >= ROOT_VERSION(6, 10, 0));
+        case ZSTD:
+          return (ROOT_VERSION_CODE >= ROOT_VERSION(6, 20, 0));
+        default:
+          return false;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::string EventCompression::algorithmName(Algorithm algorithm) {
+      switch(algorithm) {
+        case NONE: return "none";
+        case ZLIB: return "zlib";
+        case LZMA: return "lzma";
+        case LZ4: return "lz4";
+        case ZSTD: return "zstd";
+        default: return "unknown";
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventCompression::algorithmFromName(const std::string &name, Algorithm &algorithm) {
+      std::string lowerName(name);
+      std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+      for(const Algorithm alg : {NONE, ZLIB, LZMA, LZ4, ZSTD}) {
+        if(algorithmName(alg) == lowerName) {
+          algorithm = alg;
+          return STATUS_CODE_SUCCESS;
+        }
+      }
+      return STATUS_CODE_NOT_FOUND;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventCompression::uncompress(const char *data, unsigned int size, unsigned int rawSize, std::vector<char> &raw) {
+      raw.resize(rawSize);
+      unsigned int srcOffset(0), tgtOffset(0);
+      while(srcOffset < size) {
+        unsigned char *src = reinterpret_cast<unsigned char*>(const_cast<char*>(data + srcOffset));
+        int srcSize(0), tgtSize(0), uncompressedSize(0);
+        if(size - srcOffset < static_cast<unsigned int>(zipHeaderSize) || 0 != R__unzip_header(&srcSize, src, &tgtSize)) {
+          dqm_error( "EventCompression::uncompress: invalid compressed block header at offset {0}", srcOffset );
+          return STATUS_CODE_FAILURE;
+        }
+        if(srcSize <= 0 || tgtSize <= 0 || static_cast<unsigned int>(srcSize) > size - srcOffset || static_cast<unsigned int>(tgtSize) > rawSize - tgtOffset) {
+          dqm_error( "EventCompression::uncompress: compressed block at offset {0} exceeds the payload", srcOffset );
+          return STATUS_CODE_FAILURE;
+        }
+        R__unzip(&srcSize, src, &tgtSize, reinterpret_cast<unsigned char*>(raw.data() + tgtOffset), &uncompressedSize);
+        if(uncompressedSize != tgtSize) {
+          dqm_error( "EventCompression::uncompress: couldn't uncompress block at offset {0}", srcOffset );
+          return STATUS_CODE_FAILURE;
+        }
+        srcOffset += srcSize;
+        tgtOffset += tgtSize;
+      }
+      if(tgtOffset != rawSize) {
+        dqm_error( "EventCompression::uncompress: uncompressed {0} bytes, expected {1}", tgtOffset, rawSize );
+        return STATUS_CODE_FAILURE;
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    EventCompression::EventCompression(Algorithm alg, unsigned int lvl, unsigned int minimumSize) :
+      m_algorithm(alg),
+      m_level(std::min(lvl, 9u)),
+      m_minSize(minimumSize) {
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventCompression::compress(const char *data, unsigned int size, std::vector<char> &compressed) const {
+      if(not enabled() || size < m_minSize || size <= static_cast<unsigned int>(zipHeaderSize)) {
+        return STATUS_CODE_UNCHANGED;
+      }
+      // only keep the compressed payload if it is smaller than the raw one
+      compressed.resize(size - 1);
+      unsigned int srcOffset(0), tgtOffset(0);
+      while(srcOffset < size) {
+        const int srcSize = std::min(size - srcOffset, static_cast<unsigned int>(zipMaxBlockSize));
+        const int tgtSize = compressed.size() - tgtOffset;
+        if(tgtSize <= zipHeaderSize) {
+          return STATUS_CODE_UNCHANGED;
+        }
+        const int compressedSize = zipBlock(m_level, m_algorithm, srcSize, data + srcOffset, tgtSize, compressed.data() + tgtOffset);
+        // not compressible or doesn't fit
+        if(0 == compressedSize) {
+          return STATUS_CODE_UNCHANGED;
+        }
+        srcOffset += srcSize;
+        tgtOffset += compressedSize;
+      }
+      compressed.resize(tgtOffset);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventCompression::toJson(json &value) const {
+      value = {
+        {"algorithm", algorithmName(m_algorithm)},
+        {"level", m_level},
+        {"minSize", m_minSize}
+      };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventCompression::fromJson(const json &value, std::string &message) {
+      if(not value.is_object()) {
+        message = "Invalid compression settings";
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+      const std::string name(value.value<std::string>("algorithm", "none"));
+      Algorithm alg(NONE);
+      if(STATUS_CODE_SUCCESS != algorithmFromName(name, alg)) {
+        message = "Unknown compression algorithm '" + name + "'";
+        return STATUS_CODE_NOT_FOUND;
+      }
+      if(not isSupported(alg)) {
+        message = "Compression algorithm '" + name + "' not supported by this ROOT version";
+        return STATUS_CODE_NOT_ALLOWED;
+      }
+      *this = EventCompression(alg, value.value<unsigned int>("level", 1), value.value<unsigned int>("minSize", 4096));
+      return STATUS_CODE_SUCCESS;
+    }
+
+  }
+
+}
@@ -0,0 +1,196 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/EventHeader.h>
+#include <dqm4hep/Logging.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    constexpr uint8_t EventHeader::currentVersion;
+    constexpr unsigned int EventHeader::size;
+
+    //-------------------------------------------------------------------------------------------------
+
+    EventNameTable *EventNameTable::sourceNames() {
+      static EventNameTable table;
+      return &table;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    EventNameTable::Id EventNameTable::hashName(const std::string &name) {
+      // 32 bits FNV-1a
+      Id id = 2166136261u;
+      for(const char c : name) {
+        id ^= static_cast<unsigned char>(c);
+        id *= 16777619u;
+      }
+      return (invalidId == id) ? 1 : id;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventNameTable::intern(const std::string &name, Id &id, const std::string *&internedName) {
+      id = hashName(name);
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto inserted = m_names.insert(std::make_pair(id, name));
+      if(not inserted.second and inserted.first->second != name) {
+        dqm_error( "EventNameTable::intern: name '{0}' id {1} clashes with name '{2}' !", name, id, inserted.first->second );
+        return STATUS_CODE_ALREADY_PRESENT;
+      }
+      internedName = &inserted.first->second;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string *EventNameTable::name(Id id) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto findIter = m_names.find(id);
+      return (m_names.end() == findIter) ? nullptr : &findIter->second;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventNameTable::toJson(json &table) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      table = json::object();
+      for(const auto &name : m_names) {
+        table[name.second] = name.first;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventNameTable::fromJson(const json &table, std::string &message) {
+      if(not table.is_object()) {
+        message = "Invalid name table";
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+      for(auto iter = table.begin() ; table.end() != iter ; ++iter) {
+        const Id tableId = iter.value().get<Id>();
+        Id id(invalidId);
+        const std::string *internedName(nullptr);
+        if(hashName(iter.key()) != tableId) {
+          message = "Name '" + iter.key() + "' has id " + std::to_string(tableId) + ", expected " + std::to_string(hashName(iter.key()));
+          return STATUS_CODE_INVALID_PARAMETER;
+        }
+        if(STATUS_CODE_SUCCESS != intern(iter.key(), id, internedName)) {
+          message = "Name '" + iter.key() + "' id clashes with name '" + *this->name(id) + "'";
+          return STATUS_CODE_ALREADY_PRESENT;
+        }
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    void EventHeader::write(TBuffer &buffer) const {
+      buffer.WriteUChar(0);
+      buffer.WriteUChar(m_version);
+      buffer.WriteUShort(m_type);
+      buffer.WriteUInt(m_streamerId);
+      buffer.WriteUInt(m_sourceId);
+      buffer.WriteUInt(m_eventNumber);
+      buffer.WriteUInt(m_runNumber);
+      buffer.WriteLong64(m_timeStamp);
+      buffer.WriteUInt(m_compression);
+      buffer.WriteUInt(m_rawPayloadSize);
+      buffer.WriteUInt(m_compressionTime);
+      buffer.WriteUInt(m_payloadSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventHeader::overwrite(TBuffer &buffer, unsigned int headerOffset) const {
+      const Int_t length(buffer.Length());
+      buffer.SetBufferOffset(headerOffset);
+      write(buffer);
+      buffer.SetBufferOffset(length);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventHeader::read(TBuffer &buffer) {
+      if(buffer.BufferSize() - buffer.Length() < static_cast<Int_t>(size)) {
+        return false;
+      }
+      UChar_t marker(0), version(0);
+      UShort_t type(0);
+      UInt_t streamerId(0), sourceId(0), eventNumber(0), runNumber(0), payloadSize(0);
+      UInt_t compression(0), rawPayloadSize(0), compressionTime(0);
+      Long64_t timeStamp(0);
+      buffer.ReadUChar(marker);
+      if(0 != marker) {
+        return false;
+      }
+      buffer.ReadUChar(version);
+      if(currentVersion != version) {
+        dqm_error( "EventHeader::read: unsupported event header version {0}", static_cast<unsigned int>(version) );
+        return false;
+      }
+      buffer.ReadUShort(type);
+      buffer.ReadUInt(streamerId);
+      buffer.ReadUInt(sourceId);
+      buffer.ReadUInt(eventNumber);
+      buffer.ReadUInt(runNumber);
+      buffer.ReadLong64(timeStamp);
+      buffer.ReadUInt(compression);
+      buffer.ReadUInt(rawPayloadSize);
+      buffer.ReadUInt(compressionTime);
+      buffer.ReadUInt(payloadSize);
+      m_version = version;
+      m_type = type;
+      m_streamerId = streamerId;
+      m_sourceId = sourceId;
+      m_eventNumber = eventNumber;
+      m_runNumber = runNumber;
+      m_timeStamp = timeStamp;
+      m_compression = compression;
+      m_rawPayloadSize = rawPayloadSize;
+      m_compressionTime = compressionTime;
+      m_payloadSize = payloadSize;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventHeader::peek(const char *buffer, unsigned int frameSize, EventHeader &header) {
+      if(nullptr == buffer || frameSize < size) {
+        return false;
+      }
+      TBufferFile inputBuffer(TBuffer::kRead, frameSize, const_cast<char*>(buffer), false);
+      return header.read(inputBuffer);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string &EventHeader::sourceName() const {
+      static const std::string unknownSource;
+      const std::string *name(EventNameTable::sourceNames()->name(m_sourceId));
+      return (nullptr == name) ? unknownSource : *name;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventHeader::compressed() const {
+      return (0 != m_compression);
+    }
+
+  }
+
+}
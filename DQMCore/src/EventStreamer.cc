@@ -11,16 +11,66 @@
 // -- dqm4hep headers
 #include <dqm4hep/EventStreamer.h>
 #include <dqm4hep/Event.h>
+#include <dqm4hep/Logging.h>
 #include <dqm4hep/PluginManager.h>
 
 // -- root headers
-#include <TBuffer.h>
+#include <TBufferFile.h>
+
+// -- std headers
+#include <chrono>
+#include <unordered_map>
+#include <vector>
 
 namespace dqm4hep {
 
   namespace core {
-    
-    StatusCode EventStreamer::writeEvent(EventPtr event, TBuffer &buffer) {
+
+    namespace {
+
+      /**
+       *  @brief  CachedStreamer struct.
+       *          A streamer plugin instance owned by a thread
+       */
+      struct CachedStreamer {
+        const std::string          *m_name = {nullptr};
+        EventStreamerPluginPtr      m_streamer = {nullptr};
+      };
+
+      using StreamerCache = std::unordered_map<EventStreamerRegistry::StreamerId, CachedStreamer>;
+
+      /**
+       *  @brief  Get the streamer plugin cache of the calling thread
+       */
+      StreamerCache &threadStreamerCache() {
+        static thread_local StreamerCache cache;
+        return cache;
+      }
+
+      /**
+       *  @brief  Get the compression scratch buffer of the calling thread
+       */
+      std::vector<char> &threadCompressionBuffer() {
+        static thread_local std::vector<char> compressionBuffer;
+        return compressionBuffer;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventStreamer::setCompression(const EventCompression &compression) {
+      m_compression = compression;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const EventCompression &EventStreamer::compression() const {
+      return m_compression;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventStreamer::writeEvent(EventPtr event, TBuffer &buffer) const {
       // consistency check
       if (nullptr == event) {
         return STATUS_CODE_INVALID_PARAMETER;
@@ -29,57 +79,181 @@ namespace dqm4hep {
         return STATUS_CODE_NOT_ALLOWED;
       }
       // setup event streamer
-      std::string streamerName = event->getStreamerName();
-      if(not m_streamer or m_streamerName != streamerName) {
-        m_streamer = nullptr;
-        m_streamer = PluginManager::instance()->create<EventStreamerPlugin>(streamerName);
-        if(not m_streamer) {
-          dqm_error( "EventStreamer::writeEvent: streamer '{0}' not registered in plugin manager !", streamerName );
-          return STATUS_CODE_FAILURE;
-        }
-        m_streamerName = streamerName;
+      const std::string *streamerName = nullptr;
+      EventStreamerPlugin *streamer = nullptr;
+      if(STATUS_CODE_SUCCESS != EventStreamerRegistry::instance()->findStreamer(event->getStreamerId(), streamerName, streamer)) {
+        dqm_error( "EventStreamer::writeEvent: streamer '{0}' not available !", event->getStreamerName() );
+        return STATUS_CODE_FAILURE;
       }
-      // write streamer name
-      buffer.WriteStdString(&m_streamerName);
-      // write base event data
-      event->writeBase(buffer);
+      // write event header, payload size written after the user event data
+      const Int_t headerOffset = buffer.Length();
+      EventHeader header;
+      event->writeHeader(header);
+      header.write(buffer);
       // write user event data
-      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_streamer->write(event, buffer));
+      const Int_t payloadOffset = buffer.Length();
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, streamer->write(event, buffer));
+      header.m_payloadSize = header.m_rawPayloadSize = buffer.Length() - payloadOffset;
+      // compress the user event data in place, if worth it
+      if(m_compression.enabled()) {
+        std::vector<char> &compressed(threadCompressionBuffer());
+        const auto startTime = std::chrono::steady_clock::now();
+        if(STATUS_CODE_SUCCESS == m_compression.compress(buffer.Buffer() + payloadOffset, header.m_rawPayloadSize, compressed)) {
+          buffer.SetBufferOffset(payloadOffset);
+          buffer.WriteFastArray(compressed.data(), compressed.size());
+          header.m_compression = m_compression.settings();
+          header.m_payloadSize = compressed.size();
+          header.m_compressionTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+        }
+      }
+      header.overwrite(buffer, headerOffset);
       return STATUS_CODE_SUCCESS;
     }
-    
+
     //-------------------------------------------------------------------------------------------------
-    
-    StatusCode EventStreamer::readEvent(EventPtr &event, TBuffer &buffer) {
+
+    StatusCode EventStreamer::readEvent(EventPtr &event, TBuffer &buffer) const {
       // consistency check
       if (not buffer.IsReading()) {
         return STATUS_CODE_NOT_ALLOWED;
       }
-      // read streamer name
-      std::string streamerName;
-      buffer.ReadStdString(&streamerName);
-      // setup event streamer
-      if(not m_streamer or m_streamerName != streamerName) {
-        m_streamer = nullptr;
-        m_streamer = PluginManager::instance()->create<EventStreamerPlugin>(streamerName);
-        if(not m_streamer) {
-          dqm_error( "EventStreamer::readEvent: streamer '{0}' not registered in plugin manager !", streamerName );
+      EventStreamerRegistry *registry = EventStreamerRegistry::instance();
+      const std::string *streamerName = nullptr;
+      EventStreamerPlugin *streamer = nullptr;
+      const Int_t frameOffset = buffer.Length();
+      EventHeader header;
+      // older frame format, starting with the streamer name
+      if(not header.read(buffer)) {
+        buffer.SetBufferOffset(frameOffset);
+        std::string frameStreamerName;
+        buffer.ReadStdString(&frameStreamerName);
+        EventStreamerRegistry::StreamerId streamerId = EventStreamerRegistry::invalidId;
+        if(frameStreamerName.empty()
+          or STATUS_CODE_SUCCESS != registry->registerStreamer(frameStreamerName, streamerId)
+          or STATUS_CODE_SUCCESS != registry->findStreamer(streamerId, streamerName, streamer)) {
+          dqm_error( "EventStreamer::readEvent: streamer '{0}' not available !", frameStreamerName );
           return STATUS_CODE_FAILURE;
         }
-        m_streamerName = streamerName;
+        event = streamer->createEvent();
+        event->m_streamerId = streamerId;
+        event->m_streamerName = streamerName;
+        Int_t eventSize = buffer.Length();
+        event->readBase(buffer);
+        RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, streamer->read(event, buffer));
+        event->setEventSize(buffer.Length() - eventSize);
+        return STATUS_CODE_SUCCESS;
+      }
+      // setup event streamer
+      if(STATUS_CODE_SUCCESS != registry->findStreamer(header.m_streamerId, streamerName, streamer)) {
+        dqm_error( "EventStreamer::readEvent: streamer with id {0} not available !", header.m_streamerId );
+        return STATUS_CODE_FAILURE;
+      }
+      if(header.m_payloadSize > static_cast<UInt_t>(buffer.BufferSize() - buffer.Length())) {
+        dqm_error( "EventStreamer::readEvent: truncated event frame ({0} bytes payload expected) !", header.m_payloadSize );
+        return STATUS_CODE_FAILURE;
       }
       // read user event data
-      event = m_streamer->createEvent();
-      event->setStreamerName(m_streamerName);
-      Int_t eventSize = buffer.Length();
-      // write base event data
-      event->readBase(buffer);
-      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_streamer->read(event, buffer));
-      eventSize = buffer.Length() - eventSize;
-      event->setEventSize(eventSize);
+      event = streamer->createEvent();
+      event->m_streamerId = header.m_streamerId;
+      event->m_streamerName = streamerName;
+      event->readHeader(header);
+      if(not header.compressed()) {
+        RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, streamer->read(event, buffer));
+        return STATUS_CODE_SUCCESS;
+      }
+      // compressed user event data, read from the uncompressed copy
+      std::vector<char> &uncompressed(threadCompressionBuffer());
+      const Int_t payloadOffset = buffer.Length();
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, EventCompression::uncompress(buffer.Buffer() + payloadOffset, header.m_payloadSize, header.m_rawPayloadSize, uncompressed));
+      static thread_local TBufferFile payloadBuffer(TBuffer::kRead);
+      payloadBuffer.SetBuffer(uncompressed.data(), uncompressed.size(), false);
+      payloadBuffer.SetBufferOffset(0);
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, streamer->read(event, payloadBuffer));
+      buffer.SetBufferOffset(payloadOffset + header.m_payloadSize);
       return STATUS_CODE_SUCCESS;
     }
-    
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    EventStreamerRegistry *EventStreamerRegistry::instance() {
+      static EventStreamerRegistry registry;
+      return &registry;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventStreamerRegistry::registerStreamer(const std::string &streamerName, StreamerId &id) {
+      if(not PluginManager::instance()->isPluginRegistered(streamerName)) {
+        dqm_error( "EventStreamerRegistry::registerStreamer: streamer '{0}' not registered in plugin manager !", streamerName );
+        return STATUS_CODE_NOT_FOUND;
+      }
+      const std::string *internedName(nullptr);
+      return m_names.intern(streamerName, id, internedName);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventStreamerRegistry::internName(const std::string &streamerName, StreamerId &id, const std::string *&internedName) {
+      return m_names.intern(streamerName, id, internedName);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventStreamerRegistry::streamerName(StreamerId id, std::string &streamerName) {
+      const std::string *name = m_names.name(id);
+      if(nullptr != name) {
+        streamerName = *name;
+        return STATUS_CODE_SUCCESS;
+      }
+      // streamer not used yet in this process
+      for(const auto &pluginName : PluginManager::instance()->pluginNames()) {
+        if(id == EventNameTable::hashName(pluginName)) {
+          RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_names.intern(pluginName, id, name));
+          streamerName = pluginName;
+          return STATUS_CODE_SUCCESS;
+        }
+      }
+      return STATUS_CODE_NOT_FOUND;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventStreamerRegistry::streamerTable(json &table) {
+      m_names.toJson(table);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventStreamerRegistry::checkStreamerTable(const json &table, std::string &message) {
+      return m_names.fromJson(table, message);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode EventStreamerRegistry::findStreamer(StreamerId id, const std::string *&streamerName, EventStreamerPlugin *&streamer) {
+      StreamerCache &cache(threadStreamerCache());
+      auto findIter = cache.find(id);
+      if(cache.end() != findIter) {
+        streamerName = findIter->second.m_name;
+        streamer = findIter->second.m_streamer.get();
+        return STATUS_CODE_SUCCESS;
+      }
+      std::string name;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->streamerName(id, name));
+      CachedStreamer cachedStreamer;
+      cachedStreamer.m_name = m_names.name(id);
+      cachedStreamer.m_streamer = PluginManager::instance()->create<EventStreamerPlugin>(name);
+      if(nullptr == cachedStreamer.m_streamer) {
+        dqm_error( "EventStreamerRegistry: couldn't create streamer '{0}' !", name );
+        return STATUS_CODE_FAILURE;
+      }
+      streamerName = cachedStreamer.m_name;
+      streamer = cachedStreamer.m_streamer.get();
+      cache[id] = std::move(cachedStreamer);
+      return STATUS_CODE_SUCCESS;
+    }
+
   }
-  
+
 }
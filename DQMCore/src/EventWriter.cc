@@ -0,0 +1,24 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics 
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include "dqm4hep/EventWriter.h"
+
+namespace dqm4hep {
+
+  namespace core {
+    
+    EventWriter::~EventWriter() {
+      /* nop */
+    }
+
+  }
+
+}
@@ -12,10 +12,90 @@
 #include "dqm4hep/GenericEvent.h"
 #include "dqm4hep/PluginManager.h"
 
+// -- std headers
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace dqm4hep {
 
   namespace core {
 
+    /**
+     *  @brief  Get the process wide set of interned keys.
+     *          Set nodes are never moved, so that key pointers remain valid
+     */
+    static std::unordered_set<std::string> &internedKeys() {
+      static std::unordered_set<std::string> keys;
+      return keys;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  The maximum number of keys in the per-thread key cache
+     */
+    static const std::size_t maxThreadKeys = 4096;
+    
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  Get the mutex protecting the set of interned keys
+     */
+    static std::mutex &internedKeysMutex() {
+      static std::mutex mutex;
+      return mutex;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    GenericEvent::Key::Key(const std::string &keyName) :
+      m_hash(std::hash<std::string>()(keyName)) {
+      // keys already resolved by this thread: no lock.
+      // The cache is dropped when too large, e.g with dynamic key names
+      thread_local std::unordered_map<std::string, const std::string*> threadKeys;
+      auto findIter = threadKeys.find(keyName);
+
+      if (threadKeys.end() != findIter) {
+        m_name = findIter->second;
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(internedKeysMutex());
+        m_name = &(*internedKeys().insert(keyName).first);
+      }
+
+      if (threadKeys.size() >= maxThreadKeys) {
+        threadKeys.clear();
+      }
+
+      threadKeys.emplace(keyName, m_name);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string &GenericEvent::Key::name() const {
+      return *m_name;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    std::size_t GenericEvent::Key::hash() const {
+      return m_hash;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    bool GenericEvent::Key::valid() const {
+      return (nullptr != m_name);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    //-------------------------------------------------------------------------------------------------
+
     EventPtr GenericEvent::make_shared() {
       auto ptr = std::shared_ptr<Event>(new EventBase<GenericEvent>(new GenericEvent()));
       ptr->setStreamerName("GenericEventStreamer");
@@ -43,6 +123,13 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    template <typename T>
+    StatusCode GenericEvent::setValues(const Key &/*key*/, const T &/*vals*/) {
+      return STATUS_CODE_FAILURE;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
     StatusCode GenericEvent::getValues(const std::string &/*key*/, T &/*vals*/) const {
       return STATUS_CODE_FAILURE;
@@ -50,9 +137,53 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    template <typename T>
+    StatusCode GenericEvent::getValues(const Key &/*key*/, T &/*vals*/) const {
+      return STATUS_CODE_FAILURE;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    StatusCode GenericEvent::getValues(const std::string &/*key*/, ArrayView<T> &/*view*/) const {
+      return STATUS_CODE_FAILURE;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    StatusCode GenericEvent::getValues(const Key &/*key*/, ArrayView<T> &/*view*/) const {
+      return STATUS_CODE_FAILURE;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::setValues(const Key &key, const IntVector &vals) {
+      if (not key.valid()) {
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+
+      this->values<int>(key) = vals;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     template <>
     StatusCode GenericEvent::setValues(const std::string &key, const IntVector &vals) {
-      m_intValues[key] = vals;
+      return this->setValues(Key(key), vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::setValues(const Key &key, const FloatVector &vals) {
+      if (not key.valid()) {
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+
+      this->values<float>(key) = vals;
       return STATUS_CODE_SUCCESS;
     }
 
@@ -60,7 +191,18 @@ namespace dqm4hep {
 
     template <>
     StatusCode GenericEvent::setValues(const std::string &key, const FloatVector &vals) {
-      m_floatValues[key] = vals;
+      return this->setValues(Key(key), vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::setValues(const Key &key, const DoubleVector &vals) {
+      if (not key.valid()) {
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+
+      this->values<double>(key) = vals;
       return STATUS_CODE_SUCCESS;
     }
 
@@ -68,7 +210,18 @@ namespace dqm4hep {
 
     template <>
     StatusCode GenericEvent::setValues(const std::string &key, const DoubleVector &vals) {
-      m_doubleValues[key] = vals;
+      return this->setValues(Key(key), vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::setValues(const Key &key, const StringVector &vals) {
+      if (not key.valid()) {
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+
+      this->values<std::string>(key) = vals;
       return STATUS_CODE_SUCCESS;
     }
 
@@ -76,7 +229,118 @@ namespace dqm4hep {
 
     template <>
     StatusCode GenericEvent::setValues(const std::string &key, const StringVector &vals) {
-      m_stringValues[key] = vals;
+      return this->setValues(Key(key), vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const std::string &key, ArrayView<int> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<int>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<int>(*entry);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, ArrayView<int> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<int>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<int>(*entry);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const std::string &key, ArrayView<float> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<float>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<float>(*entry);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, ArrayView<float> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<float>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<float>(*entry);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const std::string &key, ArrayView<double> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<double>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<double>(*entry);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, ArrayView<double> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<double>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<double>(*entry);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const std::string &key, ArrayView<std::string> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<std::string>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<std::string>(*entry);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, ArrayView<std::string> &view) const {
+      const Entry *entry = this->findEntry(key, columnType<std::string>());
+
+      if (nullptr == entry) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      view = this->view<std::string>(*entry);
       return STATUS_CODE_SUCCESS;
     }
 
@@ -84,56 +348,235 @@ namespace dqm4hep {
 
     template <>
     StatusCode GenericEvent::getValues(const std::string &key, IntVector &vals) const {
-      auto findIter = m_intValues.find(key);
+      ArrayView<int> view;
+      const StatusCode statusCode(this->getValues(key, view));
+
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
+      }
+
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, IntVector &vals) const {
+      ArrayView<int> view;
+      const StatusCode statusCode(this->getValues(key, view));
 
-      if (m_intValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
     StatusCode GenericEvent::getValues(const std::string &key, FloatVector &vals) const {
-      auto findIter = m_floatValues.find(key);
+      ArrayView<float> view;
+      const StatusCode statusCode(this->getValues(key, view));
+
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
+      }
+
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, FloatVector &vals) const {
+      ArrayView<float> view;
+      const StatusCode statusCode(this->getValues(key, view));
 
-      if (m_floatValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
     StatusCode GenericEvent::getValues(const std::string &key, DoubleVector &vals) const {
-      auto findIter = m_doubleValues.find(key);
+      ArrayView<double> view;
+      const StatusCode statusCode(this->getValues(key, view));
 
-      if (m_doubleValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, DoubleVector &vals) const {
+      ArrayView<double> view;
+      const StatusCode statusCode(this->getValues(key, view));
+
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
+      }
+
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
     StatusCode GenericEvent::getValues(const std::string &key, StringVector &vals) const {
-      auto findIter = m_stringValues.find(key);
+      ArrayView<std::string> view;
+      const StatusCode statusCode(this->getValues(key, view));
+
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
+      }
+
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(const Key &key, StringVector &vals) const {
+      ArrayView<std::string> view;
+      const StatusCode statusCode(this->getValues(key, view));
+
+      if (STATUS_CODE_SUCCESS != statusCode) {
+        return statusCode;
+      }
+
+      vals.insert(vals.begin(), view.begin(), view.end());
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const GenericEvent::Entry *GenericEvent::findEntry(const Key &key, ColumnType type) const {
+      if (m_entries.empty() || not key.valid()) {
+        return nullptr;
+      }
+
+      const std::size_t mask(m_entries.size() - 1);
+
+      // interned keys: compare the key pointers
+      for (std::size_t index = key.m_hash & mask ; nullptr != m_entries[index].m_key ; index = (index + 1) & mask) {
+        const Entry &entry(m_entries[index]);
+
+        if (entry.m_key == key.m_name && entry.m_type == type) {
+          return &entry;
+        }
+      }
+
+      return nullptr;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const GenericEvent::Entry *GenericEvent::findEntry(const std::string &key, ColumnType type) const {
+      if (m_entries.empty()) {
+        return nullptr;
+      }
+
+      const std::size_t hash(std::hash<std::string>()(key));
+      const std::size_t mask(m_entries.size() - 1);
+
+      for (std::size_t index = hash & mask ; nullptr != m_entries[index].m_key ; index = (index + 1) & mask) {
+        const Entry &entry(m_entries[index]);
+
+        if (entry.m_hash == hash && entry.m_type == type && *entry.m_key == key) {
+          return &entry;
+        }
+      }
+
+      return nullptr;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    GenericEvent::Entry &GenericEvent::insertEntry(const Key &key, ColumnType type) {
+      // existing entry: no insertion, no growth
+      if (not m_entries.empty()) {
+        const std::size_t mask(m_entries.size() - 1);
+
+        for (std::size_t index = key.m_hash & mask ; nullptr != m_entries[index].m_key ; index = (index + 1) & mask) {
+          Entry &entry(m_entries[index]);
+
+          if (entry.m_key == key.m_name && entry.m_type == type) {
+            return entry;
+          }
+        }
+      }
+
+      // keep the load factor below 1/2
+      if (2 * (m_nEntries + 1) > m_entries.size()) {
+        std::vector<Entry> entries(std::max<std::size_t>(8, 2 * m_entries.size()));
+        const std::size_t mask(entries.size() - 1);
+        
+        for (const auto &entry : m_entries) {
+          if (nullptr == entry.m_key) {
+            continue;
+          }
+          
+          std::size_t index = entry.m_hash & mask;
+          
+          while (nullptr != entries[index].m_key) {
+            index = (index + 1) & mask;
+          }
+          
+          entries[index] = entry;
+        }
+        
+        m_entries.swap(entries);
+      }
+
+      const std::size_t mask(m_entries.size() - 1);
+      std::size_t index = key.m_hash & mask;
+
+      while (nullptr != m_entries[index].m_key) {
+        index = (index + 1) & mask;
+      }
+
+      Entry &entry(m_entries[index]);
+      entry.m_key = key.m_name;
+      entry.m_hash = key.m_hash;
+      entry.m_type = type;
+      m_nEntries++;
+      return entry;
+    }
+
+    //-------------------------------------------------------------------------------------------------
 
-      if (m_stringValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
+    void GenericEvent::addColumn(const Key &key, ColumnType type, const char *data, std::size_t size) {
+      Entry &entry(this->insertEntry(key, type));
+
+      // release the previous values, the slot is re-used by a later setValues()
+      if (entry.m_index >= 0) {
+        switch (type) {
+        case INT_COLUMN: IntVector().swap(m_intValues[entry.m_index]); break;
+        case FLOAT_COLUMN: FloatVector().swap(m_floatValues[entry.m_index]); break;
+        case DOUBLE_COLUMN: DoubleVector().swap(m_doubleValues[entry.m_index]); break;
+        case STRING_COLUMN: StringVector().swap(m_stringValues[entry.m_index]); break;
+        }
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      entry.m_column = true;
+      entry.m_data = data;
+      entry.m_size = size;
     }
 
   }
@@ -129,6 +129,7 @@ namespace dqm4hep {
 
     void MonitorElement::setPath(const std::string &p) {
       m_path = p;
+      setModified();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -144,6 +145,7 @@ namespace dqm4hep {
       }
       TNamed *named = objectTo<TNamed>();
       named->SetName(n.c_str());
+      setModified();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -187,6 +189,7 @@ namespace dqm4hep {
     void MonitorElement::setMonitorObject(TObject *pMonitorObject) {
       m_monitorObject.clear();
       m_monitorObject.set(pMonitorObject);
+      setModified();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -194,6 +197,7 @@ namespace dqm4hep {
     void MonitorElement::setMonitorObject(const PtrHandler<TObject> &monitorObject) {
       m_monitorObject.clear();
       m_monitorObject.set(monitorObject.ptr(), false);
+      setModified();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -201,6 +205,7 @@ namespace dqm4hep {
     void MonitorElement::setReferenceObject(TObject *pReferenceObject) {
       m_referenceObject.clear();
       m_referenceObject.set(pReferenceObject);
+      setModified();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -208,6 +213,7 @@ namespace dqm4hep {
     void MonitorElement::setReferenceObject(const PtrHandler<TObject> &referenceObject) {
       m_referenceObject.clear();
       m_referenceObject.set(referenceObject.ptr(), false);
+      setModified();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -217,6 +223,7 @@ namespace dqm4hep {
       m_monitorObject.set(pMonitorObject);
       m_referenceObject.clear();
       m_referenceObject.set(pReferenceObject);
+      setModified();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -226,6 +233,7 @@ namespace dqm4hep {
       m_monitorObject.set(monitorObject.ptr(), false);
       m_referenceObject.clear();
       m_referenceObject.set(referenceObject.ptr(), false);
+      setModified();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -237,6 +245,28 @@ namespace dqm4hep {
       if(resetQtests) {
         m_qualityTests.clear();
       }
+      setModified();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElement::setModified() {
+      ++m_generation;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned long MonitorElement::generation() const {
+      std::vector<double> values;
+      if(not fingerprint(values)) {
+        m_fingerprint.clear();
+        return ++m_generation;
+      }
+      if(values != m_fingerprint) {
+        m_fingerprint.swap(values);
+        ++m_generation;
+      }
+      return m_generation;
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -284,6 +314,7 @@ namespace dqm4hep {
       }
       // read path
       m_path = object.value<std::string>("path", "");
+      setModified();
     }
 #endif
     //-------------------------------------------------------------------------------------------------
@@ -342,6 +373,7 @@ namespace dqm4hep {
         }
         m_referenceObject.set(ref, true);
       }
+      setModified();
       return STATUS_CODE_SUCCESS;
     }
 
@@ -355,6 +387,7 @@ namespace dqm4hep {
         return STATUS_CODE_ALREADY_PRESENT;
 
       m_qualityTests.insert(QTestMap::value_type(qname, qualityTest));
+      setModified();
 
       return STATUS_CODE_SUCCESS;
     }
@@ -368,6 +401,7 @@ namespace dqm4hep {
         return STATUS_CODE_NOT_FOUND;
 
       m_qualityTests.erase(iter);
+      setModified();
 
       return STATUS_CODE_SUCCESS;
     }
@@ -403,6 +437,45 @@ namespace dqm4hep {
       return STATUS_CODE_SUCCESS;
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElement::setQualityReports(const QReportMap &/*reports*/) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool MonitorElement::fingerprint(std::vector<double> &values) const {
+      const TObject *pObject = object();
+      if(nullptr == pObject) {
+        values.push_back(0.);
+        return true;
+      }
+      const TH1 *histogram = dynamic_cast<const TH1*>(pObject);
+      if(nullptr != histogram) {
+        values.resize(TH1::kNstat + 1, 0.);
+        values[0] = histogram->GetEntries();
+        histogram->GetStats(&values[1]);
+        return true;
+      }
+      const TGraph *graph = dynamic_cast<const TGraph*>(pObject);
+      if(nullptr != graph) {
+        const Int_t nPoints = graph->GetN();
+        values.push_back(nPoints);
+        if(nPoints > 0) {
+          values.push_back(graph->GetX()[nPoints-1]);
+          values.push_back(graph->GetY()[nPoints-1]);
+        }
+        return true;
+      }
+      const TText *text = dynamic_cast<const TText*>(pObject);
+      if(nullptr != text) {
+        values.push_back(static_cast<double>(std::hash<std::string>()(text->GetTitle())));
+        return true;
+      }
+      return false;
+    }
+
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
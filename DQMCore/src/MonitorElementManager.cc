@@ -16,6 +16,9 @@
 #include <dqm4hep/QualityTest.h>
 #include <dqm4hep/Storage.h>
 
+// -- root headers
+#include <TList.h>
+
 // -- std headers
 #include <stdexcept>
 
@@ -131,8 +134,13 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
-    void MonitorElementManager::monitorElementsToJson(json &object) const {
-      m_storage.iterate([&object](const MonitorElementDir &, MonitorElementPtr monitorElement) {
+    void MonitorElementManager::monitorElementsToJson(json &object, bool modifiedOnly) const {
+      m_storage.iterate([&object,modifiedOnly](const MonitorElementDir &, MonitorElementPtr monitorElement) {
+        const unsigned long generation(monitorElement->generation());
+        if(modifiedOnly and generation == monitorElement->m_exportGeneration) {
+          return true;
+        }
+        monitorElement->m_exportGeneration = generation;
         json meObject;
         monitorElement->toJson(meObject);
         object.push_back(meObject);
@@ -154,6 +162,57 @@ namespace dqm4hep {
       return STATUS_CODE_SUCCESS;
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode MonitorElementManager::renameMonitorElement(const std::string &path, const std::string &name, const std::string &newName) {
+      try {
+        RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_storage.rename(path, name, newName, [&newName](const MonitorElementPtr &element) {
+          element->setName(newName);
+        }));
+      } 
+      catch (StatusCodeException &e) {
+        return e.getStatusCode();
+      }
+
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode MonitorElementManager::mergeMonitorElements(MonitorElementManager &other) {
+      other.m_storage.iterate([this](const MonitorElementDir &, MonitorElementPtr otherElement) {
+        MonitorElementPtr monitorElement;
+        if(STATUS_CODE_SUCCESS != this->getMonitorElement(otherElement->path(), otherElement->name(), monitorElement)) {
+          return true;
+        }
+        TObject *object = monitorElement->object();
+        TObject *otherObject = otherElement->object();
+        if(nullptr == object or nullptr == otherObject or object->IsA() != otherObject->IsA()) {
+          dqm_debug( "MonitorElementManager::mergeMonitorElements: can't merge element '{0}{1}', incompatible objects", otherElement->path(), otherElement->name() );
+          return true;
+        }
+        TH1 *histogram = dynamic_cast<TH1*>(object);
+        if(nullptr != histogram) {
+          histogram->Add(static_cast<TH1*>(otherObject));
+          static_cast<TH1*>(otherObject)->Reset();
+          return true;
+        }
+        ROOT::MergeFunc_t merge = object->IsA()->GetMerge();
+        ROOT::ResetAfterMergeFunc_t resetAfterMerge = object->IsA()->GetResetAfterMerge();
+        if(nullptr == merge or nullptr == resetAfterMerge) {
+          dqm_debug( "MonitorElementManager::mergeMonitorElements: can't merge element '{0}{1}', class {2} doesn't support merging", 
+            otherElement->path(), otherElement->name(), object->ClassName() );
+          return true;
+        }
+        TList list;
+        list.Add(otherObject);
+        merge(object, &list, nullptr);
+        resetAfterMerge(otherObject, nullptr);
+        return true;
+      });
+      return STATUS_CODE_SUCCESS;
+    }
+
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
@@ -251,12 +310,63 @@ namespace dqm4hep {
 
     StatusCode MonitorElementManager::runQualityTests(QReportStorage &reports) {
       try {
-        m_storage.iterate([&reports](const MonitorElementDir &, MonitorElementPtr monitorElement) {
-          QReportMap reportMap;
-          THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, monitorElement->runQualityTests(reportMap));
-          reports.addReports(reportMap);
-          return true;
-        });
+        if (nullptr == m_qualityTestPool) {
+          m_storage.iterate([&reports](const MonitorElementDir &, MonitorElementPtr monitorElement) {
+            const unsigned long generation(monitorElement->generation());
+            // not modified since the last run, re-use the previous reports
+            if (generation != monitorElement->m_reportsGeneration) {
+              QReportMap reportMap;
+              THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, monitorElement->runQualityTests(reportMap));
+              monitorElement->m_lastReports = reportMap;
+              monitorElement->m_reportsGeneration = generation;
+            }
+            reports.addReports(monitorElement->m_lastReports);
+            return true;
+          });
+        } else {
+          // list the (monitor element, quality test) pairs.
+          // Each pair writes its report in its own slot, no locking needed
+          // The elements not modified since the last run have no job
+          std::vector<MonitorElementPtr> monitorElements;
+          std::vector<unsigned long> generations;
+          std::vector<std::size_t> firstJobs;
+          std::vector<std::pair<MonitorElement *, QualityTest *>> jobs;
+          m_storage.iterate([&](const MonitorElementDir &, MonitorElementPtr monitorElement) {
+            const unsigned long generation(monitorElement->generation());
+            monitorElements.push_back(monitorElement);
+            generations.push_back(generation);
+            firstJobs.push_back(jobs.size());
+            if (generation == monitorElement->m_reportsGeneration)
+              return true;
+            for (const auto &qualityTest : monitorElement->m_qualityTests)
+              jobs.push_back(std::make_pair(monitorElement.get(), qualityTest.second.get()));
+            return true;
+          });
+          firstJobs.push_back(jobs.size());
+          std::vector<QReport> jobReports(jobs.size());
+          std::vector<std::size_t> parallelJobs, serialJobs;
+          for (std::size_t job = 0; job < jobs.size(); ++job)
+            (jobs[job].second->threadSafe() ? parallelJobs : serialJobs).push_back(job);
+          m_qualityTestPool->run(parallelJobs.size(), [&](std::size_t index) {
+            const std::size_t job(parallelJobs[index]);
+            jobs[job].second->run(jobs[job].first, jobReports[job]);
+          });
+          for (const auto job : serialJobs)
+            jobs[job].second->run(jobs[job].first, jobReports[job]);
+          // merge the reports, in the monitor element order
+          for (std::size_t e = 0; e < monitorElements.size(); ++e) {
+            MonitorElement *monitorElement = monitorElements[e].get();
+            if (generations[e] != monitorElement->m_reportsGeneration) {
+              QReportMap reportMap;
+              for (std::size_t job = firstJobs[e]; job < firstJobs[e + 1]; ++job)
+                reportMap.insert(QReportMap::value_type(jobs[job].second->name(), jobReports[job]));
+              monitorElement->setQualityReports(reportMap);
+              monitorElement->m_lastReports = reportMap;
+              monitorElement->m_reportsGeneration = generations[e];
+            }
+            reports.addReports(monitorElement->m_lastReports);
+          }
+        }
       } catch (StatusCodeException &exception) {
         dqm_error("Failed to process qtests: {0}", exception.toString());
         return exception.getStatusCode();
@@ -296,6 +406,28 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    void MonitorElementManager::setQualityTestThreads(unsigned int nThreads) {
+      if (nThreads == this->qualityTestThreads())
+        return;
+
+      if (nThreads <= 1) {
+        m_qualityTestPool.reset();
+        return;
+      }
+
+      // the quality tests read the ROOT objects from several threads
+      ROOT::EnableThreadSafety();
+      m_qualityTestPool.reset(new WorkerPool(nThreads));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int MonitorElementManager::qualityTestThreads() const {
+      return (nullptr == m_qualityTestPool) ? 1 : m_qualityTestPool->nThreads();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     const Storage<MonitorElement> &MonitorElementManager::getStorage() const {
       return m_storage;
     }
@@ -330,9 +462,7 @@ namespace dqm4hep {
     
     StatusCode MonitorElementManager::addToStorage(const std::string &path, MonitorElementPtr monitorElement) {
       // check for existence
-      if (nullptr != m_storage.findObject(path, [&](MonitorElementPtr obj) { 
-        return obj->name() == monitorElement->name(); 
-      })) {
+      if (nullptr != m_storage.findObjectByName(path, monitorElement->name())) {
         dqm_error("Monitor element '{0}' in directory '{1}' already booked !", monitorElement->name(), path);
         return STATUS_CODE_ALREADY_PRESENT;
       }
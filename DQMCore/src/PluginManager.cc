@@ -123,7 +123,7 @@ namespace dqm4hep {
     const Plugin *PluginManager::getPlugin(const std::string &pluginName) const {
       if (!isPluginRegistered(pluginName))
         return nullptr;
-      dqm_info("Returning a valid plugin pointer");
+      dqm_debug("Returning a valid plugin pointer");
       return m_pluginMap.find(pluginName)->second;
     }
 
@@ -33,6 +33,7 @@ namespace dqm4hep {
       m_message = qreport.m_message;
       m_quality = qreport.m_quality;
       m_qualityFlag = qreport.m_qualityFlag;
+      m_executionTime = qreport.m_executionTime;
       m_extraInfos = qreport.m_extraInfos;
       return *this;
     }
@@ -49,6 +50,7 @@ namespace dqm4hep {
                {"message", m_message},
                {"quality", m_quality},
                {"flag", m_qualityFlag},
+               {"executionTime", m_executionTime},
                {"extra", m_extraInfos}};
     }
 
@@ -65,6 +67,7 @@ namespace dqm4hep {
       m_message = value.value<std::string>("message", m_message);
       m_quality = value.value<float>("quality", m_quality);
       m_qualityFlag = value.value<QualityFlag>("flag", m_qualityFlag);
+      m_executionTime = value.value<double>("executionTime", m_executionTime);
       m_extraInfos = value.value<json>("extra", m_extraInfos);
     }
 
@@ -301,6 +304,14 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     void QualityTest::run(MonitorElement* monitorElement, QualityTestReport &report) {
+      const auto startTime = std::chrono::steady_clock::now();
+      this->runTest(monitorElement, report);
+      report.m_executionTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void QualityTest::runTest(MonitorElement* monitorElement, QualityTestReport &report) {
       this->fillBasicInfo(monitorElement, report);
 
       if (nullptr == monitorElement) {
@@ -0,0 +1,127 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/WorkerPool.h>
+#include <dqm4hep/Logging.h>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    WorkerPool::WorkerPool(unsigned int nThreads) {
+      if(0 == nThreads) {
+        dqm_error( "WorkerPool: number of threads must be positive !" );
+        throw StatusCodeException(STATUS_CODE_INVALID_PARAMETER);
+      }
+      for(unsigned int t=1 ; t<nThreads ; t++) {
+        m_workers.push_back(std::thread(&WorkerPool::workerLoop, this));
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    WorkerPool::~WorkerPool() {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlag = true;
+      }
+      m_startCondition.notify_all();
+      for(auto &worker : m_workers) {
+        worker.join();
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int WorkerPool::nThreads() const {
+      return m_workers.size() + 1;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void WorkerPool::run(std::size_t nTasks, const Task &task) {
+      if(0 == nTasks) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_nTasks = nTasks;
+        m_nextTask = 0;
+        m_exception = nullptr;
+        m_nBusyWorkers = m_workers.size();
+        ++m_batch;
+      }
+      m_startCondition.notify_all();
+      processTasks();
+      std::exception_ptr exception;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this](){
+          return (0 == m_nBusyWorkers);
+        });
+        m_task = nullptr;
+        exception = m_exception;
+        m_exception = nullptr;
+      }
+      if(nullptr != exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void WorkerPool::workerLoop() {
+      unsigned long batch(0);
+      while(true) {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_startCondition.wait(lock, [this,&batch](){
+            return m_stopFlag || (batch != m_batch);
+          });
+          if(m_stopFlag) {
+            return;
+          }
+          batch = m_batch;
+        }
+        processTasks();
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if(0 == --m_nBusyWorkers) {
+            m_doneCondition.notify_one();
+          }
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void WorkerPool::processTasks() {
+      while(true) {
+        const std::size_t index(m_nextTask++);
+        if(index >= m_nTasks) {
+          break;
+        }
+        try {
+          (*m_task)(index);
+        }
+        catch(...) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if(nullptr == m_exception) {
+            m_exception = std::current_exception();
+          }
+        }
+      }
+    }
+
+  }
+
+}
@@ -0,0 +1,259 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventReader.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/BinaryEventFile.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/PluginManager.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  BinaryEventReader class
+     *          Read events from a binary file written by the BinaryEventWriter.
+     *          The file is memory mapped and events are deserialized directly
+     *          from the mapped pages. The event index allows for skipping events in constant time
+     */
+    class BinaryEventReader : public EventReader {
+    public:
+      BinaryEventReader() = default;
+      ~BinaryEventReader() override;
+      BinaryEventReader(const BinaryEventReader&) = delete;
+      BinaryEventReader& operator=(const BinaryEventReader&) = delete;
+
+      core::StatusCode open(const std::string &fname) override;
+      core::StatusCode skipNEvents(int nEvents) override;
+      core::StatusCode runInfo(core::Run &run) override;
+      core::StatusCode readNextEvent() override;
+      core::StatusCode close() override;
+
+    private:
+      /**
+       *  @brief  Rebuild the index by scanning the frames.
+       *          Used for files that were not properly closed
+       */
+      core::StatusCode buildIndex();
+
+      /**
+       *  @brief  Load the event source table, so that the event source ids can be resolved
+       */
+      core::StatusCode loadSourceTable();
+
+    private:
+      std::string                 m_fileName = {};                       ///< The current file name
+      const char                 *m_data = {nullptr};                    ///< The mapped file
+      size_t                      m_size = {0};                          ///< The mapped file size
+      BinaryEventFileHeader       m_header = {};                         ///< The file header
+      std::vector<uint64_t>       m_index = {};                          ///< The frame offsets
+      size_t                      m_currentEvent = {0};                  ///< The next event to read
+      core::EventStreamer         m_streamer = {};                       ///< The event streamer
+      TBufferFile                 m_buffer = {TBuffer::kRead};           ///< The buffer reused for deserialization
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    BinaryEventReader::~BinaryEventReader() {
+      close();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventReader::open(const std::string &fname) {
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, close());
+      const int fd = ::open(fname.c_str(), O_RDONLY);
+      if(fd < 0) {
+        dqm_error( "BinaryEventReader::open(): couldn't open file '{0}': {1}", fname, strerror(errno) );
+        return STATUS_CODE_FAILURE;
+      }
+      struct stat fileStat;
+      if(0 != fstat(fd, &fileStat) || static_cast<size_t>(fileStat.st_size) < sizeof(BinaryEventFileHeader)) {
+        dqm_error( "BinaryEventReader::open(): file '{0}' is not a binary event file", fname );
+        ::close(fd);
+        return STATUS_CODE_FAILURE;
+      }
+      // private writable mapping: pages are copied only if the buffer ever writes in them
+      void *data = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      // the mapping stays valid after closing the descriptor
+      ::close(fd);
+      if(MAP_FAILED == data) {
+        dqm_error( "BinaryEventReader::open(): couldn't map file '{0}': {1}", fname, strerror(errno) );
+        return STATUS_CODE_FAILURE;
+      }
+      madvise(data, fileStat.st_size, MADV_SEQUENTIAL);
+      m_data = static_cast<const char*>(data);
+      m_size = fileStat.st_size;
+      m_fileName = fname;
+      memcpy(&m_header, m_data, sizeof(m_header));
+      if(not m_header.valid()) {
+        dqm_error( "BinaryEventReader::open(): file '{0}' has an invalid header (wrong format, version or byte order)", fname );
+        close();
+        return STATUS_CODE_FAILURE;
+      }
+      // file not properly closed, scan the frames
+      if(0 == m_header.m_indexOffset) {
+        dqm_warning( "BinaryEventReader::open(): no index in file '{0}', scanning events", fname );
+        return buildIndex();
+      }
+      if(m_header.m_indexOffset % sizeof(uint64_t) != 0 || m_header.m_indexOffset > m_size
+         || m_header.m_nEvents > (m_size - m_header.m_indexOffset) / sizeof(uint64_t)) {
+        dqm_error( "BinaryEventReader::open(): corrupted index in file '{0}'", fname );
+        close();
+        return STATUS_CODE_FAILURE;
+      }
+      const uint64_t *index = reinterpret_cast<const uint64_t*>(m_data + m_header.m_indexOffset);
+      m_index.assign(index, index + m_header.m_nEvents);
+      return loadSourceTable();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventReader::skipNEvents(int nEvents) {
+      if(nEvents < 0 || m_currentEvent + nEvents > m_index.size()) {
+        dqm_error( "Couldn't skip {0} events in file '{1}' : file has {2} events left", nEvents, m_fileName, m_index.size() - m_currentEvent );
+        return STATUS_CODE_OUT_OF_RANGE;
+      }
+      m_currentEvent += nEvents;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventReader::runInfo(core::Run &run) {
+      if(nullptr == m_data) {
+        return STATUS_CODE_NOT_INITIALIZED;
+      }
+      if(0 == m_header.m_runInfoOffset || m_header.m_runInfoOffset > m_size || m_header.m_runInfoSize > m_size - m_header.m_runInfoOffset) {
+        dqm_error( "No run info available in file '{0}'", m_fileName );
+        return STATUS_CODE_NOT_FOUND;
+      }
+      try {
+        json runJson = json::parse(std::string(m_data + m_header.m_runInfoOffset, m_header.m_runInfoSize));
+        run.fromJson(runJson);
+      }
+      catch(const std::exception &exception) {
+        dqm_error( "Couldn't parse run info in file '{0}': {1}", m_fileName, exception.what() );
+        return STATUS_CODE_FAILURE;
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventReader::loadSourceTable() {
+      if(0 == m_header.m_sourceTableSize) {
+        return STATUS_CODE_SUCCESS;
+      }
+      const uint64_t offset = m_header.m_runInfoOffset + m_header.m_runInfoSize;
+      if(0 == m_header.m_runInfoOffset || offset > m_size || m_header.m_sourceTableSize > m_size - offset) {
+        dqm_error( "BinaryEventReader::open(): corrupted source table in file '{0}'", m_fileName );
+        close();
+        return STATUS_CODE_FAILURE;
+      }
+      std::string message;
+      try {
+        json sourceTable = json::parse(std::string(m_data + offset, m_header.m_sourceTableSize));
+        if(STATUS_CODE_SUCCESS != EventNameTable::sourceNames()->fromJson(sourceTable, message)) {
+          dqm_error( "BinaryEventReader::open(): invalid source table in file '{0}': {1}", m_fileName, message );
+          close();
+          return STATUS_CODE_FAILURE;
+        }
+      }
+      catch(const std::exception &exception) {
+        dqm_error( "BinaryEventReader::open(): couldn't parse source table in file '{0}': {1}", m_fileName, exception.what() );
+        close();
+        return STATUS_CODE_FAILURE;
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventReader::readNextEvent() {
+      // end of file !
+      if(m_currentEvent >= m_index.size()) {
+        return STATUS_CODE_OUT_OF_RANGE;
+      }
+      const uint64_t offset = m_index[m_currentEvent];
+      uint32_t frameSize = 0;
+      if(offset > m_size || sizeof(frameSize) > m_size - offset) {
+        dqm_error( "BinaryEventReader::readNextEvent(): corrupted frame offset in file '{0}'", m_fileName );
+        return STATUS_CODE_FAILURE;
+      }
+      memcpy(&frameSize, m_data + offset, sizeof(frameSize));
+      if(frameSize > m_size - offset - sizeof(frameSize)) {
+        dqm_error( "BinaryEventReader::readNextEvent(): corrupted frame size in file '{0}'", m_fileName );
+        return STATUS_CODE_FAILURE;
+      }
+      // read directly from the mapped pages, the buffer doesn't own the memory
+      m_buffer.SetBuffer(const_cast<char*>(m_data + offset + sizeof(frameSize)), frameSize, false);
+      EventPtr event;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_streamer.readEvent(event, m_buffer));
+      m_currentEvent++;
+      onEventRead().emit(event);
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventReader::close() {
+      if(nullptr != m_data) {
+        // detach the buffer from the mapped pages first
+        m_buffer.SetBuffer(nullptr, 0, false);
+        munmap(const_cast<char*>(m_data), m_size);
+      }
+      m_data = nullptr;
+      m_size = 0;
+      m_header = BinaryEventFileHeader();
+      m_index.clear();
+      m_currentEvent = 0;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventReader::buildIndex() {
+      size_t offset = sizeof(BinaryEventFileHeader);
+      while(offset + sizeof(uint32_t) <= m_size) {
+        uint32_t frameSize = 0;
+        memcpy(&frameSize, m_data + offset, sizeof(frameSize));
+        // truncated last frame, stop here
+        if(0 == frameSize || frameSize > m_size - offset - sizeof(frameSize)) {
+          break;
+        }
+        m_index.push_back(offset);
+        offset += sizeof(frameSize) + frameSize;
+      }
+      m_header.m_nEvents = m_index.size();
+      dqm_info( "BinaryEventReader::buildIndex(): found {0} events in file '{1}'", m_index.size(), m_fileName );
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    DQM_PLUGIN_DECL(BinaryEventReader, "BinaryEventReader");
+  }
+}
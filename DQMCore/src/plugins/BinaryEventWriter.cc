@@ -0,0 +1,190 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventWriter.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/BinaryEventFile.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/PluginManager.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <cstdio>
+#include <cerrno>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  BinaryEventWriter class
+     *          Write events in a binary file, see BinaryEventFileHeader for the file layout.
+     *          Events are serialized with the EventStreamer, using the streamer set in each event
+     */
+    class BinaryEventWriter : public EventWriter {
+    public:
+      BinaryEventWriter() = default;
+      ~BinaryEventWriter() override;
+      BinaryEventWriter(const BinaryEventWriter&) = delete;
+      BinaryEventWriter& operator=(const BinaryEventWriter&) = delete;
+
+      core::StatusCode open(const std::string &fname) override;
+      core::StatusCode setRunInfo(const core::Run &run) override;
+      core::StatusCode writeEvent(core::EventPtr event) override;
+      core::StatusCode close() override;
+
+    private:
+      /**
+       *  @brief  Write raw bytes in the file
+       */
+      core::StatusCode write(const void *data, size_t size);
+
+    private:
+      std::string                 m_fileName = {};                       ///< The current file name
+      FILE                       *m_file = {nullptr};                    ///< The current file
+      uint64_t                    m_offset = {0};                        ///< The current write offset
+      std::vector<uint64_t>       m_index = {};                          ///< The frame offsets
+      core::Run                   m_run = {};                            ///< The run info to write on close
+      json                        m_sourceTable = {};                    ///< The event sources to write on close
+      core::EventStreamer         m_streamer = {};                       ///< The event streamer
+      TBufferFile                 m_buffer = {TBuffer::kWrite};          ///< The buffer reused for serialization
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    BinaryEventWriter::~BinaryEventWriter() {
+      if(nullptr != m_file) {
+        close();
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventWriter::open(const std::string &fname) {
+      if(nullptr != m_file) {
+        dqm_error( "BinaryEventWriter::open(): file '{0}' still open", m_fileName );
+        return STATUS_CODE_NOT_ALLOWED;
+      }
+      m_file = fopen(fname.c_str(), "wb");
+      if(nullptr == m_file) {
+        dqm_error( "BinaryEventWriter::open(): couldn't open file '{0}': {1}", fname, strerror(errno) );
+        return STATUS_CODE_FAILURE;
+      }
+      m_fileName = fname;
+      m_offset = 0;
+      m_index.clear();
+      m_run.reset();
+      m_sourceTable = json::object();
+      // placeholder header, rewritten on close
+      BinaryEventFileHeader header;
+      return write(&header, sizeof(header));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventWriter::setRunInfo(const core::Run &run) {
+      m_run = run;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventWriter::writeEvent(core::EventPtr event) {
+      if(nullptr == m_file) {
+        return STATUS_CODE_NOT_INITIALIZED;
+      }
+      m_buffer.Reset();
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_streamer.writeEvent(event, m_buffer));
+      const uint32_t frameSize = m_buffer.Length();
+      const uint64_t frameOffset = m_offset;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, write(&frameSize, sizeof(frameSize)));
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, write(m_buffer.Buffer(), frameSize));
+      m_index.push_back(frameOffset);
+      if(EventNameTable::invalidId != event->getSourceId() && 0 == m_sourceTable.count(event->getSource())) {
+        m_sourceTable[event->getSource()] = event->getSourceId();
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventWriter::close() {
+      if(nullptr == m_file) {
+        return STATUS_CODE_SUCCESS;
+      }
+      BinaryEventFileHeader header;
+      header.m_nEvents = m_index.size();
+      core::StatusCode statusCode = STATUS_CODE_SUCCESS;
+      // index, aligned on 8 bytes
+      const char padding[sizeof(uint64_t)] = {0};
+      const size_t paddingSize = (sizeof(uint64_t) - m_offset % sizeof(uint64_t)) % sizeof(uint64_t);
+      if(STATUS_CODE_SUCCESS == statusCode) {
+        statusCode = write(padding, paddingSize);
+      }
+      header.m_indexOffset = m_offset;
+      if(STATUS_CODE_SUCCESS == statusCode) {
+        statusCode = write(m_index.data(), m_index.size()*sizeof(uint64_t));
+      }
+      // run info, as json
+      json runJson;
+      m_run.toJson(runJson);
+      const std::string runInfo = runJson.dump();
+      header.m_runInfoOffset = m_offset;
+      header.m_runInfoSize = runInfo.size();
+      if(STATUS_CODE_SUCCESS == statusCode) {
+        statusCode = write(runInfo.data(), runInfo.size());
+      }
+      // source table, as json
+      const std::string sourceTable = m_sourceTable.dump();
+      header.m_sourceTableSize = sourceTable.size();
+      if(STATUS_CODE_SUCCESS == statusCode) {
+        statusCode = write(sourceTable.data(), sourceTable.size());
+      }
+      // final header
+      if(STATUS_CODE_SUCCESS == statusCode) {
+        if(0 != fseek(m_file, 0, SEEK_SET) || 1 != fwrite(&header, sizeof(header), 1, m_file)) {
+          dqm_error( "BinaryEventWriter::close(): couldn't write header in file '{0}': {1}", m_fileName, strerror(errno) );
+          statusCode = STATUS_CODE_FAILURE;
+        }
+      }
+      if(0 != fclose(m_file)) {
+        dqm_error( "BinaryEventWriter::close(): couldn't close file '{0}': {1}", m_fileName, strerror(errno) );
+        statusCode = STATUS_CODE_FAILURE;
+      }
+      m_file = nullptr;
+      m_index.clear();
+      return statusCode;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode BinaryEventWriter::write(const void *data, size_t size) {
+      if(0 == size) {
+        return STATUS_CODE_SUCCESS;
+      }
+      if(1 != fwrite(data, size, 1, m_file)) {
+        dqm_error( "BinaryEventWriter::write(): couldn't write {0} bytes in file '{1}': {2}", size, m_fileName, strerror(errno) );
+        return STATUS_CODE_FAILURE;
+      }
+      m_offset += size;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    DQM_PLUGIN_DECL(BinaryEventWriter, "BinaryEventWriter");
+  }
+}
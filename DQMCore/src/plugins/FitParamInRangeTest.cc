@@ -76,6 +76,11 @@ namespace dqm4hep {
        */
       StatusCode readSettings(const dqm4hep::core::TiXmlHandle xmlHandle) override;
       
+      /**
+       *  @brief  The fit uses the default ROOT minimizer (TMinuit) which is not thread safe
+       */
+      bool threadSafe() const override;
+      
       /**
        *  @brief  Run the quality test and get a quality test report from it
        *  
@@ -323,6 +328,12 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    bool FitParamInRangeTest::threadSafe() const {
+      return false;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     bool FitParamInRangeTest::checkElement(MonitorElement* monitorElement) const {
       const bool isHistogram = (nullptr == monitorElement->objectTo<TH1>());
       const bool isGraph = (nullptr == monitorElement->objectTo<TGraph>());
@@ -0,0 +1,365 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/PluginManager.h>
+
+// -- root headers
+#include <TBuffer.h>
+
+// -- std headers
+#include <cstring>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  GenericEventColumnarStreamer class
+     *          Serialize a GenericEvent as a single columnar block:
+     *
+     *          - header: magic number, number of columns
+     *          - key table: per column the type, number of values,
+     *            key offset and length, data offset and size
+     *          - keys: all keys, contiguous
+     *          - columns: the values of each key, contiguous and 8 bytes aligned.
+     *            String columns are stored as the string lengths followed by the characters
+     *
+     *          The block is written in the host byte order, the magic number
+     *          telling the reader whether the block has to be byte swapped.
+     *          On read, the block is copied once in the event and the numeric
+     *          values are accessed in place (see GenericEvent::getValues() with ArrayView),
+     *          instead of allocating and filling a vector per key.
+     *          The strings are copied in the event.
+     */
+    class GenericEventColumnarStreamer : public EventStreamerPlugin {
+    public:
+      /** Constructor
+       */
+      GenericEventColumnarStreamer();
+
+      /** Destructor
+       */
+      ~GenericEventColumnarStreamer() override;
+
+      /** Factory method to create the corresponding event to this streamer.
+       *  The event is expected to contains an allocated wrapped event
+       */
+      EventPtr createEvent() const override;
+
+      /** Serialize the event and store it into a data stream.
+       */
+      StatusCode write(EventPtr event, TBuffer &buffer) override;
+
+      /** De-serialize the event.
+       */
+      StatusCode read(EventPtr event, TBuffer &buffer) override;
+
+    private:
+      /**
+       *  @brief  ColumnEntry struct. An entry of the key table
+       */
+      struct ColumnEntry {
+        uint32_t     m_type;          ///< The column type
+        uint32_t     m_size;          ///< The number of values
+        uint32_t     m_keyOffset;     ///< The key offset in the block
+        uint32_t     m_keyLength;     ///< The key length
+        uint32_t     m_dataOffset;    ///< The values offset in the block
+        uint32_t     m_dataSize;      ///< The values size (unit bytes)
+      };
+
+      /**
+       *  @brief  Add the numeric columns of a map to the key table
+       */
+      template <typename T>
+      void addColumns(const GenericEvent *pGenericEvent);
+
+      /**
+       *  @brief  Write the numeric columns of a map, in the key table order
+       */
+      template <typename T>
+      void writeColumns(TBuffer &buffer, const GenericEvent *pGenericEvent);
+
+      /**
+       *  @brief  Add a column to the key table
+       */
+      void addColumn(const std::string &key, uint32_t type, uint32_t size, uint32_t dataSize);
+
+      /**
+       *  @brief  Write padding bytes up to the next 8 bytes alignment
+       */
+      static void writePadding(TBuffer &buffer, uint32_t size);
+
+      /**
+       *  @brief  Get the 8 bytes aligned size
+       */
+      static uint32_t align(uint32_t size);
+
+      /**
+       *  @brief  Swap the byte order of n values of a given size, in place
+       */
+      static void swapBytes(char *data, uint32_t valueSize, uint32_t n);
+
+    private:
+      std::vector<ColumnEntry>          m_columnEntries = {};     ///< The key table (write only)
+      std::vector<const std::string*>   m_keys = {};              ///< The column keys (write only)
+      uint32_t                          m_keysSize = {0};         ///< The total keys size (write only)
+      uint32_t                          m_dataSize = {0};         ///< The total columns size (write only)
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /// The block magic number, as read in the host byte order
+    static const uint32_t columnarMagic = 0x44514D43;
+    /// The block magic number, as read in the opposite byte order
+    static const uint32_t columnarSwappedMagic = 0x434D5144;
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void GenericEventColumnarStreamer::addColumns(const GenericEvent *pGenericEvent) {
+      pGenericEvent->visitValues<T>([this](const std::string &key, const T *, std::size_t size){
+        this->addColumn(key, GenericEvent::columnType<T>(), size, size*sizeof(T));
+      });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void GenericEventColumnarStreamer::writeColumns(TBuffer &buffer, const GenericEvent *pGenericEvent) {
+      pGenericEvent->visitValues<T>([&buffer](const std::string &, const T *array, std::size_t size){
+        const uint32_t dataSize = size*sizeof(T);
+        buffer.WriteFastArray(reinterpret_cast<const Char_t*>(array), dataSize);
+        GenericEventColumnarStreamer::writePadding(buffer, dataSize);
+      });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    GenericEventColumnarStreamer::GenericEventColumnarStreamer() {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    GenericEventColumnarStreamer::~GenericEventColumnarStreamer() {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    EventPtr GenericEventColumnarStreamer::createEvent() const {
+      return Event::create<GenericEvent>();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode GenericEventColumnarStreamer::write(EventPtr event, TBuffer &buffer) {
+      const GenericEvent *pGenericEvent = event->getEvent<GenericEvent>();
+      if (nullptr == pGenericEvent) {
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+      // build the key table
+      m_columnEntries.clear();
+      m_keys.clear();
+      m_keysSize = 0;
+      m_dataSize = 0;
+      addColumns<int>(pGenericEvent);
+      addColumns<float>(pGenericEvent);
+      addColumns<double>(pGenericEvent);
+      pGenericEvent->visitValues<std::string>([this](const std::string &key, const std::string *strings, std::size_t size){
+        uint32_t dataSize = size*sizeof(uint32_t);
+        for(std::size_t s=0 ; s<size ; s++) {
+          dataSize += strings[s].size();
+        }
+        this->addColumn(key, GenericEvent::STRING_COLUMN, size, dataSize);
+      });
+      // key and data offsets, relative to the block start
+      const uint32_t nColumns = m_columnEntries.size();
+      const uint32_t keysOffset = 2*sizeof(uint32_t) + nColumns*sizeof(ColumnEntry);
+      const uint32_t dataOffset = align(keysOffset + m_keysSize);
+      for(auto &entry : m_columnEntries) {
+        entry.m_keyOffset += keysOffset;
+        entry.m_dataOffset += dataOffset;
+      }
+      const uint32_t blockSize = dataOffset + m_dataSize;
+      buffer.WriteUInt(blockSize);
+      // header and key table
+      buffer.WriteFastArray(reinterpret_cast<const Char_t*>(&columnarMagic), sizeof(uint32_t));
+      buffer.WriteFastArray(reinterpret_cast<const Char_t*>(&nColumns), sizeof(uint32_t));
+      if(nColumns > 0) {
+        buffer.WriteFastArray(reinterpret_cast<const Char_t*>(&m_columnEntries[0]), nColumns*sizeof(ColumnEntry));
+      }
+      // keys
+      for(auto key : m_keys) {
+        buffer.WriteFastArray(key->data(), key->size());
+      }
+      writePadding(buffer, keysOffset + m_keysSize);
+      // columns, same order as the key table
+      writeColumns<int>(buffer, pGenericEvent);
+      writeColumns<float>(buffer, pGenericEvent);
+      writeColumns<double>(buffer, pGenericEvent);
+      pGenericEvent->visitValues<std::string>([&buffer](const std::string &, const std::string *strings, std::size_t size){
+        uint32_t dataSize = 0;
+        for(std::size_t s=0 ; s<size ; s++) {
+          const uint32_t length = strings[s].size();
+          buffer.WriteFastArray(reinterpret_cast<const Char_t*>(&length), sizeof(uint32_t));
+          dataSize += sizeof(uint32_t);
+        }
+        for(std::size_t s=0 ; s<size ; s++) {
+          buffer.WriteFastArray(strings[s].data(), strings[s].size());
+          dataSize += strings[s].size();
+        }
+        GenericEventColumnarStreamer::writePadding(buffer, dataSize);
+      });
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode GenericEventColumnarStreamer::read(EventPtr event, TBuffer &buffer) {
+      GenericEvent *pGenericEvent = event->getEvent<GenericEvent>();
+      if (nullptr == pGenericEvent) {
+        return STATUS_CODE_INVALID_PARAMETER;
+      }
+      UInt_t blockSize = 0;
+      buffer.ReadUInt(blockSize);
+      if(blockSize < 2*sizeof(uint32_t) || blockSize > static_cast<UInt_t>(buffer.BufferSize() - buffer.Length())) {
+        dqm_error( "GenericEventColumnarStreamer::read: invalid block size ({0} bytes)", blockSize );
+        return STATUS_CODE_FAILURE;
+      }
+      // single copy of the block, 8 bytes aligned
+      // owned by the event from now on, so that the values stay valid even if reading fails
+      pGenericEvent->m_columnBuffer.reset(new uint64_t[(blockSize+7)/8]);
+      char *block = reinterpret_cast<char*>(pGenericEvent->m_columnBuffer.get());
+      buffer.ReadFastArray(block, blockSize);
+      // header
+      uint32_t magic = 0, nColumns = 0;
+      memcpy(&magic, block, sizeof(uint32_t));
+      const bool swap = (columnarSwappedMagic == magic);
+      if(not swap && columnarMagic != magic) {
+        dqm_error( "GenericEventColumnarStreamer::read: invalid magic number" );
+        return STATUS_CODE_FAILURE;
+      }
+      if(swap) {
+        swapBytes(block, sizeof(uint32_t), 2);
+      }
+      memcpy(&nColumns, block + sizeof(uint32_t), sizeof(uint32_t));
+      const uint64_t headerSize = 2*sizeof(uint32_t) + static_cast<uint64_t>(nColumns)*sizeof(ColumnEntry);
+      if(headerSize > blockSize) {
+        dqm_error( "GenericEventColumnarStreamer::read: invalid number of columns ({0})", nColumns );
+        return STATUS_CODE_FAILURE;
+      }
+      ColumnEntry *entries = reinterpret_cast<ColumnEntry*>(block + 2*sizeof(uint32_t));
+      if(swap) {
+        swapBytes(reinterpret_cast<char*>(entries), sizeof(uint32_t), nColumns*sizeof(ColumnEntry)/sizeof(uint32_t));
+      }
+      for(uint32_t c=0 ; c<nColumns ; c++) {
+        const ColumnEntry &entry(entries[c]);
+        const bool validKey = static_cast<uint64_t>(entry.m_keyOffset) + entry.m_keyLength <= blockSize;
+        const bool validData = static_cast<uint64_t>(entry.m_dataOffset) + entry.m_dataSize <= blockSize && 0 == entry.m_dataOffset % 8;
+        if(not validKey || not validData || entry.m_type > GenericEvent::STRING_COLUMN) {
+          dqm_error( "GenericEventColumnarStreamer::read: invalid key table entry" );
+          return STATUS_CODE_FAILURE;
+        }
+        const GenericEvent::Key key(std::string(block + entry.m_keyOffset, entry.m_keyLength));
+        char *data = block + entry.m_dataOffset;
+        // strings are copied in the event
+        if(GenericEvent::STRING_COLUMN == entry.m_type) {
+          if(static_cast<uint64_t>(entry.m_size)*sizeof(uint32_t) > entry.m_dataSize) {
+            dqm_error( "GenericEventColumnarStreamer::read: invalid string column '{0}'", key.name() );
+            return STATUS_CODE_FAILURE;
+          }
+          if(swap) {
+            swapBytes(data, sizeof(uint32_t), entry.m_size);
+          }
+          StringVector &strings(pGenericEvent->values<std::string>(key));
+          strings.resize(entry.m_size);
+          const uint32_t *lengths = reinterpret_cast<const uint32_t*>(data);
+          uint64_t position = entry.m_size*sizeof(uint32_t);
+          for(uint32_t s=0 ; s<entry.m_size ; s++) {
+            if(position + lengths[s] > entry.m_dataSize) {
+              dqm_error( "GenericEventColumnarStreamer::read: invalid string column '{0}'", key.name() );
+              return STATUS_CODE_FAILURE;
+            }
+            strings[s].assign(data + position, lengths[s]);
+            position += lengths[s];
+          }
+          continue;
+        }
+        // numeric values are referenced in place
+        const uint32_t valueSize = (GenericEvent::DOUBLE_COLUMN == entry.m_type) ? sizeof(double) : sizeof(int);
+        if(static_cast<uint64_t>(entry.m_size)*valueSize != entry.m_dataSize) {
+          dqm_error( "GenericEventColumnarStreamer::read: invalid column '{0}'", key.name() );
+          return STATUS_CODE_FAILURE;
+        }
+        if(swap) {
+          swapBytes(data, valueSize, entry.m_size);
+        }
+        pGenericEvent->addColumn(key, static_cast<GenericEvent::ColumnType>(entry.m_type), data, entry.m_size);
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void GenericEventColumnarStreamer::addColumn(const std::string &key, uint32_t type, uint32_t size, uint32_t dataSize) {
+      ColumnEntry entry;
+      entry.m_type = type;
+      entry.m_size = size;
+      entry.m_keyOffset = m_keysSize;
+      entry.m_keyLength = key.size();
+      entry.m_dataOffset = m_dataSize;
+      entry.m_dataSize = dataSize;
+      m_columnEntries.push_back(entry);
+      m_keys.push_back(&key);
+      m_keysSize += key.size();
+      m_dataSize += align(dataSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void GenericEventColumnarStreamer::writePadding(TBuffer &buffer, uint32_t size) {
+      static const Char_t padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      const uint32_t paddingSize = align(size) - size;
+      if(paddingSize > 0) {
+        buffer.WriteFastArray(padding, paddingSize);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t GenericEventColumnarStreamer::align(uint32_t size) {
+      return (size + 7) & ~static_cast<uint32_t>(7);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void GenericEventColumnarStreamer::swapBytes(char *data, uint32_t valueSize, uint32_t n) {
+      for(uint32_t i=0 ; i<n ; i++) {
+        char *value = data + i*valueSize;
+        for(uint32_t b=0 ; b<valueSize/2 ; b++) {
+          std::swap(value[b], value[valueSize-1-b]);
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    DQM_PLUGIN_DECL(GenericEventColumnarStreamer, "GenericEventColumnarStreamer");
+  }
+}
@@ -50,51 +50,63 @@ namespace dqm4hep {
       
     private:
       template <typename T>
-      void writeMap(TBuffer &buffer, const std::map<std::string, std::vector<T>> &values);
+      void writeValues(TBuffer &buffer, const GenericEvent *pGenericEvent);
       
       template <typename T>
-      void readMap(TBuffer &buffer, std::map<std::string, std::vector<T>> &values);
+      void readValues(TBuffer &buffer, GenericEvent *pGenericEvent);
     };
     
     
     template <typename T>
-    inline void GenericEventStreamer::writeMap(TBuffer &buffer, const std::map<std::string, std::vector<T>> &values) {
-      buffer.WriteInt(values.size());
-      for(auto elt : values) {
-        buffer.WriteStdString(&elt.first);
-        buffer.WriteArray(&elt.second[0], elt.second.size());
-      }
+    inline void GenericEventStreamer::writeValues(TBuffer &buffer, const GenericEvent *pGenericEvent) {
+      Int_t size = 0;
+      pGenericEvent->visitValues<T>([&size](const std::string &, const T *, std::size_t){
+        ++size;
+      });
+      buffer.WriteInt(size);
+      pGenericEvent->visitValues<T>([&buffer](const std::string &key, const T *array, std::size_t arraySize){
+        buffer.WriteStdString(&key);
+        buffer.WriteArray(array, arraySize);
+      });
     }
     
     template <typename T>
-    inline void GenericEventStreamer::readMap(TBuffer &buffer, std::map<std::string, std::vector<T>> &values) {
+    inline void GenericEventStreamer::readValues(TBuffer &buffer, GenericEvent *pGenericEvent) {
       Int_t size = 0;
       buffer.ReadInt(size);
       for(Int_t s=0 ; s<size ; s++) {
         std::string key;
         buffer.ReadStdString(&key);
-        T *array = nullptr;
-        Int_t size = buffer.ReadArray(array);
-        std::vector<T> vecValues(array, array + sizeof(array) / sizeof(T));
-        delete [] array;
-        values[key] = vecValues;
+        // same layout as WriteArray(): array size then values.
+        // Read directly in the vector storage, no intermediate array
+        Int_t arraySize = 0;
+        buffer.ReadInt(arraySize);
+        std::vector<T> &vecValues(pGenericEvent->values<T>(GenericEvent::Key(key)));
+        vecValues.resize(arraySize);
+        if(arraySize > 0) {
+          buffer.ReadFastArray(&vecValues[0], arraySize);
+        }
       }
     }
     
     template <>
-    inline void GenericEventStreamer::writeMap(TBuffer &buffer, const std::map<std::string, std::vector<std::string>> &values) {
-      buffer.WriteInt(values.size());
-      for(auto elt : values) {
-        buffer.WriteStdString(&elt.first);
-        buffer.WriteInt(elt.second.size());
-        for(auto elt2 : elt.second) {
-          buffer.WriteStdString(&elt2);
+    inline void GenericEventStreamer::writeValues<std::string>(TBuffer &buffer, const GenericEvent *pGenericEvent) {
+      Int_t size = 0;
+      pGenericEvent->visitValues<std::string>([&size](const std::string &, const std::string *, std::size_t){
+        ++size;
+      });
+      buffer.WriteInt(size);
+      pGenericEvent->visitValues<std::string>([&buffer](const std::string &key, const std::string *array, std::size_t arraySize){
+        buffer.WriteStdString(&key);
+        buffer.WriteInt(arraySize);
+        for(std::size_t i=0 ; i<arraySize ; i++) {
+          buffer.WriteStdString(&array[i]);
         }
-      }
+      });
     }
     
     template <>
-    inline void GenericEventStreamer::readMap(TBuffer &buffer, std::map<std::string, std::vector<std::string>> &values) {
+    inline void GenericEventStreamer::readValues<std::string>(TBuffer &buffer, GenericEvent *pGenericEvent) {
       Int_t size = 0;
       buffer.ReadInt(size);
       for(Int_t s=0 ; s<size ; s++) {
@@ -102,14 +114,11 @@ namespace dqm4hep {
         buffer.ReadStdString(&key);
         Int_t vecSize = 0;
         buffer.ReadInt(vecSize);
-        std::vector<std::string> vecValues;
-        vecValues.reserve(vecSize);
+        std::vector<std::string> &vecValues(pGenericEvent->values<std::string>(GenericEvent::Key(key)));
+        vecValues.resize(vecSize);
         for(Int_t s2=0 ; s2<vecSize ; s2++) {
-          std::string value;
-          buffer.ReadStdString(&value);
-          vecValues.push_back(value);
+          buffer.ReadStdString(&vecValues[s2]);
         }
-        values[key] = vecValues;
       }
     }
     
@@ -140,10 +149,10 @@ namespace dqm4hep {
         return STATUS_CODE_INVALID_PARAMETER;
       }
       // write event contents
-      writeMap(buffer, pGenericEvent->m_intValues);
-      writeMap(buffer, pGenericEvent->m_floatValues);
-      writeMap(buffer, pGenericEvent->m_doubleValues);
-      writeMap(buffer, pGenericEvent->m_stringValues);
+      writeValues<int>(buffer, pGenericEvent);
+      writeValues<float>(buffer, pGenericEvent);
+      writeValues<double>(buffer, pGenericEvent);
+      writeValues<std::string>(buffer, pGenericEvent);
       return STATUS_CODE_SUCCESS;
     }
 
@@ -155,10 +164,10 @@ namespace dqm4hep {
         return STATUS_CODE_INVALID_PARAMETER;
       }
       // write event contents
-      readMap(buffer, pGenericEvent->m_intValues);
-      readMap(buffer, pGenericEvent->m_floatValues);
-      readMap(buffer, pGenericEvent->m_doubleValues);
-      readMap(buffer, pGenericEvent->m_stringValues);
+      readValues<int>(buffer, pGenericEvent);
+      readValues<float>(buffer, pGenericEvent);
+      readValues<double>(buffer, pGenericEvent);
+      readValues<std::string>(buffer, pGenericEvent);
       return STATUS_CODE_SUCCESS;
     }
     
@@ -16,13 +16,22 @@
 #include <dqm4hep/PluginManager.h>
 #include <dqm4hep/XmlHelper.h>
 
+// -- std headers
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+
 namespace dqm4hep {
 
   namespace core {
 
     /**
      *  @brief  GenericEventXMLReader class
-     *          Read an XML and read GenericEvent events from it
+     *          Read an XML and read GenericEvent events from it.
+     *          The file is streamed: the <run> element is parsed on open
+     *          and the <event> elements are then parsed one at a time, so that
+     *          the memory usage doesn't depend on the number of events in the file
      */
     class GenericEventXMLReader : public EventReader {
     public:
@@ -38,46 +47,131 @@ namespace dqm4hep {
       core::StatusCode close() override;
       
     private:
-      TiXmlDocument        m_document = {};
-      TiXmlElement        *m_currentEvent = {nullptr};
+      /**
+       *  @brief  Read the opening tag of the root element
+       */
+      core::StatusCode readRootElement();
+
+      /**
+       *  @brief  Parse the next <event> element from the file in m_currentEvent.
+       *          A <run> element found on the way is kept for runInfo().
+       *          Returns STATUS_CODE_OUT_OF_RANGE at the end of the root element
+       */
+      core::StatusCode readNextEventElement();
+
+      /**
+       *  @brief  Move the stream to the next child element of the root element.
+       *          Skip text, comments and processing instructions
+       */
+      core::StatusCode nextElement();
+
+      /**
+       *  @brief  Skip the stream content up to and including the end string
+       */
+      bool skipTo(const std::string &end);
+
+      /**
+       *  @brief  Parse the whitespace separated numbers of an element text in place
+       */
+      template <typename T>
+      static bool parseValues(const char *text, std::vector<T> &values);
+
+      /**
+       *  @brief  Convert a single number, see std::strtof and friends
+       */
+      template <typename T>
+      static T convert(const char *str, char **end);
+
+    private:
+      std::string                            m_fileName = {};              ///< The current file name
+      std::ifstream                          m_file = {};                  ///< The file stream
+      bool                                   m_endOfFile = {true};         ///< Whether the end of the root element was reached
+      std::unique_ptr<TiXmlElement>          m_runElement = {nullptr};     ///< The parsed <run> element
+      std::unique_ptr<TiXmlElement>          m_currentEvent = {nullptr};   ///< The next <event> element to process
     };
     
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
+    template <>
+    inline int GenericEventXMLReader::convert(const char *str, char **end) {
+      return static_cast<int>(std::strtol(str, end, 10));
+    }
+
+    template <>
+    inline float GenericEventXMLReader::convert(const char *str, char **end) {
+      return std::strtof(str, end);
+    }
+
+    template <>
+    inline double GenericEventXMLReader::convert(const char *str, char **end) {
+      return std::strtod(str, end);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool GenericEventXMLReader::parseValues(const char *text, std::vector<T> &values) {
+      const char *current = text;
+      while(true) {
+        while(' ' == *current || '\t' == *current || '\n' == *current || '\r' == *current) {
+          ++current;
+        }
+        if('\0' == *current) {
+          return true;
+        }
+        char *end = nullptr;
+        errno = 0;
+        const T value = convert<T>(current, &end);
+        if(end == current || 0 != errno) {
+          return false;
+        }
+        values.push_back(value);
+        current = end;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     GenericEventXMLReader::~GenericEventXMLReader() {
-      /* nop */
+      close();
     }
 
     //-------------------------------------------------------------------------------------------------
 
     core::StatusCode GenericEventXMLReader::open(const std::string &fname) {
-      if(not m_document.LoadFile(fname)) {
-        dqm_error("GenericEventXMLReader::open(): couldn't load xml file ['{0}', row: {1}, col: {2}] : {3}", fname,
-                  m_document.ErrorRow(), m_document.ErrorCol(), m_document.ErrorDesc());
+      close();
+      m_file.open(fname.c_str(), std::ios::in | std::ios::binary);
+      if(not m_file.is_open()) {
+        dqm_error("GenericEventXMLReader::open(): couldn't open xml file '{0}'", fname);
         return STATUS_CODE_FAILURE;
       }
-      m_currentEvent = m_document.RootElement()->FirstChildElement("event");
-      if(nullptr == m_currentEvent) {
+      m_fileName = fname;
+      m_endOfFile = false;
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, readRootElement());
+      // reads the <run> element (if placed before the events) and the first event
+      const core::StatusCode statusCode = readNextEventElement();
+      if(STATUS_CODE_OUT_OF_RANGE == statusCode) {
         dqm_error( "No event stored in the file '{0}'", fname );
         return STATUS_CODE_FAILURE;
       }
-      return STATUS_CODE_SUCCESS;
+      return statusCode;
     }
     
     //-------------------------------------------------------------------------------------------------
     
     core::StatusCode GenericEventXMLReader::skipNEvents(int nEvents) {
-      int nSkippedEvents = 0;
-      while(1) {
-        if(nSkippedEvents == nEvents)
-          break;
-        m_currentEvent = m_currentEvent->NextSiblingElement("event");
+      for(int nSkippedEvents = 0 ; nSkippedEvents < nEvents ; nSkippedEvents++) {
         if(nullptr == m_currentEvent) {
-          dqm_error( "Couldn't skip {0} events in file '{1}' : file has less than {1}", nEvents, m_document.ValueStr() );
-          return STATUS_CODE_OUT_OF_RANGE;
+          const core::StatusCode statusCode = readNextEventElement();
+          if(STATUS_CODE_OUT_OF_RANGE == statusCode) {
+            dqm_error( "Couldn't skip {0} events in file '{1}' : file has less than {0}", nEvents, m_fileName );
+          }
+          if(STATUS_CODE_SUCCESS != statusCode) {
+            return statusCode;
+          }
         }
-        nSkippedEvents++;
+        m_currentEvent.reset();
       }
       return STATUS_CODE_SUCCESS;
     }
@@ -85,9 +179,9 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     core::StatusCode GenericEventXMLReader::runInfo(core::Run &run) {
-      auto runInfoElement = m_document.RootElement()->FirstChildElement("run");
+      auto runInfoElement = m_runElement.get();
       if(!runInfoElement) {
-        dqm_error( "No run info available in file '{0}'", m_document.ValueStr() );
+        dqm_error( "No run info available in file '{0}'", m_fileName );
         return STATUS_CODE_NOT_FOUND;
       }
       TiXmlHandle handle(runInfoElement);
@@ -123,13 +217,18 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     core::StatusCode GenericEventXMLReader::readNextEvent() {
-      EventPtr event = GenericEvent::make_shared();
-      GenericEvent *generic = event->getEvent<GenericEvent>();
-      // end of file !
       if(nullptr == m_currentEvent) {
-        return STATUS_CODE_OUT_OF_RANGE;
+        // end of file !
+        RETURN_RESULT_IF_AND_IF(STATUS_CODE_SUCCESS, STATUS_CODE_OUT_OF_RANGE, !=, readNextEventElement());
+        if(nullptr == m_currentEvent) {
+          return STATUS_CODE_OUT_OF_RANGE;
+        }
       }
-      TiXmlHandle handle(m_currentEvent);
+      // the element is released whatever happens next
+      std::unique_ptr<TiXmlElement> currentEvent(std::move(m_currentEvent));
+      EventPtr event = GenericEvent::make_shared();
+      GenericEvent *generic = event->getEvent<GenericEvent>();
+      TiXmlHandle handle(currentEvent.get());
       int32_t eventType = static_cast<int32_t>(UNKNOWN_EVENT);
       std::string source;
       int32_t timeStamp = 0, eventNumber = 0, runNumber = 0;
@@ -149,35 +248,24 @@ namespace dqm4hep {
       event->setEventNumber(eventNumber);
       event->setRunNumber(runNumber);
       // loop over <field> elements
-      for(auto field = m_currentEvent->FirstChildElement("field") ; nullptr != field ; field = field->NextSiblingElement("field")) {
+      for(auto field = currentEvent->FirstChildElement("field") ; nullptr != field ; field = field->NextSiblingElement("field")) {
         std::string name, type;
         RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::getAttribute(field, "name", name));
         RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, XmlHelper::getAttribute(field, "type", type));
+        bool parsed = true;
         if("int" == type) {
-          if(nullptr == field->GetText()) {
-            return STATUS_CODE_FAILURE;
-          }
-          std::string content = field->GetText();
           IntVector values;
-          core::tokenize(content, values, " ");
+          parsed = (nullptr != field->GetText()) && parseValues(field->GetText(), values);
           generic->setValues(name, values);
         }
         else if("float" == type) {
-          if(nullptr == field->GetText()) {
-            return STATUS_CODE_FAILURE;
-          }
-          std::string content = field->GetText();
           FloatVector values;
-          core::tokenize(content, values, " ");
+          parsed = (nullptr != field->GetText()) && parseValues(field->GetText(), values);
           generic->setValues(name, values);
         }
         else if("double" == type) {
-          if(nullptr == field->GetText()) {
-            return STATUS_CODE_FAILURE;
-          }
-          std::string content = field->GetText();
           DoubleVector values;
-          core::tokenize(content, values, " ");
+          parsed = (nullptr != field->GetText()) && parseValues(field->GetText(), values);
           generic->setValues(name, values);
         }
         else if("string" == type) {
@@ -192,18 +280,139 @@ namespace dqm4hep {
           dqm_warning( "Unrecognized field type '{0}' ! Skipping ...", type );
           continue;
         }
+        if(not parsed) {
+          dqm_error( "Couldn't parse values of field '{0}' (type {1}) in file '{2}'", name, type, m_fileName );
+          return STATUS_CODE_FAILURE;
+        }
       }
       onEventRead().emit(event);
-      m_currentEvent = m_currentEvent->NextSiblingElement("event");
       return STATUS_CODE_SUCCESS;
     }
     
     //-------------------------------------------------------------------------------------------------
     
     core::StatusCode GenericEventXMLReader::close() {
-      m_document.Clear();
+      if(m_file.is_open()) {
+        m_file.close();
+      }
+      m_file.clear();
+      m_fileName.clear();
+      m_endOfFile = true;
+      m_runElement.reset();
+      m_currentEvent.reset();
       return STATUS_CODE_SUCCESS;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode GenericEventXMLReader::readRootElement() {
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, nextElement());
+      // read the opening tag only, taking care of '>' in attribute values
+      char quote = '\0';
+      char previous = '\0';
+      while(true) {
+        const int c = m_file.get();
+        if(not m_file.good()) {
+          dqm_error( "GenericEventXMLReader::readRootElement(): unterminated root element in file '{0}'", m_fileName );
+          return STATUS_CODE_FAILURE;
+        }
+        if('\0' != quote) {
+          quote = (c == quote) ? '\0' : quote;
+        }
+        else if('"' == c || '\'' == c) {
+          quote = static_cast<char>(c);
+        }
+        else if('>' == c) {
+          // <root/>: no child element at all
+          m_endOfFile = ('/' == previous);
+          return STATUS_CODE_SUCCESS;
+        }
+        previous = static_cast<char>(c);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode GenericEventXMLReader::readNextEventElement() {
+      while(nullptr == m_currentEvent) {
+        const core::StatusCode statusCode = nextElement();
+        if(STATUS_CODE_SUCCESS != statusCode) {
+          return statusCode;
+        }
+        std::unique_ptr<TiXmlElement> element(new TiXmlElement(""));
+        m_file >> *element;
+        if(m_file.fail() || element->ValueStr().empty()) {
+          dqm_error( "GenericEventXMLReader::readNextEventElement(): couldn't parse element in file '{0}'", m_fileName );
+          return STATUS_CODE_FAILURE;
+        }
+        if("event" == element->ValueStr()) {
+          m_currentEvent = std::move(element);
+        }
+        else if("run" == element->ValueStr()) {
+          m_runElement = std::move(element);
+        }
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode GenericEventXMLReader::nextElement() {
+      if(m_endOfFile) {
+        return STATUS_CODE_OUT_OF_RANGE;
+      }
+      while(true) {
+        // skip text
+        while(m_file.good() && '<' != m_file.peek()) {
+          m_file.get();
+        }
+        m_file.get();
+        const int c = m_file.peek();
+        if(not m_file.good()) {
+          m_endOfFile = true;
+          dqm_error( "GenericEventXMLReader::nextElement(): unexpected end of file '{0}'", m_fileName );
+          return STATUS_CODE_FAILURE;
+        }
+        if('/' == c) {
+          // closing tag of the root element
+          m_endOfFile = true;
+          return STATUS_CODE_OUT_OF_RANGE;
+        }
+        else if('?' == c) {
+          if(not skipTo("?>")) {
+            return STATUS_CODE_FAILURE;
+          }
+        }
+        else if('!' == c) {
+          m_file.get();
+          const bool comment = ('-' == m_file.peek());
+          if(not skipTo(comment ? "-->" : ">")) {
+            return STATUS_CODE_FAILURE;
+          }
+        }
+        else {
+          // positioned on the '<' of the element
+          m_file.unget();
+          return STATUS_CODE_SUCCESS;
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool GenericEventXMLReader::skipTo(const std::string &end) {
+      std::string::size_type matched = 0;
+      while(matched < end.size()) {
+        const int c = m_file.get();
+        if(not m_file.good()) {
+          dqm_error( "GenericEventXMLReader::skipTo(): missing '{0}' in file '{1}'", end, m_fileName );
+          m_endOfFile = true;
+          return false;
+        }
+        matched = (c == end[matched]) ? matched + 1 : ((c == end[0]) ? 1 : 0);
+      }
+      return true;
+    }
     
     //-------------------------------------------------------------------------------------------------
     
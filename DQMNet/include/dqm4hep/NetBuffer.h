@@ -16,9 +16,11 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace dqm4hep {
 
@@ -164,6 +166,17 @@ namespace dqm4hep {
         m_rawBuffer.adopt(m_value.c_str(), m_value.size());
       }
 
+      /**
+       *  @brief  Copy a raw buffer, re-using the current string storage if large enough
+       *
+       *  @param  buffer the start buffer address
+       *  @param  size the buffer size
+       */
+      inline void copy(const char *buffer, size_t size) {
+        m_value.assign(buffer, size);
+        m_rawBuffer.adopt(m_value.c_str(), m_value.size());
+      }
+
     private:
       std::string m_value = {""}; ///< An internal copy of the stored value as std::string
     };
@@ -246,6 +259,60 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
+    /**
+     *  @brief  BufferPool class.
+     *          A slab of reusable std::string buffer models. A model handed out 
+     *          by the pool is shared (refcounted) by all the buffers using it, e.g a 
+     *          retained buffer, a service update and a request response. It goes back 
+     *          to the pool when the pool holds the last reference on it, so that
+     *          retaining a copy of a transient buffer doesn't allocate memory once
+     *          the pool storage is warm.
+     */
+    class BufferPool {
+    public:
+      typedef std::shared_ptr<BufferModelT<std::string>> ModelPtr;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  maxModels the maximum number of models kept in the pool
+       */
+      BufferPool(unsigned int maxModels = 16);
+      BufferPool(const BufferPool &) = delete;
+      BufferPool &operator=(const BufferPool &) = delete;
+
+      /**
+       *  @brief  Get a free model from the pool and copy the raw buffer in it.
+       *          If all pooled models are still in use, a new model is created,
+       *          and kept in the pool if the maximum number of models is not reached
+       *
+       *  @param  buffer the start buffer address
+       *  @param  size the buffer size
+       */
+      ModelPtr copy(const char *buffer, size_t size);
+
+      /**
+       *  @brief  Get the number of models obtained by re-using a free pooled model
+       */
+      unsigned long hits() const;
+
+      /**
+       *  @brief  Get the number of models obtained by a new allocation
+       */
+      unsigned long misses() const;
+
+    private:
+      const unsigned int         m_maxModels;           ///< The maximum number of models in the pool
+      std::vector<ModelPtr>      m_models = {};         ///< The pooled models
+      unsigned int               m_nextModel = {0};     ///< The next model to check for re-use
+      unsigned long              m_hits = {0};          ///< The number of re-used models
+      unsigned long              m_misses = {0};        ///< The number of allocated models
+      mutable std::mutex         m_mutex = {};          ///< The pool mutex
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
     inline BufferModelT<T>::BufferModelT() {
       m_rawBuffer.adopt((const char *)&m_value, sizeof(m_value));
@@ -125,10 +125,22 @@ namespace dqm4hep {
       bool isServiceConnected() const;
 
       /**
+       *  @brief  Send the buffer to the clients
        *
+       *  @param  buffer the buffer to send
+       *  @param  clientIds the clients to send the buffer to (all clients if empty)
        */
       void sendData(const Buffer &buffer, const std::vector<int> &clientIds);
 
+      /**
+       *  @brief  Send a raw buffer to the clients, without wrapping it in a Buffer
+       *
+       *  @param  ptr the buffer start address
+       *  @param  size the buffer size
+       *  @param  clientIds the clients to send the buffer to (all clients if empty)
+       */
+      void sendRaw(const char *ptr, size_t size, const std::vector<int> &clientIds);
+
     private:
       DimService         *m_pService = {nullptr};      ///< The service implementation
       std::string         m_name = {""};               ///< The service name
@@ -11,6 +11,9 @@
 // -- dqm4hep headers
 #include "dqm4hep/DQMNet.h"
 
+// -- std headers
+#include <atomic>
+
 namespace dqm4hep {
 
   namespace net {
@@ -121,5 +124,57 @@ namespace dqm4hep {
     BufferModelPtr Buffer::model() const {
       return m_model;
     }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    BufferPool::BufferPool(unsigned int maxModels) :
+      m_maxModels(maxModels) {
+      m_models.reserve(m_maxModels);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    BufferPool::ModelPtr BufferPool::copy(const char *buffer, size_t s) {
+      ModelPtr model = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // a model only referenced by the pool is free
+        for (unsigned int i = 0; i < m_models.size(); i++) {
+          auto &pooledModel = m_models[(m_nextModel + i) % m_models.size()];
+          if (1 == pooledModel.use_count()) {
+            // synchronize with the release of the last external reference
+            std::atomic_thread_fence(std::memory_order_acquire);
+            model = pooledModel;
+            m_nextModel = (m_nextModel + i + 1) % m_models.size();
+            ++m_hits;
+            break;
+          }
+        }
+        if (nullptr == model) {
+          model = std::make_shared<BufferModelT<std::string>>();
+          ++m_misses;
+          if (m_models.size() < m_maxModels) {
+            m_models.push_back(model);
+          }
+        }
+      }
+      model->copy(buffer, s);
+      return model;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned long BufferPool::hits() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_hits;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned long BufferPool::misses() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_misses;
+    }
   }
 }
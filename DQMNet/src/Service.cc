@@ -65,35 +65,35 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     void Service::sendBuffer(const void *ptr, size_t size) {
-      Buffer buffer;
-      buffer.adopt((const char *)ptr, size);
-      this->sendData(buffer, std::vector<int>());
+      this->sendRaw((const char *)ptr, size, std::vector<int>());
     }
 
     //-------------------------------------------------------------------------------------------------
 
     void Service::sendBuffer(const void *ptr, size_t size, int clientId) {
-      Buffer buffer;
-      buffer.adopt((const char *)ptr, size);
-      this->sendData(buffer, std::vector<int>(1, clientId));
+      this->sendRaw((const char *)ptr, size, std::vector<int>(1, clientId));
     }
 
     //-------------------------------------------------------------------------------------------------
 
     void Service::sendBuffer(const void *ptr, size_t size, const std::vector<int> &clientIds) {
-      Buffer buffer;
-      buffer.adopt((const char *)ptr, size);
-      this->sendData(buffer, clientIds);
+      this->sendRaw((const char *)ptr, size, clientIds);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     void Service::sendData(const Buffer &buffer, const std::vector<int> &clientIds) {
+      this->sendRaw(buffer.begin(), buffer.size(), clientIds);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Service::sendRaw(const char *ptr, size_t size, const std::vector<int> &clientIds) {
       if (!this->isServiceConnected())
         throw; // TODO implement exceptions
 
       if (clientIds.empty()) {
-        m_pService->updateService((void *)buffer.begin(), buffer.size());
+        m_pService->updateService((void *)ptr, size);
         m_pService->itsData = (void *)NullBuffer::buffer;
         m_pService->itsSize = NullBuffer::size;
       } else {
@@ -103,7 +103,7 @@ namespace dqm4hep {
           clientIdList.push_back(0);
 
         int *clientIdsArray = &clientIdList[0];
-        m_pService->selectiveUpdateService((void *)buffer.begin(), buffer.size(), clientIdsArray);
+        m_pService->selectiveUpdateService((void *)ptr, size, clientIdsArray);
         m_pService->itsData = (void *)NullBuffer::buffer;
         m_pService->itsSize = NullBuffer::size;
       }
@@ -11,11 +11,18 @@
 #ifndef DQM4HEP_APPEVENT_H
 #define DQM4HEP_APPEVENT_H
 
+// -- std headers
+#include <atomic>
+
 namespace dqm4hep {
 
   namespace online {
 
+    class AppEventPool;
+
     class AppEvent {
+      friend class AppEventLoop;
+      friend class AppEventPool;
     public:
       /**
        *  @brief  AppEvent type enum
@@ -63,10 +70,18 @@ namespace dqm4hep {
       int priority() const;
       
     private:
+      // not copiable, the event is owned by the event loop
+      AppEvent(const AppEvent&) = delete;
+      AppEvent &operator=(const AppEvent&) = delete;
+      
       /// The application event type
       int               m_type = {AppEvent::NONE};
       /// The event priority
       int               m_priority = {50};
+      /// The next event in the event loop queue (intrusive link)
+      std::atomic<AppEvent*>  m_next = {nullptr};
+      /// The pool owning the event, if any
+      AppEventPool*           m_pool = {nullptr};
     };
 
   }
@@ -15,6 +15,7 @@
 #include "dqm4hep/Internal.h"
 #include "dqm4hep/AppEvent.h"
 #include "dqm4hep/AppEvents.h"
+#include "dqm4hep/AppEventPool.h"
 #include "dqm4hep/Signal.h"
 #include "dqm4hep/Logging.h"
 #include "dqm4hep/StatusCodes.h"
@@ -22,6 +23,14 @@
 
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
+#include <array>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <map>
+#include <memory>
+#include <typeindex>
 
 namespace dqm4hep {
 
@@ -30,7 +39,16 @@ namespace dqm4hep {
     class AppEventLoop {
       friend class AppTimer;
       friend class Application;
-    public:     
+    public:
+      /**
+       *  @brief  Mode enumerator.
+       *          Defines how the event loop waits for new events
+       */
+      enum Mode {
+        POLLING,    ///< Poll the event queue with a short sleep between two checks
+        BLOCKING    ///< Block on a condition variable, woken up by postEvent()
+      };
+      
       /**
        *  @brief  Constructor
        */
@@ -43,7 +61,9 @@ namespace dqm4hep {
        
       /**
        *  @brief  Post an event in the event queue. 
-       *          The event queue is sorted by event priority.
+       *          The event queue is sorted by event priority and events
+       *          of equal priority are processed in posting order.
+       *          Can be called from any thread without locking.
        *          The event pointer ownership is taken by the event loop.
        *          
        *  @param  pAppEvent the event to post
@@ -68,7 +88,8 @@ namespace dqm4hep {
       void processFunction(Function function, Args ...args);
       
       /**
-       *  @brief  Clear the event queue
+       *  @brief  Clear the event queue.
+       *          Must not be called while the event loop is running
        */
       void clear();
 
@@ -86,6 +107,19 @@ namespace dqm4hep {
        */
       bool running() const;
       
+      /**
+       *  @brief  Set the event loop mode (default BLOCKING).
+       *          Must be called before exec()
+       *
+       *  @param  loopMode the event loop mode
+       */
+      void setMode(Mode loopMode);
+      
+      /**
+       *  @brief  Get the event loop mode
+       */
+      Mode mode() const;
+      
       /**
        *  @brief  Connect a function to callback on event processing.
        *          Calling this function is thread safe.
@@ -134,24 +168,61 @@ namespace dqm4hep {
       void onException(T *pObject, void (T::*function)(AppEvent *));
       
       /**
-       *  @brief  Count the number of events of the given type currently in the event queue
-       *  
-       *  @param  eventType the event type
+       *  @brief  Get the number of events currently in the event queue.
+       *          Lock-free, read from an atomic counter
        */
-      int count(int eventType);
+      int count() const;
       
       /**
-       *  @brief  Count the number of events currently in the event queue satifying the unary predicate 
+       *  @brief  Get the number of events of the given priority currently in the event queue.
+       *          Lock-free, read from the atomic counter of the priority lane
        *  
-       *  @param  predicate the unary predicate
+       *  @param  priority the event priority, range [0,100]
+       */
+      int countPriority(int priority) const;
+      
+      /**
+       *  @brief  Get the pool of store events of type T owned by the event loop.
+       *          Events created from this pool and posted to the event loop are
+       *          given back to the pool after processing instead of being deleted.
+       *          The pool is created on first call. Calling this function is thread safe.
+       */
+      template <typename T>
+      StoreEventPool<T> &storeEventPool();
+      
+      /**
+       *  @brief  Get the total number of events created from the event pools by re-using a pooled event
        */
-      template <typename Predicate>
-      int count(Predicate predicate);
+      unsigned long poolHits() const;
+      
+      /**
+       *  @brief  Get the total number of events created from the event pools by a new allocation
+       */
+      unsigned long poolMisses() const;
       
     private:
+      using TimerClock = std::chrono::steady_clock;
+      
       void processEvent(AppEvent *pAppEvent);
       
+      /**
+       *  @brief  Release the queued events, without checking whether the loop is running
+       */
+      void releaseEvents();
+      
+      /**
+       *  @brief  Pop the next event from the highest priority non-empty lane.
+       *          Returns nullptr if the queue is empty or if a push is not yet
+       *          completed in the highest priority lane, so that an event is never 
+       *          taken before a higher priority event already posted
+       */
+      AppEvent *popEvent();
+      void markLane(int priority);
+      void unmarkLane(int priority);
+      void notifyQueue();
+      
       void timerThread();
+      void armTimer(AppTimer *timer, TimerClock::time_point deadline);
       void addTimer(AppTimer *timer);
       void startTimer(AppTimer *timer);
       void stopTimer(AppTimer *timer);
@@ -163,17 +234,77 @@ namespace dqm4hep {
       AppEventLoop(const AppEventLoop&) = delete;
       AppEventLoop(AppEventLoop&&) = delete;
       
-      struct QueueCompare {
-        bool operator()(AppEvent* lhs, AppEvent* rhs) const {
-          return lhs->priority() < rhs->priority();
+      /**
+       *  @brief  EventLane class.
+       *          Lock-free multi-producer single-consumer FIFO queue of events
+       *          sharing the same priority. The events are linked together
+       *          using the AppEvent::m_next intrusive pointer, so posting an
+       *          event never allocates and never blocks.
+       */
+      class EventLane {
+      public:
+        EventLane();
+        EventLane(const EventLane&) = delete;
+        EventLane& operator=(const EventLane&) = delete;
+        
+        /**
+         *  @brief  Push an event in the lane. Can be called from any thread
+         */
+        void push(AppEvent *pAppEvent);
+        
+        /**
+         *  @brief  Pop the oldest event of the lane. Must be called from the consumer thread only.
+         *          Returns nullptr if the lane is empty or if a push is not yet completed
+         */
+        AppEvent *pop();
+        
+      private:
+        void link(AppEvent *pAppEvent);
+        
+      public:
+        std::atomic<int>             m_count = {0};
+        
+      private:
+        AppEvent                     m_stub;
+        std::atomic<AppEvent*>       m_head;
+        AppEvent*                    m_tail;
+      };
+      
+      static constexpr int         NLanes = 101;   ///< One lane per priority level [0,100]
+      static constexpr int         NLaneWords = (NLanes + 63) / 64;   ///< The number of words of the non-empty lane bitmap
+      
+      /**
+       *  @brief  TimerEntry struct.
+       *          A timer deadline in the timer min-heap. An entry is stale if
+       *          the timer has been stopped, restarted or removed since then
+       */
+      struct TimerEntry {
+        TimerClock::time_point       m_deadline;
+        AppTimer*                    m_timer;
+        unsigned long long           m_timerId;
+      };
+      
+      struct TimerCompare {
+        bool operator()(const TimerEntry &lhs, const TimerEntry &rhs) const {
+          return lhs.m_deadline > rhs.m_deadline;
         }
       };
       
-      std::set<AppEvent*,QueueCompare>             m_eventQueue = {};
-      std::recursive_mutex                         m_queueMutex = {};
+      using EventPoolMap = std::map<std::type_index, std::unique_ptr<AppEventPool>>;
+      
+      EventPoolMap                                 m_eventPools = {};
+      mutable std::mutex                           m_poolMutex = {};
+      std::array<EventLane,NLanes>                 m_lanes = {};
+      std::array<std::atomic<uint64_t>,NLaneWords> m_activeLanes = {};   ///< One bit per non-empty lane, to pop without scanning all lanes
+      std::atomic<int>                             m_nQueuedEvents = {0};
+      std::atomic<bool>                            m_waiting = {false};
+      std::mutex                                   m_queueMutex = {};
+      std::condition_variable                      m_queueCondition = {};
+      std::atomic<Mode>                            m_mode = {BLOCKING};
       std::recursive_mutex                         m_eventMutex = {};
       std::recursive_mutex                         m_exceptionMutex = {};
-      std::recursive_mutex                         m_timerMutex = {};
+      std::mutex                                   m_timerMutex = {};
+      std::condition_variable                      m_timerCondition = {};
       core::Signal<AppEvent *>                     m_onEventSignal = {};
       core::Signal<AppEvent *>                     m_onExceptionSignal = {};
       std::atomic<bool>                            m_running = {false};
@@ -182,6 +313,9 @@ namespace dqm4hep {
       std::thread                                  m_timerThread = {};
       std::atomic_bool                             m_timerStopFlag = {false};
       std::set<AppTimer*>                          m_timers = {};
+      std::vector<TimerEntry>                      m_timerHeap = {};
+      bool                                         m_timersChanged = {false};
+      unsigned long long                           m_lastTimerId = {0};
     };
     
     //-------------------------------------------------------------------------------------------------
@@ -219,10 +353,15 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
-    template <typename Predicate>
-    inline int AppEventLoop::count(Predicate predicate) {
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
-      return std::count_if(m_eventQueue.begin(), m_eventQueue.begin(), predicate);
+    template <typename T>
+    inline StoreEventPool<T> &AppEventLoop::storeEventPool() {
+      std::lock_guard<std::mutex> lock(m_poolMutex);
+      auto &pool = m_eventPools[std::type_index(typeid(T))];
+      
+      if(nullptr == pool) {
+        pool.reset(new StoreEventPool<T>());
+      }
+      return *static_cast<StoreEventPool<T>*>(pool.get());
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -0,0 +1,210 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_APPEVENTPOOL_H
+#define DQM4HEP_APPEVENTPOOL_H
+
+// -- dqm4hep headers
+#include "dqm4hep/AppEvent.h"
+#include "dqm4hep/AppEvents.h"
+
+// -- std headers
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  AppEventPool class.
+     *          Base class of event pools. An event created by a pool
+     *          is given back to it by the event loop after processing
+     *          instead of being deleted.
+     */
+    class AppEventPool {
+    public:
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  capacity the maximum number of free events kept in the pool
+       */
+      AppEventPool(unsigned int capacity);
+
+      /**
+       *  @brief  Destructor
+       */
+      virtual ~AppEventPool();
+
+      /**
+       *  @brief  Give back an event to the pool, for re-use.
+       *          The event must have been created by this pool
+       *
+       *  @param  pAppEvent the event to recycle
+       */
+      virtual void recycle(AppEvent *pAppEvent) = 0;
+
+      /**
+       *  @brief  Get the number of events created by re-using a pooled event
+       */
+      unsigned long hits() const;
+
+      /**
+       *  @brief  Get the number of events created by a new allocation
+       */
+      unsigned long misses() const;
+
+      /**
+       *  @brief  Get the maximum number of free events kept in the pool
+       */
+      unsigned int capacity() const;
+
+      /**
+       *  @brief  Release an event: give it back to its pool if it has one, delete it otherwise
+       *
+       *  @param  pAppEvent the event to release
+       */
+      static void release(AppEvent *pAppEvent);
+
+    protected:
+      /**
+       *  @brief  Mark a newly allocated event as owned by this pool
+       *
+       *  @param  pAppEvent the event to adopt
+       */
+      void adopt(AppEvent *pAppEvent);
+
+      /**
+       *  @brief  Re-initialize the base event properties of a pooled event
+       *
+       *  @param  pAppEvent the event to reset
+       *  @param  type the new event type
+       */
+      void reset(AppEvent *pAppEvent, int type);
+
+    protected:
+      std::atomic<unsigned long>      m_hits = {0};
+      std::atomic<unsigned long>      m_misses = {0};
+      const unsigned int              m_capacity;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  StoreEventPool class.
+     *          Recycles StoreEvent<T> instances. The data type T
+     *          must be default constructible: the data of a recycled
+     *          event is reset so that it doesn't hold its resources
+     *          while waiting in the pool.
+     */
+    template <typename T>
+    class StoreEventPool : public AppEventPool {
+    public:
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  capacity the maximum number of free events kept in the pool
+       */
+      StoreEventPool(unsigned int capacity = 1024);
+
+      /**
+       *  @brief  Destructor
+       */
+      ~StoreEventPool();
+
+      /**
+       *  @brief  Create a store event, re-using a pooled event if available.
+       *          The event ownership is given to the caller, usually by
+       *          posting the event to the event loop right after.
+       *
+       *  @param  type the event type
+       *  @param  data the data to store
+       */
+      StoreEvent<T> *create(int type, T data);
+
+      void recycle(AppEvent *pAppEvent) override;
+
+    private:
+      StoreEventPool(const StoreEventPool&) = delete;
+      StoreEventPool& operator=(const StoreEventPool&) = delete;
+
+      std::mutex                        m_mutex = {};
+      std::vector<StoreEvent<T>*>       m_freeEvents = {};
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StoreEventPool<T>::StoreEventPool(unsigned int cap) :
+      AppEventPool(cap) {
+      m_freeEvents.reserve(cap);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StoreEventPool<T>::~StoreEventPool() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for(auto event : m_freeEvents) {
+        delete event;
+      }
+      m_freeEvents.clear();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StoreEvent<T> *StoreEventPool<T>::create(int type, T data) {
+      StoreEvent<T> *event = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(not m_freeEvents.empty()) {
+          event = m_freeEvents.back();
+          m_freeEvents.pop_back();
+        }
+      }
+      if(nullptr == event) {
+        ++m_misses;
+        event = new StoreEvent<T>(type, std::move(data));
+        adopt(event);
+        return event;
+      }
+      ++m_hits;
+      reset(event, type);
+      event->m_data = std::move(data);
+      return event;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void StoreEventPool<T>::recycle(AppEvent *pAppEvent) {
+      StoreEvent<T> *event = static_cast<StoreEvent<T>*>(pAppEvent);
+      // release the stored data now
+      event->m_data = T();
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_freeEvents.size() < m_capacity) {
+          m_freeEvents.push_back(event);
+          return;
+        }
+      }
+      // pool is full
+      delete event;
+    }
+
+  }
+
+}
+
+#endif  //  DQM4HEP_APPEVENTPOOL_H
@@ -62,8 +62,12 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
     
+    template <typename T>
+    class StoreEventPool;
+    
     template <typename T>
     class StoreEvent : public AppEvent {
+      friend class StoreEventPool<T>;
     public:
       StoreEvent(int type, T data);
       const T &data() const;
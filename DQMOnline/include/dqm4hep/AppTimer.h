@@ -98,6 +98,8 @@ namespace dqm4hep {
       std::atomic_bool             m_active = {false};
       /// The time point when the timer was started
       core::time::point            m_startTime = {};
+      /// The id of the current timer run in the event loop, 0 if not armed
+      unsigned long long           m_timerId = {0};
     };
   
   }
@@ -230,6 +230,15 @@ namespace dqm4hep {
       template <typename Operation>
       void sendRequest(const std::string &name, const net::Buffer &request, Operation operation);
       
+      /**
+       *  @brief  Notify a server when the application exits, so that the server 
+       *          can release what it holds for the application (see AppEvent::CLIENT_EXIT).
+       *          See net::Client class.
+       *
+       *  @param  serverName the server name to notify
+       */
+      void notifyServerOnExit(const std::string &serverName);
+      
       /**
        *  @brief  Subscribe to service. On service update, the content is posted
        *          using the postEvent() function with a ServiceUpdateEvent event.
@@ -433,11 +442,13 @@ namespace dqm4hep {
       private:
         using ContentSignal = core::Signal<const net::Buffer&>;
         using RequestSignal = core::Signal<const net::Buffer&, net::Buffer&>;
+        using PendingCounterPtr = std::shared_ptr<std::atomic_int>;
         
         AppEventLoop           &m_eventLoop;
         const std::string       m_name = {""};
         const int               m_priority = {50};
         const int               m_maxNEvents = {std::numeric_limits<int>::max()};
+        PendingCounterPtr       m_nPendingEvents = {std::make_shared<std::atomic_int>(0)};
         ContentSignal           m_sendContentSignal = {};
         RequestSignal           m_sendRequestSignal = {};
       };
@@ -511,7 +522,7 @@ namespace dqm4hep {
       object["appName"] = this->name();
       object["time"] = core::time::asTime(core::time::now());
       dqm_debug( "Sending app stat : \n'{0}'", object.dump() );
-      m_client.sendCommand(OnlineRoutes::OnlineManager::appStats(), object.dump());
+      m_client.sendCommand(OnlineRoutes::OnlineManager::collectAppStat(), object.dump());
     }
 
     //-------------------------------------------------------------------------------------------------
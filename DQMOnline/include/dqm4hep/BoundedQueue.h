@@ -0,0 +1,194 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_BOUNDEDQUEUE_H
+#define DQM4HEP_BOUNDEDQUEUE_H
+
+// -- std headers
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  BoundedQueue class.
+     *          Lock-free fixed size queue (D. Vyukov's bounded queue algorithm).
+     *          Each slot carries a sequence number telling whether it can be
+     *          written or read, so that pushing and popping never allocate
+     *          and never block. Typically used with one producer and one
+     *          consumer thread, the producer being allowed to pop too (e.g
+     *          to drop the oldest element when the queue is full).
+     *          Elements are swapped in and out of the queue, so that the
+     *          resources they hold (e.g a string capacity) are recycled.
+     */
+    template <typename T>
+    class BoundedQueue {
+    public:
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  capacity the maximum number of elements in the queue
+       */
+      BoundedQueue(std::size_t capacity);
+      BoundedQueue(const BoundedQueue&) = delete;
+      BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+      /**
+       *  @brief  Push an element in the queue. On success, the value is
+       *          swapped with the content of a free slot
+       *
+       *  @param  value the value to push
+       *  @return false if the queue is full
+       */
+      bool push(T &value);
+
+      /**
+       *  @brief  Pop the oldest element of the queue. On success, the value
+       *          is swapped with the content of the slot
+       *
+       *  @param  value the value to receive
+       *  @return false if the queue is empty
+       */
+      bool pop(T &value);
+
+      /**
+       *  @brief  Get the maximum number of elements in the queue
+       */
+      std::size_t capacity() const;
+
+      /**
+       *  @brief  Get the number of elements in the queue.
+       *          Approximate if other threads are pushing or popping
+       */
+      std::size_t size() const;
+
+      /**
+       *  @brief  Whether the queue is empty
+       */
+      bool empty() const;
+
+    private:
+      /**
+       *  @brief  Cell struct
+       */
+      struct Cell {
+        std::atomic<std::size_t>     m_sequence = {0};        ///< The slot sequence number
+        T                            m_data = {};             ///< The slot data
+      };
+
+      const std::size_t              m_capacity;              ///< The queue capacity
+      std::unique_ptr<Cell[]>        m_cells;                 ///< The queue slots
+      std::atomic<std::size_t>       m_pushPosition = {0};    ///< The next position to push at
+      std::atomic<std::size_t>       m_popPosition = {0};     ///< The next position to pop from
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline BoundedQueue<T>::BoundedQueue(std::size_t cap) :
+      m_capacity(cap > 0 ? cap : 1),
+      m_cells(new Cell[m_capacity]) {
+      for(std::size_t i=0 ; i<m_capacity ; i++) {
+        m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool BoundedQueue<T>::push(T &value) {
+      std::size_t position = m_pushPosition.load(std::memory_order_relaxed);
+
+      while(true) {
+        Cell &cell(m_cells[position % m_capacity]);
+        const std::size_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        // slot is free, try to claim it
+        if(0 == difference) {
+          if(m_pushPosition.compare_exchange_weak(position, position+1, std::memory_order_relaxed)) {
+            std::swap(cell.m_data, value);
+            cell.m_sequence.store(position+1, std::memory_order_release);
+            return true;
+          }
+        }
+        // slot still holds the element pushed one round before: full
+        else if(difference < 0) {
+          return false;
+        }
+        // another producer claimed this position
+        else {
+          position = m_pushPosition.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool BoundedQueue<T>::pop(T &value) {
+      std::size_t position = m_popPosition.load(std::memory_order_relaxed);
+
+      while(true) {
+        Cell &cell(m_cells[position % m_capacity]);
+        const std::size_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position+1);
+
+        // slot is filled, try to claim it
+        if(0 == difference) {
+          if(m_popPosition.compare_exchange_weak(position, position+1, std::memory_order_relaxed)) {
+            std::swap(cell.m_data, value);
+            cell.m_sequence.store(position+m_capacity, std::memory_order_release);
+            return true;
+          }
+        }
+        // slot not filled yet: empty
+        else if(difference < 0) {
+          return false;
+        }
+        // another consumer claimed this position
+        else {
+          position = m_popPosition.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline std::size_t BoundedQueue<T>::capacity() const {
+      return m_capacity;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline std::size_t BoundedQueue<T>::size() const {
+      const std::size_t pushPosition = m_pushPosition.load(std::memory_order_acquire);
+      const std::size_t popPosition = m_popPosition.load(std::memory_order_acquire);
+      return (pushPosition > popPosition) ? (pushPosition - popPosition) : 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool BoundedQueue<T>::empty() const {
+      return (0 == size());
+    }
+
+  }
+
+}
+
+#endif  //  DQM4HEP_BOUNDEDQUEUE_H
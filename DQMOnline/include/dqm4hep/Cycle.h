@@ -17,6 +17,11 @@
 
 // -- std headers
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 
 namespace dqm4hep {
 
@@ -153,11 +158,18 @@ namespace dqm4hep {
       bool running() const;
       
     private:
+      using CycleClock = std::chrono::steady_clock;
+      
       /**
        *  @brief  The main cycle loop thread
        */
       void cycleLoop();
       
+      /**
+       *  @brief  Wake up the cycle thread to re-evaluate the cycle conditions
+       */
+      void notifyCycle();
+      
       /**
        *  @brief  Called at end of cycle. 
        *          Fill the end of cycle conditions and post an event in the event loop
@@ -191,8 +203,16 @@ namespace dqm4hep {
       std::atomic_uint                 m_currentCounter = {0};
       /// The end of cycle event priority in the event loop 
       std::atomic_int                  m_eventPriority = {60};
-      /// The last time point when the increement method was called
-      core::time::point                m_lastCounterIncrement = {};
+      /// The last time point when the increment method was called (unit CycleClock ticks)
+      std::atomic<CycleClock::rep>     m_lastCounterIncrement = {0};
+      /// The mutex protecting the cycle state changes
+      std::mutex                       m_mutex = {};
+      /// The condition variable waking up the cycle thread
+      std::condition_variable          m_condition = {};
+      /// The promise fulfilled at the end of the current cycle
+      std::promise<void>               m_endPromise = {};
+      /// The future of the current cycle end, waited in forceStopCycle()
+      std::shared_future<void>         m_endFuture = {};
     };
 
   }
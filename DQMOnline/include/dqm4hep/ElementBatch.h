@@ -0,0 +1,140 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_ELEMENTBATCH_H
+#define DQM4HEP_ELEMENTBATCH_H
+
+// -- dqm4hep headers
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/OnlineElement.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  ElementBatch class.
+     *          Packs several serialized monitor elements in a single frame,
+     *          sent in one go from a module to a monitor element collector
+     *          and from a collector to its clients.
+     *          The frame layout is:
+     *            - the batch marker (string)
+     *            - the number of elements (int)
+     *            - for each element: the module name, path, name and type (strings),
+     *              the element size (int) followed by the serialized element (see OnlineElement::write())
+     *          Each element is serialized on its own, so that a collector can keep or
+     *          re-pack it in an other batch without reading it
+     */
+    class ElementBatch {
+    public:
+      /**
+       *  @brief  Frame struct.
+       *          A serialized element inside a raw buffer, with its identifiers
+       */
+      struct Frame {
+        std::string           m_moduleName = {""};        ///< The name of the module that has booked the element
+        std::string           m_path = {""};              ///< The element path
+        std::string           m_name = {""};              ///< The element name
+        std::string           m_type = {""};              ///< The element type (class name)
+        const char           *m_buffer = {nullptr};       ///< The serialized element, pointing in the raw buffer
+        unsigned int          m_size = {0};               ///< The serialized element size
+      };
+
+      /**
+       *  @brief  Constructor
+       */
+      ElementBatch();
+      ElementBatch(const ElementBatch&) = delete;
+      ElementBatch& operator=(const ElementBatch&) = delete;
+
+      /**
+       *  @brief  Serialize a monitor element and append it to the batch
+       *
+       *  @param  moduleName the name of the module that has booked the element
+       *  @param  element the monitor element to serialize
+       */
+      core::StatusCode addElement(const std::string &moduleName, const OnlineElement &element);
+
+      /**
+       *  @brief  Append an already serialized element to the batch (see readFrames())
+       *
+       *  @param  frame the serialized element frame
+       */
+      void addElement(const Frame &frame);
+
+      /**
+       *  @brief  Remove all elements from the batch
+       */
+      void clear();
+
+      /**
+       *  @brief  Whether the batch contains no element
+       */
+      bool empty() const;
+
+      /**
+       *  @brief  Get the number of elements in the batch
+       */
+      unsigned int nElements() const;
+
+      /**
+       *  @brief  Get the frame raw buffer
+       */
+      const char *buffer() const;
+
+      /**
+       *  @brief  Get the frame size (unit bytes)
+       */
+      unsigned int size() const;
+
+      /**
+       *  @brief  Split a raw buffer in serialized elements, without reading them.
+       *          The frames point in the raw buffer and are appended to the frame list
+       *
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       *  @param  frames the frame list to receive
+       */
+      static core::StatusCode readFrames(const char *buffer, unsigned int size, std::vector<Frame> &frames);
+
+      /**
+       *  @brief  Read the monitor elements from a raw buffer.
+       *          The elements are appended to the element list
+       *
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       *  @param  elements the element list to receive
+       */
+      static core::StatusCode readElements(const char *buffer, unsigned int size, OnlineElementPtrList &elements);
+
+    private:
+      /**
+       *  @brief  Append a serialized element to the frame and update the number of elements
+       */
+      void writeElement(const std::string &moduleName, const std::string &path, const std::string &name,
+        const std::string &type, const char *buffer, unsigned int size);
+
+    private:
+      static const std::string            m_marker;                                   ///< The batch frame marker
+      TBufferFile                         m_buffer = {TBuffer::kWrite, 64*1024};      ///< The frame raw buffer
+      TBufferFile                         m_elementBuffer = {TBuffer::kWrite, 16*1024};  ///< The buffer to serialize a single element
+      Int_t                               m_nElements = {0};                          ///< The number of elements in the batch
+      Int_t                               m_nElementsOffset = {0};                    ///< The offset of the number of elements in the frame
+    };
+
+  }
+
+}
+
+#endif  //  DQM4HEP_ELEMENTBATCH_H
@@ -0,0 +1,180 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics 
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_EVENTBATCH_H
+#define DQM4HEP_EVENTBATCH_H
+
+// -- dqm4hep headers
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/EventStreamer.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /** 
+     *  @brief  EventBatch class.
+     *          Packs several serialized events in a single frame, 
+     *          sent in one go from an event source to a collector 
+     *          and from a collector to its subscribers.
+     *          The frame layout is:
+     *            - the batch marker (string), in place of the event header of a single event frame
+     *            - the number of events (int)
+     *            - for each event: the event size (int) followed by the serialized event
+     */
+    class EventBatch {
+    public:
+      /**
+       *  @brief  Frame struct.
+       *          A serialized event inside a raw buffer, with its header
+       */
+      struct Frame {
+        core::EventHeader     m_header = {};              ///< The event header
+        const char           *m_buffer = {nullptr};       ///< The serialized event, pointing in the raw buffer
+        unsigned int          m_size = {0};               ///< The serialized event size
+      };
+      
+      /**
+       *  @brief  Constructor
+       */
+      EventBatch();
+      EventBatch(const EventBatch&) = delete;
+      EventBatch& operator=(const EventBatch&) = delete;
+      
+      /**
+       *  @brief  Append a serialized event to the batch
+       *  
+       *  @param  buffer the serialized event
+       *  @param  size the serialized event size
+       */
+      void addEvent(const char *buffer, unsigned int size);
+      
+      /**
+       *  @brief  Remove all events from the batch
+       */
+      void clear();
+      
+      /**
+       *  @brief  Whether the batch contains no event
+       */
+      bool empty() const;
+      
+      /**
+       *  @brief  Get the number of events in the batch
+       */
+      unsigned int nEvents() const;
+      
+      /**
+       *  @brief  Get the frame raw buffer
+       */
+      const char *buffer() const;
+      
+      /**
+       *  @brief  Get the frame size (unit bytes)
+       */
+      unsigned int size() const;
+      
+      /**
+       *  @brief  Get the time at which the first event was added to the batch
+       */
+      const core::time::point &firstEventTime() const;
+      
+      /**
+       *  @brief  Whether the raw buffer is a batch frame or a single event frame
+       *  
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       */
+      static bool isBatch(const char *buffer, unsigned int size);
+      
+      /**
+       *  @brief  Get the number of events in the raw buffer.
+       *          Returns 1 if the buffer is a single event frame
+       *  
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       */
+      static unsigned int nEvents(const char *buffer, unsigned int size);
+      
+      /**
+       *  @brief  Read the events from a raw buffer using the event streamer.
+       *          The buffer can be either a batch frame or a single event frame.
+       *          The events are appended to the event list
+       *  
+       *  @param  streamer the event streamer
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       *  @param  events the event list to receive
+       */
+      static core::StatusCode readEvents(core::EventStreamer &streamer, const char *buffer, unsigned int size, core::EventList &events);
+      
+      /**
+       *  @brief  Read the events from a raw buffer using the event streamer and 
+       *          a user provided input buffer device, to avoid creating one per call.
+       *          See the function above
+       *  
+       *  @param  streamer the event streamer
+       *  @param  inputBuffer the input buffer device (read mode)
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       *  @param  events the event list to receive
+       */
+      static core::StatusCode readEvents(core::EventStreamer &streamer, TBuffer &inputBuffer, const char *buffer, unsigned int size, core::EventList &events);
+      
+      /**
+       *  @brief  Read the event headers from a raw buffer, without decoding the event payloads.
+       *          The buffer can be either a batch frame or a single event frame.
+       *          The headers are appended to the header list. Events written with the 
+       *          older frame format have no header and make the call fail
+       *  
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       *  @param  headers the header list to receive
+       */
+      static core::StatusCode readHeaders(const char *buffer, unsigned int size, std::vector<core::EventHeader> &headers);
+      
+      /**
+       *  @brief  Split a raw buffer in serialized events and read their headers, without 
+       *          decoding the event payloads. The frames point in the raw buffer and can be 
+       *          re-packed in an other batch (see addEvent()). Fails like readHeaders()
+       *  
+       *  @param  buffer the raw buffer
+       *  @param  size the raw buffer size
+       *  @param  frames the frame list to receive
+       */
+      static core::StatusCode readFrames(const char *buffer, unsigned int size, std::vector<Frame> &frames);
+      
+    private:
+      /**
+       *  @brief  Read the batch header, if any
+       *  
+       *  @param  buffer the buffer to read from
+       *  @param  nBatchEvents the number of events in the batch to receive
+       *  @return whether the buffer is a batch frame
+       */
+      static bool readHeader(TBuffer &buffer, Int_t &nBatchEvents);
+      
+    private:
+      static const std::string            m_marker;                          ///< The batch frame marker
+      TBufferFile                         m_buffer = {TBuffer::kWrite, 64*1024};  ///< The frame raw buffer
+      Int_t                               m_nEvents = {0};                   ///< The number of events in the batch
+      Int_t                               m_nEventsOffset = {0};             ///< The offset of the number of events in the frame
+      core::time::point                   m_firstEventTime = {};             ///< The time at which the first event was added
+    };
+
+  }
+
+} 
+
+#endif  //  DQM4HEP_EVENTBATCH_H
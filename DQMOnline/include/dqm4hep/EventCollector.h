@@ -15,6 +15,10 @@
 #include "dqm4hep/Internal.h"
 #include "dqm4hep/StatusCodes.h"
 #include "dqm4hep/Application.h"
+#include "dqm4hep/EventBatch.h"
+#include "dqm4hep/EventCompression.h"
+#include "dqm4hep/EventHeader.h"
+#include "dqm4hep/EventSubscription.h"
 
 // -- tclap headers
 #include "tclap/CmdLine.h"
@@ -53,6 +57,11 @@ namespace dqm4hep {
       void handleClientExit(StoreEvent<int> *event);
       void handleCollectEvent(const net::Buffer &buffer);
       void handleClientUnregistration(const net::Buffer &buffer);
+      void collectCompressionStats(const net::Buffer &buffer);
+      void handleSubscription(const net::Buffer &request, net::Buffer &response);
+      void handleUnsubscription(const net::Buffer &buffer);
+      void sendEventUpdate(const std::string &sourceName, net::Service *service, net::Service *selectedService, const char *buffer, std::size_t size);
+      void flushLatestUpdates();
       void handleEventRequest(const net::Buffer &request, net::Buffer &response);
       void sendStatsTimer10();
       void sendStatsTimer60();
@@ -74,20 +83,48 @@ namespace dqm4hep {
         core::StringMap      m_hostInfo = {};
         net::Buffer          m_buffer = {};
         net::Service        *m_eventService = {nullptr};
+        net::Service        *m_selectedEventService = {nullptr};
+        core::EventCompression m_compression = {};
       };
       
       typedef std::map<std::string, SourceInfo> SourceInfoMap;
+      typedef std::map<int, EventSubscription> SubscriptionMap;
+      typedef std::map<std::string, SubscriptionMap> SourceSubscriptionMap;
+      typedef std::map<std::vector<bool>, std::vector<int>> FilteredClientMap;
+      typedef std::map<int, std::string> PendingUpdateMap;
+      typedef std::map<std::string, PendingUpdateMap> SourcePendingUpdateMap;
+      
+      void dispatchEventUpdate(const std::string &sourceName, SubscriptionMap &subscriptions, net::Service *service, const char *buffer, std::size_t size, bool flushPending);
       
       std::shared_ptr<TCLAP::CmdLine>     m_cmdLine = nullptr;
       SourceInfoMap                       m_sourceInfoMap = {};
+      SourceSubscriptionMap               m_subscriptions = {};
+      std::vector<int>                    m_clientIds = {};
+      std::vector<EventBatch::Frame>      m_eventFrames = {};
+      std::vector<bool>                   m_matchedFrames = {};
+      FilteredClientMap                   m_filteredClientIds = {};
+      EventBatch                          m_filteredBatch;
+      SourcePendingUpdateMap              m_pendingUpdates = {};
+      std::set<std::string>               m_unfilterableSources = {};
+      net::BufferPool                     m_bufferPool = {64};
       core::time::point                   m_lastStatCall10 = {};
       core::time::point                   m_lastStatCall60 = {};
       unsigned int                        m_nCollectedEvents10 = {0};
       unsigned int                        m_nCollectedEvents60 = {0};
       unsigned int                        m_nCollectedBytes10 = {0};
       unsigned int                        m_nCollectedBytes60 = {0};
+      std::vector<core::EventHeader>      m_eventHeaders = {};
+      unsigned long                       m_nCompressedEvents10 = {0};
+      unsigned long                       m_nCompressedEvents60 = {0};
+      unsigned long                       m_nRawPayloadBytes10 = {0};
+      unsigned long                       m_nRawPayloadBytes60 = {0};
+      unsigned long                       m_nCompressedPayloadBytes10 = {0};
+      unsigned long                       m_nCompressedPayloadBytes60 = {0};
+      unsigned long                       m_compressionTime10 = {0};
+      unsigned long                       m_compressionTime60 = {0};
       AppTimer*                           m_statsTimer10 = {nullptr};
       AppTimer*                           m_statsTimer60 = {nullptr};
+      AppTimer*                           m_latestTimer = {nullptr};
     };
 
   }
@@ -16,11 +16,11 @@
 #include "dqm4hep/StatusCodes.h"
 #include "dqm4hep/EventStreamer.h"
 #include "dqm4hep/Client.h"
-
-// -- root headers
-#include <TBufferFile.h>
+#include "dqm4hep/EventDecoder.h"
+#include "dqm4hep/EventSubscription.h"
 
 // -- std headers
+#include <memory>
 #include <mutex>
 
 namespace dqm4hep {
@@ -66,6 +66,19 @@ namespace dqm4hep {
        */
       void startEventUpdates(const std::string &source);
       
+      /**
+       *  @brief  Instruct the event collector to send the event updates of a given 
+       *          source, filtered, prescaled or rate limited on the collector side (see EventSubscription).
+       *          The subscription mode is declared to the collector before subscribing.
+       *          Selective subscriptions are received on a dedicated collector service,
+       *          see OnlineRoutes::EventCollector::selectedEventUpdate(). If the collector
+       *          doesn't acknowledge the subscription, all the event updates are received
+       *
+       *  @param  source the source name
+       *  @param  subscription how to receive the event updates
+       */
+      void startEventUpdates(const std::string &source, const EventSubscription &subscription);
+      
       /**
        *  @brief  Instruct the event collector to stop sending event
        */
@@ -79,9 +92,47 @@ namespace dqm4hep {
       void startEventUpdates();
       void stopEventUpdates();
       
+      /**
+       *  @brief  Decode the received events on a pool of worker threads instead of 
+       *          the network thread (see EventDecoder). With nThreads = 0, events are 
+       *          decoded on the network thread (default). With more than one thread, 
+       *          the events may be received out of order.
+       *          Must be called before starting the event updates
+       *
+       *  @param  nThreads the number of decoding threads
+       *  @param  queueSize the maximum number of received frames waiting for decoding
+       */
+      void setDecodingThreads(unsigned int nThreads, unsigned int queueSize);
+      
     private:
       void setUpdateMode(const std::string &source, bool receiveUpdates);
-      core::EventPtr readEvent(const net::Buffer &buffer);
+      
+      /**
+       *  @brief  Declare the subscription mode of a source to the collector
+       *  
+       *  @param  source the source name
+       *  @param  subscription the subscription mode
+       *
+       *  @return whether the collector has acknowledged the subscription
+       */
+      bool declareSubscription(const std::string &source, const EventSubscription &subscription);
+      
+      /**
+       *  @brief  Read the events from a buffer received from the collector.
+       *          The buffer is either a single event frame or a batch frame
+       *  
+       *  @param  buffer the buffer to read
+       *  @param  events the event list to receive
+       */
+      void readEvents(const net::Buffer &buffer, core::EventList &events);
+      
+      /**
+       *  @brief  Intern the source name, so that the source id of 
+       *          the received event headers can be resolved
+       *  
+       *  @param  source the source name
+       */
+      void internSourceName(const std::string &source);
 
     private:
       using EventUpdateSignal = core::Signal<core::EventPtr>;
@@ -92,6 +143,8 @@ namespace dqm4hep {
       struct SourceInfo {
         EventUpdateSignal       m_eventUpdateSignal = {};      ///< The signal to process on event update
         EventCollectorClient   *m_collectorClient = {nullptr};
+        EventSubscription       m_subscription = {};           ///< How to receive the event updates
+        std::string             m_updateService = {""};        ///< The subscribed update service, empty if not receiving updates
         void receiveEvent(const net::Buffer &buffer);
       };
       friend struct SourceInfo;
@@ -100,10 +153,11 @@ namespace dqm4hep {
     private:
       std::string                         m_collectorName = {""};
       SourceInfoMap                       m_sourceInfoMap = {};
+      std::unique_ptr<EventDecoder>       m_decoder = {nullptr};
       net::Client                         m_client = {};
       mutable std::recursive_mutex        m_mutex = {};
       core::EventStreamer                 m_eventStreamer = {};
-      TBufferFile                         m_buffer = {TBuffer::kRead};
+      bool                                m_notifyOnExit = {false};
     };
     
     //-------------------------------------------------------------------------------------------------
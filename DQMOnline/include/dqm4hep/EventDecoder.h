@@ -0,0 +1,115 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics 
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_EVENTDECODER_H
+#define DQM4HEP_EVENTDECODER_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Signal.h>
+#include <dqm4hep/BoundedQueue.h>
+
+// -- std headers
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /** 
+     *  @brief  EventDecoder class.
+     *          Deserializes event frames (single event or batch, see EventBatch) 
+     *          on a pool of worker threads, each with its own event streamer and 
+     *          input buffer device. The raw frames are copied in a bounded queue,
+     *          so that the network thread only pays for a memcpy. The decoded events
+     *          are emitted from the worker threads with the signal given with the frame.
+     *          With more than one worker, the events may be emitted out of order.
+     */
+    class EventDecoder {
+    public:
+      typedef core::Signal<core::EventPtr> EventSignal;
+      
+      /**
+       *  @brief  Constructor. Starts the worker threads
+       *
+       *  @param  nThreads the number of worker threads
+       *  @param  queueSize the maximum number of frames waiting for decoding
+       */
+      EventDecoder(unsigned int nThreads, unsigned int queueSize);
+      EventDecoder(const EventDecoder&) = delete;
+      EventDecoder& operator=(const EventDecoder&) = delete;
+      
+      /**
+       *  @brief  Destructor. Stops the worker threads. The frames still in the queue are not decoded
+       */
+      ~EventDecoder();
+      
+      /**
+       *  @brief  Copy a raw frame in the queue for decoding
+       *
+       *  @param  buffer the raw frame
+       *  @param  size the raw frame size
+       *  @param  signal the signal to emit the decoded events with
+       *  @return false if the queue is full and the frame was dropped
+       */
+      bool push(const char *buffer, size_t size, EventSignal &signal);
+      
+      /**
+       *  @brief  Get the number of worker threads
+       */
+      unsigned int nThreads() const;
+      
+      /**
+       *  @brief  Get the total number of decoded events
+       */
+      unsigned long nDecodedEvents() const;
+      
+      /**
+       *  @brief  Get the total number of frames dropped because the queue was full
+       */
+      unsigned long nDroppedFrames() const;
+      
+    private:
+      /**
+       *  @brief  The worker thread function
+       */
+      void workerLoop();
+      
+      /**
+       *  @brief  Frame struct. A raw frame waiting for decoding
+       */
+      struct Frame {
+        std::string         m_buffer = {};         ///< The raw frame copy
+        EventSignal        *m_signal = {nullptr};  ///< The signal to emit the decoded events with
+      };
+      
+    private:
+      BoundedQueue<Frame>                 m_queue;                       ///< The queue of frames to decode
+      Frame                               m_pushedFrame = {};            ///< The frame to push (producer side)
+      std::mutex                          m_pushMutex = {};              ///< The mutex protecting the producer side frame
+      std::vector<std::thread>            m_workers = {};                ///< The worker threads
+      std::atomic_bool                    m_stopFlag = {false};          ///< Whether to stop the workers
+      std::atomic<unsigned int>           m_nWaitingWorkers = {0};       ///< The number of workers waiting for frames
+      std::mutex                          m_mutex = {};                  ///< The mutex for the workers wake up
+      std::condition_variable             m_condition = {};              ///< The condition to wake up the workers
+      std::atomic<unsigned long>          m_nDecodedEvents = {0};        ///< The total number of decoded events
+      std::atomic<unsigned long>          m_nDroppedFrames = {0};        ///< The total number of dropped frames
+    };
+
+  }
+
+} 
+
+#endif  //  DQM4HEP_EVENTDECODER_H
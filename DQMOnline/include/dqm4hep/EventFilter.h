@@ -0,0 +1,143 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_EVENTFILTER_H
+#define DQM4HEP_EVENTFILTER_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/EventHeader.h>
+
+// -- std headers
+#include <string>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  EventFilter class.
+     *          A filter expression evaluated on the event headers (see core::EventHeader),
+     *          so that the events can be selected without decoding their payload.
+     *          The expression is a list of conditions joined by "&&" (or "and"), all of
+     *          which have to be fulfilled. A condition is "field op value" or "field in (v1, v2, ...)"
+     *          with op one of ==, !=, <, <=, >, >= and field one of:
+     *            - type: the event type, a number or unknown, raw, reconstructed, physics, custom
+     *            - source: the event source name (==, != and in only)
+     *            - number: the event number, optionally as "number % n"
+     *            - run: the run number
+     *            - time: the event time stamp (unit s since epoch)
+     *            - age: the time elapsed since the event time stamp (unit s)
+     *          Example: "type == raw && number % 10 == 0 && age < 5".
+     *          An empty expression selects all the events
+     */
+    class EventFilter {
+    public:
+      /**
+       *  @brief  Default constructor. Select all the events
+       */
+      EventFilter() = default;
+
+      /**
+       *  @brief  Parse a filter expression. On failure, the filter is left unchanged
+       *
+       *  @param  expression the filter expression
+       *  @param  message an error message filled on failure
+       */
+      core::StatusCode parse(const std::string &expression, std::string &message);
+
+      /**
+       *  @brief  Get the filter expression
+       */
+      const std::string &expression() const;
+
+      /**
+       *  @brief  Whether the filter selects all the events
+       */
+      bool empty() const;
+
+      /**
+       *  @brief  Whether the event matches the filter
+       *
+       *  @param  header the event header
+       *  @param  now the current time, used for the event age
+       */
+      bool match(const core::EventHeader &header, const core::time::point &now) const;
+
+    private:
+      /**
+       *  @brief  Field enum
+       */
+      enum Field {
+        TYPE,
+        SOURCE,
+        NUMBER,
+        RUN,
+        TIME,
+        AGE
+      };
+
+      /**
+       *  @brief  Operator enum
+       */
+      enum Operator {
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+        IN
+      };
+
+      /**
+       *  @brief  Condition struct
+       */
+      struct Condition {
+        Field                 m_field = {TYPE};           ///< The header field
+        Operator              m_operator = {EQUAL};       ///< The comparison operator
+        uint32_t              m_modulo = {0};             ///< The modulo applied on the event number, 0 if none
+        std::vector<double>   m_values = {};              ///< The values to compare with
+      };
+
+      /**
+       *  @brief  Get the value of a header field
+       *
+       *  @param  condition the condition to evaluate
+       *  @param  header the event header
+       *  @param  now the current time
+       */
+      static double fieldValue(const Condition &condition, const core::EventHeader &header, const core::time::point &now);
+
+    private:
+      std::string               m_expression = {};        ///< The filter expression
+      std::vector<Condition>    m_conditions = {};        ///< The parsed conditions
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    inline const std::string &EventFilter::expression() const {
+      return m_expression;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline bool EventFilter::empty() const {
+      return m_conditions.empty();
+    }
+
+  }
+
+}
+
+#endif  //  DQM4HEP_EVENTFILTER_H
@@ -17,10 +17,19 @@
 #include <dqm4hep/Event.h>
 #include <dqm4hep/EventStreamer.h>
 #include <dqm4hep/Client.h>
+#include <dqm4hep/EventBatch.h>
+#include <dqm4hep/BoundedQueue.h>
 
 // -- root headers
 #include <TBufferFile.h>
 
+// -- std headers
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace dqm4hep {
 
   namespace online {
@@ -47,6 +56,16 @@ namespace dqm4hep {
      */
     class EventSource {
     public:
+      /**
+       *  @brief  OverflowPolicy enum.
+       *          What to do with a new event when the send queue is full (asynchronous mode)
+       */
+      enum OverflowPolicy {
+        DROP_NEWEST,      ///< Drop the new event
+        DROP_OLDEST,      ///< Drop the oldest event of the queue to make room for the new one
+        BLOCK             ///< Wait for the sender thread to make room in the queue
+      };
+      
       /**
        *  @brief  Factory method to create a shared pointer of event source
        *  
@@ -73,6 +92,117 @@ namespace dqm4hep {
        */
       void addCollector(const std::string &name);
       
+      /**
+       *  @brief  Declare an event streamer used by the source.
+       *          The streamer ids are sent to the collectors at registration,
+       *          which refuse the source if they clash with their own streamers.
+       *          Can be used only before calling start().
+       *          
+       *  @param  streamerName the event streamer plugin name
+       */
+      void addStreamer(const std::string &streamerName);
+      
+      /**
+       *  @brief  Set the time between two checks of the collector servers liveness (unit ms).
+       *          The liveness is checked by a background thread and cached, so that 
+       *          sending an event doesn't query the DIM DNS. If set to 0, the liveness 
+       *          is checked on every sent event. Default is 1000 ms.
+       *          Can be used only before calling start().
+       *          
+       *  @param  msec the liveness cache time to live (unit ms)
+       */
+      void setLivenessTTL(unsigned int msec);
+      
+      /**
+       *  @brief  Get the collector servers liveness cache time to live (unit ms)
+       */
+      unsigned int livenessTTL() const;
+      
+      /**
+       *  @brief  Enable the event batching mode (opt-in).
+       *          Events are packed in a single frame per collector (see EventBatch),
+       *          sent when the batch reaches the maximum number of events or the
+       *          maximum size, or when its first event has waited for the maximum latency.
+       *          Can be used only before calling start().
+       *          
+       *  @param  maxEvents the maximum number of events per batch
+       *  @param  maxBytes the maximum batch size (unit bytes)
+       *  @param  maxLatency the maximum time an event can wait in a batch (unit ms)
+       */
+      void setBatching(unsigned int maxEvents, unsigned int maxBytes, unsigned int maxLatency);
+      
+      /**
+       *  @brief  Whether the event batching mode is enabled
+       */
+      bool batching() const;
+      
+      /**
+       *  @brief  Send the pending event batches to the collectors right now.
+       *          Does nothing if the batching mode is not enabled
+       */
+      void flush();
+      
+      /**
+       *  @brief  Enable the asynchronous sending mode.
+       *          Serialized events are pushed in a bounded queue and sent to the 
+       *          collectors by a dedicated sender thread, so that a slow collector 
+       *          doesn't stall the calling thread. sendEvent() must always be called
+       *          from the same thread in this mode.
+       *          Can be used only before calling start().
+       *          
+       *  @param  queueSize the maximum number of events in the send queue
+       *  @param  policy what to do with a new event when the queue is full
+       */
+      void setAsync(unsigned int queueSize, OverflowPolicy policy);
+      
+      /**
+       *  @brief  Whether the asynchronous sending mode is enabled
+       */
+      bool async() const;
+      
+      /**
+       *  @brief  Enable the compression of the event payloads (see core::EventCompression).
+       *          Payloads smaller than the minimum size or not reduced by the compression
+       *          are sent uncompressed. The settings are sent to the collectors at registration,
+       *          which refuse the source if they can't handle the compression algorithm.
+       *          Can be used only before calling start().
+       *          
+       *  @param  algorithm the compression algorithm
+       *  @param  level the compression level (1 to 9)
+       *  @param  minSize the minimum payload size to compress (unit bytes)
+       */
+      void setCompression(core::EventCompression::Algorithm algorithm, unsigned int level, unsigned int minSize);
+      
+      /**
+       *  @brief  Get the compression settings of the event payloads
+       */
+      const core::EventCompression &compression() const;
+      
+      /**
+       *  @brief  Set whether to send the source statistics to the online manager.
+       *          The statistics are sent every 5 seconds by the sender thread (asynchronous mode only).
+       *          Can be used only before calling start(). Enabled by default
+       *  
+       *  @param  enable whether to enable the source statistics
+       */
+      void enableStats(bool enable);
+      
+      /**
+       *  @brief  Get the total number of events pushed in the send queue (asynchronous mode)
+       */
+      unsigned long nQueuedEvents() const;
+      
+      /**
+       *  @brief  Get the total number of events sent to at least one collector.
+       *          Events skipped by all the collectors (not running or not registered) are not counted
+       */
+      unsigned long nSentEvents() const;
+      
+      /**
+       *  @brief  Get the total number of events dropped because the send queue was full
+       */
+      unsigned long nDroppedEvents() const;
+      
       /**
        *  @brief  Start the event source.
        *          Setup raw buffers and register it to event collectors
@@ -126,6 +256,60 @@ namespace dqm4hep {
        *  @param  event the event to send
        */
       void sendEvent(const core::StringVector &collectors, core::EventPtr event);
+      
+      /**
+       *  @brief  Send a serialized event to the specified list of collectors
+       *  
+       *  @param  collectors the list of collectors
+       *  @param  buffer the serialized event
+       *  @param  size the serialized event size
+       */
+      void dispatchEvent(const core::StringVector &collectors, const char *buffer, unsigned int size);
+      
+      /**
+       *  @brief  Push the serialized event in the send queue, applying the overflow policy
+       *  
+       *  @param  collectors the list of collectors
+       */
+      void queueEvent(const core::StringVector &collectors);
+      
+      /**
+       *  @brief  The sender thread function. Send the queued events and the statistics
+       */
+      void senderLoop();
+      
+      /**
+       *  @brief  Send a statistics entry to the online manager
+       *  
+       *  @param  name the stat entry name
+       *  @param  description the stat entry description
+       *  @param  value the stat value
+       */
+      void sendStat(const std::string &name, const std::string &description, unsigned long value);
+      
+      /**
+       *  @brief  Query the list of running servers once and update the liveness flag of all collectors
+       */
+      void updateLiveness();
+      
+      /**
+       *  @brief  The liveness cache thread function. Update the collectors liveness every TTL
+       */
+      void livenessLoop();
+      
+      /**
+       *  @brief  Send the event batch to the collector and clear it.
+       *          The batch mutex must be locked by the caller
+       *  
+       *  @param  collector the collector name
+       *  @param  batch the event batch to send
+       */
+      void sendBatch(const std::string &collector, EventBatch &batch);
+      
+      /**
+       *  @brief  The batch flush thread function. Send the batches reaching the maximum latency
+       */
+      void flushLoop();
 
     private:
       /** 
@@ -140,17 +324,58 @@ namespace dqm4hep {
        */
       struct CollectorInfo {
         bool             m_registered = {false};   ///< Whether the source is registered to the event collector
+        std::atomic_bool m_running = {false};      ///< Whether the event collector server is running (cached)
+        EventBatch       m_batch = {};             ///< The pending event batch (batching mode only)
+      };
+      
+      /**
+       *  @brief  EventFrame struct. A serialized event waiting in the send queue
+       */
+      struct EventFrame {
+        std::string         m_buffer = {};        ///< The serialized event
+        core::StringVector  m_collectors = {};    ///< The collectors to send the event to
       };
       
     private:
       typedef std::map<std::string, CollectorInfo> CollectorInfoMap;
+      typedef BoundedQueue<EventFrame> SendQueue;
       
       bool                                m_started = {false};               ///< Whether the event source was started
       std::string                         m_sourceName = {""};               ///< The source name
       core::EventStreamer                 m_eventStreamer = {};              ///< The event streamer
       CollectorInfoMap                    m_collectorInfos = {};             ///< The map of event collector infos
+      core::StringVector                  m_streamerNames = {};              ///< The declared event streamers
       net::Client                         m_client = {};                     ///< The networking client interface 
       TBufferFile                         m_buffer = {TBuffer::kWrite, 2*1024*1024};  ///< The serialized event raw buffer
+      unsigned int                        m_livenessTTL = {1000};            ///< The collectors liveness cache time to live (unit ms)
+      std::thread                         m_livenessThread = {};             ///< The collectors liveness cache thread
+      std::atomic_bool                    m_stopLiveness = {false};          ///< Whether to stop the liveness cache thread
+      std::mutex                          m_livenessMutex = {};              ///< The mutex for the liveness thread wake up
+      std::condition_variable             m_livenessCondition = {};          ///< The condition to wake up the liveness thread
+      bool                                m_batching = {false};              ///< Whether the event batching mode is enabled
+      unsigned int                        m_batchMaxEvents = {0};            ///< The maximum number of events per batch
+      unsigned int                        m_batchMaxBytes = {0};             ///< The maximum batch size (unit bytes)
+      unsigned int                        m_batchMaxLatency = {0};           ///< The maximum time an event can wait in a batch (unit ms)
+      std::thread                         m_flushThread = {};                ///< The batch flush thread
+      bool                                m_stopFlush = {false};             ///< Whether to stop the batch flush thread
+      std::mutex                          m_batchMutex = {};                 ///< The mutex protecting the event batches
+      std::condition_variable             m_batchCondition = {};             ///< The condition to wake up the batch flush thread
+      bool                                m_async = {false};                 ///< Whether the asynchronous sending mode is enabled
+      bool                                m_statsEnabled = {true};           ///< Whether to send the source statistics
+      OverflowPolicy                      m_overflowPolicy = {DROP_NEWEST};  ///< The send queue overflow policy
+      std::unique_ptr<SendQueue>          m_sendQueue = {nullptr};           ///< The send queue (asynchronous mode)
+      EventFrame                          m_queuedFrame = {};                ///< The frame to push in the send queue (producer side)
+      EventFrame                          m_droppedFrame = {};               ///< The frame receiving the dropped events (producer side)
+      std::thread                         m_senderThread = {};               ///< The sender thread
+      std::atomic_bool                    m_stopSender = {false};            ///< Whether to stop the sender thread
+      std::atomic_bool                    m_senderWaiting = {false};         ///< Whether the sender thread waits for events
+      std::atomic_bool                    m_producerWaiting = {false};       ///< Whether the producer waits for room in the queue
+      std::mutex                          m_sendMutex = {};                  ///< The mutex for the sender and producer wake up
+      std::condition_variable             m_sendCondition = {};              ///< The condition to wake up the sender thread
+      std::condition_variable             m_spaceCondition = {};             ///< The condition to wake up a blocked producer
+      std::atomic<unsigned long>          m_nQueuedEvents = {0};             ///< The total number of queued events
+      std::atomic<unsigned long>          m_nSentEvents = {0};               ///< The total number of sent events
+      std::atomic<unsigned long>          m_nDroppedEvents = {0};            ///< The total number of dropped events
     };
 
   }
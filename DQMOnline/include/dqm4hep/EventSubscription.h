@@ -0,0 +1,224 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_EVENTSUBSCRIPTION_H
+#define DQM4HEP_EVENTSUBSCRIPTION_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/json.h>
+#include <dqm4hep/EventFilter.h>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  EventSubscription class.
+     *          How a client wants to receive the event updates of a source from an
+     *          event collector. Declared by the client at subscription time, so that
+     *          the collector only sends the updates the client will actually process.
+     *          The collector keeps one subscription per client and per source and asks
+     *          it whether to forward each collected update (a single event or a batch).
+     *          An optional event filter restricts the forwarded events to the ones matching
+     *          it. The filter is applied before the prescale and rate limits.
+     *          Selective subscriptions (not ALL or with a filter) are served on a dedicated
+     *          collector service, so that the clients receiving all the updates are unaffected
+     *          (see OnlineRoutes::EventCollector::selectedEventUpdate()).
+     */
+    class EventSubscription {
+    public:
+      /**
+       *  @brief  Mode enum
+       */
+      enum Mode {
+        ALL,          ///< Receive all the updates (default)
+        PRESCALE,     ///< Receive one update every N updates
+        MAX_RATE,     ///< Receive at most N updates per second, the updates arriving too early are dropped
+        LATEST        ///< Receive at most N updates per second, always the latest one (coalescing)
+      };
+
+      /**
+       *  @brief  Get the mode name
+       *
+       *  @param  mode the subscription mode
+       */
+      static std::string modeName(Mode mode);
+
+      /**
+       *  @brief  Get a mode from its name (case insensitive)
+       *
+       *  @param  name the mode name
+       *  @param  mode the mode to receive
+       */
+      static core::StatusCode modeFromName(const std::string &name, Mode &mode);
+
+      /**
+       *  @brief  Default constructor. Receive all the updates
+       */
+      EventSubscription() = default;
+
+      /**
+       *  @brief  Create a prescaled subscription
+       *
+       *  @param  prescale receive one update every prescale updates
+       */
+      static EventSubscription prescaled(unsigned int prescale);
+
+      /**
+       *  @brief  Create a rate limited subscription.
+       *          Throws STATUS_CODE_INVALID_PARAMETER if maxRate is not positive
+       *
+       *  @param  maxRate the maximum number of updates per second
+       */
+      static EventSubscription rateLimited(double maxRate);
+
+      /**
+       *  @brief  Create a latest only subscription.
+       *          Throws STATUS_CODE_INVALID_PARAMETER if maxRate is not positive
+       *
+       *  @param  maxRate the maximum number of updates per second
+       */
+      static EventSubscription latestOnly(double maxRate);
+
+      /**
+       *  @brief  Get the subscription mode
+       */
+      Mode mode() const;
+
+      /**
+       *  @brief  Get the prescale factor (PRESCALE mode)
+       */
+      unsigned int prescale() const;
+
+      /**
+       *  @brief  Get the maximum update rate (unit Hz, MAX_RATE and LATEST modes)
+       */
+      double maxRate() const;
+
+      /**
+       *  @brief  Set the event filter
+       *
+       *  @param  filter the event filter
+       */
+      void setFilter(const EventFilter &filter);
+
+      /**
+       *  @brief  Get the event filter
+       */
+      const EventFilter &filter() const;
+
+      /**
+       *  @brief  Whether the subscription selects a subset of the updates,
+       *          i.e a mode other than ALL or a non empty filter
+       */
+      bool selective() const;
+
+      /**
+       *  @brief  Whether a new update has to be forwarded now to the subscriber.
+       *          In LATEST mode, an update arriving too early is kept pending
+       *          and sent by flushPending() once the rate allows it
+       *
+       *  @param  now the update time
+       */
+      bool select(const core::time::point &now);
+
+      /**
+       *  @brief  Whether a pending update (LATEST mode) has to be sent now
+       *
+       *  @param  now the current time
+       */
+      bool flushPending(const core::time::point &now);
+
+      /**
+       *  @brief  Whether an update is pending (LATEST mode)
+       */
+      bool pending() const;
+
+      /**
+       *  @brief  Write the settings in a json object
+       *
+       *  @param  value the json object to receive
+       */
+      void toJson(core::json &value) const;
+
+      /**
+       *  @brief  Read the settings from a json object, as written by toJson()
+       *
+       *  @param  value the json object
+       *  @param  message an error message filled on failure
+       */
+      core::StatusCode fromJson(const core::json &value, std::string &message);
+
+    private:
+      /**
+       *  @brief  Whether the minimum time between two updates has elapsed
+       */
+      bool rateAllows(const core::time::point &now) const;
+
+    private:
+      Mode                    m_mode = {ALL};           ///< The subscription mode
+      unsigned int            m_prescale = {1};         ///< The prescale factor
+      double                  m_maxRate = {0.};         ///< The maximum update rate (unit Hz)
+      unsigned long           m_nUpdates = {0};         ///< The number of updates seen so far
+      core::time::point       m_lastSendTime = {};      ///< The time of the last forwarded update
+      bool                    m_pending = {false};      ///< Whether an update is pending (LATEST mode)
+      EventFilter             m_filter = {};            ///< The event filter
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    inline EventSubscription::Mode EventSubscription::mode() const {
+      return m_mode;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline unsigned int EventSubscription::prescale() const {
+      return m_prescale;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline double EventSubscription::maxRate() const {
+      return m_maxRate;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline bool EventSubscription::pending() const {
+      return m_pending;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline void EventSubscription::setFilter(const EventFilter &filter) {
+      m_filter = filter;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline const EventFilter &EventSubscription::filter() const {
+      return m_filter;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline bool EventSubscription::selective() const {
+      return (ALL != m_mode) || (not m_filter.empty());
+    }
+
+  }
+
+}
+
+#endif  //  DQM4HEP_EVENTSUBSCRIPTION_H
@@ -20,6 +20,10 @@
 
 namespace dqm4hep {
 
+  namespace core {
+    class MonitorElementManager;
+  }
+
   namespace online {
 
     class ModuleApplication;
@@ -157,6 +161,8 @@ namespace dqm4hep {
       core::Version                 m_version = {};
       /// The module application instance
       ModuleApplication            *m_moduleApplication = {nullptr};
+      /// The monitor element manager of the module, if not the application one (replay workers)
+      std::shared_ptr<core::MonitorElementManager> m_monitorElementManager = {nullptr};
     };
     
     //-------------------------------------------------------------------------------------------------
@@ -250,6 +250,14 @@ namespace dqm4hep {
        *  @param  module the user module calling this method
        */
       static core::StatusCode checkModule(const Module *const module);
+      
+      /**
+       *  @brief  Get the monitor element manager in which the module books and looks up its monitor elements.
+       *          This is the module application one, except for the replay worker modules
+       *
+       *  @param  module the user module calling this method
+       */
+      static std::shared_ptr<core::MonitorElementManager> monitorElementManager(const Module *const module);
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -262,7 +270,7 @@ namespace dqm4hep {
         dqm_error( "Module application allows monitor element booking only in readSettings() or init() functions !" );
         return core::STATUS_CODE_NOT_ALLOWED;
       }
-      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, module->moduleApplication()->monitorElementManager()->bookObject<ObjectType>(path, name, title, monitorElement, args...));
+      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::monitorElementManager(module)->bookObject<ObjectType>(path, name, title, monitorElement, args...));
       monitorElement->setModuleName(module->name());
       return core::STATUS_CODE_SUCCESS;
     }
@@ -276,7 +284,7 @@ namespace dqm4hep {
         dqm_error( "Module application allows monitor element booking only in readSettings() or init() functions !" );
         return core::STATUS_CODE_NOT_ALLOWED;
       }
-      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, module->moduleApplication()->monitorElementManager()->bookHisto<HistoType>(path, name, title, monitorElement, args...));
+      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::monitorElementManager(module)->bookHisto<HistoType>(path, name, title, monitorElement, args...));
       monitorElement->setModuleName(module->name());
       return core::STATUS_CODE_SUCCESS;
     }
@@ -290,7 +298,7 @@ namespace dqm4hep {
         dqm_error( "Module application allows monitor element booking only in readSettings() or init() functions !" );
         return core::STATUS_CODE_NOT_ALLOWED;
       }
-      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, module->moduleApplication()->monitorElementManager()->bookScalar<ScalarType>(path, name, title, monitorElement, args...));
+      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::monitorElementManager(module)->bookScalar<ScalarType>(path, name, title, monitorElement, args...));
       monitorElement->setModuleName(module->name());
       return core::STATUS_CODE_SUCCESS;
     }
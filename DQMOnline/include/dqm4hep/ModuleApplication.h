@@ -23,6 +23,13 @@
 #include "dqm4hep/MonitorElementManager.h"
 #include "dqm4hep/EventReader.h"
 #include "dqm4hep/Archiver.h"
+#include "dqm4hep/ElementBatch.h"
+
+// -- std headers
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 // -- tclap headers
 #include "tclap/CmdLine.h"
@@ -52,7 +59,8 @@ namespace dqm4hep {
       enum RunningMode {
         UNDEFINED_MODE,
         ONLINE,
-        EVENT_READER
+        EVENT_READER,
+        REPLAY
       };
       
       ModuleApplication(const ModuleApplication&) = delete;
@@ -158,6 +166,16 @@ namespace dqm4hep {
        */
       void configureArchiver(core::TiXmlElement *element);
       
+      /**
+       *  @brief  Configure the replay mode: create the worker modules,
+       *          each of them with its own monitor element manager
+       *
+       *  @param  element the settings xml element
+       *  @param  storageElement the storage xml element (optional)
+       *  @param  moduleElement the module xml element
+       */
+      void configureReplay(core::TiXmlElement *element, core::TiXmlElement *storageElement, core::TiXmlElement *moduleElement);
+      
       /**
        *  @brief  Process the start of run service update
        *
@@ -184,6 +202,20 @@ namespace dqm4hep {
        */
       void receiveSubscriptionList(CommandEvent *cmd);
       
+      /**
+       *  @brief  Update the monitor element subscriptions
+       *  
+       *  @param  subscriptions the subscription list (json array of path, name and sub)
+       */
+      void updateSubscriptions(const core::json &subscriptions);
+      
+      /**
+       *  @brief  Send the modified monitor elements to the monitor element collector
+       *  
+       *  @param  elements the monitor elements to send
+       */
+      void sendElementsToCollector(const OnlineElementPtrList &elements);
+      
       /**
        *  @brief  Slot to set the run number of all monitor elements on start of run
        *  
@@ -214,6 +246,46 @@ namespace dqm4hep {
        *  @param  run the run description on end of run
        */
       void archiveAndClose(const core::Run &run);
+      
+      /**
+       *  @brief  Start the replay reader and worker threads
+       */
+      void startReplay();
+      
+      /**
+       *  @brief  Stop and join the replay reader and worker threads
+       */
+      void stopReplay();
+      
+      /**
+       *  @brief  The replay reader thread function. 
+       *          Read the events from the file and queue them for the workers
+       */
+      void replayReadLoop();
+      
+      /**
+       *  @brief  Receive an event from the event reader and queue it for the replay workers.
+       *          Block while the queue is full
+       *
+       *  @param  event an event read from file
+       */
+      void queueReplayEvent(core::EventPtr event);
+      
+      /**
+       *  @brief  The replay worker thread function. 
+       *          Process the queued events with the worker module
+       *
+       *  @param  workerId the worker index
+       */
+      void replayWorkerLoop(unsigned int workerId);
+      
+      /**
+       *  @brief  Merge the monitor elements of the replay workers in the application storage.
+       *          Call the worker modules end of cycle function before merging
+       *
+       *  @param  condition the end of cycle condition, nullptr if not at end of cycle
+       */
+      void mergeReplayWorkers(const EOCCondition *condition);
     
     private:  
       using CmdLine = std::shared_ptr<TCLAP::CmdLine>;
@@ -222,6 +294,22 @@ namespace dqm4hep {
       using EventReaderPtr = std::shared_ptr<core::EventReader>;
       using ArchiverPtr = std::shared_ptr<core::Archiver>;
       
+      /**
+       *  @brief  ReplayWorker struct.
+       *          A clone of the user module processing events on its own thread
+       */
+      struct ReplayWorker {
+        /// The worker module
+        ModulePtr                  m_module = {nullptr};
+        /// The worker module monitor element manager
+        MonitorElementManagerPtr   m_monitorElementManager = {nullptr};
+        /// Held while processing an event, to merge the monitor elements in a consistent state
+        std::mutex                 m_mutex = {};
+        /// The worker thread
+        std::thread                m_thread = {};
+      };
+      using ReplayWorkerPtr = std::unique_ptr<ReplayWorker>;
+      
       /**
        *  @brief  Priorities enumerator
        */
@@ -256,6 +344,12 @@ namespace dqm4hep {
       EventClientPtr               m_eventCollectorClient = {nullptr};
       /// The event source from the event collector
       std::string                  m_eventSourceName = {""};
+      /// How the events are sub-sampled by the event collector
+      EventSubscription            m_eventSubscription = {};
+      /// The monitor element collector to send the monitor elements to (optional)
+      std::string                  m_elementCollectorName = {""};
+      /// The batch of monitor elements sent to the collector at end of cycle
+      ElementBatch                 m_elementBatch;
       /// The current number of events in the event loop
       std::atomic_uint             m_currentNQueuedEvents = {0};
       /// The maximum of queued events to be processed (sub-sampling)
@@ -284,6 +378,26 @@ namespace dqm4hep {
       core::ArchiverSelector       m_archiverSelector = {};
       /// The monitor element archiver
       ArchiverPtr                  m_archiver = {nullptr};
+      /// The replay worker modules
+      std::vector<ReplayWorkerPtr> m_replayWorkers = {};
+      /// The replay reader thread
+      std::thread                  m_replayReader = {};
+      /// The events read from file, waiting for a replay worker
+      std::deque<core::EventPtr>   m_replayQueue = {};
+      /// The replay queue mutex
+      std::mutex                   m_replayMutex = {};
+      /// Notified when an event is queued or when the reading ends
+      std::condition_variable      m_replayQueueNotEmpty = {};
+      /// Notified when an event is dequeued or when the replay is stopped
+      std::condition_variable      m_replayQueueNotFull = {};
+      /// Whether the reader has read the whole file
+      bool                         m_replayReadDone = {false};
+      /// Whether the replay has to stop
+      std::atomic_bool             m_replayStop = {false};
+      /// Whether an error occured while reading the file
+      std::atomic_bool             m_replayFailed = {false};
+      /// The number of worker still processing events
+      std::atomic_uint             m_nActiveReplayWorkers = {0};
     };
     
     //-------------------------------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_MONITORELEMENTCLIENT_H
+#define DQM4HEP_MONITORELEMENTCLIENT_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/Client.h"
+#include "dqm4hep/OnlineElement.h"
+#include "dqm4hep/Signal.h"
+
+// -- std headers
+#include <mutex>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  MonitorElementClient class.
+     *          Subscribes to the monitor elements of a monitor element collector
+     *          and queries their latest versions (see MonitorElementCollector)
+     */
+    class MonitorElementClient {
+    public:
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  collectorName the collector name to connect to
+       */
+      MonitorElementClient(const std::string &collectorName);
+      MonitorElementClient(const MonitorElementClient&) = delete;
+      MonitorElementClient& operator=(const MonitorElementClient&) = delete;
+
+      /**
+       *  @brief  Destructor
+       */
+      ~MonitorElementClient();
+
+      /**
+       *  @brief  Request the latest version of an element in the collector
+       *
+       *  @param  moduleName the name of the module that has booked the element
+       *  @param  path the element path
+       *  @param  name the element name
+       *
+       *  @return the element, nullptr if not collected yet
+       */
+      OnlineElementPtr queryElement(const std::string &moduleName, const std::string &path, const std::string &name);
+
+      /**
+       *  @brief  Connect a function to receive the updates of the subscribed elements.
+       *          The function is called from the network thread
+       *
+       *  @param  controller the object receiving the elements
+       *  @param  function the object function receiving the elements
+       */
+      template <typename Controller>
+      void onElementUpdate(Controller *controller, void (Controller::*function)(const OnlineElementPtrList &elements));
+
+      /**
+       *  @brief  Subscribe to the updates of an element.
+       *          The latest version of the element is received straight away if already collected
+       *
+       *  @param  moduleName the name of the module that has booked the element
+       *  @param  path the element path
+       *  @param  name the element name
+       */
+      void subscribe(const std::string &moduleName, const std::string &path, const std::string &name);
+
+      /**
+       *  @brief  Unsubscribe from the updates of an element
+       *
+       *  @param  moduleName the name of the module that has booked the element
+       *  @param  path the element path
+       *  @param  name the element name
+       */
+      void unsubscribe(const std::string &moduleName, const std::string &path, const std::string &name);
+
+    private:
+      /**
+       *  @brief  Send a subscription change to the collector
+       */
+      void sendSubscription(const std::string &moduleName, const std::string &path, const std::string &name, bool subscribe);
+
+      /**
+       *  @brief  Read the elements of an update batch and emit them
+       *
+       *  @param  buffer the received batch
+       */
+      void receiveElements(const net::Buffer &buffer);
+
+    private:
+      using ElementUpdateSignal = core::Signal<const OnlineElementPtrList &>;
+
+      std::string                         m_collectorName = {""};
+      ElementUpdateSignal                 m_elementUpdateSignal = {};
+      net::Client                         m_client = {};
+      std::recursive_mutex                m_mutex = {};
+      bool                                m_receivingUpdates = {false};
+      bool                                m_notifyOnExit = {false};
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Controller>
+    inline void MonitorElementClient::onElementUpdate(Controller *controller, void (Controller::*function)(const OnlineElementPtrList &elements)) {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      m_elementUpdateSignal.connect(controller, function);
+    }
+
+  }
+
+}
+
+#endif  //  DQM4HEP_MONITORELEMENTCLIENT_H
@@ -0,0 +1,123 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_MONITORELEMENTCOLLECTOR_H
+#define DQM4HEP_MONITORELEMENTCOLLECTOR_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/Application.h"
+#include "dqm4hep/ElementBatch.h"
+#include "dqm4hep/MonitorElementStore.h"
+
+// -- tclap headers
+#include "tclap/CmdLine.h"
+#include "tclap/Arg.h"
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  MonitorElementCollector class.
+     *          Collects the monitor elements published by the modules at end of cycle
+     *          (see ElementBatch) and keeps the latest version of each element in memory,
+     *          per module, path and name (see MonitorElementStore). The elements are kept
+     *          serialized and never read by the collector. Clients subscribe to elements to
+     *          receive their updates (see MonitorElementClient) and can query the latest
+     *          versions at any time. A received batch is forwarded as is to the subscribers
+     *          of all its elements, the other subscribers get a batch of their elements only.
+     *          The modules are notified of the elements having at least one subscriber,
+     *          as they only publish these ones.
+     */
+    class MonitorElementCollector : public Application {
+    public:
+      /**
+       *  @brief  Default constructor
+       */
+      MonitorElementCollector();
+      MonitorElementCollector(const MonitorElementCollector&) = delete;
+      MonitorElementCollector& operator=(const MonitorElementCollector&) = delete;
+
+      /**
+       *  @brief  Default destructor
+       */
+      ~MonitorElementCollector();
+
+      void parseCmdLine(int argc, char **argv) override;
+      void onInit() override;
+      void onEvent(AppEvent *pAppEvent) override;
+      void onStart() override;
+      void onStop() override;
+
+    private:
+      typedef MonitorElementStore::ElementInfo ElementInfo;
+      typedef MonitorElementStore::NotificationMap ModuleNotificationMap;
+      typedef std::map<std::vector<bool>, std::vector<int>> SelectedClientMap;
+
+      void handleModuleRegistration(const net::Buffer &request, net::Buffer &response);
+      void handleCollectElements(const net::Buffer &buffer);
+      void handleSubscription(const net::Buffer &buffer);
+      void handleUnsubscription(const net::Buffer &buffer);
+      void handleElementRequest(const net::Buffer &request, net::Buffer &response);
+      void handleElementListRequest(const net::Buffer &request, net::Buffer &response);
+      void handleClientExit(StoreEvent<int> *event);
+      void sendStatsTimer10();
+
+      /**
+       *  @brief  Subscribe or unsubscribe a client to a list of elements.
+       *          The modules are notified of the elements getting their first subscriber
+       *          or losing their last one
+       *
+       *  @param  buffer the element list (json array of module, path and name)
+       *  @param  subscribe whether to subscribe or unsubscribe
+       */
+      void updateSubscriptions(const net::Buffer &buffer, bool subscribe);
+
+      /**
+       *  @brief  Send the subscription changes to the modules (see ModuleApplication)
+       *
+       *  @param  notifications the subscription changes, per module
+       */
+      void notifyModules(const ModuleNotificationMap &notifications);
+
+      /**
+       *  @brief  Add a stored element to a batch
+       *
+       *  @param  batch the batch to fill
+       *  @param  moduleName the module name
+       *  @param  key the element path and name
+       *  @param  element the stored element
+       */
+      static void addToBatch(ElementBatch &batch, const std::string &moduleName, const core::StringPair &key, const ElementInfo &element);
+
+    private:
+      std::shared_ptr<TCLAP::CmdLine>     m_cmdLine = nullptr;
+      MonitorElementStore                 m_store = {};
+      std::vector<ElementBatch::Frame>    m_frames = {};
+      std::vector<const ElementInfo*>     m_frameElements = {};
+      std::map<int, std::vector<bool>>    m_clientSelections = {};
+      SelectedClientMap                   m_selectedClients = {};
+      ElementBatch                        m_updateBatch;
+      ElementBatch                        m_requestBatch;
+      net::Service                       *m_elementService = {nullptr};
+      unsigned int                        m_nElements = {0};
+      unsigned int                        m_nCollectedElements10 = {0};
+      unsigned int                        m_nCollectedBytes10 = {0};
+      core::time::point                   m_lastStatCall10 = {};
+      AppTimer*                           m_statsTimer10 = {nullptr};
+    };
+
+  }
+
+}
+
+#endif  //  DQM4HEP_MONITORELEMENTCOLLECTOR_H
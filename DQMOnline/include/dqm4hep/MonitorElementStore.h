@@ -0,0 +1,134 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+#ifndef DQM4HEP_MONITORELEMENTSTORE_H
+#define DQM4HEP_MONITORELEMENTSTORE_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/json.h"
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  MonitorElementStore class.
+     *          The state of a monitor element collector: the registered modules, the latest
+     *          version of their elements (kept serialized) and the client subscriptions to
+     *          these elements. The subscription changes report the elements getting their
+     *          first subscriber or losing their last one, as the modules only publish the
+     *          subscribed elements. Not thread safe
+     */
+    class MonitorElementStore {
+    public:
+      /**
+       *  @brief  ElementInfo struct.
+       *          The latest version of a collected element and its subscribers
+       */
+      struct ElementInfo {
+        std::string          m_type = {""};               ///< The element type (class name)
+        std::string          m_buffer = {""};             ///< The latest serialized element, empty if not collected yet
+        std::set<int>        m_subscribers = {};          ///< The client ids of the subscribers
+      };
+
+      typedef std::map<core::StringPair, ElementInfo> ElementInfoMap;
+
+      /**
+       *  @brief  ModuleInfo struct
+       */
+      struct ModuleInfo {
+        int                  m_clientId = {0};            ///< The module client id, 0 if not connected
+        ElementInfoMap       m_elements = {};             ///< The module elements, per path and name
+      };
+
+      typedef std::map<std::string, ModuleInfo> ModuleInfoMap;
+      typedef std::map<std::string, core::json> NotificationMap;
+
+      /**
+       *  @brief  Register a module client.
+       *          The module may restart: its elements and subscriptions are kept
+       *
+       *  @param  moduleName the module name
+       *  @param  clientId the module client id
+       *
+       *  @return the subscribed module elements (json array of path, name and sub)
+       */
+      core::json registerModule(const std::string &moduleName, int clientId);
+
+      /**
+       *  @brief  Get the client id of a module, 0 if not connected
+       *
+       *  @param  moduleName the module name
+       */
+      int moduleClientId(const std::string &moduleName) const;
+
+      /**
+       *  @brief  Get an element, created if not collected yet
+       *
+       *  @param  moduleName the module name
+       *  @param  key the element path and name
+       */
+      ElementInfo &element(const std::string &moduleName, const core::StringPair &key);
+
+      /**
+       *  @brief  Find an element, nullptr if not found
+       *
+       *  @param  moduleName the module name
+       *  @param  key the element path and name
+       */
+      const ElementInfo *findElement(const std::string &moduleName, const core::StringPair &key) const;
+
+      /**
+       *  @brief  Subscribe or unsubscribe a client to an element, that may not be collected yet.
+       *          The element is added to the module notifications if it gets its first
+       *          subscriber or loses its last one
+       *
+       *  @param  clientId the client id
+       *  @param  moduleName the module name
+       *  @param  key the element path and name
+       *  @param  subscribe whether to subscribe or unsubscribe
+       *  @param  notifications the subscription changes to receive, per module
+       *
+       *  @return the element
+       */
+      const ElementInfo &updateSubscription(int clientId, const std::string &moduleName, const core::StringPair &key,
+        bool subscribe, NotificationMap &notifications);
+
+      /**
+       *  @brief  Remove a client that has exited.
+       *          A module client is marked as not connected and its elements are kept until
+       *          it registers again. The client subscriptions are dropped
+       *
+       *  @param  clientId the client id
+       *  @param  notifications the subscription changes to receive, per module
+       */
+      void removeClient(int clientId, NotificationMap &notifications);
+
+      /**
+       *  @brief  Get the modules and their elements
+       */
+      const ModuleInfoMap &modules() const;
+
+    private:
+      /**
+       *  @brief  Add a subscription change to the module notifications
+       */
+      static void addNotification(NotificationMap &notifications, const std::string &moduleName, const core::StringPair &key, bool subscribe);
+
+    private:
+      ModuleInfoMap                       m_moduleInfoMap = {};
+    };
+
+  }
+
+}
+
+#endif  //  DQM4HEP_MONITORELEMENTSTORE_H
@@ -205,6 +205,13 @@ namespace dqm4hep {
        */
       core::StatusCode runQualityTest(const std::string &name, core::QReport &report) override;
 
+      /** 
+       *  @brief  Receive the reports of all quality tests run by the monitor element manager
+       *
+       *  @param  reports the quality test reports
+       */
+      void setQualityReports(const core::QReportMap &reports) override;
+
     private:
       /// The run number
       int                           m_runNumber = {0};
@@ -220,6 +227,8 @@ namespace dqm4hep {
       bool                          m_publish = {true};
       /// Whether a shifter has subscribed to this element
       bool                          m_subscribed = {false};
+      /// The generation of the element at its last publication
+      unsigned long                 m_publishedGeneration = {0};
     }; 
 
   }
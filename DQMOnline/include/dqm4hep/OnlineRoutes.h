@@ -116,12 +116,101 @@ namespace dqm4hep {
          */
         static std::string eventUpdate(const std::string &collector, const std::string &source);
         
+        /**
+         *  @brief  Get the event collector service name to receive the event updates selected 
+         *          by a selective subscription (prescaled, rate limited or filtered, see EventSubscription).
+         *          The updates are only sent to the subscribers they were selected for
+         * 
+         *  @param  collector the collector name
+         *  @param  source the source name
+         */
+        static std::string selectedEventUpdate(const std::string &collector, const std::string &source);
+        
         /**
          *  @brief  Get the event collector request name to receive event on query
          * 
          *  @param  collector the collector name
          */
         static std::string eventRequest(const std::string &collector);
+        
+        /**
+         *  @brief  Get the event collector request name to declare how a client 
+         *          wants to receive the event updates of a source (see EventSubscription)
+         * 
+         *  @param  collector the collector name
+         */
+        static std::string subscribe(const std::string &collector);
+        
+        /**
+         *  @brief  Get the event collector command name to remove a client subscription
+         * 
+         *  @param  collector the collector name
+         */
+        static std::string unsubscribe(const std::string &collector);
+      };
+
+      //-------------------------------------------------------------------------------------------------
+      //-------------------------------------------------------------------------------------------------
+
+      /**
+       *  @brief  MonitorElementCollector class
+       *          Defines routes related to the monitor element collector
+       */
+      class MonitorElementCollector {
+      public:
+        /**
+         *  @brief  Get the monitor element collector application type
+         */
+        static std::string applicationType();
+
+        /**
+         *  @brief  Get the collector request name to register a module
+         *
+         *  @param  collector the collector name
+         */
+        static std::string registerModule(const std::string &collector);
+
+        /**
+         *  @brief  Get the collector command name to collect a batch of monitor elements (see ElementBatch)
+         *
+         *  @param  collector the collector name
+         */
+        static std::string collectElements(const std::string &collector);
+
+        /**
+         *  @brief  Get the collector service name to receive the updates of the subscribed monitor elements
+         *
+         *  @param  collector the collector name
+         */
+        static std::string elementUpdate(const std::string &collector);
+
+        /**
+         *  @brief  Get the collector request name to receive monitor elements on query
+         *
+         *  @param  collector the collector name
+         */
+        static std::string elementRequest(const std::string &collector);
+
+        /**
+         *  @brief  Get the collector request name to receive the list of collected monitor elements
+         *
+         *  @param  collector the collector name
+         */
+        static std::string elementList(const std::string &collector);
+
+        /**
+         *  @brief  Get the collector command name to subscribe to monitor element updates
+         *
+         *  @param  collector the collector name
+         */
+        static std::string subscribe(const std::string &collector);
+
+        /**
+         *  @brief  Get the collector command name to unsubscribe from monitor element updates
+         *
+         *  @param  collector the collector name
+         */
+        static std::string unsubscribe(const std::string &collector);
       };
 
       //-------------------------------------------------------------------------------------------------
@@ -0,0 +1,250 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/PluginManager.h"
+#include "dqm4hep/Logging.h"
+#include "dqm4hep/EventWriter.h"
+#include "dqm4hep/EventCollectorClient.h"
+#include "dqm4hep/DQM4hepConfig.h"
+
+// -- tclap headers
+#include "tclap/CmdLine.h"
+#include "tclap/Arg.h"
+
+// -- std headers
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <signal.h>
+
+using namespace std;
+using namespace dqm4hep::net;
+using namespace dqm4hep::online;
+using namespace dqm4hep::core;
+
+std::atomic_bool running(true);
+
+//-------------------------------------------------------------------------------------------------
+
+// key interrupt signal handling
+void int_key_signal_handler(int /*signal*/)
+{
+  std::cout << std::endl;
+  dqm_info( "Caught CTRL+C. Exiting..." );
+  running = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  EventRecorder class.
+ *          Write the events received from the collector in a file
+ */
+class EventRecorder {
+public:
+  /**
+   *  @brief  Constructor
+   *
+   *  @param  writer the event writer to use
+   *  @param  maxNEvents the maximum number of events to record (0 means no limit)
+   */
+  EventRecorder(EventWriterPtr writer, unsigned int maxNEvents);
+
+  /**
+   *  @brief  Write the event in the file
+   */
+  void recordEvent(EventPtr event);
+
+  /**
+   *  @brief  Get the number of recorded events
+   */
+  unsigned int nEvents() const;
+
+  /**
+   *  @brief  Write the run info and close the file
+   */
+  StatusCode close();
+
+private:
+  mutable std::mutex          m_mutex = {};                   ///< Protects the writer from concurrent callbacks
+  EventWriterPtr              m_writer = {nullptr};           ///< The event writer
+  const unsigned int          m_maxNEvents = {0};             ///< The maximum number of events to record
+  unsigned int                m_nEvents = {0};                ///< The number of recorded events
+  Run                         m_run = {};                     ///< The run info, filled from the recorded events
+};
+
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+  dqm4hep::core::screenSplash();
+
+  std::string cmdLineFooter = "Please report bug to <dqm4hep@gmail.com>";
+  TCLAP::CmdLine *pCommandLine = new TCLAP::CmdLine(cmdLineFooter, ' ', DQM4hep_VERSION_STR);
+
+  TCLAP::ValueArg<std::string> collectorNameArg(
+      "c"
+      , "collector-name"
+      , "The event collector name"
+      , true
+      , ""
+      , "string");
+  pCommandLine->add(collectorNameArg);
+
+  TCLAP::ValueArg<std::string> sourceNameArg(
+      "s"
+      , "source-name"
+      , "The event source name"
+      , true
+      , ""
+      , "string");
+  pCommandLine->add(sourceNameArg);
+
+  TCLAP::ValueArg<std::string> outputFileArg(
+      "o"
+      , "output-file"
+      , "The output file to write events in"
+      , true
+      , ""
+      , "string");
+  pCommandLine->add(outputFileArg);
+
+  TCLAP::ValueArg<std::string> writerArg(
+      "w"
+      , "writer"
+      , "The event writer plugin name"
+      , false
+      , "BinaryEventWriter"
+      , "string");
+  pCommandLine->add(writerArg);
+
+  TCLAP::ValueArg<unsigned int> maxNEventsArg(
+      "n"
+      , "max-events"
+      , "The maximum number of events to record (0 means until CTRL+C)"
+      , false
+      , 0
+      , "unsigned int");
+  pCommandLine->add(maxNEventsArg);
+
+  StringVector verbosities(Logger::logLevels());
+  TCLAP::ValuesConstraint<std::string> verbosityConstraint(verbosities);
+  TCLAP::ValueArg<std::string> verbosityArg(
+      "v"
+      , "verbosity"
+      , "The logging verbosity"
+      , false
+      , "info"
+      , &verbosityConstraint);
+  pCommandLine->add(verbosityArg);
+
+  // parse command line
+  pCommandLine->parse(argc, argv);
+
+  // install signal handlers
+  signal(SIGINT,  int_key_signal_handler);
+
+  // set log level
+  std::string verbosity(verbosityArg.getValue());
+  Logger::createLogger("record-evts", {Logger::coloredConsole()});
+  Logger::setMainLogger("record-evts");
+  Logger::setLogLevel(Logger::logLevelFromString(verbosity));
+
+  try {
+    THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, PluginManager::instance()->loadLibraries());
+  }
+  catch(StatusCodeException &e) {
+    dqm_error( "Couldn't load plugins: {0}", e.toString() );
+    return e.getStatusCode();
+  }
+
+  EventWriterPtr writer = PluginManager::instance()->create<EventWriter>(writerArg.getValue());
+
+  if(nullptr == writer) {
+    dqm_error( "Event writer plugin '{0}' not found", writerArg.getValue() );
+    return STATUS_CODE_NOT_FOUND;
+  }
+
+  if(STATUS_CODE_SUCCESS != writer->open(outputFileArg.getValue())) {
+    return STATUS_CODE_FAILURE;
+  }
+
+  EventRecorder recorder(writer, maxNEventsArg.getValue());
+  EventCollectorClient client(collectorNameArg.getValue());
+  client.onEventUpdate(sourceNameArg.getValue(), &recorder, &EventRecorder::recordEvent);
+  client.startEventUpdates();
+
+  while(running) {
+    dqm4hep::core::time::msleep(100);
+  }
+
+  client.stopEventUpdates();
+  const StatusCode statusCode = recorder.close();
+  dqm_info( "Recorded {0} events in file '{1}'", recorder.nEvents(), outputFileArg.getValue() );
+
+  delete pCommandLine;
+
+  return statusCode;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+EventRecorder::EventRecorder(EventWriterPtr writer, unsigned int maxNEvents) :
+  m_writer(writer),
+  m_maxNEvents(maxNEvents) {
+  /* nop */
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void EventRecorder::recordEvent(EventPtr event) {
+  if(not event) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(not running) {
+    return;
+  }
+  if(STATUS_CODE_SUCCESS != m_writer->writeEvent(event)) {
+    dqm_error( "Couldn't write event {0}, stopping ...", event->getEventNumber() );
+    running = false;
+    return;
+  }
+  // run info from the first and last recorded events
+  if(0 == m_nEvents) {
+    m_run.setRunNumber(event->getRunNumber());
+    m_run.setStartTime(event->getTimeStamp());
+  }
+  m_run.setEndTime(event->getTimeStamp());
+  m_nEvents++;
+  dqm_debug( "Recorded event {0} (run {1})", event->getEventNumber(), event->getRunNumber() );
+  if(0 != m_maxNEvents && m_nEvents >= m_maxNEvents) {
+    dqm_info( "Recorded {0} events, stopping ...", m_nEvents );
+    running = false;
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+unsigned int EventRecorder::nEvents() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_nEvents;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+StatusCode EventRecorder::close() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_writer->setRunInfo(m_run);
+  return m_writer->close();
+}
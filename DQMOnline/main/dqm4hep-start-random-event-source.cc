@@ -27,6 +27,8 @@
 #include <atomic>
 #include <signal.h>
 #include <random>
+#include <chrono>
+#include <thread>
 
 using namespace std;
 using namespace dqm4hep::online;
@@ -80,6 +82,53 @@ int main(int argc, char* argv[])
       , true
       , "string");
   pCommandLine->add(collectorNameArg);
+  
+  TCLAP::ValueArg<unsigned int> sleepTimeArg(
+      "s"
+      , "sleep"
+      , "The time to sleep between two events (unit ms)"
+      , false
+      , 1000
+      , "unsigned int");
+  pCommandLine->add(sleepTimeArg);
+  
+  TCLAP::ValueArg<unsigned int> maxEventsArg(
+      "m"
+      , "max-events"
+      , "The maximum number of events to send (0 means no limit)"
+      , false
+      , 0
+      , "unsigned int");
+  pCommandLine->add(maxEventsArg);
+  
+  TCLAP::ValueArg<unsigned int> livenessTTLArg(
+      "t"
+      , "liveness-ttl"
+      , "The time between two checks of the collectors liveness (unit ms). 0 means check on every event"
+      , false
+      , 1000
+      , "unsigned int");
+  pCommandLine->add(livenessTTLArg);
+  
+  TCLAP::ValueArg<unsigned int> queueSizeArg(
+      "q"
+      , "queue-size"
+      , "The send queue size, to send the events asynchronously (0 means synchronous sending)"
+      , false
+      , 0
+      , "unsigned int");
+  pCommandLine->add(queueSizeArg);
+  
+  StringVector overflowPolicies({"drop-newest", "drop-oldest", "block"});
+  TCLAP::ValuesConstraint<std::string> overflowPolicyConstraint(overflowPolicies);
+  TCLAP::ValueArg<std::string> overflowPolicyArg(
+      "p"
+      , "overflow-policy"
+      , "What to do with a new event when the send queue is full"
+      , false
+      , "drop-newest"
+      , &overflowPolicyConstraint);
+  pCommandLine->add(overflowPolicyArg);
 
   // parse command line
   pCommandLine->parse(argc, argv);
@@ -100,8 +149,27 @@ int main(int argc, char* argv[])
   for(auto collector : collectors)
     eventSource->addCollector(collector);
 
+  eventSource->addStreamer("GenericEventStreamer");
+  eventSource->setLivenessTTL(livenessTTLArg.getValue());
+  
+  if(0 != queueSizeArg.getValue()) {
+    EventSource::OverflowPolicy policy(EventSource::DROP_NEWEST);
+    if("drop-oldest" == overflowPolicyArg.getValue()) {
+      policy = EventSource::DROP_OLDEST;
+    }
+    else if("block" == overflowPolicyArg.getValue()) {
+      policy = EventSource::BLOCK;
+    }
+    eventSource->setAsync(queueSizeArg.getValue(), policy);
+  }
   eventSource->start();
   
+  const unsigned int sleepTime(sleepTimeArg.getValue());
+  const unsigned int maxEvents(maxEventsArg.getValue());
+  auto startTime = std::chrono::steady_clock::now();
+  auto lastRateTime = startTime;
+  uint32_t lastRateEventNumber(0);
+  
   uint32_t eventNumber(0);
   uint32_t runNumber((rand() / float(RAND_MAX))*125632);
   std::random_device rd{};
@@ -129,7 +197,28 @@ int main(int argc, char* argv[])
     
     eventSource->sendEvent(event);
     ++eventNumber;
-    sleep(1);
+    
+    // print the sending rate every 5 seconds
+    auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - lastRateTime).count();
+    if(elapsed > 5.) {
+      dqm_info( "Sending rate: {0} events/s", (eventNumber - lastRateEventNumber) / elapsed );
+      lastRateTime = now;
+      lastRateEventNumber = eventNumber;
+    }
+    
+    if(0 != maxEvents && eventNumber >= maxEvents) {
+      break;
+    }
+    if(0 != sleepTime) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
+    }
+  }
+  
+  const double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  dqm_info( "Sent {0} events in {1} s: {2} events/s", eventNumber, totalTime, eventNumber / totalTime );
+  if(eventSource->async()) {
+    dqm_info( "Send queue: {0} queued, {1} dropped", eventSource->nQueuedEvents(), eventSource->nDroppedEvents() );
   }
 
   return 0;
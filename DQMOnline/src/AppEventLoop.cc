@@ -13,7 +13,9 @@
 #include "dqm4hep/Logging.h"
 
 // -- std headers
+#include <algorithm>
 #include <memory>
+#include <thread>
 
 namespace dqm4hep {
 
@@ -26,7 +28,12 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     AppEventLoop::~AppEventLoop() {
-      
+      // must not throw: the queued events are left to the running loop
+      if(running()) {
+        dqm_error( "AppEventLoop::~AppEventLoop: event loop destroyed while running !" );
+        return;
+      }
+      releaseEvents();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -35,9 +42,12 @@ namespace dqm4hep {
       if(nullptr == pAppEvent) {
         return;
       }
-      // push event in the queue
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);      
-      m_eventQueue.insert(pAppEvent);   
+      // push event in its priority lane
+      ++m_nQueuedEvents;
+      m_lanes[pAppEvent->priority()].push(pAppEvent);
+      markLane(pAppEvent->priority());
+      // wake up the event loop if waiting
+      notifyQueue();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -53,17 +63,26 @@ namespace dqm4hep {
       catch(...) {
         dqm_error( "AppEventLoop::sendEvent: caught exception for event {0} of type {1}", (void*)pAppEvent, pAppEvent->type() );
       }
-      delete pAppEvent;
+      AppEventPool::release(pAppEvent);
     }
     
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::clear() {
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
-      for(auto evt : m_eventQueue) {
-        delete evt;
+      if(running()) {
+        dqm_error( "AppEventLoop::clear: can't clear the event queue while running !" );
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      releaseEvents();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::releaseEvents() {
+      AppEvent *event = nullptr;
+      while(nullptr != (event = popEvent())) {
+        AppEventPool::release(event);
       }
-      m_eventQueue.clear();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -71,6 +90,7 @@ namespace dqm4hep {
     int AppEventLoop::exec() {
       m_running = true;
       m_quitFlag = false;
+      m_timerStopFlag = false;
       
       m_timerThread = std::thread(&AppEventLoop::timerThread, this);
       
@@ -79,21 +99,29 @@ namespace dqm4hep {
           break;
         }
         
-        // safely get the app event pointer 
-        AppEvent* event = nullptr;
+        const bool blocking = (BLOCKING == m_mode.load());
         
-        {
-          std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
-          
-          if(!m_eventQueue.empty()) {
-            event = *m_eventQueue.rbegin();
-            m_eventQueue.erase(event);               
-          }
+        // wait for an event to be posted or for an exit request
+        if(blocking and 0 == m_nQueuedEvents.load()) {
+          std::unique_lock<std::mutex> lock(m_queueMutex);
+          m_waiting = true;
+          m_queueCondition.wait(lock, [this](){
+            return (m_nQueuedEvents.load() > 0 or m_quitFlag.load());
+          });
+          m_waiting = false;
         }
         
+        AppEvent* event = popEvent();
+        
         // if no event, save cpu ressources ...
         if(nullptr == event) {
-          usleep(100);
+          if(blocking) {
+            // an event is being pushed, yield until it is visible
+            std::this_thread::yield();
+          }
+          else {
+            usleep(100);
+          }
           continue;
         }
         
@@ -104,11 +132,17 @@ namespace dqm4hep {
           m_returnCode = 1;
           break;
         }
-        delete event;
-        usleep(100);
+        AppEventPool::release(event);
+        if(not blocking) {
+          usleep(100);
+        }
       }
       
-      m_timerStopFlag = true;
+      {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        m_timerStopFlag = true;
+      }
+      m_timerCondition.notify_one();
       m_timerThread.join();      
       m_running = false;
       return m_returnCode.load();
@@ -119,6 +153,22 @@ namespace dqm4hep {
     bool AppEventLoop::running() const {
       return m_running.load();
     }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::setMode(Mode loopMode) {
+      if(running()) {
+        dqm_error( "AppEventLoop::setMode: can't change event loop mode while running !" );
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      m_mode = loopMode;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    AppEventLoop::Mode AppEventLoop::mode() const {
+      return m_mode.load();
+    }
 
     //-------------------------------------------------------------------------------------------------    
     
@@ -176,101 +226,330 @@ namespace dqm4hep {
       }
       
       if(pAppEvent->type() == AppEvent::QUIT) {
-        m_quitFlag = true;
         m_returnCode = 1;
         StoreEvent<int> *quitEvent = dynamic_cast<StoreEvent<int>*>(pAppEvent);
         
         if(quitEvent) {
           m_returnCode = quitEvent->data();
         }
+        {
+          // set the flag under lock to not miss the wake up in exec()
+          std::lock_guard<std::mutex> lock(m_queueMutex);
+          m_quitFlag = true;
+        }
+        m_queueCondition.notify_all();
       }
     }
     
     //-------------------------------------------------------------------------------------------------
     
-    int AppEventLoop::count(int eventType) {
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
-      return std::count_if(m_eventQueue.begin(), m_eventQueue.end(), [&eventType](AppEvent* ptr){
-        return (ptr->type() == eventType);
-      });
+    int AppEventLoop::count() const {
+      return m_nQueuedEvents.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    int AppEventLoop::countPriority(int priority) const {
+      if(priority < 0 or priority >= NLanes) {
+        return 0;
+      }
+      return m_lanes[priority].m_count.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned long AppEventLoop::poolHits() const {
+      std::lock_guard<std::mutex> lock(m_poolMutex);
+      unsigned long hits = 0;
+      for(auto &pool : m_eventPools) {
+        hits += pool.second->hits();
+      }
+      return hits;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned long AppEventLoop::poolMisses() const {
+      std::lock_guard<std::mutex> lock(m_poolMutex);
+      unsigned long misses = 0;
+      for(auto &pool : m_eventPools) {
+        misses += pool.second->misses();
+      }
+      return misses;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    AppEvent *AppEventLoop::popEvent() {
+      // highest non-empty lane first
+      for(int w=NLaneWords-1 ; w>=0 ; w--) {
+        uint64_t lanes = m_activeLanes[w].load();
+        
+        while(0 != lanes) {
+          const int bit = 63 - __builtin_clzll(lanes);
+          const int p = w*64 + bit;
+          lanes &= ~(uint64_t(1) << bit);
+          EventLane &lane(m_lanes[p]);
+          AppEvent *event = lane.pop();
+          
+          if(0 == lane.m_count.load()) {
+            unmarkLane(p);
+          }
+          if(nullptr != event) {
+            --m_nQueuedEvents;
+            return event;
+          }
+          // a push is not yet completed in this lane and may hide completed ones
+          // behind it: don't take a lower priority event, the caller tries again
+          if(0 != lane.m_count.load()) {
+            return nullptr;
+          }
+        }
+      }
+      return nullptr;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::markLane(int priority) {
+      m_activeLanes[priority / 64].fetch_or(uint64_t(1) << (priority % 64));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::unmarkLane(int priority) {
+      m_activeLanes[priority / 64].fetch_and(~(uint64_t(1) << (priority % 64)));
+      // a producer may have pushed in between: its count is already visible
+      if(0 != m_lanes[priority].m_count.load()) {
+        markLane(priority);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::notifyQueue() {
+      // only take the lock if the loop is sleeping.
+      // m_waiting is set under lock before checking the queue
+      // in exec(), so the notification can't be missed
+      if(m_waiting.load()) {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queueCondition.notify_one();
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::timerThread() {
-      {
-        // initialize start time point of all timers
-        std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
-        for(auto timer : m_timers) {
-          timer->m_startTime = core::time::now();
+      std::unique_lock<std::mutex> lock(m_timerMutex);
+      
+      // initialize start time point of all active timers
+      m_timerHeap.clear();
+      for(auto timer : m_timers) {
+        if(timer->active()) {
+          armTimer(timer, TimerClock::now() + std::chrono::milliseconds(timer->interval()));
         }
       }
+      
+      std::vector<std::pair<AppTimer*, unsigned long long>> expiredTimers;
+      
       while(not m_timerStopFlag.load()) {
-        {
-          std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
-          for(auto timer : m_timers) {
-            if(timer->active()) {
-              const unsigned int timeoutEllapsed = std::chrono::duration_cast<std::chrono::milliseconds>(core::time::now()-timer->m_startTime).count();
-              const bool timeoutReached = (timeoutEllapsed >= timer->interval());
-              if(timeoutReached) {
-                // process timer timeout in event loop
-                processFunction([timer](){
-                  timer->m_signal.emit();
-                });
-                // stop it if single shot
-                if(timer->singleShot()) {
-                  timer->m_active = false;
-                }
-                else {
-                  timer->m_startTime = core::time::now();
-                }
-              }
-            }
-            if(m_timerStopFlag.load()) {
-              break;
+        // sleep until the next deadline or until a timer is (re)started
+        auto wakeUp = [this](){
+          return (m_timersChanged or m_timerStopFlag.load());
+        };
+        if(m_timerHeap.empty()) {
+          m_timerCondition.wait(lock, wakeUp);
+        }
+        else {
+          m_timerCondition.wait_until(lock, m_timerHeap.front().m_deadline, wakeUp);
+        }
+        m_timersChanged = false;
+        
+        if(m_timerStopFlag.load()) {
+          break;
+        }
+        
+        // collect the expired timers
+        const auto now = TimerClock::now();
+        
+        while(not m_timerHeap.empty() and m_timerHeap.front().m_deadline <= now) {
+          std::pop_heap(m_timerHeap.begin(), m_timerHeap.end(), TimerCompare());
+          const TimerEntry entry = m_timerHeap.back();
+          m_timerHeap.pop_back();
+          
+          // stale entry: timer removed, stopped or restarted
+          if(m_timers.end() == m_timers.find(entry.m_timer) or entry.m_timerId != entry.m_timer->m_timerId) {
+            continue;
+          }
+          expiredTimers.push_back(std::make_pair(entry.m_timer, entry.m_timerId));
+          
+          if(entry.m_timer->singleShot()) {
+            entry.m_timer->m_active = false;
+          }
+          else {
+            // re-arm from the previous deadline to not accumulate drift
+            auto deadline = entry.m_deadline + std::chrono::milliseconds(entry.m_timer->interval());
+            if(deadline <= now) {
+              deadline = now + std::chrono::milliseconds(entry.m_timer->interval());
             }
+            entry.m_timer->m_startTime = core::time::now();
+            m_timerHeap.push_back({deadline, entry.m_timer, entry.m_timerId});
+            std::push_heap(m_timerHeap.begin(), m_timerHeap.end(), TimerCompare());
           }
         }
-        usleep(100);
+        
+        if(expiredTimers.empty()) {
+          continue;
+        }
+        
+        // process timer timeouts in event loop, without holding the timer lock
+        lock.unlock();
+        
+        for(auto &expired : expiredTimers) {
+          processFunction([this, &expired](){
+            {
+              // the timer may have been removed or restarted meanwhile
+              std::lock_guard<std::mutex> timerLock(m_timerMutex);
+              if(m_timers.end() == m_timers.find(expired.first) or expired.second != expired.first->m_timerId) {
+                return;
+              }
+            }
+            expired.first->m_signal.emit();
+          });
+        }
+        expiredTimers.clear();
+        lock.lock();
       }
       dqm_debug( "Exiting timer thread !" );
     }
     
     //-------------------------------------------------------------------------------------------------
     
+    void AppEventLoop::armTimer(AppTimer *timer, TimerClock::time_point deadline) {
+      timer->m_timerId = ++m_lastTimerId;
+      timer->m_startTime = core::time::now();
+      m_timerHeap.push_back({deadline, timer, timer->m_timerId});
+      std::push_heap(m_timerHeap.begin(), m_timerHeap.end(), TimerCompare());
+      
+      // drop stale entries if too many timers have been restarted or stopped
+      if(m_timerHeap.size() > 4*m_timers.size() + 16) {
+        auto newEnd = std::remove_if(m_timerHeap.begin(), m_timerHeap.end(), [this](const TimerEntry &entry){
+          return (m_timers.end() == m_timers.find(entry.m_timer) or entry.m_timerId != entry.m_timer->m_timerId);
+        });
+        m_timerHeap.erase(newEnd, m_timerHeap.end());
+        std::make_heap(m_timerHeap.begin(), m_timerHeap.end(), TimerCompare());
+      }
+      m_timersChanged = true;
+      m_timerCondition.notify_one();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void AppEventLoop::addTimer(AppTimer *timer) {
-      std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
+      std::lock_guard<std::mutex> lock(m_timerMutex);
       m_timers.insert(timer);
     }
     
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::startTimer(AppTimer *timer) {
-      std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
-      timer->m_startTime = core::time::now();
+      std::lock_guard<std::mutex> lock(m_timerMutex);
       timer->m_active = true;
+      
+      if(m_timers.end() != m_timers.find(timer)) {
+        armTimer(timer, TimerClock::now() + std::chrono::milliseconds(timer->interval()));
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::stopTimer(AppTimer *timer) {
-      std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
+      std::lock_guard<std::mutex> lock(m_timerMutex);
       auto findIter = m_timers.find(timer);
       if(m_timers.end() != findIter) {
         (*findIter)->m_active = false;
+        // invalidates the pending heap entry
+        (*findIter)->m_timerId = 0;
       }
     }
     
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::removeTimer(AppTimer *timer) {
+      // wait for a running timeout callback to finish
+      std::lock_guard<std::recursive_mutex> eventLock(m_eventMutex);
       stopTimer(timer);
-      std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
-      m_timers.erase(timer);
+      {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        m_timers.erase(timer);
+      }
       delete timer;
     }
     
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    AppEventLoop::EventLane::EventLane() :
+      m_stub(AppEvent::NONE),
+      m_head(&m_stub),
+      m_tail(&m_stub) {
+      /* nop */
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::EventLane::push(AppEvent *pAppEvent) {
+      ++m_count;
+      link(pAppEvent);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    AppEvent *AppEventLoop::EventLane::pop() {
+      AppEvent *tail = m_tail;
+      AppEvent *next = tail->m_next.load(std::memory_order_acquire);
+      
+      // skip the stub node
+      if(&m_stub == tail) {
+        if(nullptr == next) {
+          return nullptr;
+        }
+        m_tail = next;
+        tail = next;
+        next = next->m_next.load(std::memory_order_acquire);
+      }
+      
+      if(nullptr != next) {
+        m_tail = next;
+        --m_count;
+        return tail;
+      }
+      
+      // a producer has swapped the head but not yet linked its event
+      if(tail != m_head.load(std::memory_order_acquire)) {
+        return nullptr;
+      }
+      
+      // last event in the lane: re-insert the stub behind it to release it
+      link(&m_stub);
+      next = tail->m_next.load(std::memory_order_acquire);
+      
+      if(nullptr != next) {
+        m_tail = next;
+        --m_count;
+        return tail;
+      }
+      return nullptr;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::EventLane::link(AppEvent *pAppEvent) {
+      pAppEvent->m_next.store(nullptr, std::memory_order_relaxed);
+      AppEvent *previous = m_head.exchange(pAppEvent, std::memory_order_acq_rel);
+      previous->m_next.store(pAppEvent, std::memory_order_release);
+    }
+
   }
 
 }
-
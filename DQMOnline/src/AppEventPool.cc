@@ -0,0 +1,76 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include "dqm4hep/AppEventPool.h"
+
+namespace dqm4hep {
+
+  namespace online {
+
+    AppEventPool::AppEventPool(unsigned int cap) :
+      m_capacity(cap) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AppEventPool::~AppEventPool() {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned long AppEventPool::hits() const {
+      return m_hits.load();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned long AppEventPool::misses() const {
+      return m_misses.load();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int AppEventPool::capacity() const {
+      return m_capacity;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AppEventPool::release(AppEvent *pAppEvent) {
+      if(nullptr == pAppEvent) {
+        return;
+      }
+      if(nullptr != pAppEvent->m_pool) {
+        pAppEvent->m_pool->recycle(pAppEvent);
+      }
+      else {
+        delete pAppEvent;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AppEventPool::adopt(AppEvent *pAppEvent) {
+      pAppEvent->m_pool = this;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AppEventPool::reset(AppEvent *pAppEvent, int type) {
+      pAppEvent->m_type = type;
+      pAppEvent->m_priority = 50;
+    }
+
+  }
+
+}
@@ -20,6 +20,31 @@ namespace dqm4hep {
 
   namespace online {
     
+    /**
+     *  @brief  PendingEvent class.
+     *          A network event posted by a NetworkHandler, counting the 
+     *          number of events of the handler still pending in the event loop
+     */
+    template <typename T>
+    class PendingEvent : public T {
+    public:
+      PendingEvent(const std::string &name, net::BufferModelPtr bufferModel, std::shared_ptr<std::atomic_int> counter) :
+        T(name, bufferModel),
+        m_counter(counter) {
+        ++(*m_counter);
+      }
+      
+      ~PendingEvent() {
+        --(*m_counter);
+      }
+      
+    private:
+      std::shared_ptr<std::atomic_int>     m_counter;
+    };
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
     Application::~Application() {
       removeTimer(m_appStatTimer);
     }
@@ -270,6 +295,12 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    void Application::notifyServerOnExit(const std::string &serverName) {
+      m_client.notifyServerOnExit(serverName);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void Application::queuedSubscribe(const std::string &serviceName, int priority, int maxNEvents) {
       if(noServer()){
         throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
@@ -369,6 +400,9 @@ namespace dqm4hep {
       std::strftime(date_buf, sizeof(date_buf), "%Y-%m-%d %H:%M:%S", tm_time);
 
       sendStat("LastUpdate", date_buf );
+      
+      sendStat("EventPoolHits", m_eventLoop.poolHits());
+      sendStat("EventPoolMisses", m_eventLoop.poolMisses());
       dqm_debug( "Sending internal app stats ... OK" );
     }
     
@@ -393,6 +427,10 @@ namespace dqm4hep {
       // Last Update
       createStatsEntry("LastUpdate", "%Y-%m-%d %H:%M:%S", "The time the last statistics update occured (unit %Y-%m-%d %H:%M:%S)");
 
+      // Event pools
+      createStatsEntry("EventPoolHits", "", "The total number of events posted in the event loop by re-using a pooled event");
+      createStatsEntry("EventPoolMisses", "", "The total number of events posted in the event loop from an event pool by a new allocation");
+
       // Network
       // createStatsEntry("CPU", "%", "The current resident set size memory in use by the application (unit Mo)");
       // createStatsEntry("CPU", "%", "The current resident set size memory percentage in use by the application compare to the total available on the host (unit %)");
@@ -433,12 +471,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void Application::NetworkHandler::postServiceContent(const net::Buffer &buffer) {
-      int count = m_eventLoop.count([this](AppEvent* ptr){
-        ServiceUpdateEvent *evt = dynamic_cast<ServiceUpdateEvent*>(ptr);
-        return (evt && evt->serviceName() == this->m_name);
-      });
-      
-      if(count >= m_maxNEvents) {
+      if(m_nPendingEvents->load() >= m_maxNEvents) {
         dqm_debug( "NetworkHandler::postServiceContent(): maximum of posted service updates reached ({0}) !", m_maxNEvents );
         return;
       }
@@ -452,7 +485,7 @@ namespace dqm4hep {
       bufferModel->move(std::move(content));
       
       // create the event to post, pass the copied buffer in ctor
-      ServiceUpdateEvent *pEvent = new ServiceUpdateEvent(m_name, bufferModel);
+      ServiceUpdateEvent *pEvent = new PendingEvent<ServiceUpdateEvent>(m_name, bufferModel, m_nPendingEvents);
       pEvent->setPriority(m_priority);
       
       // post the event !
@@ -478,12 +511,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void Application::NetworkHandler::postCommandEvent(const net::Buffer &buffer) {
-      int count = m_eventLoop.count([this](AppEvent* ptr){
-        CommandEvent *evt = dynamic_cast<CommandEvent*>(ptr);
-        return (evt && evt->commandName() == this->m_name);
-      });
-      
-      if(count >= m_maxNEvents) {
+      if(m_nPendingEvents->load() >= m_maxNEvents) {
         dqm_debug( "NetworkHandler::postCommandEvent(): maximum of posted command handling reached ({0}) !", m_maxNEvents );
         return;
       }
@@ -497,7 +525,7 @@ namespace dqm4hep {
       bufferModel->move(std::move(content));
       
       // create the event to post, pass the copied buffer in ctor
-      CommandEvent *pEvent = new CommandEvent(m_name, bufferModel);
+      CommandEvent *pEvent = new PendingEvent<CommandEvent>(m_name, bufferModel, m_nPendingEvents);
       pEvent->setPriority(m_priority);
       
       // post the event !
@@ -12,6 +12,9 @@
 #include "dqm4hep/Cycle.h"
 #include "dqm4hep/AppEvents.h"
 
+// -- std headers
+#include <algorithm>
+
 namespace dqm4hep {
 
   namespace online {
@@ -34,7 +37,11 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     Cycle::~Cycle() {
-      m_stopFlag = true;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlag = true;
+      }
+      m_condition.notify_all();
       m_thread.join();
     }
     
@@ -48,6 +55,7 @@ namespace dqm4hep {
 
     void Cycle::setTimeout(unsigned int value) {
       m_timeout = value;
+      notifyCycle();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -60,6 +68,7 @@ namespace dqm4hep {
     
     void Cycle::setTimerPeriod(unsigned int value) {
       m_period = value;
+      notifyCycle();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -72,6 +81,7 @@ namespace dqm4hep {
 
     void Cycle::setCounterLimit(unsigned int value) {
       m_counterLimit = value;
+      notifyCycle();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -91,8 +101,13 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void Cycle::incrementCounter(unsigned int increment) {
-      m_currentCounter += increment;
-      m_lastCounterIncrement = core::time::now();
+      const unsigned int counter = (m_currentCounter += increment);
+      m_lastCounterIncrement = CycleClock::now().time_since_epoch().count();
+      const unsigned int limit = m_counterLimit.load();
+      // wake up the cycle thread only when the limit is crossed
+      if(0 != limit and counter >= limit and counter - increment < limit) {
+        notifyCycle();
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -103,21 +118,30 @@ namespace dqm4hep {
         throw core::StatusCodeException(core::STATUS_CODE_FAILURE);
       }
       forceStopCycle(true, emit);
-      m_startCycleFlag = true;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_startCycleFlag = true;
+      }
+      m_condition.notify_all();
       dqm_debug( "=====> Started new cycle !" );
     }
     
     //-------------------------------------------------------------------------------------------------
 
     void Cycle::forceStopCycle(bool waitEnd, bool emit) {
-      if(running()) {
+      std::shared_future<void> endFuture;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(not running()) {
+          return;
+        }
         m_eocEmit = emit;
         m_forceStopFlag = true;
-        if(waitEnd) {
-          while(running()) {
-            usleep(1000);
-          }          
-        }
+        endFuture = m_endFuture;
+      }
+      m_condition.notify_all();
+      if(waitEnd) {
+        endFuture.wait();
       }
     }
     
@@ -130,34 +154,40 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     void Cycle::cycleLoop() {
+      std::unique_lock<std::mutex> lock(m_mutex);
       while(1) {
+        // wait for a new cycle to start
+        m_condition.wait(lock, [this](){
+          return (m_stopFlag.load() or m_startCycleFlag.load());
+        });
         if(m_stopFlag.load()) {
-          break;          
-        }
-        if(not m_startCycleFlag.load()) {
-          usleep(10000);
-          continue;
+          break;
         }
         // start of cycle here
-        m_running = true;
+        m_endPromise = std::promise<void>();
+        m_endFuture = m_endPromise.get_future().share();
         m_forceStopFlag = false;
         m_eocEmit = true;
         EOCCondition condition;
         condition.m_startTime = core::time::now();
         condition.m_forcedEnd = false;
-        m_lastCounterIncrement = condition.m_startTime;
+        const CycleClock::time_point startTime = CycleClock::now();
+        m_lastCounterIncrement = startTime.time_since_epoch().count();
         m_currentCounter = 0;
+        m_running = true;
         while(1) {
           if(m_stopFlag.load() or m_forceStopFlag.load()) {
             condition.m_forcedEnd = true;
             if(m_eocEmit.load()) {
               endOfCycle(condition);
-              break;
             }
+            break;
           }
-          const core::time::point now = core::time::now();
-          const float timeoutEllapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now-m_lastCounterIncrement).count() / 1000.f;
-          const bool timeoutReached = (0 == m_timeout) ? false : (timeoutEllapsed >= m_timeout.load());
+          const CycleClock::time_point now = CycleClock::now();
+          const CycleClock::time_point lastIncrement(CycleClock::duration(m_lastCounterIncrement.load()));
+          const std::chrono::seconds timeout(m_timeout.load());
+          const std::chrono::seconds period(m_period.load());
+          const bool timeoutReached = (0 == timeout.count()) ? false : (now - lastIncrement >= timeout);
           // check timeout first
           if(timeoutReached) {
             condition.m_timeoutReached = true;
@@ -166,25 +196,48 @@ namespace dqm4hep {
           }
           // check for normal termination of cycle
           const bool counterOver = (0 == m_counterLimit) ? false : (m_currentCounter >= m_counterLimit);
-          const float ellapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now-condition.m_startTime).count() / 1000.f;
-          const bool periodReached = (0 == m_period) ? false : (ellapsed >= m_period.load());
+          const bool periodReached = (0 == period.count()) ? false : (now - startTime >= period);
           if(counterOver or periodReached) {
             endOfCycle(condition);
             break;
           }
-          usleep(10000);
+          // sleep until the next timeout/period deadline or until notified
+          auto wakeUp = [this](){
+            return (m_stopFlag.load() or m_forceStopFlag.load() or 
+              (0 != m_counterLimit and m_currentCounter >= m_counterLimit));
+          };
+          if(0 == timeout.count() and 0 == period.count()) {
+            m_condition.wait(lock, wakeUp);
+          }
+          else {
+            CycleClock::time_point deadline = CycleClock::time_point::max();
+            if(0 != period.count()) {
+              deadline = startTime + period;
+            }
+            if(0 != timeout.count()) {
+              deadline = std::min(deadline, lastIncrement + timeout);
+            }
+            m_condition.wait_until(lock, deadline, wakeUp);
+          }
         }
         // reset cycle properties
         m_startCycleFlag = false;
         m_forceStopFlag = false;
         m_eocEmit = true;
         m_running = false;
-        usleep(10000);
+        m_endPromise.set_value();
       }
     }
     
     //-------------------------------------------------------------------------------------------------
     
+    void Cycle::notifyCycle() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_condition.notify_all();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void Cycle::endOfCycle(EOCCondition &condition) {
       condition.m_endTime = core::time::now();
       condition.m_counter = m_currentCounter.load();
@@ -192,7 +245,7 @@ namespace dqm4hep {
       condition.m_rate = (condition.m_startTime == condition.m_endTime) ? 0 : (condition.m_counter / condition.m_totalTime);
       dqm_debug( "End of cycle !" );
       // post event to event loop
-      auto *event = new StoreEvent<EOCCondition>(AppEvent::END_OF_CYCLE, condition);
+      auto *event = m_eventLoop.storeEventPool<EOCCondition>().create(AppEvent::END_OF_CYCLE, condition);
       event->setPriority(m_eventPriority.load());
       m_eventLoop.postEvent(event);
     }
@@ -0,0 +1,155 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/ElementBatch.h>
+#include <dqm4hep/Logging.h>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    const std::string ElementBatch::m_marker = "dqm4hep::ElementBatch";
+
+    //-------------------------------------------------------------------------------------------------
+
+    ElementBatch::ElementBatch() {
+      clear();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode ElementBatch::addElement(const std::string &moduleName, const OnlineElement &element) {
+      // ROOT writes the object and class references as offsets from the buffer start:
+      // the element is serialized at the start of its own buffer, so that it can be
+      // read on its own once copied in the batch, stored or re-packed by a collector
+      m_elementBuffer.Reset();
+      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, element.write(m_elementBuffer));
+      writeElement(moduleName, element.path(), element.name(), element.type(), m_elementBuffer.Buffer(), m_elementBuffer.Length());
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementBatch::addElement(const Frame &frame) {
+      writeElement(frame.m_moduleName, frame.m_path, frame.m_name, frame.m_type, frame.m_buffer, frame.m_size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementBatch::clear() {
+      m_buffer.Reset();
+      m_buffer.WriteStdString(&m_marker);
+      m_nElementsOffset = m_buffer.Length();
+      m_nElements = 0;
+      m_buffer.WriteInt(m_nElements);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ElementBatch::empty() const {
+      return (0 == m_nElements);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ElementBatch::nElements() const {
+      return m_nElements;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const char *ElementBatch::buffer() const {
+      return m_buffer.Buffer();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ElementBatch::size() const {
+      return m_buffer.Length();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode ElementBatch::readFrames(const char *buffer, unsigned int size, std::vector<Frame> &frames) {
+      if(nullptr == buffer || 0 == size) {
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      TBufferFile inputBuffer(TBuffer::kRead, size, const_cast<char*>(buffer), false);
+      std::string marker;
+      inputBuffer.ReadStdString(&marker);
+      if(marker != m_marker) {
+        dqm_error( "ElementBatch::readFrames: not an element batch frame !" );
+        return core::STATUS_CODE_FAILURE;
+      }
+      Int_t nBatchElements(0);
+      inputBuffer.ReadInt(nBatchElements);
+      frames.reserve(frames.size() + nBatchElements);
+      Frame frame;
+
+      for(Int_t e=0 ; e<nBatchElements ; e++) {
+        inputBuffer.ReadStdString(&frame.m_moduleName);
+        inputBuffer.ReadStdString(&frame.m_path);
+        inputBuffer.ReadStdString(&frame.m_name);
+        inputBuffer.ReadStdString(&frame.m_type);
+        Int_t elementSize(0);
+        inputBuffer.ReadInt(elementSize);
+        const Int_t elementOffset(inputBuffer.Length());
+
+        if(elementSize < 0 || elementOffset + elementSize > static_cast<Int_t>(size)) {
+          dqm_error( "ElementBatch::readFrames: corrupted batch frame (element {0}/{1}) !", e, nBatchElements );
+          return core::STATUS_CODE_FAILURE;
+        }
+        frame.m_buffer = buffer + elementOffset;
+        frame.m_size = elementSize;
+        frames.push_back(frame);
+        inputBuffer.SetBufferOffset(elementOffset + elementSize);
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode ElementBatch::readElements(const char *buffer, unsigned int size, OnlineElementPtrList &elements) {
+      std::vector<Frame> frames;
+      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ElementBatch::readFrames(buffer, size, frames));
+      elements.reserve(elements.size() + frames.size());
+
+      for(const auto &frame : frames) {
+        TBufferFile inputBuffer(TBuffer::kRead, frame.m_size, const_cast<char*>(frame.m_buffer), false);
+        OnlineElementPtr element = OnlineElement::make_shared();
+        RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, element->read(inputBuffer));
+        elements.push_back(element);
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementBatch::writeElement(const std::string &moduleName, const std::string &path, const std::string &name,
+      const std::string &type, const char *buffer, unsigned int size) {
+      m_buffer.WriteStdString(&moduleName);
+      m_buffer.WriteStdString(&path);
+      m_buffer.WriteStdString(&name);
+      m_buffer.WriteStdString(&type);
+      m_buffer.WriteInt(static_cast<Int_t>(size));
+      m_buffer.WriteFastArray(buffer, size);
+      ++m_nElements;
+
+      // update the number of elements in the header
+      const Int_t length(m_buffer.Length());
+      m_buffer.SetBufferOffset(m_nElementsOffset);
+      m_buffer.WriteInt(m_nElements);
+      m_buffer.SetBufferOffset(length);
+    }
+
+  }
+
+}
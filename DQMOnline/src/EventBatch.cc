@@ -0,0 +1,250 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics 
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/EventBatch.h>
+#include <dqm4hep/Logging.h>
+
+namespace dqm4hep {
+
+  namespace online {
+    
+    const std::string EventBatch::m_marker = "dqm4hep::EventBatch";
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    EventBatch::EventBatch() {
+      clear();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventBatch::addEvent(const char *buffer, unsigned int size) {
+      if(0 == m_nEvents) {
+        m_firstEventTime = core::time::now();
+      }
+      m_buffer.WriteInt(static_cast<Int_t>(size));
+      m_buffer.WriteFastArray(buffer, size);
+      ++m_nEvents;
+      
+      // update the number of events in the header
+      const Int_t length(m_buffer.Length());
+      m_buffer.SetBufferOffset(m_nEventsOffset);
+      m_buffer.WriteInt(m_nEvents);
+      m_buffer.SetBufferOffset(length);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventBatch::clear() {
+      m_buffer.Reset();
+      m_buffer.WriteStdString(&m_marker);
+      m_nEventsOffset = m_buffer.Length();
+      m_nEvents = 0;
+      m_buffer.WriteInt(m_nEvents);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventBatch::empty() const {
+      return (0 == m_nEvents);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int EventBatch::nEvents() const {
+      return m_nEvents;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    const char *EventBatch::buffer() const {
+      return m_buffer.Buffer();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int EventBatch::size() const {
+      return m_buffer.Length();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    const core::time::point &EventBatch::firstEventTime() const {
+      return m_firstEventTime;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventBatch::isBatch(const char *buffer, unsigned int size) {
+      if(nullptr == buffer || 0 == size) {
+        return false;
+      }
+      TBufferFile inputBuffer(TBuffer::kRead, size, const_cast<char*>(buffer), false);
+      Int_t nBatchEvents(0);
+      return readHeader(inputBuffer, nBatchEvents);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int EventBatch::nEvents(const char *buffer, unsigned int size) {
+      if(nullptr == buffer || 0 == size) {
+        return 0;
+      }
+      TBufferFile inputBuffer(TBuffer::kRead, size, const_cast<char*>(buffer), false);
+      Int_t nBatchEvents(0);
+      return readHeader(inputBuffer, nBatchEvents) ? nBatchEvents : 1;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode EventBatch::readEvents(core::EventStreamer &streamer, const char *buffer, unsigned int size, core::EventList &events) {
+      if(nullptr == buffer || 0 == size) {
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      TBufferFile inputBuffer(TBuffer::kRead, size, const_cast<char*>(buffer), false);
+      return readEvents(streamer, inputBuffer, buffer, size, events);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode EventBatch::readEvents(core::EventStreamer &streamer, TBuffer &inputBuffer, const char *buffer, unsigned int size, core::EventList &events) {
+      if(nullptr == buffer || 0 == size || not inputBuffer.IsReading()) {
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      inputBuffer.SetBuffer(const_cast<char*>(buffer), size, false);
+      Int_t nBatchEvents(0);
+      
+      // single event frame
+      if(not readHeader(inputBuffer, nBatchEvents)) {
+        inputBuffer.SetBufferOffset(0);
+        core::EventPtr event(nullptr);
+        RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, streamer.readEvent(event, inputBuffer));
+        events.push_back(event);
+        return core::STATUS_CODE_SUCCESS;
+      }
+      
+      events.reserve(events.size() + nBatchEvents);
+      
+      for(Int_t e=0 ; e<nBatchEvents ; e++) {
+        Int_t eventSize(0);
+        inputBuffer.ReadInt(eventSize);
+        const Int_t eventOffset(inputBuffer.Length());
+        
+        if(eventSize < 0 || eventOffset + eventSize > static_cast<Int_t>(size)) {
+          dqm_error( "EventBatch::readEvents: corrupted batch frame (event {0}/{1}) !", e, nBatchEvents );
+          return core::STATUS_CODE_FAILURE;
+        }
+        core::EventPtr event(nullptr);
+        RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, streamer.readEvent(event, inputBuffer));
+        events.push_back(event);
+        // the next event starts right after the declared size
+        inputBuffer.SetBufferOffset(eventOffset + eventSize);
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode EventBatch::readHeaders(const char *buffer, unsigned int size, std::vector<core::EventHeader> &headers) {
+      if(nullptr == buffer || 0 == size) {
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      TBufferFile inputBuffer(TBuffer::kRead, size, const_cast<char*>(buffer), false);
+      Int_t nBatchEvents(0);
+      core::EventHeader header;
+      
+      // single event frame
+      if(not readHeader(inputBuffer, nBatchEvents)) {
+        if(not core::EventHeader::peek(buffer, size, header)) {
+          return core::STATUS_CODE_FAILURE;
+        }
+        headers.push_back(header);
+        return core::STATUS_CODE_SUCCESS;
+      }
+      
+      headers.reserve(headers.size() + nBatchEvents);
+      
+      for(Int_t e=0 ; e<nBatchEvents ; e++) {
+        Int_t eventSize(0);
+        inputBuffer.ReadInt(eventSize);
+        const Int_t eventOffset(inputBuffer.Length());
+        
+        if(eventSize < 0 || eventOffset + eventSize > static_cast<Int_t>(size)) {
+          dqm_error( "EventBatch::readHeaders: corrupted batch frame (event {0}/{1}) !", e, nBatchEvents );
+          return core::STATUS_CODE_FAILURE;
+        }
+        if(not core::EventHeader::peek(buffer + eventOffset, eventSize, header)) {
+          return core::STATUS_CODE_FAILURE;
+        }
+        headers.push_back(header);
+        inputBuffer.SetBufferOffset(eventOffset + eventSize);
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode EventBatch::readFrames(const char *buffer, unsigned int size, std::vector<Frame> &frames) {
+      if(nullptr == buffer || 0 == size) {
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      TBufferFile inputBuffer(TBuffer::kRead, size, const_cast<char*>(buffer), false);
+      Int_t nBatchEvents(0);
+      Frame frame;
+      
+      // single event frame
+      if(not readHeader(inputBuffer, nBatchEvents)) {
+        if(not core::EventHeader::peek(buffer, size, frame.m_header)) {
+          return core::STATUS_CODE_FAILURE;
+        }
+        frame.m_buffer = buffer;
+        frame.m_size = size;
+        frames.push_back(frame);
+        return core::STATUS_CODE_SUCCESS;
+      }
+      
+      frames.reserve(frames.size() + nBatchEvents);
+      
+      for(Int_t e=0 ; e<nBatchEvents ; e++) {
+        Int_t eventSize(0);
+        inputBuffer.ReadInt(eventSize);
+        const Int_t eventOffset(inputBuffer.Length());
+        
+        if(eventSize < 0 || eventOffset + eventSize > static_cast<Int_t>(size)) {
+          dqm_error( "EventBatch::readFrames: corrupted batch frame (event {0}/{1}) !", e, nBatchEvents );
+          return core::STATUS_CODE_FAILURE;
+        }
+        if(not core::EventHeader::peek(buffer + eventOffset, eventSize, frame.m_header)) {
+          return core::STATUS_CODE_FAILURE;
+        }
+        frame.m_buffer = buffer + eventOffset;
+        frame.m_size = eventSize;
+        frames.push_back(frame);
+        inputBuffer.SetBufferOffset(eventOffset + eventSize);
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventBatch::readHeader(TBuffer &buffer, Int_t &nBatchEvents) {
+      std::string marker;
+      buffer.ReadStdString(&marker);
+      if(marker != m_marker) {
+        return false;
+      }
+      buffer.ReadInt(nBatchEvents);
+      return true;
+    }
+
+  }
+
+}
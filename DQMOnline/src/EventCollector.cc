@@ -10,6 +10,8 @@
 
 // -- dqm4hep headers
 #include "dqm4hep/EventCollector.h"
+#include "dqm4hep/EventBatch.h"
+#include "dqm4hep/EventStreamer.h"
 #include "dqm4hep/DQM4hepConfig.h"
 #include "dqm4hep/Logging.h"
 #include "dqm4hep/OnlineRoutes.h"
@@ -27,6 +29,7 @@ namespace dqm4hep {
     EventCollector::~EventCollector() {
       removeTimer(m_statsTimer10);
       removeTimer(m_statsTimer60);
+      removeTimer(m_latestTimer);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -89,6 +92,16 @@ namespace dqm4hep {
         this, 
         &EventCollector::handleCollectEvent
       );
+      createRequestHandler(
+        OnlineRoutes::EventCollector::subscribe(name()), 
+        this, 
+        &EventCollector::handleSubscription
+      );
+      createDirectCommand(
+        OnlineRoutes::EventCollector::unsubscribe(name()), 
+        this, 
+        &EventCollector::handleUnsubscription
+      );
       
       // create statistics entries
       createStatsEntry("NSources", "", "The current number of registered sources");
@@ -98,6 +111,10 @@ namespace dqm4hep {
       createStatsEntry("NBytes_10sec", "bytes", "The total number of collected bytes within the last 10 secondes");
       createStatsEntry("NMeanBytes_60sec", "bytes/min", "The mean number of collected bytes within the last minute");
       createStatsEntry("NMeanBytes_10sec", "bytes/10 sec", "The mean number of collected bytes within the last 10 secondes");
+      createStatsEntry("CompressionRatio_60sec", "", "The compression ratio (raw/compressed) of the compressed events collected within the last minute");
+      createStatsEntry("CompressionRatio_10sec", "", "The compression ratio (raw/compressed) of the compressed events collected within the last 10 secondes");
+      createStatsEntry("CompressionTime_60sec", "us/event", "The mean source CPU time spent compressing an event collected within the last minute");
+      createStatsEntry("CompressionTime_10sec", "us/event", "The mean source CPU time spent compressing an event collected within the last 10 secondes");
       
       // app stats timers
       m_statsTimer10 = createTimer();
@@ -114,6 +131,13 @@ namespace dqm4hep {
       
       m_statsTimer10->start();
       m_statsTimer60->start();
+      
+      // send the pending updates of the "latest only" subscriptions
+      m_latestTimer = createTimer();
+      m_latestTimer->setInterval(50);
+      m_latestTimer->setSingleShot(false);
+      m_latestTimer->onTimeout().connect(this, &EventCollector::flushLatestUpdates);
+      m_latestTimer->start();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -146,6 +170,8 @@ namespace dqm4hep {
       auto clientId = this->serverClientId();  
       auto findIter = m_sourceInfoMap.find(clientSourceName);
       core::json clientResponseValue({});
+      std::string streamerMessage;
+      core::EventCompression compression;
       
       // source already registered
       if(m_sourceInfoMap.end() != findIter) {
@@ -159,7 +185,24 @@ namespace dqm4hep {
           clientResponseValue["registered"] = false;
         }
       }
-      // source not registered yet
+      // source not registered yet, check the streamer ids first
+      else if(registrationDetails.count("streamers") and 
+        core::STATUS_CODE_SUCCESS != core::EventStreamerRegistry::instance()->checkStreamerTable(registrationDetails["streamers"], streamerMessage)) {
+        clientResponseValue["message"] = "Event streamers mismatch: " + streamerMessage;
+        clientResponseValue["registered"] = false;
+      }
+      // then the source ids written in the event headers
+      else if(registrationDetails.count("sources") and 
+        core::STATUS_CODE_SUCCESS != core::EventNameTable::sourceNames()->fromJson(registrationDetails["sources"], streamerMessage)) {
+        clientResponseValue["message"] = "Event source ids mismatch: " + streamerMessage;
+        clientResponseValue["registered"] = false;
+      }
+      // and the compression of the event payloads
+      else if(registrationDetails.count("compression") and 
+        core::STATUS_CODE_SUCCESS != compression.fromJson(registrationDetails["compression"], streamerMessage)) {
+        clientResponseValue["message"] = "Event compression refused: " + streamerMessage;
+        clientResponseValue["registered"] = false;
+      }
       else {
         std::string sourceName = registrationDetails.value<std::string>("source", "");
         SourceInfo sourceInfo;
@@ -169,6 +212,8 @@ namespace dqm4hep {
         findIter->second.m_name = registrationDetails.value<std::string>("source", "");
         findIter->second.m_streamerName = registrationDetails.value<std::string>("streamer", "");
         findIter->second.m_eventService = createService(OnlineRoutes::EventCollector::eventUpdate(name(), findIter->first));
+        findIter->second.m_selectedEventService = createService(OnlineRoutes::EventCollector::selectedEventUpdate(name(), findIter->first));
+        findIter->second.m_compression = compression;
         
         auto collectors = registrationDetails["collectors"];
         auto hostInfo = registrationDetails["host"];
@@ -187,6 +232,7 @@ namespace dqm4hep {
         dqm_info( "New event source '{0}' registered with client id {1}", findIter->second.m_name, findIter->second.m_clientId );
         
         clientResponseValue["registered"] = true;
+        compression.toJson(clientResponseValue["compression"]);
         sendStat("NSources", m_sourceInfoMap.size());
       }
       
@@ -208,6 +254,13 @@ namespace dqm4hep {
         m_sourceInfoMap.erase(findIter);
         sendStat("NSources", m_sourceInfoMap.size());
       }
+      // the client may also be an event subscriber
+      for(auto &subscriptions : m_subscriptions) {
+        subscriptions.second.erase(clientId);
+      }
+      for(auto &pendingUpdates : m_pendingUpdates) {
+        pendingUpdates.second.erase(clientId);
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -219,18 +272,229 @@ namespace dqm4hep {
         return (iter.second.m_clientId == clientId);
       });
       
-      if(findIter != m_sourceInfoMap.end()) {          
-        std::string copiedBuffer(buffer.begin(), buffer.size());
-        auto newModel = findIter->second.m_buffer.createModel<std::string>();
-        findIter->second.m_buffer.setModel(newModel);
-        newModel->move(std::move(copiedBuffer));
+      if(findIter != m_sourceInfoMap.end()) {
+        // retain the event in a pooled buffer, shared with the 
+        // service update and the event requests
+        auto model = m_bufferPool.copy(buffer.begin(), buffer.size());
+        findIter->second.m_buffer.setModel(model);
         
-        m_nCollectedEvents10++;
-        m_nCollectedEvents60++;
+        // a single event or a batch of events (see EventBatch)
+        const unsigned int nEvents(EventBatch::nEvents(buffer.begin(), buffer.size()));
+        m_nCollectedEvents10 += nEvents;
+        m_nCollectedEvents60 += nEvents;
         m_nCollectedBytes10 += buffer.size();
         m_nCollectedBytes60 += buffer.size();
+        // compression stats, from the event headers only
+        if(findIter->second.m_compression.enabled()) {
+          this->collectCompressionStats(buffer);
+        }
         // send update
-        findIter->second.m_eventService->sendBuffer(buffer.begin(), buffer.size());
+        this->sendEventUpdate(findIter->first, findIter->second.m_eventService, findIter->second.m_selectedEventService, model->raw().begin(), model->raw().size());
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollector::collectCompressionStats(const net::Buffer &buffer) {
+      m_eventHeaders.clear();
+      if(core::STATUS_CODE_SUCCESS != EventBatch::readHeaders(buffer.begin(), buffer.size(), m_eventHeaders)) {
+        return;
+      }
+      for(const auto &header : m_eventHeaders) {
+        if(not header.compressed()) {
+          continue;
+        }
+        m_nCompressedEvents10++;
+        m_nCompressedEvents60++;
+        m_nRawPayloadBytes10 += header.m_rawPayloadSize;
+        m_nRawPayloadBytes60 += header.m_rawPayloadSize;
+        m_nCompressedPayloadBytes10 += header.m_payloadSize;
+        m_nCompressedPayloadBytes60 += header.m_payloadSize;
+        m_compressionTime10 += header.m_compressionTime;
+        m_compressionTime60 += header.m_compressionTime;
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollector::sendEventUpdate(const std::string &sourceName, net::Service *service, net::Service *selectedService, const char *buffer, std::size_t size) {
+      // all the updates to the clients with no or a non selective subscription
+      service->sendBuffer(buffer, size);
+      // the selective subscriptions are served on their own service
+      auto subIter = m_subscriptions.find(sourceName);
+      if(m_subscriptions.end() != subIter && not subIter->second.empty()) {
+        this->dispatchEventUpdate(sourceName, subIter->second, selectedService, buffer, size, false);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollector::flushLatestUpdates() {
+      for(auto &subscriptions : m_subscriptions) {
+        const bool pending = std::any_of(subscriptions.second.begin(), subscriptions.second.end(), [](const SubscriptionMap::value_type &subscription){
+          return subscription.second.pending();
+        });
+        if(not pending) {
+          continue;
+        }
+        auto findIter = m_sourceInfoMap.find(subscriptions.first);
+        if(m_sourceInfoMap.end() == findIter || 0 == findIter->second.m_buffer.size()) {
+          continue;
+        }
+        this->dispatchEventUpdate(subscriptions.first, subscriptions.second, findIter->second.m_selectedEventService, findIter->second.m_buffer.begin(), findIter->second.m_buffer.size(), true);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollector::dispatchEventUpdate(const std::string &sourceName, SubscriptionMap &subscriptions, net::Service *service, const char *buffer, std::size_t size, bool flushPending) {
+      const auto now = core::time::now();
+      PendingUpdateMap &pendingUpdates(m_pendingUpdates[sourceName]);
+      // split the update in events only if a subscriber filters them.
+      // The pending updates of the filtered subscriptions are already filtered
+      const bool filtering = not flushPending && std::any_of(subscriptions.begin(), subscriptions.end(), [](const SubscriptionMap::value_type &subscription){
+        return not subscription.second.filter().empty();
+      });
+      bool unfilterable(false);
+      m_eventFrames.clear();
+      if(filtering && core::STATUS_CODE_SUCCESS != EventBatch::readFrames(buffer, size, m_eventFrames)) {
+        // events written without header can't be filtered: forward them as they are
+        m_eventFrames.clear();
+        unfilterable = true;
+        if(m_unfilterableSources.insert(sourceName).second) {
+          dqm_warning( "Events of source '{0}' have no event header and can't be filtered, forwarding them unfiltered", sourceName );
+        }
+      }
+      m_clientIds.clear();
+      m_filteredClientIds.clear();
+      
+      for(auto &subscription : subscriptions) {
+        const EventFilter &filter(subscription.second.filter());
+        if(flushPending && not filter.empty()) {
+          // the latest matching update, retained when it arrived too early
+          auto pendingIter = pendingUpdates.find(subscription.first);
+          if(pendingUpdates.end() != pendingIter && subscription.second.flushPending(now)) {
+            service->sendBuffer(pendingIter->second.data(), pendingIter->second.size(), subscription.first);
+            pendingUpdates.erase(pendingIter);
+          }
+          continue;
+        }
+        const bool filtered(not filter.empty() && not unfilterable);
+        unsigned int nMatches(m_eventFrames.size());
+        if(filtered) {
+          m_matchedFrames.assign(m_eventFrames.size(), false);
+          nMatches = 0;
+          for(std::size_t f=0 ; f<m_eventFrames.size() ; f++) {
+            if(filter.match(m_eventFrames[f].m_header, now)) {
+              m_matchedFrames[f] = true;
+              ++nMatches;
+            }
+          }
+          // non matching updates don't count for the prescale and rate limits
+          if(0 == nMatches) {
+            continue;
+          }
+        }
+        const bool selected = flushPending ? subscription.second.flushPending(now) : subscription.second.select(now);
+        // a filtered update arriving too early (LATEST mode) is retained until the rate allows it
+        if(not filter.empty()) {
+          if(subscription.second.pending()) {
+            std::string &pendingUpdate(pendingUpdates[subscription.first]);
+            if(not filtered || nMatches == m_eventFrames.size()) {
+              pendingUpdate.assign(buffer, size);
+            }
+            else {
+              m_filteredBatch.clear();
+              for(std::size_t f=0 ; f<m_eventFrames.size() ; f++) {
+                if(m_matchedFrames[f]) {
+                  m_filteredBatch.addEvent(m_eventFrames[f].m_buffer, m_eventFrames[f].m_size);
+                }
+              }
+              pendingUpdate.assign(m_filteredBatch.buffer(), m_filteredBatch.size());
+            }
+          }
+          else {
+            pendingUpdates.erase(subscription.first);
+          }
+        }
+        if(not selected) {
+          continue;
+        }
+        if(not filtered || nMatches == m_eventFrames.size()) {
+          m_clientIds.push_back(subscription.first);
+        }
+        else {
+          m_filteredClientIds[m_matchedFrames].push_back(subscription.first);
+        }
+      }
+      // an empty client list would mean all clients
+      if(not m_clientIds.empty()) {
+        service->sendBuffer(buffer, size, m_clientIds);
+      }
+      // re-pack the matching events, once per distinct selection
+      for(const auto &filtered : m_filteredClientIds) {
+        m_filteredBatch.clear();
+        for(std::size_t f=0 ; f<m_eventFrames.size() ; f++) {
+          if(filtered.first[f]) {
+            m_filteredBatch.addEvent(m_eventFrames[f].m_buffer, m_eventFrames[f].m_size);
+          }
+        }
+        service->sendBuffer(m_filteredBatch.buffer(), m_filteredBatch.size(), filtered.second);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollector::handleSubscription(const net::Buffer &request, net::Buffer &response) {
+      core::json subscriptionDetails({}), responseValue({});
+      std::string message;
+      EventSubscription subscription;
+      try {
+        subscriptionDetails = core::json::parse(request.begin(), request.end());
+      }
+      catch(...) {
+        subscriptionDetails = core::json({});
+      }
+      const std::string sourceName(subscriptionDetails.value<std::string>("source", ""));
+      
+      if(sourceName.empty()) {
+        responseValue["message"] = "No source name in subscription request";
+        responseValue["subscribed"] = false;
+      }
+      else if(core::STATUS_CODE_SUCCESS != subscription.fromJson(subscriptionDetails.value<core::json>("subscription", core::json({})), message)) {
+        responseValue["message"] = "Invalid subscription: " + message;
+        responseValue["subscribed"] = false;
+      }
+      else {
+        const int clientId(this->serverClientId());
+        // only the selective subscriptions need a per client dispatch
+        if(subscription.selective()) {
+          m_subscriptions[sourceName][clientId] = subscription;
+        }
+        else {
+          m_subscriptions[sourceName].erase(clientId);
+        }
+        m_pendingUpdates[sourceName].erase(clientId);
+        dqm_info( "Client {0} subscribed to source '{1}' (mode: {2})", clientId, sourceName, EventSubscription::modeName(subscription.mode()) );
+        responseValue["subscribed"] = true;
+      }
+      
+      auto model = response.createModel<std::string>();
+      model->copy(responseValue.dump());
+      response.setModel(model);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollector::handleUnsubscription(const net::Buffer &buffer) {
+      const std::string sourceName(buffer.begin(), buffer.size());
+      auto findIter = m_subscriptions.find(sourceName);
+      if(m_subscriptions.end() != findIter) {
+        findIter->second.erase(this->serverClientId());
+      }
+      auto pendingIter = m_pendingUpdates.find(sourceName);
+      if(m_pendingUpdates.end() != pendingIter) {
+        pendingIter->second.erase(this->serverClientId());
       }
     }
     
@@ -267,9 +531,17 @@ namespace dqm4hep {
       sendStat("NEvents_10sec", m_nCollectedEvents10);
       sendStat("NBytes_10sec", m_nCollectedBytes10);
       sendStat("NMeanBytes_10sec", m_nCollectedBytes10 / (timeDifference/1000.));
+      if(0 != m_nCompressedEvents10) {
+        sendStat("CompressionRatio_10sec", static_cast<double>(m_nRawPayloadBytes10) / m_nCompressedPayloadBytes10);
+        sendStat("CompressionTime_10sec", static_cast<double>(m_compressionTime10) / m_nCompressedEvents10);
+      }
       // reset counters
       m_nCollectedEvents10 = 0;
       m_nCollectedBytes10 = 0;
+      m_nCompressedEvents10 = 0;
+      m_nRawPayloadBytes10 = 0;
+      m_nCompressedPayloadBytes10 = 0;
+      m_compressionTime10 = 0;
       m_lastStatCall10 = core::time::now();
     }
     
@@ -281,9 +553,17 @@ namespace dqm4hep {
       sendStat("NEvents_60sec", m_nCollectedEvents60);
       sendStat("NBytes_60sec", m_nCollectedBytes60);
       sendStat("NMeanBytes_60sec", m_nCollectedBytes60 / (timeDifference/1000.));
+      if(0 != m_nCompressedEvents60) {
+        sendStat("CompressionRatio_60sec", static_cast<double>(m_nRawPayloadBytes60) / m_nCompressedPayloadBytes60);
+        sendStat("CompressionTime_60sec", static_cast<double>(m_compressionTime60) / m_nCompressedEvents60);
+      }
       // reset counters
       m_nCollectedEvents60 = 0;
       m_nCollectedBytes60 = 0;
+      m_nCompressedEvents60 = 0;
+      m_nRawPayloadBytes60 = 0;
+      m_nCompressedPayloadBytes60 = 0;
+      m_compressionTime60 = 0;
       m_lastStatCall60 = core::time::now();
     }
     
@@ -294,6 +574,7 @@ namespace dqm4hep {
         dqm_debug( "== Source '{0}' ==", source.first );
         dqm_debug( "     Client id: '{0}' ==", source.second.m_clientId );
         dqm_debug( "     Streamer:  '{0}' ==", source.second.m_streamerName );
+        dqm_debug( "     Compression: '{0}' ==", core::EventCompression::algorithmName(source.second.m_compression.algorithm()) );
       }
     }
     
@@ -307,8 +588,11 @@ namespace dqm4hep {
       m_collectors(std::move(info.m_collectors)),
       m_hostInfo(std::move(info.m_hostInfo)),
       m_buffer(std::move(info.m_buffer)),
-      m_eventService(info.m_eventService) {
+      m_eventService(info.m_eventService),
+      m_selectedEventService(info.m_selectedEventService),
+      m_compression(info.m_compression) {
       info.m_eventService = nullptr;
+      info.m_selectedEventService = nullptr;
     }
 
   }
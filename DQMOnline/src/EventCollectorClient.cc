@@ -10,6 +10,7 @@
 
 // -- dqm4hep headers
 #include "dqm4hep/EventCollectorClient.h"
+#include "dqm4hep/EventBatch.h"
 #include "dqm4hep/Logging.h"
 #include "dqm4hep/OnlineRoutes.h"
 
@@ -19,8 +20,18 @@ namespace dqm4hep {
     
     
     void EventCollectorClient::SourceInfo::receiveEvent(const net::Buffer &buffer) {
-      core::EventPtr event = m_collectorClient->readEvent(buffer);
-      m_eventUpdateSignal.emit(event);
+      if(nullptr != m_collectorClient->m_decoder) {
+        if(not m_collectorClient->m_decoder->push(buffer.begin(), buffer.size(), m_eventUpdateSignal)) {
+          dqm_debug( "EventCollectorClient: decoding queue full, event frame dropped" );
+        }
+        return;
+      }
+      // the update may contain a batch of events
+      core::EventList events;
+      m_collectorClient->readEvents(buffer, events);
+      for(auto event : events) {
+        m_eventUpdateSignal.emit(event);
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -35,6 +46,7 @@ namespace dqm4hep {
 
     core::EventPtr EventCollectorClient::queryEvent(const std::string &source) {
       core::EventPtr event = nullptr;
+      this->internSourceName(source);
       net::Buffer buffer;
       auto model = buffer.createModel<std::string>();
       buffer.setModel(model);
@@ -43,7 +55,12 @@ namespace dqm4hep {
         OnlineRoutes::EventCollector::eventRequest(m_collectorName),
         buffer,
         [&event,this](const net::Buffer &response){
-          event = this->readEvent(response);
+          // the collector may store a batch of events, take the latest one
+          core::EventList events;
+          this->readEvents(response, events);
+          if(not events.empty()) {
+            event = events.back();
+          }
       });
       return event;
     }
@@ -54,6 +71,19 @@ namespace dqm4hep {
       std::lock_guard<std::recursive_mutex> lock(m_mutex);
       setUpdateMode(source, true);
     }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollectorClient::startEventUpdates(const std::string &source, const EventSubscription &subscription) {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      auto findIter = m_sourceInfoMap.find(source);
+      if(m_sourceInfoMap.end() == findIter) {
+        dqm_error( "EventCollectorClient::startEventUpdates: no source with '{0}' registered !", source );
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_FOUND);
+      }
+      findIter->second.m_subscription = subscription;
+      setUpdateMode(source, true);
+    }
 
     //-------------------------------------------------------------------------------------------------
 
@@ -70,24 +100,32 @@ namespace dqm4hep {
         dqm_error( "EventCollectorClient::setUpdateMode: no source with '{0}' registered !", source );
         throw core::StatusCodeException(core::STATUS_CODE_NOT_FOUND);
       }
-      bool subscribed = m_client.hasSubscribed(OnlineRoutes::EventCollector::eventUpdate(m_collectorName, source));
+      bool subscribed = not findIter->second.m_updateService.empty();
       
       // two cases:
       // 1) already subscribed and don't want to receive updates anymore
       // 2) not subscribed and want to receive updates
       if(subscribed != receiveUpdates) {
         if(receiveUpdates) {
+          this->internSourceName(source);
+          const bool declared = this->declareSubscription(source, findIter->second.m_subscription);
+          // not declared: no selected update would be received, receive all the updates instead
+          findIter->second.m_updateService = (declared and findIter->second.m_subscription.selective()) ? 
+            OnlineRoutes::EventCollector::selectedEventUpdate(m_collectorName, source) :
+            OnlineRoutes::EventCollector::eventUpdate(m_collectorName, source);
           m_client.subscribe(
-            OnlineRoutes::EventCollector::eventUpdate(m_collectorName, source),
+            findIter->second.m_updateService,
             &findIter->second,
             &EventCollectorClient::SourceInfo::receiveEvent
           );          
         }
         else {
           m_client.unsubscribe(
-            OnlineRoutes::EventCollector::eventUpdate(m_collectorName, source), 
+            findIter->second.m_updateService, 
             &findIter->second
           );
+          findIter->second.m_updateService.clear();
+          m_client.sendCommand(OnlineRoutes::EventCollector::unsubscribe(m_collectorName), source);
         }
       }
     }
@@ -101,7 +139,7 @@ namespace dqm4hep {
         dqm_error( "EventCollectorClient::receivingEventUpdates: no source with '{0}' registered !", source );
         throw core::StatusCodeException(core::STATUS_CODE_NOT_FOUND);
       }
-      return m_client.hasSubscribed(OnlineRoutes::EventCollector::eventUpdate(m_collectorName, source));
+      return not findIter->second.m_updateService.empty();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -124,25 +162,73 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
-    core::EventPtr EventCollectorClient::readEvent(const net::Buffer &buffer) {
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    bool EventCollectorClient::declareSubscription(const std::string &source, const EventSubscription &subscription) {
+      core::json subscriptionValue;
+      subscription.toJson(subscriptionValue);
+      const core::json requestValue = {
+        {"source", source},
+        {"subscription", subscriptionValue}
+      };
+      net::Buffer requestBuffer;
+      auto model = requestBuffer.createModel<std::string>();
+      requestBuffer.setModel(model);
+      model->move(requestValue.dump());
+      
+      bool declared(false);
+      m_client.sendRequest(OnlineRoutes::EventCollector::subscribe(m_collectorName), requestBuffer, [&source,&declared,this](const net::Buffer &buffer){
+        core::json response({});
+        if(0 != buffer.size()) {
+          response = core::json::parse(buffer.begin(), buffer.end());
+        }
+        declared = response.value<bool>("subscribed", false);
+        // refused or collector not running yet: the subscription is only declared 
+        // again when the event updates are restarted
+        if(not declared) {
+          dqm_warning( "EventCollectorClient: couldn't declare subscription to source '{0}' on collector '{1}': {2}. Receiving all the updates", 
+            source, m_collectorName, response.value<std::string>("message", "collector not available") );
+        }
+      });
       
-      try {
-        m_buffer.SetBuffer((void*)buffer.begin(), buffer.size(), false);      
+      // the collector drops the subscriptions of the clients that exit
+      if(not m_notifyOnExit) {
+        m_client.notifyServerOnExit(OnlineRoutes::Application::serverName(OnlineRoutes::EventCollector::applicationType(), m_collectorName));
+        m_notifyOnExit = true;
       }
-      catch(...) {
-        dqm_error( "EventCollectorClient::readEvent: couldn't setup buffer device !" );
-        return nullptr;
+      return declared;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollectorClient::internSourceName(const std::string &source) {
+      // resolve the source id of the received event headers
+      core::EventNameTable::Id sourceId(core::EventNameTable::invalidId);
+      const std::string *sourceName(nullptr);
+      core::EventNameTable::sourceNames()->intern(source, sourceId, sourceName);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollectorClient::setDecodingThreads(unsigned int nThreads, unsigned int queueSize) {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      for(auto &source : m_sourceInfoMap) {
+        if(not source.second.m_updateService.empty()) {
+          dqm_error( "EventCollectorClient::setDecodingThreads: can't change decoding threads while receiving event updates !" );
+          throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+        }
       }
-      // read event using event streamer
-      core::EventPtr event(nullptr);
-      core::StatusCode statusCode = m_eventStreamer.readEvent(event, m_buffer);
+      m_decoder.reset(0 == nThreads ? nullptr : new EventDecoder(nThreads, queueSize));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventCollectorClient::readEvents(const net::Buffer &buffer, core::EventList &events) {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      // read events using event streamer
+      core::StatusCode statusCode = EventBatch::readEvents(m_eventStreamer, buffer.begin(), buffer.size(), events);
       
       if(core::STATUS_CODE_SUCCESS != statusCode) {
-        dqm_error( "EventCollectorClient::readEvent: streamer couldn't read event: {0}", core::statusCodeToString(statusCode) );
-        return nullptr;
+        dqm_error( "EventCollectorClient::readEvents: streamer couldn't read event: {0}", core::statusCodeToString(statusCode) );
       }
-      return event;
     }
 
 
@@ -0,0 +1,124 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics 
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/EventDecoder.h>
+#include <dqm4hep/EventBatch.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/Logging.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+namespace dqm4hep {
+
+  namespace online {
+    
+    EventDecoder::EventDecoder(unsigned int nThreads, unsigned int queueSize) :
+      m_queue(queueSize) {
+      if(0 == nThreads) {
+        dqm_error( "EventDecoder: number of threads must be positive !" );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      for(unsigned int t=0 ; t<nThreads ; t++) {
+        m_workers.push_back(std::thread(&EventDecoder::workerLoop, this));
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    EventDecoder::~EventDecoder() {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlag = true;
+      }
+      m_condition.notify_all();
+      for(auto &worker : m_workers) {
+        worker.join();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventDecoder::push(const char *buffer, size_t size, EventSignal &signal) {
+      {
+        std::lock_guard<std::mutex> lock(m_pushMutex);
+        m_pushedFrame.m_buffer.assign(buffer, size);
+        m_pushedFrame.m_signal = &signal;
+        
+        if(not m_queue.push(m_pushedFrame)) {
+          ++m_nDroppedFrames;
+          return false;
+        }
+      }
+      // pairs with the fence in workerLoop(): either the worker sees the frame or we see the worker waiting
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if(0 != m_nWaitingWorkers.load()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_condition.notify_one();
+      }
+      return true;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int EventDecoder::nThreads() const {
+      return m_workers.size();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned long EventDecoder::nDecodedEvents() const {
+      return m_nDecodedEvents.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned long EventDecoder::nDroppedFrames() const {
+      return m_nDroppedFrames.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventDecoder::workerLoop() {
+      // worker own decoding devices
+      core::EventStreamer eventStreamer;
+      TBufferFile inputBuffer(TBuffer::kRead);
+      core::EventList events;
+      Frame frame;
+      
+      while(not m_stopFlag.load()) {
+        if(not m_queue.pop(frame)) {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          ++m_nWaitingWorkers;
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          m_condition.wait(lock, [this](){
+            return (not m_queue.empty()) || m_stopFlag.load();
+          });
+          --m_nWaitingWorkers;
+          continue;
+        }
+        events.clear();
+        core::StatusCode statusCode = EventBatch::readEvents(eventStreamer, inputBuffer, frame.m_buffer.data(), frame.m_buffer.size(), events);
+        
+        if(core::STATUS_CODE_SUCCESS != statusCode) {
+          dqm_error( "EventDecoder: streamer couldn't read event: {0}", core::statusCodeToString(statusCode) );
+        }
+        m_nDecodedEvents += events.size();
+        
+        for(auto event : events) {
+          frame.m_signal->emit(event);
+        }
+      }
+    }
+
+  }
+
+}
@@ -0,0 +1,258 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/EventFilter.h>
+#include <dqm4hep/Event.h>
+
+// -- std headers
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    namespace {
+
+      /**
+       *  @brief  Split a filter expression in tokens: words, quoted words, operators and punctuation
+       */
+      bool tokenize(const std::string &expression, std::vector<std::string> &tokens, std::string &message) {
+        static const std::string symbols("&=!<>(),%\"");
+        std::size_t pos(0);
+        while(pos < expression.size()) {
+          const char c(expression[pos]);
+          if(std::isspace(static_cast<unsigned char>(c))) {
+            ++pos;
+          }
+          else if('"' == c) {
+            const std::size_t end(expression.find('"', pos+1));
+            if(std::string::npos == end) {
+              message = "Unterminated quoted string";
+              return false;
+            }
+            tokens.push_back(expression.substr(pos+1, end-pos-1));
+            pos = end+1;
+          }
+          else if('(' == c || ')' == c || ',' == c || '%' == c) {
+            tokens.push_back(std::string(1, c));
+            ++pos;
+          }
+          else if(std::string::npos != symbols.find(c)) {
+            const std::string twoChars(expression.substr(pos, 2));
+            if("&&" == twoChars || "==" == twoChars || "!=" == twoChars || "<=" == twoChars || ">=" == twoChars) {
+              tokens.push_back(twoChars);
+              pos += 2;
+            }
+            else if('<' == c || '>' == c) {
+              tokens.push_back(std::string(1, c));
+              ++pos;
+            }
+            else {
+              message = "Unexpected character '" + std::string(1, c) + "'";
+              return false;
+            }
+          }
+          else {
+            std::size_t end(pos);
+            while(end < expression.size() && not std::isspace(static_cast<unsigned char>(expression[end])) && std::string::npos == symbols.find(expression[end])) {
+              ++end;
+            }
+            tokens.push_back(expression.substr(pos, end-pos));
+            pos = end;
+          }
+        }
+        return true;
+      }
+
+      //-------------------------------------------------------------------------------------------------
+
+      std::string toLower(std::string str) {
+        std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+        return str;
+      }
+
+      //-------------------------------------------------------------------------------------------------
+
+      bool toNumber(const std::string &str, double &value) {
+        if(str.empty()) {
+          return false;
+        }
+        char *end(nullptr);
+        value = std::strtod(str.c_str(), &end);
+        return (end == str.c_str() + str.size());
+      }
+
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode EventFilter::parse(const std::string &expression, std::string &message) {
+      std::vector<std::string> tokens;
+      if(not tokenize(expression, tokens, message)) {
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      std::vector<Condition> conditions;
+      std::size_t pos(0);
+      const std::string endToken;
+      auto next = [&]() -> const std::string& {
+        return (pos < tokens.size()) ? tokens[pos++] : endToken;
+      };
+
+      while(pos < tokens.size()) {
+        Condition condition;
+        // field
+        const std::string field(toLower(next()));
+        if("type" == field) condition.m_field = TYPE;
+        else if("source" == field) condition.m_field = SOURCE;
+        else if("number" == field) condition.m_field = NUMBER;
+        else if("run" == field) condition.m_field = RUN;
+        else if("time" == field) condition.m_field = TIME;
+        else if("age" == field) condition.m_field = AGE;
+        else {
+          message = "Unknown field '" + field + "'";
+          return core::STATUS_CODE_INVALID_PARAMETER;
+        }
+        std::string op(next());
+        // event number modulo
+        if("%" == op) {
+          double modulo(0.);
+          if(NUMBER != condition.m_field || not toNumber(next(), modulo) || modulo < 1. || modulo > 4294967295.) {
+            message = "Modulo only applies to the event number with a positive integer";
+            return core::STATUS_CODE_INVALID_PARAMETER;
+          }
+          condition.m_modulo = static_cast<uint32_t>(modulo);
+          op = next();
+        }
+        // operator
+        if("==" == op) condition.m_operator = EQUAL;
+        else if("!=" == op) condition.m_operator = NOT_EQUAL;
+        else if("<" == op) condition.m_operator = LESS;
+        else if("<=" == op) condition.m_operator = LESS_EQUAL;
+        else if(">" == op) condition.m_operator = GREATER;
+        else if(">=" == op) condition.m_operator = GREATER_EQUAL;
+        else if("in" == toLower(op)) condition.m_operator = IN;
+        else {
+          message = "Unknown operator '" + op + "' for field '" + field + "'";
+          return core::STATUS_CODE_INVALID_PARAMETER;
+        }
+        if(SOURCE == condition.m_field && EQUAL != condition.m_operator && NOT_EQUAL != condition.m_operator && IN != condition.m_operator) {
+          message = "Source names can only be compared with ==, != and in";
+          return core::STATUS_CODE_INVALID_PARAMETER;
+        }
+        // values
+        std::vector<std::string> values;
+        if(IN == condition.m_operator) {
+          if("(" != next()) {
+            message = "Expected '(' after 'in'";
+            return core::STATUS_CODE_INVALID_PARAMETER;
+          }
+          while(true) {
+            values.push_back(next());
+            const std::string separator(next());
+            if(")" == separator) {
+              break;
+            }
+            if("," != separator) {
+              message = "Expected ',' or ')' in value list";
+              return core::STATUS_CODE_INVALID_PARAMETER;
+            }
+          }
+        }
+        else {
+          values.push_back(next());
+        }
+        for(const auto &str : values) {
+          double value(0.);
+          if(str.empty() || "(" == str || ")" == str || "," == str) {
+            message = "Missing value for field '" + field + "'";
+            return core::STATUS_CODE_INVALID_PARAMETER;
+          }
+          if(SOURCE == condition.m_field) {
+            value = core::EventNameTable::hashName(str);
+          }
+          else if(TYPE == condition.m_field && not toNumber(str, value)) {
+            const std::string type(toLower(str));
+            if("unknown" == type) value = core::UNKNOWN_EVENT;
+            else if("raw" == type) value = core::RAW_DATA_EVENT;
+            else if("reconstructed" == type) value = core::RECONSTRUCTED_EVENT;
+            else if("physics" == type) value = core::PHYSICS_EVENT;
+            else if("custom" == type) value = core::CUSTOM_EVENT;
+            else {
+              message = "Unknown event type '" + str + "'";
+              return core::STATUS_CODE_INVALID_PARAMETER;
+            }
+          }
+          else if(TYPE != condition.m_field && not toNumber(str, value)) {
+            message = "Invalid value '" + str + "' for field '" + field + "'";
+            return core::STATUS_CODE_INVALID_PARAMETER;
+          }
+          condition.m_values.push_back(value);
+        }
+        conditions.push_back(condition);
+        // next condition
+        if(pos < tokens.size()) {
+          const std::string conjunction(toLower(next()));
+          if(("&&" != conjunction && "and" != conjunction) || pos == tokens.size()) {
+            message = "Expected a condition after '" + conjunction + "'";
+            return core::STATUS_CODE_INVALID_PARAMETER;
+          }
+        }
+      }
+      m_expression = expression;
+      m_conditions = std::move(conditions);
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventFilter::match(const core::EventHeader &header, const core::time::point &now) const {
+      for(const auto &condition : m_conditions) {
+        const double value(fieldValue(condition, header, now));
+        const double ref(condition.m_values.front());
+        bool pass(false);
+        switch(condition.m_operator) {
+          case EQUAL: pass = (value == ref); break;
+          case NOT_EQUAL: pass = (value != ref); break;
+          case LESS: pass = (value < ref); break;
+          case LESS_EQUAL: pass = (value <= ref); break;
+          case GREATER: pass = (value > ref); break;
+          case GREATER_EQUAL: pass = (value >= ref); break;
+          case IN: pass = (condition.m_values.end() != std::find(condition.m_values.begin(), condition.m_values.end(), value)); break;
+        }
+        if(not pass) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    double EventFilter::fieldValue(const Condition &condition, const core::EventHeader &header, const core::time::point &now) {
+      switch(condition.m_field) {
+        case TYPE: return header.m_type;
+        case SOURCE: return header.m_sourceId;
+        case NUMBER: return (0 == condition.m_modulo) ? header.m_eventNumber : (header.m_eventNumber % condition.m_modulo);
+        case RUN: return header.m_runNumber;
+        case TIME: return header.m_timeStamp * 1e-9;
+        case AGE: {
+          const int64_t nowNs(std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count());
+          return (nowNs - header.m_timeStamp) * 1e-9;
+        }
+        default: return 0.;
+      }
+    }
+
+  }
+
+}
@@ -15,6 +15,9 @@
 #include <dqm4hep/Server.h>
 #include <dqm4hep/OnlineRoutes.h>
 
+// -- std headers
+#include <algorithm>
+
 namespace dqm4hep {
 
   namespace online {
@@ -32,7 +35,35 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     EventSource::~EventSource() {
-      for(auto colIter : m_collectorInfos) {
+      // the sender thread sends the remaining queued events before exiting
+      if(m_senderThread.joinable()) {
+        {
+          std::lock_guard<std::mutex> lock(m_sendMutex);
+          m_stopSender = true;
+        }
+        m_sendCondition.notify_all();
+        m_spaceCondition.notify_all();
+        m_senderThread.join();
+      }
+      if(m_flushThread.joinable()) {
+        {
+          std::lock_guard<std::mutex> lock(m_batchMutex);
+          m_stopFlush = true;
+        }
+        m_batchCondition.notify_all();
+        m_flushThread.join();
+      }
+      // send the last pending events
+      this->flush();
+      if(m_livenessThread.joinable()) {
+        {
+          std::lock_guard<std::mutex> lock(m_livenessMutex);
+          m_stopLiveness = true;
+        }
+        m_livenessCondition.notify_all();
+        m_livenessThread.join();
+      }
+      for(auto &colIter : m_collectorInfos) {
         this->unregisterMe(colIter.first);
       }
     }
@@ -56,9 +87,139 @@ namespace dqm4hep {
         throw core::StatusCodeException(core::STATUS_CODE_ALREADY_PRESENT);
       }
       
-      CollectorInfo info;
-      info.m_registered = false;
-      m_collectorInfos.insert(CollectorInfoMap::value_type(name, info));
+      m_collectorInfos[name].m_registered = false;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::addStreamer(const std::string &streamerName) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      if(m_streamerNames.end() != std::find(m_streamerNames.begin(), m_streamerNames.end(), streamerName)) {
+        return;
+      }
+      core::EventStreamerRegistry::StreamerId streamerId(core::EventStreamerRegistry::invalidId);
+      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, core::EventStreamerRegistry::instance()->registerStreamer(streamerName, streamerId));
+      m_streamerNames.push_back(streamerName);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::setLivenessTTL(unsigned int msec) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      m_livenessTTL = msec;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int EventSource::livenessTTL() const {
+      return m_livenessTTL;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::setBatching(unsigned int maxEvents, unsigned int maxBytes, unsigned int maxLatency) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      if(0 == maxEvents || 0 == maxBytes || 0 == maxLatency) {
+        dqm_error( "EventSource::setBatching(): batch limits must be positive !" );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      m_batching = true;
+      m_batchMaxEvents = maxEvents;
+      m_batchMaxBytes = maxBytes;
+      m_batchMaxLatency = maxLatency;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventSource::batching() const {
+      return m_batching;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::setAsync(unsigned int queueSize, OverflowPolicy policy) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      if(0 == queueSize) {
+        dqm_error( "EventSource::setAsync(): queue size must be positive !" );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      m_async = true;
+      m_overflowPolicy = policy;
+      m_sendQueue.reset(new SendQueue(queueSize));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventSource::async() const {
+      return m_async;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::setCompression(core::EventCompression::Algorithm algorithm, unsigned int level, unsigned int minSize) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      if(not core::EventCompression::isSupported(algorithm)) {
+        dqm_error( "EventSource::setCompression(): compression algorithm '{0}' not supported !", core::EventCompression::algorithmName(algorithm) );
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      m_eventStreamer.setCompression(core::EventCompression(algorithm, level, minSize));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    const core::EventCompression &EventSource::compression() const {
+      return m_eventStreamer.compression();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::enableStats(bool enable) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      m_statsEnabled = enable;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned long EventSource::nQueuedEvents() const {
+      return m_nQueuedEvents.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned long EventSource::nSentEvents() const {
+      return m_nSentEvents.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned long EventSource::nDroppedEvents() const {
+      return m_nDroppedEvents.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::flush() {
+      if(not m_batching) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(m_batchMutex);
+      for(auto &colIter : m_collectorInfos) {
+        if(not colIter.second.m_batch.empty()) {
+          this->sendBatch(colIter.first, colIter.second.m_batch);
+        }
+      }
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -76,11 +237,24 @@ namespace dqm4hep {
       core::json sourceInfo;
       this->getSourceInfo(sourceInfo);
       
-      for(auto colIter : m_collectorInfos) {
+      for(auto &colIter : m_collectorInfos) {
         bool registered = this->registerMe(colIter.first, sourceInfo);
         colIter.second.m_registered = registered;
       }
       
+      if(0 != m_livenessTTL) {
+        this->updateLiveness();
+        m_livenessThread = std::thread(&EventSource::livenessLoop, this);
+      }
+      
+      if(m_batching) {
+        m_flushThread = std::thread(&EventSource::flushLoop, this);
+      }
+      
+      if(m_async) {
+        m_senderThread = std::thread(&EventSource::senderLoop, this);
+      }
+      
       m_started = true;
     }
     
@@ -89,7 +263,7 @@ namespace dqm4hep {
     void EventSource::sendEvent(core::EventPtr event) {
       core::StringVector collectors;
 
-      for(auto iter : m_collectorInfos)
+      for(auto &iter : m_collectorInfos)
         collectors.push_back(iter.first);
         
       this->sendEvent(collectors, event);
@@ -120,11 +294,23 @@ namespace dqm4hep {
       m_buffer.Reset();
       THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_eventStreamer.writeEvent(event, m_buffer));
       
+      if(m_async) {
+        this->queueEvent(collectors);
+      }
+      else {
+        this->dispatchEvent(collectors, m_buffer.Buffer(), m_buffer.Length());
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::dispatchEvent(const core::StringVector &collectors, const char *buffer, unsigned int size) {
       core::json sourceInfo;
       net::Buffer collectBuffer;
       auto model = collectBuffer.createModel();
       collectBuffer.setModel(model);
-      model->handle(m_buffer.Buffer(), m_buffer.Length());
+      model->handle(buffer, size);
+      bool sent(false);
       
       // send serialized event to all collectors 
       for(auto collector : collectors) {
@@ -136,8 +322,12 @@ namespace dqm4hep {
         }
         
         // Is the event collector server actually running ?
-        const std::string serverName(OnlineRoutes::Application::serverName(OnlineRoutes::EventCollector::applicationType(), iter->first));
-        if(!net::Server::isServerRunning(serverName)) {
+        bool collectorRunning = iter->second.m_running.load();
+        if(0 == m_livenessTTL) {
+          const std::string serverName(OnlineRoutes::Application::serverName(OnlineRoutes::EventCollector::applicationType(), iter->first));
+          collectorRunning = net::Server::isServerRunning(serverName);
+        }
+        if(!collectorRunning) {
           // in case the server was stopped, we will need to send 
           // back the source registration on wake up
           iter->second.m_registered = false;
@@ -158,10 +348,201 @@ namespace dqm4hep {
           continue;
         }
         
+        if(m_batching) {
+          std::lock_guard<std::mutex> lock(m_batchMutex);
+          EventBatch &batch(iter->second.m_batch);
+          const bool firstEvent(batch.empty());
+          batch.addEvent(buffer, size);
+          sent = true;
+          
+          if(batch.nEvents() >= m_batchMaxEvents || batch.size() >= m_batchMaxBytes) {
+            this->sendBatch(iter->first, batch);
+          }
+          else if(firstEvent) {
+            // a new latency deadline to watch
+            m_batchCondition.notify_one();
+          }
+          continue;
+        }
+        
         m_client.sendCommand(OnlineRoutes::EventCollector::collectEvent(collector), collectBuffer);
-      }  
+        sent = true;
+      }
+      // skipped by all the collectors: not sent
+      if(sent) {
+        ++m_nSentEvents;
+      }
     }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::queueEvent(const core::StringVector &collectors) {
+      m_queuedFrame.m_buffer.assign(m_buffer.Buffer(), m_buffer.Length());
+      m_queuedFrame.m_collectors = collectors;
+      
+      while(not m_sendQueue->push(m_queuedFrame)) {
+        if(DROP_NEWEST == m_overflowPolicy) {
+          ++m_nDroppedEvents;
+          return;
+        }
+        else if(DROP_OLDEST == m_overflowPolicy) {
+          // the sender thread may have made room in the meantime
+          if(m_sendQueue->pop(m_droppedFrame)) {
+            ++m_nDroppedEvents;
+          }
+        }
+        else {
+          std::unique_lock<std::mutex> lock(m_sendMutex);
+          m_producerWaiting = true;
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          m_spaceCondition.wait(lock, [this](){
+            return (m_sendQueue->size() < m_sendQueue->capacity()) || m_stopSender.load();
+          });
+          m_producerWaiting = false;
+          if(m_stopSender.load()) {
+            ++m_nDroppedEvents;
+            return;
+          }
+        }
+      }
+      ++m_nQueuedEvents;
+      
+      // pairs with the fence in senderLoop(): either the sender sees the frame or we see it waiting
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if(m_senderWaiting.load()) {
+        std::lock_guard<std::mutex> lock(m_sendMutex);
+        m_sendCondition.notify_one();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::senderLoop() {
+      const std::chrono::seconds statsPeriod(5);
+      auto nextStatsTime = std::chrono::steady_clock::now() + statsPeriod;
+      EventFrame frame;
+      
+      while(true) {
+        if(m_sendQueue->pop(frame)) {
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if(m_producerWaiting.load()) {
+            std::lock_guard<std::mutex> lock(m_sendMutex);
+            m_spaceCondition.notify_one();
+          }
+          this->dispatchEvent(frame.m_collectors, frame.m_buffer.data(), frame.m_buffer.size());
+        }
+        // exit only once the queue is drained
+        else if(m_stopSender.load()) {
+          break;
+        }
+        else {
+          std::unique_lock<std::mutex> lock(m_sendMutex);
+          m_senderWaiting = true;
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          m_sendCondition.wait_until(lock, nextStatsTime, [this](){
+            return (not m_sendQueue->empty()) || m_stopSender.load();
+          });
+          m_senderWaiting = false;
+        }
+        
+        if(m_statsEnabled && std::chrono::steady_clock::now() >= nextStatsTime) {
+          this->sendStat("NQueuedEvents", "The total number of events pushed in the send queue", m_nQueuedEvents.load());
+          this->sendStat("NSentEvents", "The total number of events sent to the collectors", m_nSentEvents.load());
+          this->sendStat("NDroppedEvents", "The total number of events dropped because the send queue was full", m_nDroppedEvents.load());
+          nextStatsTime = std::chrono::steady_clock::now() + statsPeriod;
+        }
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::sendStat(const std::string &name, const std::string &description, unsigned long value) {
+      core::json object = {
+        {"name", name},
+        {"description", description},
+        {"unit", ""},
+        {"value", value},
+        {"appType", "EventSource"},
+        {"appName", m_sourceName},
+        {"time", core::time::asTime(core::time::now())}
+      };
+      m_client.sendCommand(OnlineRoutes::OnlineManager::collectAppStat(), object.dump());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::sendBatch(const std::string &collector, EventBatch &batch) {
+      net::Buffer batchBuffer;
+      auto model = batchBuffer.createModel();
+      batchBuffer.setModel(model);
+      model->handle(batch.buffer(), batch.size());
+      m_client.sendCommand(OnlineRoutes::EventCollector::collectEvent(collector), batchBuffer);
+      batch.clear();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::flushLoop() {
+      const std::chrono::milliseconds maxLatency(m_batchMaxLatency);
+      std::unique_lock<std::mutex> lock(m_batchMutex);
+      
+      while(not m_stopFlush) {
+        const auto now = core::time::now();
+        auto nextDeadline = now + maxLatency;
+        
+        for(auto &colIter : m_collectorInfos) {
+          EventBatch &batch(colIter.second.m_batch);
+          if(batch.empty()) {
+            continue;
+          }
+          const auto deadline = batch.firstEventTime() + maxLatency;
+          if(deadline <= now) {
+            this->sendBatch(colIter.first, batch);
+          }
+          else {
+            nextDeadline = std::min(nextDeadline, deadline);
+          }
+        }
+        m_batchCondition.wait_until(lock, nextDeadline);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
 
+    void EventSource::updateLiveness() {
+      const core::StringVector runningServers(net::Server::runningServers());
+      
+      for(auto &colIter : m_collectorInfos) {
+        const std::string serverName(OnlineRoutes::Application::serverName(OnlineRoutes::EventCollector::applicationType(), colIter.first));
+        const bool running = (runningServers.end() != std::find(runningServers.begin(), runningServers.end(), serverName));
+        
+        if(running != colIter.second.m_running.load()) {
+          dqm_debug( "EventSource: collector '{0}' is now {1}", colIter.first, running ? "running" : "stopped" );
+        }
+        colIter.second.m_running = running;
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::livenessLoop() {
+      std::unique_lock<std::mutex> lock(m_livenessMutex);
+      
+      while(not m_stopLiveness.load()) {
+        m_livenessCondition.wait_for(lock, std::chrono::milliseconds(m_livenessTTL), [this](){
+          return m_stopLiveness.load();
+        });
+        
+        if(m_stopLiveness.load()) {
+          break;
+        }
+        // don't hold the lock during the DNS query
+        lock.unlock();
+        this->updateLiveness();
+        lock.lock();
+      }
+    }
+    
     //-------------------------------------------------------------------------------------------------
 
     void EventSource::getSourceInfo(core::json &info) {
@@ -171,13 +552,28 @@ namespace dqm4hep {
                   
       // collectors
       core::json collectorsValue;
-      for(auto colIter : m_collectorInfos)
+      for(auto &colIter : m_collectorInfos)
         collectorsValue.push_back(colIter.first);
       
+      // streamer ids
+      core::json streamersValue = core::json::object();
+      for(auto &streamerName : m_streamerNames)
+        streamersValue[streamerName] = core::EventNameTable::hashName(streamerName);
+      
+      // source id, written in the event headers
+      core::json sourcesValue = {{m_sourceName, core::EventNameTable::hashName(m_sourceName)}};
+      
+      // event payload compression
+      core::json compressionValue;
+      m_eventStreamer.compression().toJson(compressionValue);
+      
       info = {
         {"source", m_sourceName},
         {"host", hostInfo},
-        {"collectors", collectorsValue}
+        {"collectors", collectorsValue},
+        {"streamers", streamersValue},
+        {"sources", sourcesValue},
+        {"compression", compressionValue}
       };
     }
     
@@ -0,0 +1,177 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/EventSubscription.h>
+#include <dqm4hep/Logging.h>
+
+// -- std headers
+#include <algorithm>
+#include <cctype>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    std::string EventSubscription::modeName(Mode mode) {
+      switch(mode) {
+        case ALL: return "all";
+        case PRESCALE: return "prescale";
+        case MAX_RATE: return "maxrate";
+        case LATEST: return "latest";
+        default: return "unknown";
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode EventSubscription::modeFromName(const std::string &name, Mode &mode) {
+      std::string lowerName(name);
+      std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+      for(const Mode m : {ALL, PRESCALE, MAX_RATE, LATEST}) {
+        if(modeName(m) == lowerName) {
+          mode = m;
+          return core::STATUS_CODE_SUCCESS;
+        }
+      }
+      return core::STATUS_CODE_NOT_FOUND;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    EventSubscription EventSubscription::prescaled(unsigned int prescale) {
+      EventSubscription subscription;
+      subscription.m_mode = PRESCALE;
+      subscription.m_prescale = std::max(prescale, 1u);
+      return subscription;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    EventSubscription EventSubscription::rateLimited(double maxRate) {
+      if(maxRate <= 0.) {
+        dqm_error( "EventSubscription::rateLimited: maximum update rate must be positive ! Got {0}", maxRate );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      EventSubscription subscription;
+      subscription.m_mode = MAX_RATE;
+      subscription.m_maxRate = maxRate;
+      return subscription;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    EventSubscription EventSubscription::latestOnly(double maxRate) {
+      if(maxRate <= 0.) {
+        dqm_error( "EventSubscription::latestOnly: maximum update rate must be positive ! Got {0}", maxRate );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      EventSubscription subscription;
+      subscription.m_mode = LATEST;
+      subscription.m_maxRate = maxRate;
+      return subscription;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventSubscription::select(const core::time::point &now) {
+      switch(m_mode) {
+        case PRESCALE:
+          return (0 == (m_nUpdates++ % m_prescale));
+        case MAX_RATE:
+          if(not rateAllows(now)) {
+            return false;
+          }
+          m_lastSendTime = now;
+          return true;
+        case LATEST:
+          if(not rateAllows(now)) {
+            m_pending = true;
+            return false;
+          }
+          m_pending = false;
+          m_lastSendTime = now;
+          return true;
+        default:
+          return true;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventSubscription::flushPending(const core::time::point &now) {
+      if(not m_pending or not rateAllows(now)) {
+        return false;
+      }
+      m_pending = false;
+      m_lastSendTime = now;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventSubscription::toJson(core::json &value) const {
+      value = {
+        {"mode", modeName(m_mode)},
+        {"prescale", m_prescale},
+        {"maxRate", m_maxRate},
+        {"filter", m_filter.expression()}
+      };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode EventSubscription::fromJson(const core::json &value, std::string &message) {
+      if(not value.is_object()) {
+        message = "Invalid subscription settings";
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      const std::string name(value.value<std::string>("mode", "all"));
+      Mode mode(ALL);
+      if(core::STATUS_CODE_SUCCESS != modeFromName(name, mode)) {
+        message = "Unknown subscription mode '" + name + "'";
+        return core::STATUS_CODE_NOT_FOUND;
+      }
+      const unsigned int prescale(value.value<unsigned int>("prescale", 1));
+      const double maxRate(value.value<double>("maxRate", 0.));
+      if(PRESCALE == mode && 0 == prescale) {
+        message = "Prescale factor must be positive";
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      if((MAX_RATE == mode || LATEST == mode) && maxRate <= 0.) {
+        message = "Maximum update rate must be positive";
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      EventFilter filter;
+      if(core::STATUS_CODE_SUCCESS != filter.parse(value.value<std::string>("filter", ""), message)) {
+        message = "Invalid event filter: " + message;
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      *this = EventSubscription();
+      m_mode = mode;
+      m_prescale = prescale;
+      m_maxRate = maxRate;
+      m_filter = std::move(filter);
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool EventSubscription::rateAllows(const core::time::point &now) const {
+      if(m_maxRate <= 0.) {
+        return true;
+      }
+      const auto minInterval = std::chrono::duration_cast<core::time::duration>(std::chrono::duration<double>(1. / m_maxRate));
+      return (core::time::point() == m_lastSendTime) || (now - m_lastSendTime >= minInterval);
+    }
+
+  }
+
+}
@@ -20,7 +20,7 @@ namespace dqm4hep {
 
     core::StatusCode ModuleApi::cd(const Module *const module) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      module->moduleApplication()->monitorElementManager()->cd();
+      ModuleApi::monitorElementManager(module)->cd();
       return core::STATUS_CODE_SUCCESS;
     }
 
@@ -28,49 +28,49 @@ namespace dqm4hep {
 
     core::StatusCode ModuleApi::cd(const Module *const module, const std::string &dirName) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->cd(dirName);
+      return ModuleApi::monitorElementManager(module)->cd(dirName);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     core::StatusCode ModuleApi::mkdir(const Module *const module, const std::string &dirName) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->mkdir(dirName);
+      return ModuleApi::monitorElementManager(module)->mkdir(dirName);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     const std::string &ModuleApi::pwd(const Module *const module) {
       THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->pwd();
+      return ModuleApi::monitorElementManager(module)->pwd();
     }
 
     //-------------------------------------------------------------------------------------------------
 
     core::StatusCode ModuleApi::goUp(const Module *const module) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->goUp();
+      return ModuleApi::monitorElementManager(module)->goUp();
     }
 
     //-------------------------------------------------------------------------------------------------
 
     core::StatusCode ModuleApi::rmdir(const Module *const module, const std::string &dirName) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->rmdir(dirName);
+      return ModuleApi::monitorElementManager(module)->rmdir(dirName);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     bool ModuleApi::dirExists(const Module *const module, const std::string &dirName) {
       THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->dirExists(dirName);
+      return ModuleApi::monitorElementManager(module)->dirExists(dirName);
     }
     
     //-------------------------------------------------------------------------------------------------
     
     core::StatusCode ModuleApi::dump(const Module *const module) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      module->moduleApplication()->monitorElementManager()->dumpStorage();
+      ModuleApi::monitorElementManager(module)->dumpStorage();
       return core::STATUS_CODE_SUCCESS;
     }
 
@@ -79,7 +79,7 @@ namespace dqm4hep {
 
     core::StatusCode ModuleApi::getMonitorElements(const Module *const module, OnlineElementPtrList &monitorElementList) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      module->moduleApplication()->monitorElementManager()->getMonitorElements(monitorElementList);
+      ModuleApi::monitorElementManager(module)->getMonitorElements(monitorElementList);
       return core::STATUS_CODE_SUCCESS;
     }
 
@@ -87,14 +87,14 @@ namespace dqm4hep {
 
     core::StatusCode ModuleApi::getMonitorElement(const Module *const module, const std::string &monitorElementName, OnlineElementPtr &monitorElement) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->getMonitorElement(monitorElementName, monitorElement);
+      return ModuleApi::monitorElementManager(module)->getMonitorElement(monitorElementName, monitorElement);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     core::StatusCode ModuleApi::getMonitorElement(const Module *const module, const std::string &dirName, const std::string &monitorElementName, OnlineElementPtr &monitorElement) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->getMonitorElement(dirName, monitorElementName, monitorElement);
+      return ModuleApi::monitorElementManager(module)->getMonitorElement(dirName, monitorElementName, monitorElement);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -102,7 +102,7 @@ namespace dqm4hep {
     OnlineElementPtr ModuleApi::getMonitorElement(const Module *const module, const std::string &monitorElementName) {
       OnlineElementPtr monitorElement;
       THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, module->moduleApplication()->monitorElementManager()->getMonitorElement(monitorElementName, monitorElement));
+      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::monitorElementManager(module)->getMonitorElement(monitorElementName, monitorElement));
       return monitorElement;
     }
 
@@ -111,7 +111,7 @@ namespace dqm4hep {
     OnlineElementPtr ModuleApi::getMonitorElement(const Module *const module, const std::string &dirName, const std::string &monitorElementName) {
       OnlineElementPtr monitorElement;
       THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, module->moduleApplication()->monitorElementManager()->getMonitorElement(dirName, monitorElementName, monitorElement));
+      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::monitorElementManager(module)->getMonitorElement(dirName, monitorElementName, monitorElement));
       return monitorElement;
     }
 
@@ -120,7 +120,7 @@ namespace dqm4hep {
 
     core::StatusCode ModuleApi::resetMonitorElements(const Module *const module) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      module->moduleApplication()->monitorElementManager()->resetMonitorElements();
+      ModuleApi::monitorElementManager(module)->resetMonitorElements();
       return core::STATUS_CODE_SUCCESS;
     }
 
@@ -129,7 +129,7 @@ namespace dqm4hep {
     
     core::StatusCode ModuleApi::addQualityTest(const Module *const module, OnlineElementPtr monitorElement, const std::string &qualityTestName) {
       RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, ModuleApi::checkModule(module));
-      return module->moduleApplication()->monitorElementManager()->addQualityTest(monitorElement->path(), monitorElement->name(), qualityTestName);
+      return ModuleApi::monitorElementManager(module)->addQualityTest(monitorElement->path(), monitorElement->name(), qualityTestName);
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -145,8 +145,16 @@ namespace dqm4hep {
       }
       return core::STATUS_CODE_SUCCESS;
     }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::shared_ptr<core::MonitorElementManager> ModuleApi::monitorElementManager(const Module *const module) {
+      if(nullptr != module->m_monitorElementManager) {
+        return module->m_monitorElementManager;
+      }
+      return module->moduleApplication()->monitorElementManager();
+    }
 
   }
 
 }
-
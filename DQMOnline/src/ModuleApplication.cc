@@ -31,6 +31,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     ModuleApplication::~ModuleApplication() {
+      stopReplay();
       removeTimer(m_standaloneTimer);
     }
     
@@ -122,13 +123,23 @@ namespace dqm4hep {
           Priorities::END_OF_RUN
         );        
       }
-      createQueuedCommand(
-        OnlineRoutes::ModuleApplication::subscribe(name()),
-        Priorities::SUBSCRIBE
-      );
+      // the offline modes (EventReader, Replay) can run without server
+      if(not noServer()) {
+        createQueuedCommand(
+          OnlineRoutes::ModuleApplication::subscribe(name()),
+          Priorities::SUBSCRIBE
+        );
+      }
       if(EVENT_READER == appRunningMode()) {
         m_eventReader->onEventRead().connect(this, &ModuleApplication::receiveEvent);
       }
+      if(REPLAY == appRunningMode()) {
+        m_eventReader->onEventRead().connect(this, &ModuleApplication::queueReplayEvent);
+        // end of run is called manually on workers, see END_OF_RUN event handling
+        for(auto &worker : m_replayWorkers) {
+          m_runControl.onStartOfRun().connect(worker->m_module.get(), &Module::startOfRun);
+        }
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -155,10 +166,18 @@ namespace dqm4hep {
       if(AppEvent::END_OF_RUN == appEvent->type()) {
         auto eorEvent = dynamic_cast<StoreEvent<core::Run>*>(appEvent);
         auto run = eorEvent->data();
+        if(REPLAY == appRunningMode()) {
+          // all workers are done at this point
+          stopReplay();
+          for(auto &worker : m_replayWorkers) {
+            worker->m_module->endOfRun(run);
+          }
+          mergeReplayWorkers(nullptr);
+        }
         m_runControl.endCurrentRun(run.parameters());
-        if(EVENT_READER == appRunningMode()) {
+        if(EVENT_READER == appRunningMode() or REPLAY == appRunningMode()) {
           dqm_info( "End of run processed. Exiting application ..." );
-          this->exit(0);
+          this->exit(m_replayFailed ? 1 : 0);
         }
       }
       // process event received from the event collector
@@ -195,6 +214,9 @@ namespace dqm4hep {
       if(AppEvent::END_OF_CYCLE == appEvent->type()) {
         auto eocEvent = dynamic_cast<StoreEvent<EOCCondition>*>(appEvent);
         auto condition = eocEvent->data();
+        if(REPLAY == appRunningMode()) {
+          mergeReplayWorkers(&condition);
+        }
         m_module->endOfCycle(condition);
         if(condition.m_counter > 0) {
           try {
@@ -210,10 +232,16 @@ namespace dqm4hep {
               if(not monitorElement->publish() or not monitorElement->subscribed()){
                 return true;                
               }
+              // not modified since the last publication
+              const unsigned long generation(monitorElement->generation());
+              if(generation == monitorElement->m_publishedGeneration) {
+                return true;
+              }
+              monitorElement->m_publishedGeneration = generation;
               publishElements.push_back(monitorElement);
               return true;
             });
-            // TODO send monitor element to collector
+            sendElementsToCollector(publishElements);
           }
           catch(core::StatusCodeException &exception) {
             dqm_error( "Error caught at end of cycle: {0}", exception.getStatusCode() );
@@ -228,6 +256,10 @@ namespace dqm4hep {
         // do not restart a cycle in this case
         if(ANALYSIS == appModuleType() and not condition.m_forcedEnd) {
           m_module->startOfCycle();
+          for(auto &worker : m_replayWorkers) {
+            std::lock_guard<std::mutex> lock(worker->m_mutex);
+            worker->m_module->startOfCycle();
+          }
           m_cycle.startCycle(true); 
         }
       }
@@ -247,7 +279,29 @@ namespace dqm4hep {
             run.fromJson(runJson);
             m_runControl.startNewRun(run);
           }
-        });        
+        });
+        // register to the monitor element collector and get the current subscriptions
+        if(not m_elementCollectorName.empty()) {
+          const core::json registration = {{"module", name()}};
+          net::Buffer request;
+          auto model = request.createModel<std::string>();
+          model->copy(registration.dump());
+          request.setModel(model);
+          sendRequest(OnlineRoutes::MonitorElementCollector::registerModule(m_elementCollectorName), request, [this](const net::Buffer &response){
+            if(0 == response.size()) {
+              dqm_warning( "Couldn't register to monitor element collector '{0}'", m_elementCollectorName );
+              return;
+            }
+            core::json registrationJson = core::json::parse(response.begin(), response.end());
+            if(not registrationJson.value<bool>("registered", false)) {
+              dqm_warning( "Monitor element collector registration refused: {0}", registrationJson.value<std::string>("message", "") );
+              return;
+            }
+            updateSubscriptions(registrationJson.value<core::json>("subscriptions", core::json::array()));
+          });
+          // the collector keeps the module elements but drops its client id on exit
+          notifyServerOnExit(OnlineRoutes::Application::serverName(OnlineRoutes::MonitorElementCollector::applicationType(), m_elementCollectorName));
+        }
       }
       if(STANDALONE == appModuleType()) {
         m_module->startOfCycle();
@@ -267,6 +321,17 @@ namespace dqm4hep {
         // read first will post an event in event loop
         THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_eventReader->readNextEvent());
       }
+      if(REPLAY == appRunningMode()) {
+        core::Run run;
+        THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_eventReader->runInfo(run));
+        m_runControl.startNewRun(run);
+        m_module->startOfCycle();
+        for(auto &worker : m_replayWorkers) {
+          worker->m_module->startOfCycle();
+        }
+        m_cycle.startCycle();
+        startReplay();
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -275,6 +340,7 @@ namespace dqm4hep {
       if(STANDALONE == appModuleType()) {
         m_standaloneTimer->stop();
       }
+      stopReplay();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -347,7 +413,7 @@ namespace dqm4hep {
       }
       
       // determine running mode
-      static core::StringVector possibleModes = {"Online", "EventReader"}; 
+      static core::StringVector possibleModes = {"Online", "EventReader", "Replay"}; 
       std::string runningMode;
       THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, core::XmlHelper::getAttribute(settingsElement, 
         "mode", runningMode, [&](const std::string &value){
@@ -356,6 +422,9 @@ namespace dqm4hep {
       if(runningMode == "Online") {
         m_appRunningMode = ONLINE;
       }
+      else if(runningMode == "Replay") {
+        m_appRunningMode = REPLAY;
+      }
       else {
         m_appRunningMode = EVENT_READER;
       }
@@ -365,6 +434,7 @@ namespace dqm4hep {
       configureNetwork(settingsElement);
       configureEventReader(settingsElement);
       configureArchiver(archiverElement);
+      configureReplay(settingsElement, storageElement, moduleElement);
       
       core::TiXmlHandle settingsHandle(settingsElement);
       bool enableStatistics = false;
@@ -373,6 +443,11 @@ namespace dqm4hep {
       THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND,!=, 
         core::XmlHelper::readParameter(settingsHandle, "EnableStatistics", enableStatistics));
       enableStats(enableStatistics);
+      // end of cycle quality tests on a worker pool
+      unsigned int qualityTestThreads = 1;
+      THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND,!=, 
+        core::XmlHelper::readParameter(settingsHandle, "QualityTestThreads", qualityTestThreads));
+      m_monitorElementManager->setQualityTestThreads(qualityTestThreads);
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -405,8 +480,8 @@ namespace dqm4hep {
         dqm_error( "Undefined module type, must be AnalysisModule or StandaloneModule" );
         throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
       }
-      if(m_appRunningMode == EVENT_READER and m_appModuleType != ANALYSIS) {
-        dqm_error( "Application running in FileReader mode. Can run only module of type AnalysisModule" );
+      if((m_appRunningMode == EVENT_READER or m_appRunningMode == REPLAY) and m_appModuleType != ANALYSIS) {
+        dqm_error( "Application running in FileReader or Replay mode. Can run only module of type AnalysisModule" );
         throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
       }
       m_module->setModuleApplication(this);
@@ -460,16 +535,45 @@ namespace dqm4hep {
         THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, core::XmlHelper::readParameter(handle, "EventCollector", eventCollector));
         THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, core::XmlHelper::readParameter(handle, "EventSource", m_eventSourceName));
         THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventQueueSize", m_eventQueueSize));
+        // optionally decode events out of the network thread (see EventCollectorClient::setDecodingThreads())
+        unsigned int decodingThreads(0);
+        THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "DecodingThreads", decodingThreads));
+        if(decodingThreads > 1) {
+          dqm_warning( "ModuleApplication::configureNetwork(): {0} decoding threads: events may be received concurrently and out of order", decodingThreads );
+        }
+        // sub-sample the events on the collector side (all, prescale, maxrate or latest)
+        // and only receive the events matching a filter on the event headers (see EventFilter)
+        std::string subscriptionMode("all"), eventFilter;
+        unsigned int prescale(1);
+        double maxRate(0.);
+        THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventSubscription", subscriptionMode));
+        THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventPrescale", prescale));
+        THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventMaxRate", maxRate));
+        THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventFilter", eventFilter));
+        const core::json subscriptionValue = {
+          {"mode", subscriptionMode},
+          {"prescale", prescale},
+          {"maxRate", maxRate},
+          {"filter", eventFilter}
+        };
+        std::string message;
+        if(core::STATUS_CODE_SUCCESS != m_eventSubscription.fromJson(subscriptionValue, message)) {
+          dqm_error( "ModuleApplication::configureNetwork(): invalid event subscription: {0}", message );
+          throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+        }
         
         m_eventCollectorClient = std::make_shared<EventClientPtr::element_type>(eventCollector);
+        m_eventCollectorClient->setDecodingThreads(decodingThreads, m_eventQueueSize);
         m_eventCollectorClient->onEventUpdate(m_eventSourceName, this, &ModuleApplication::receiveEvent);        
       }
+      // publish the monitor elements to a collector at end of cycle
+      THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "MonitorElementCollector", m_elementCollectorName));
     }
     
     //-------------------------------------------------------------------------------------------------
     
     void ModuleApplication::configureEventReader(core::TiXmlElement *element) {
-      if(EVENT_READER != appRunningMode()) {
+      if(EVENT_READER != appRunningMode() and REPLAY != appRunningMode()) {
         return;
       }
       std::string eventReaderName, eventFileName;
@@ -551,6 +655,44 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    void ModuleApplication::configureReplay(core::TiXmlElement *element, core::TiXmlElement *storageElement, core::TiXmlElement *moduleElement) {
+      if(REPLAY != appRunningMode()) {
+        return;
+      }
+      core::TiXmlHandle handle(element);
+      unsigned int replayThreads = 1;
+      THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "ReplayThreads", replayThreads));
+      THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventQueueSize", m_eventQueueSize));
+      if(0 == replayThreads or 0 == m_eventQueueSize) {
+        dqm_error( "Invalid replay settings: threads={0}, queue size={1}", replayThreads, m_eventQueueSize );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      // worker modules fill their ROOT objects concurrently
+      ROOT::EnableThreadSafety();
+      const core::TiXmlHandle moduleHandle(moduleElement);
+      m_allowBooking = true;
+      for(unsigned int w=0 ; w<replayThreads ; w++) {
+        ReplayWorkerPtr worker(new ReplayWorker());
+        worker->m_monitorElementManager = std::make_shared<core::MonitorElementManager>();
+        if(nullptr != storageElement) {
+          THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, worker->m_monitorElementManager->parseStorage<OnlineElement>(storageElement));
+        }
+        worker->m_module = core::PluginManager::instance()->create<Module>(m_moduleType);
+        worker->m_module->setModuleApplication(this);
+        worker->m_module->m_monitorElementManager = worker->m_monitorElementManager;
+        worker->m_module->readSettings(moduleHandle);
+        worker->m_module->initModule();
+        m_replayWorkers.push_back(std::move(worker));
+      }
+      m_allowBooking = false;
+      dqm_info( "== Replay settings ==" );
+      dqm_info( "=> Worker threads:  {0}", replayThreads );
+      dqm_info( "=> Event queue size: {0}", m_eventQueueSize );
+      dqm_info( "=====================" );
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void ModuleApplication::processStartOfRun(ServiceUpdateEvent *svc) {
       core::json runJson = core::json::parse(svc->buffer().begin(), svc->buffer().end());
       core::Run run;
@@ -561,7 +703,7 @@ namespace dqm4hep {
         m_module->startOfCycle();
         m_cycle.startCycle();
         if(ONLINE == appRunningMode()) {
-          m_eventCollectorClient->startEventUpdates(m_eventSourceName);          
+          m_eventCollectorClient->startEventUpdates(m_eventSourceName, m_eventSubscription);          
         }
       }
     }
@@ -588,7 +730,7 @@ namespace dqm4hep {
       if(m_currentNQueuedEvents.load() >= m_eventQueueSize) {
         return;
       }
-      auto appEvent = new StoreEvent<core::EventPtr>(AppEvent::PROCESS_EVENT, event);
+      auto appEvent = m_eventLoop.storeEventPool<core::EventPtr>().create(AppEvent::PROCESS_EVENT, event);
       appEvent->setPriority(ModuleApplication::PROCESS_CALL);
       m_eventLoop.postEvent(appEvent);
       m_currentNQueuedEvents++;
@@ -605,11 +747,17 @@ namespace dqm4hep {
         dqm_error( "Caught exception: Couldn't update monitor element subscription list !" );
         return;
       }
-      if(not jsubscription.is_array()) {
+      updateSubscriptions(jsubscription);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::updateSubscriptions(const core::json &subscriptions) {
+      if(not subscriptions.is_array()) {
         dqm_error( "Monitor element subscription json object is not a list !" );
         return;
       }
-      for(auto &element : jsubscription) {
+      for(auto &element : subscriptions) {
         auto path = element.value<std::string>("path", "");
         auto eltName = element.value<std::string>("name", "");
         auto subscribe = element.value<bool>("sub", false);
@@ -626,6 +774,31 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    void ModuleApplication::sendElementsToCollector(const OnlineElementPtrList &elements) {
+      if(m_elementCollectorName.empty() or elements.empty()) {
+        return;
+      }
+      // all elements in a single frame, serialized once
+      m_elementBatch.clear();
+      for(const auto &element : elements) {
+        if(core::STATUS_CODE_SUCCESS != m_elementBatch.addElement(name(), *element)) {
+          dqm_warning( "Couldn't serialize monitor element path '{0}', name '{1}'", element->path(), element->name() );
+          // published again at next cycle
+          element->m_publishedGeneration = 0;
+        }
+      }
+      if(m_elementBatch.empty()) {
+        return;
+      }
+      net::Buffer batchBuffer;
+      auto model = batchBuffer.createModel();
+      batchBuffer.setModel(model);
+      model->handle(m_elementBatch.buffer(), m_elementBatch.size());
+      sendCommand(OnlineRoutes::MonitorElementCollector::collectElements(m_elementCollectorName), batchBuffer);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void ModuleApplication::setElementsRunNumber(core::Run &run) {
       m_monitorElementManager->iterate<OnlineElement>([&](OnlineElementPtr monitorElement){
         monitorElement->setRunNumber(run.runNumber());
@@ -636,7 +809,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void ModuleApplication::postStandaloneProcess() {
-      auto *processEvent = new StoreEvent<core::time::point>(AppEvent::PROCESS_EVENT, core::time::now());
+      auto *processEvent = m_eventLoop.storeEventPool<core::time::point>().create(AppEvent::PROCESS_EVENT, core::time::now());
       processEvent->setPriority(ModuleApplication::PROCESS_CALL);
       m_eventLoop.postEvent(processEvent);
     }
@@ -658,8 +831,138 @@ namespace dqm4hep {
         THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_archiver->close());
       }
     }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::startReplay() {
+      {
+        std::lock_guard<std::mutex> lock(m_replayMutex);
+        m_replayQueue.clear();
+        m_replayReadDone = false;
+      }
+      m_replayStop = false;
+      m_replayFailed = false;
+      m_nActiveReplayWorkers = m_replayWorkers.size();
+      for(unsigned int w=0 ; w<m_replayWorkers.size() ; w++) {
+        m_replayWorkers[w]->m_thread = std::thread(&ModuleApplication::replayWorkerLoop, this, w);
+      }
+      m_replayReader = std::thread(&ModuleApplication::replayReadLoop, this);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::stopReplay() {
+      {
+        std::lock_guard<std::mutex> lock(m_replayMutex);
+        m_replayStop = true;
+      }
+      m_replayQueueNotEmpty.notify_all();
+      m_replayQueueNotFull.notify_all();
+      if(m_replayReader.joinable()) {
+        m_replayReader.join();
+      }
+      for(auto &worker : m_replayWorkers) {
+        if(worker->m_thread.joinable()) {
+          worker->m_thread.join();
+        }
+      }
+      std::lock_guard<std::mutex> lock(m_replayMutex);
+      m_replayQueue.clear();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::replayReadLoop() {
+      while(not m_replayStop) {
+        auto status = m_eventReader->readNextEvent();
+        // end of file ?
+        if(status == core::STATUS_CODE_OUT_OF_RANGE) {
+          break;
+        }
+        else if(status != core::STATUS_CODE_SUCCESS) {
+          dqm_error( "Error while reading event: file reader returned status '{0}'", core::statusCodeToString(status) );
+          m_replayFailed = true;
+          break;
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_replayMutex);
+        m_replayReadDone = true;
+      }
+      m_replayQueueNotEmpty.notify_all();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::queueReplayEvent(core::EventPtr event) {
+      {
+        std::unique_lock<std::mutex> lock(m_replayMutex);
+        m_replayQueueNotFull.wait(lock, [this](){
+          return (m_replayStop or m_replayQueue.size() < m_eventQueueSize);
+        });
+        if(m_replayStop) {
+          return;
+        }
+        m_replayQueue.push_back(event);
+      }
+      m_replayQueueNotEmpty.notify_one();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::replayWorkerLoop(unsigned int workerId) {
+      ReplayWorker &worker(*m_replayWorkers[workerId]);
+      auto anaModule = dynamic_cast<AnalysisModule*>(worker.m_module.get());
+      while(true) {
+        core::EventPtr event;
+        {
+          std::unique_lock<std::mutex> lock(m_replayMutex);
+          m_replayQueueNotEmpty.wait(lock, [this](){
+            return (m_replayStop or m_replayReadDone or not m_replayQueue.empty());
+          });
+          // stopped or file fully processed
+          if(m_replayStop or m_replayQueue.empty()) {
+            break;
+          }
+          event = std::move(m_replayQueue.front());
+          m_replayQueue.pop_front();
+        }
+        m_replayQueueNotFull.notify_one();
+        try {
+          std::lock_guard<std::mutex> lock(worker.m_mutex);
+          anaModule->process(event);
+        }
+        catch(const std::exception &exception) {
+          dqm_error( "Replay worker {0}: caught exception while processing event: {1}", workerId, exception.what() );
+          m_replayFailed = true;
+          {
+            std::lock_guard<std::mutex> lock(m_replayMutex);
+            m_replayStop = true;
+          }
+          m_replayQueueNotEmpty.notify_all();
+          m_replayQueueNotFull.notify_all();
+          break;
+        }
+        m_cycle.incrementCounter();
+      }
+      // the last worker ends the run, unless the application is stopping
+      if(1 == m_nActiveReplayWorkers.fetch_sub(1) and (m_replayFailed or not m_replayStop)) {
+        processEndOfRun();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::mergeReplayWorkers(const EOCCondition *condition) {
+      for(auto &worker : m_replayWorkers) {
+        std::lock_guard<std::mutex> lock(worker->m_mutex);
+        if(nullptr != condition) {
+          worker->m_module->endOfCycle(*condition);
+        }
+        THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_monitorElementManager->mergeMonitorElements(*worker->m_monitorElementManager));
+      }
+    }
 
   }
 
 }
-
@@ -0,0 +1,118 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include "dqm4hep/MonitorElementClient.h"
+#include "dqm4hep/ElementBatch.h"
+#include "dqm4hep/Logging.h"
+#include "dqm4hep/OnlineRoutes.h"
+
+namespace dqm4hep {
+
+  namespace online {
+
+    MonitorElementClient::MonitorElementClient(const std::string &collectorName) :
+      m_collectorName(collectorName) {
+        /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    MonitorElementClient::~MonitorElementClient() {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      if(m_receivingUpdates) {
+        m_client.unsubscribe(OnlineRoutes::MonitorElementCollector::elementUpdate(m_collectorName), this);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    OnlineElementPtr MonitorElementClient::queryElement(const std::string &moduleName, const std::string &path, const std::string &name) {
+      OnlineElementPtr element = nullptr;
+      core::json elementList = core::json::array();
+      elementList.push_back({{"module", moduleName}, {"path", path}, {"name", name}});
+      net::Buffer buffer;
+      auto model = buffer.createModel<std::string>();
+      buffer.setModel(model);
+      model->move(elementList.dump());
+      m_client.sendRequest(
+        OnlineRoutes::MonitorElementCollector::elementRequest(m_collectorName),
+        buffer,
+        [&element](const net::Buffer &response){
+          OnlineElementPtrList elements;
+          if(0 != response.size() and core::STATUS_CODE_SUCCESS == ElementBatch::readElements(response.begin(), response.size(), elements)
+            and not elements.empty()) {
+            element = elements.front();
+          }
+      });
+      return element;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementClient::subscribe(const std::string &moduleName, const std::string &path, const std::string &name) {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      // receive the latest version sent on subscription
+      if(not m_receivingUpdates) {
+        m_client.subscribe(
+          OnlineRoutes::MonitorElementCollector::elementUpdate(m_collectorName),
+          this,
+          &MonitorElementClient::receiveElements
+        );
+        m_receivingUpdates = true;
+      }
+      this->sendSubscription(moduleName, path, name, true);
+
+      // the collector drops the subscriptions of the clients that exit
+      if(not m_notifyOnExit) {
+        m_client.notifyServerOnExit(OnlineRoutes::Application::serverName(OnlineRoutes::MonitorElementCollector::applicationType(), m_collectorName));
+        m_notifyOnExit = true;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementClient::unsubscribe(const std::string &moduleName, const std::string &path, const std::string &name) {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      this->sendSubscription(moduleName, path, name, false);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementClient::sendSubscription(const std::string &moduleName, const std::string &path, const std::string &name, bool subscribe) {
+      core::json elementList = core::json::array();
+      elementList.push_back({{"module", moduleName}, {"path", path}, {"name", name}});
+      const std::string commandName = subscribe ?
+        OnlineRoutes::MonitorElementCollector::subscribe(m_collectorName) :
+        OnlineRoutes::MonitorElementCollector::unsubscribe(m_collectorName);
+      m_client.sendCommand(commandName, elementList.dump());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementClient::receiveElements(const net::Buffer &buffer) {
+      // nothing published yet on subscription
+      if(0 == buffer.size()) {
+        return;
+      }
+      OnlineElementPtrList elements;
+      core::StatusCode statusCode = ElementBatch::readElements(buffer.begin(), buffer.size(), elements);
+
+      if(core::STATUS_CODE_SUCCESS != statusCode) {
+        dqm_error( "MonitorElementClient::receiveElements: couldn't read element batch: {0}", core::statusCodeToString(statusCode) );
+        return;
+      }
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      m_elementUpdateSignal.emit(elements);
+    }
+
+  }
+
+}
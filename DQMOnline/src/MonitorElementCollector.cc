@@ -0,0 +1,384 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include "dqm4hep/MonitorElementCollector.h"
+#include "dqm4hep/DQM4hepConfig.h"
+#include "dqm4hep/Logging.h"
+#include "dqm4hep/OnlineRoutes.h"
+
+// -- std headers
+#include <algorithm>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    MonitorElementCollector::MonitorElementCollector() :
+      Application() {
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    MonitorElementCollector::~MonitorElementCollector() {
+      removeTimer(m_statsTimer10);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::parseCmdLine(int argc, char **argv) {
+      std::string cmdLineFooter = "Please report bug to <dqm4hep@gmail.com>";
+      m_cmdLine = std::make_shared<TCLAP::CmdLine>(cmdLineFooter, ' ', DQM4hep_VERSION_STR);
+
+      TCLAP::ValueArg<std::string> collectorNameArg(
+          "c"
+          , "collector-name"
+          , "The monitor element collector name"
+          , true
+          , ""
+          , "string");
+      m_cmdLine->add(collectorNameArg);
+
+      core::StringVector verbosities(core::Logger::logLevels());
+      TCLAP::ValuesConstraint<std::string> verbosityConstraint(verbosities);
+      TCLAP::ValueArg<std::string> verbosityArg(
+          "v"
+          , "verbosity"
+          , "The logging verbosity"
+          , false
+          , "info"
+          , &verbosityConstraint);
+      m_cmdLine->add(verbosityArg);
+
+      // parse command line
+      m_cmdLine->parse(argc, argv);
+
+      std::string verbosity(verbosityArg.getValue());
+      std::string collectorName(collectorNameArg.getValue());
+      setType(OnlineRoutes::MonitorElementCollector::applicationType());
+      setName(collectorName);
+      setLogLevel(core::Logger::logLevelFromString(verbosity));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::onInit() {
+      // create network services
+      createRequestHandler(
+        OnlineRoutes::MonitorElementCollector::registerModule(name()),
+        this,
+        &MonitorElementCollector::handleModuleRegistration
+      );
+      createDirectCommand(
+        OnlineRoutes::MonitorElementCollector::collectElements(name()),
+        this,
+        &MonitorElementCollector::handleCollectElements
+      );
+      createRequestHandler(
+        OnlineRoutes::MonitorElementCollector::elementRequest(name()),
+        this,
+        &MonitorElementCollector::handleElementRequest
+      );
+      createRequestHandler(
+        OnlineRoutes::MonitorElementCollector::elementList(name()),
+        this,
+        &MonitorElementCollector::handleElementListRequest
+      );
+      createDirectCommand(
+        OnlineRoutes::MonitorElementCollector::subscribe(name()),
+        this,
+        &MonitorElementCollector::handleSubscription
+      );
+      createDirectCommand(
+        OnlineRoutes::MonitorElementCollector::unsubscribe(name()),
+        this,
+        &MonitorElementCollector::handleUnsubscription
+      );
+      m_elementService = createService(OnlineRoutes::MonitorElementCollector::elementUpdate(name()));
+
+      // create statistics entries
+      createStatsEntry("NModules", "", "The current number of registered modules");
+      createStatsEntry("NElements", "", "The current number of collected monitor elements");
+      createStatsEntry("NElements_10sec", "1/10 sec", "The number of collected monitor elements within the last 10 secondes");
+      createStatsEntry("NBytes_10sec", "bytes", "The total number of collected bytes within the last 10 secondes");
+      createStatsEntry("NMeanBytes_10sec", "bytes/10 sec", "The mean number of collected bytes within the last 10 secondes");
+
+      // app stats timer
+      m_statsTimer10 = createTimer();
+      m_statsTimer10->setInterval(10000);
+      m_statsTimer10->setSingleShot(false);
+      m_statsTimer10->onTimeout().connect(this, &MonitorElementCollector::sendStatsTimer10);
+      m_lastStatCall10 = core::time::now();
+      m_statsTimer10->start();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::onEvent(AppEvent *pAppEvent) {
+      if(pAppEvent->type() == AppEvent::CLIENT_EXIT) {
+        auto exitEvent = dynamic_cast<StoreEvent<int>*>(pAppEvent);
+        this->handleClientExit(exitEvent);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::onStart() {
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::onStop() {
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::handleModuleRegistration(const net::Buffer &request, net::Buffer &response) {
+      core::json registrationDetails({}), responseValue({});
+      try {
+        registrationDetails = core::json::parse(request.begin(), request.end());
+      }
+      catch(...) {
+        registrationDetails = core::json({});
+      }
+      const std::string moduleName(registrationDetails.value<std::string>("module", ""));
+      const int clientId(this->serverClientId());
+
+      if(moduleName.empty()) {
+        responseValue["message"] = "No module name in registration request";
+        responseValue["registered"] = false;
+      }
+      else {
+        // the module may restart: keep its elements and subscriptions
+        core::json subscriptions = m_store.registerModule(moduleName, clientId);
+        dqm_info( "Module '{0}' registered with client id {1}", moduleName, clientId );
+        responseValue["registered"] = true;
+        responseValue["subscriptions"] = subscriptions;
+        sendStat("NModules", m_store.modules().size());
+      }
+
+      auto model = response.createModel<std::string>();
+      model->copy(responseValue.dump());
+      response.setModel(model);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::handleCollectElements(const net::Buffer &buffer) {
+      m_frames.clear();
+      if(core::STATUS_CODE_SUCCESS != ElementBatch::readFrames(buffer.begin(), buffer.size(), m_frames)) {
+        dqm_error( "MonitorElementCollector::handleCollectElements(): couldn't read element batch from client {0}", serverClientId() );
+        return;
+      }
+      m_clientSelections.clear();
+      m_frameElements.clear();
+
+      for(std::size_t f=0 ; f<m_frames.size() ; f++) {
+        const ElementBatch::Frame &frame(m_frames[f]);
+        ElementInfo &elementInfo(m_store.element(frame.m_moduleName, core::StringPair(frame.m_path, frame.m_name)));
+        if(elementInfo.m_buffer.empty()) {
+          ++m_nElements;
+        }
+        // re-using the string storage of the previous version
+        elementInfo.m_type = frame.m_type;
+        elementInfo.m_buffer.assign(frame.m_buffer, frame.m_size);
+        m_frameElements.push_back(&elementInfo);
+
+        for(const auto &subscriber : elementInfo.m_subscribers) {
+          std::vector<bool> &selection(m_clientSelections[subscriber]);
+          selection.resize(m_frames.size(), false);
+          selection[f] = true;
+        }
+      }
+      m_nCollectedElements10 += m_frames.size();
+      m_nCollectedBytes10 += buffer.size();
+      sendStat("NElements", m_nElements);
+
+      // subscribers with the same selection get the same update
+      m_selectedClients.clear();
+      for(const auto &selection : m_clientSelections) {
+        m_selectedClients[selection.second].push_back(selection.first);
+      }
+      for(const auto &selected : m_selectedClients) {
+        // subscribed to every element of the batch: forward it as received
+        if(selected.first.end() == std::find(selected.first.begin(), selected.first.end(), false)) {
+          m_elementService->sendBuffer(buffer.begin(), buffer.size(), selected.second);
+          continue;
+        }
+        // else re-pack the selected elements from their stored version
+        m_updateBatch.clear();
+        for(std::size_t f=0 ; f<m_frames.size() ; f++) {
+          if(selected.first[f]) {
+            ElementBatch::Frame &frame(m_frames[f]);
+            frame.m_buffer = m_frameElements[f]->m_buffer.c_str();
+            frame.m_size = m_frameElements[f]->m_buffer.size();
+            m_updateBatch.addElement(frame);
+          }
+        }
+        m_elementService->sendBuffer(m_updateBatch.buffer(), m_updateBatch.size(), selected.second);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::handleSubscription(const net::Buffer &buffer) {
+      this->updateSubscriptions(buffer, true);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::handleUnsubscription(const net::Buffer &buffer) {
+      this->updateSubscriptions(buffer, false);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::updateSubscriptions(const net::Buffer &buffer, bool subscribe) {
+      core::json elementList = nullptr;
+      try {
+        elementList = core::json::parse(buffer.begin(), buffer.end());
+      }
+      catch(...) {
+        dqm_error( "MonitorElementCollector::updateSubscriptions(): couldn't parse element list !" );
+        return;
+      }
+      if(not elementList.is_array()) {
+        dqm_error( "MonitorElementCollector::updateSubscriptions(): element list is not a json array !" );
+        return;
+      }
+      const int clientId(this->serverClientId());
+      ModuleNotificationMap notifications;
+      m_updateBatch.clear();
+
+      for(auto &element : elementList) {
+        const std::string moduleName(element.value<std::string>("module", ""));
+        const core::StringPair key(element.value<std::string>("path", ""), element.value<std::string>("name", ""));
+        if(moduleName.empty() || key.second.empty()) {
+          continue;
+        }
+        // the element may not be collected yet
+        const ElementInfo &elementInfo(m_store.updateSubscription(clientId, moduleName, key, subscribe, notifications));
+
+        // send the latest version straight away
+        if(subscribe and not elementInfo.m_buffer.empty()) {
+          addToBatch(m_updateBatch, moduleName, key, elementInfo);
+        }
+      }
+      if(not m_updateBatch.empty()) {
+        m_elementService->sendBuffer(m_updateBatch.buffer(), m_updateBatch.size(), clientId);
+      }
+      this->notifyModules(notifications);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::notifyModules(const ModuleNotificationMap &notifications) {
+      for(const auto &notification : notifications) {
+        // not connected: the module gets its subscriptions on registration
+        if(0 == m_store.moduleClientId(notification.first)) {
+          continue;
+        }
+        sendCommand(OnlineRoutes::ModuleApplication::subscribe(notification.first), notification.second.dump());
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::handleElementRequest(const net::Buffer &request, net::Buffer &response) {
+      core::json elementList = nullptr;
+      try {
+        elementList = core::json::parse(request.begin(), request.end());
+      }
+      catch(...) {
+        elementList = nullptr;
+      }
+      m_requestBatch.clear();
+
+      if(elementList.is_array()) {
+        for(auto &element : elementList) {
+          const std::string moduleName(element.value<std::string>("module", ""));
+          const core::StringPair key(element.value<std::string>("path", ""), element.value<std::string>("name", ""));
+          const ElementInfo *elementInfo(m_store.findElement(moduleName, key));
+          if(nullptr == elementInfo || elementInfo->m_buffer.empty()) {
+            continue;
+          }
+          addToBatch(m_requestBatch, moduleName, key, *elementInfo);
+        }
+      }
+
+      auto model = response.createModel<std::string>();
+      model->copy(m_requestBatch.buffer(), m_requestBatch.size());
+      response.setModel(model);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::handleElementListRequest(const net::Buffer &/*request*/, net::Buffer &response) {
+      core::json responseValue({});
+
+      for(const auto &module : m_store.modules()) {
+        core::json elements = core::json::array();
+        for(const auto &element : module.second.m_elements) {
+          if(element.second.m_buffer.empty()) {
+            continue;
+          }
+          elements.push_back({
+            {"path", element.first.first},
+            {"name", element.first.second},
+            {"type", element.second.m_type},
+            {"subscribers", element.second.m_subscribers.size()}
+          });
+        }
+        responseValue[module.first] = elements;
+      }
+
+      auto model = response.createModel<std::string>();
+      model->copy(responseValue.dump());
+      response.setModel(model);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::handleClientExit(StoreEvent<int> *event) {
+      ModuleNotificationMap notifications;
+      m_store.removeClient(event->data(), notifications);
+      this->notifyModules(notifications);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::addToBatch(ElementBatch &batch, const std::string &moduleName, const core::StringPair &key, const ElementInfo &element) {
+      ElementBatch::Frame frame;
+      frame.m_moduleName = moduleName;
+      frame.m_path = key.first;
+      frame.m_name = key.second;
+      frame.m_type = element.m_type;
+      frame.m_buffer = element.m_buffer.c_str();
+      frame.m_size = element.m_buffer.size();
+      batch.addElement(frame);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::sendStatsTimer10() {
+      auto timeDifference = std::chrono::duration_cast<std::chrono::milliseconds>(core::time::now()-m_lastStatCall10).count();
+      // send stats
+      sendStat("NElements_10sec", m_nCollectedElements10);
+      sendStat("NBytes_10sec", m_nCollectedBytes10);
+      sendStat("NMeanBytes_10sec", m_nCollectedBytes10 / (timeDifference/1000.));
+      // reset counters
+      m_nCollectedElements10 = 0;
+      m_nCollectedBytes10 = 0;
+      m_lastStatCall10 = core::time::now();
+    }
+
+  }
+
+}
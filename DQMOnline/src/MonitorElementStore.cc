@@ -0,0 +1,115 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include "dqm4hep/MonitorElementStore.h"
+#include "dqm4hep/Logging.h"
+
+namespace dqm4hep {
+
+  namespace online {
+
+    core::json MonitorElementStore::registerModule(const std::string &moduleName, int clientId) {
+      ModuleInfo &moduleInfo(m_moduleInfoMap[moduleName]);
+      moduleInfo.m_clientId = clientId;
+      core::json subscriptions = core::json::array();
+
+      for(const auto &element : moduleInfo.m_elements) {
+        if(not element.second.m_subscribers.empty()) {
+          subscriptions.push_back({
+            {"path", element.first.first},
+            {"name", element.first.second},
+            {"sub", true}
+          });
+        }
+      }
+      return subscriptions;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    int MonitorElementStore::moduleClientId(const std::string &moduleName) const {
+      auto findIter = m_moduleInfoMap.find(moduleName);
+      return (m_moduleInfoMap.end() == findIter) ? 0 : findIter->second.m_clientId;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    MonitorElementStore::ElementInfo &MonitorElementStore::element(const std::string &moduleName, const core::StringPair &key) {
+      return m_moduleInfoMap[moduleName].m_elements[key];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const MonitorElementStore::ElementInfo *MonitorElementStore::findElement(const std::string &moduleName, const core::StringPair &key) const {
+      auto findIter = m_moduleInfoMap.find(moduleName);
+      if(m_moduleInfoMap.end() == findIter) {
+        return nullptr;
+      }
+      auto elementIter = findIter->second.m_elements.find(key);
+      return (findIter->second.m_elements.end() == elementIter) ? nullptr : &elementIter->second;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const MonitorElementStore::ElementInfo &MonitorElementStore::updateSubscription(int clientId, const std::string &moduleName, const core::StringPair &key,
+        bool subscribe, NotificationMap &notifications) {
+      ElementInfo &elementInfo(this->element(moduleName, key));
+      const bool wasSubscribed(not elementInfo.m_subscribers.empty());
+
+      if(subscribe) {
+        elementInfo.m_subscribers.insert(clientId);
+      }
+      else {
+        elementInfo.m_subscribers.erase(clientId);
+      }
+      if(wasSubscribed == elementInfo.m_subscribers.empty()) {
+        addNotification(notifications, moduleName, key, subscribe);
+      }
+      return elementInfo;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementStore::removeClient(int clientId, NotificationMap &notifications) {
+      for(auto &module : m_moduleInfoMap) {
+        // the module elements are kept until it restarts
+        if(module.second.m_clientId == clientId) {
+          dqm_info( "Module '{0}' disconnected !", module.first );
+          module.second.m_clientId = 0;
+        }
+        // the client may also be an element subscriber
+        for(auto &element : module.second.m_elements) {
+          if(1 == element.second.m_subscribers.erase(clientId) && element.second.m_subscribers.empty()) {
+            addNotification(notifications, module.first, element.first, false);
+          }
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const MonitorElementStore::ModuleInfoMap &MonitorElementStore::modules() const {
+      return m_moduleInfoMap;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementStore::addNotification(NotificationMap &notifications, const std::string &moduleName, const core::StringPair &key, bool subscribe) {
+      notifications[moduleName].push_back({
+        {"path", key.first},
+        {"name", key.second},
+        {"sub", subscribe}
+      });
+    }
+
+  }
+
+}
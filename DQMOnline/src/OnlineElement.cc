@@ -87,7 +87,10 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     void OnlineElement::setRunNumber(int runNum) {
-      m_runNumber = runNum;
+      if(runNum != m_runNumber) {
+        m_runNumber = runNum;
+        setModified();
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -112,6 +115,7 @@ namespace dqm4hep {
     
     void OnlineElement::setDescription(const std::string &desc) {
       m_description = desc;
+      setModified();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -153,6 +157,10 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void OnlineElement::setSubscribed(bool sub) {
+      // a new subscriber needs the element, even if not modified
+      if(sub and not m_subscribed) {
+        m_publishedGeneration = 0;
+      }
       m_subscribed = sub;
     }
     
@@ -172,6 +180,12 @@ namespace dqm4hep {
       m_reports[report.m_qualityTestName] = report;
       return core::STATUS_CODE_SUCCESS;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void OnlineElement::setQualityReports(const core::QReportMap &reports) {
+      m_reports = reports;
+    }
     
     //-------------------------------------------------------------------------------------------------
     
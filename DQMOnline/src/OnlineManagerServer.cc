@@ -99,7 +99,7 @@ namespace dqm4hep {
       }
       // check app stat consistency
       bool appStatConsistent = (
-        1 == appStat.count("logger") &&
+        1 == appStat.count("name") &&
         1 == appStat.count("value") &&
         1 == appStat.count("appType") &&
         1 == appStat.count("appName") &&
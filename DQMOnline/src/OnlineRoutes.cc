@@ -74,12 +74,79 @@ namespace dqm4hep {
       return OnlineRoutes::Application::serverName(applicationType(), collector) + "/updates/" + source;
     }
     
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::EventCollector::selectedEventUpdate(const std::string &collector, const std::string &source) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/selected/" + source;
+    }
+    
     //-------------------------------------------------------------------------------------------------
 
     std::string OnlineRoutes::EventCollector::eventRequest(const std::string &collector) {
       return OnlineRoutes::Application::serverName(applicationType(), collector) + "/lastevt";
     }
     
+    //-------------------------------------------------------------------------------------------------
+
+    std::string OnlineRoutes::EventCollector::subscribe(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/subscribe";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    std::string OnlineRoutes::EventCollector::unsubscribe(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/unsubscribe";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::applicationType() {
+      return "mecol";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::registerModule(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/register";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::collectElements(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/collect";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::elementUpdate(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/updates";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::elementRequest(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/elements";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::elementList(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/list";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::subscribe(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/subscribe";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::unsubscribe(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/unsubscribe";
+    }
+    
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
     
@@ -0,0 +1,126 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Logger.h>
+#include <dqm4hep/AppEventLoop.h>
+#include <dqm4hep/AppEvents.h>
+
+// -- std headers
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+
+using BenchClock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  EventLoopBenchmark class.
+ *          Posts N StoreEvent<int> from a producer thread and
+ *          measures the post-to-dispatch latency of each event
+ */
+class EventLoopBenchmark {
+public:
+  EventLoopBenchmark(AppEventLoop::Mode loopMode, unsigned int nEvents) :
+    m_nEvents(nEvents),
+    m_postTimes(nEvents),
+    m_dispatchTimes(nEvents) {
+    m_eventLoop.setMode(loopMode);
+    m_eventLoop.connectOnEvent(this, &EventLoopBenchmark::onEvent);
+  }
+
+  EventLoopBenchmark(const EventLoopBenchmark&) = delete;
+  EventLoopBenchmark& operator=(const EventLoopBenchmark&) = delete;
+
+  void run(const std::string &modeName) {
+    std::thread producer([this](){
+      for(unsigned int i=0 ; i<m_nEvents ; i++) {
+        m_postTimes[i] = BenchClock::now();
+        m_eventLoop.postEvent(new StoreEvent<int>(AppEvent::USER, i));
+      }
+    });
+    m_eventLoop.exec();
+    producer.join();
+
+    std::vector<double> latencies(m_nEvents);
+    for(unsigned int i=0 ; i<m_nEvents ; i++) {
+      latencies[i] = std::chrono::duration<double, std::micro>(m_dispatchTimes[i] - m_postTimes[i]).count();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const double totalTime = std::chrono::duration<double>(m_dispatchTimes[m_lastIndex] - m_postTimes[0]).count();
+    const double p50 = latencies[static_cast<size_t>(0.50*(m_nEvents-1))];
+    const double p99 = latencies[static_cast<size_t>(0.99*(m_nEvents-1))];
+
+    dqm_info( "[{0}] {1} events processed in {2} s", modeName, m_nEvents, totalTime );
+    dqm_info( "[{0}]   throughput  : {1} events/s", modeName, m_nEvents/totalTime );
+    dqm_info( "[{0}]   latency p50 : {1} us", modeName, p50 );
+    dqm_info( "[{0}]   latency p99 : {1} us", modeName, p99 );
+  }
+
+private:
+  void onEvent(AppEvent *pAppEvent) {
+    if(pAppEvent->type() != AppEvent::USER) {
+      return;
+    }
+    auto storeEvent = dynamic_cast<StoreEvent<int>*>(pAppEvent);
+    m_dispatchTimes[storeEvent->data()] = BenchClock::now();
+    m_lastIndex = storeEvent->data();
+
+    if(++m_nReceived == m_nEvents) {
+      m_eventLoop.quit();
+    }
+  }
+
+private:
+  AppEventLoop                         m_eventLoop = {};
+  const unsigned int                   m_nEvents;
+  unsigned int                         m_nReceived = {0};
+  int                                  m_lastIndex = {0};
+  std::vector<BenchClock::time_point>  m_postTimes;
+  std::vector<BenchClock::time_point>  m_dispatchTimes;
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  Logger::createLogger("bench-app-event-loop", {Logger::coloredConsole()});
+  Logger::setMainLogger("bench-app-event-loop");
+
+  // the polling mode sleeps 100 us per event, pass a smaller
+  // number of events as first argument for a quicker run
+  const unsigned int nEvents = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+  if(0 == nEvents) {
+    dqm_error( "Number of events must be positive" );
+    return 1;
+  }
+
+  {
+    EventLoopBenchmark benchmark(AppEventLoop::POLLING, nEvents);
+    benchmark.run("POLLING");
+  }
+  {
+    EventLoopBenchmark benchmark(AppEventLoop::BLOCKING, nEvents);
+    benchmark.run("BLOCKING");
+  }
+
+  return 0;
+}
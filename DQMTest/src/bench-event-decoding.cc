@@ -0,0 +1,153 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Logger.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/EventBatch.h>
+#include <dqm4hep/EventDecoder.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+
+using BenchClock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  EventCounter class.
+ *          Counts the events emitted by the decoder
+ */
+class EventCounter {
+public:
+  void receiveEvent(EventPtr /*event*/) {
+    ++m_nEvents;
+  }
+
+public:
+  std::atomic<unsigned long>    m_nEvents = {0};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Serialize a generic event with a float payload of approximately the given size
+ */
+std::string createFrame(unsigned int payloadSize) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName("GenericEventStreamer");
+  event->setSource("BenchSource");
+  // 4 keys of equal size
+  const unsigned int nValues = payloadSize / (4*sizeof(float));
+  for(unsigned int k=0 ; k<4 ; k++) {
+    FloatVector values(nValues, 1.f*k);
+    event->getEvent<GenericEvent>()->setValues("Values" + std::to_string(k), values);
+  }
+  EventStreamer streamer;
+  TBufferFile buffer(TBuffer::kWrite);
+  streamer.writeEvent(event, buffer);
+  return std::string(buffer.Buffer(), buffer.Length());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Decode the frame N times on the calling thread. Return the elapsed time (unit s)
+ */
+double runInline(const std::string &frame, unsigned int nFrames) {
+  EventStreamer streamer;
+  TBufferFile inputBuffer(TBuffer::kRead);
+  EventList events;
+  const auto startTime = BenchClock::now();
+  for(unsigned int i=0 ; i<nFrames ; i++) {
+    events.clear();
+    EventBatch::readEvents(streamer, inputBuffer, frame.data(), frame.size(), events);
+  }
+  return std::chrono::duration<double>(BenchClock::now() - startTime).count();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Push the frame N times in a decoder. Return the elapsed time (unit s)
+ *          until all the events are emitted
+ */
+double runDecoder(const std::string &frame, unsigned int nFrames, unsigned int nThreads) {
+  EventCounter counter;
+  EventDecoder::EventSignal signal;
+  signal.connect(&counter, &EventCounter::receiveEvent);
+  EventDecoder decoder(nThreads, 64);
+  const auto startTime = BenchClock::now();
+  for(unsigned int i=0 ; i<nFrames ; i++) {
+    // retry instead of dropping, we want to measure the decoding throughput
+    while(not decoder.push(frame.data(), frame.size(), signal)) {
+      std::this_thread::yield();
+    }
+  }
+  while(counter.m_nEvents.load() < nFrames) {
+    std::this_thread::yield();
+  }
+  return std::chrono::duration<double>(BenchClock::now() - startTime).count();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void printResult(const std::string &name, const std::string &frame, unsigned int nFrames, double time) {
+  dqm_info( "[{0}] {1} frames of {2} bytes: {3} frames/s, {4} MB/s", name, nFrames, frame.size(),
+    nFrames/time, (nFrames*frame.size())/(time*1024.*1024.) );
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  Logger::createLogger("bench-event-decoding", {Logger::coloredConsole()});
+  Logger::setMainLogger("bench-event-decoding");
+
+  // total amount of data decoded per configuration (unit MB)
+  const unsigned int totalSize = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200;
+
+  if(0 == totalSize) {
+    dqm_error( "Total size must be positive" );
+    return 1;
+  }
+
+  const std::vector<unsigned int> payloadSizes = {1024, 10*1024, 100*1024, 1024*1024};
+  const std::vector<unsigned int> nThreads = {1, 2, 4};
+
+  for(auto payloadSize : payloadSizes) {
+    const std::string frame = createFrame(payloadSize);
+    const unsigned int nFrames = std::max<unsigned int>(1, (totalSize*1024*1024) / frame.size());
+    printResult("INLINE", frame, nFrames, runInline(frame, nFrames));
+    for(auto threads : nThreads) {
+      printResult("DECODER-" + std::to_string(threads), frame, nFrames, runDecoder(frame, nFrames, threads));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Logger.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/PluginManager.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace dqm4hep::core;
+
+using BenchClock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Create a small generic event with nValues floats
+ */
+EventPtr createEvent(const std::string &streamerName, unsigned int nValues) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName(streamerName);
+  event->setSource("BenchSource");
+  event->getEvent<GenericEvent>()->setValues("Values", FloatVector(nValues, 1.f));
+  return event;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Convert the compact frame to the older frame format, starting with the streamer name
+ *          followed by the base event data
+ */
+void toLegacyFrame(EventPtr event, const TBufferFile &compactBuffer, TBufferFile &legacyBuffer) {
+  legacyBuffer.Reset();
+  legacyBuffer.WriteStdString(&event->getStreamerName());
+  legacyBuffer.WriteInt(event->getType());
+  legacyBuffer.WriteStdString(&event->getSource());
+  legacyBuffer.WriteInt(time::asInt(event->getTimeStamp()));
+  legacyBuffer.WriteLong64(event->getEventSize());
+  legacyBuffer.WriteInt(event->getEventNumber());
+  legacyBuffer.WriteInt(event->getRunNumber());
+  legacyBuffer.WriteFastArray(compactBuffer.Buffer() + EventHeader::size, compactBuffer.Length() - EventHeader::size);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Stream N events alternating two streamers, with compact and older frames
+ */
+void runBenchmark(unsigned int nValues, unsigned int nEvents) {
+  const std::vector<std::string> streamerNames = {"GenericEventStreamer", "GenericEventColumnarStreamer"};
+  std::vector<EventPtr> events = {createEvent(streamerNames[0], nValues), createEvent(streamerNames[1], nValues)};
+  std::vector<TBufferFile*> compactFrames, legacyFrames;
+  EventStreamer streamer;
+  for(unsigned int s=0 ; s<streamerNames.size() ; s++) {
+    compactFrames.push_back(new TBufferFile(TBuffer::kWrite));
+    legacyFrames.push_back(new TBufferFile(TBuffer::kWrite));
+    streamer.writeEvent(events[s], *compactFrames[s]);
+    toLegacyFrame(events[s], *compactFrames[s], *legacyFrames[s]);
+  }
+  TBufferFile outBuffer(TBuffer::kWrite);
+  TBufferFile inBuffer(TBuffer::kRead);
+
+  // write, compact frames
+  auto startTime = BenchClock::now();
+  for(unsigned int e=0 ; e<nEvents ; e++) {
+    outBuffer.Reset();
+    streamer.writeEvent(events[e%2], outBuffer);
+  }
+  const double writeTime = std::chrono::duration<double, std::nano>(BenchClock::now() - startTime).count() / nEvents;
+
+  // read, compact and older frames
+  double readTimes[2] = {0., 0.};
+  for(unsigned int format=0 ; format<2 ; format++) {
+    std::vector<TBufferFile*> &frames(0 == format ? compactFrames : legacyFrames);
+    startTime = BenchClock::now();
+    for(unsigned int e=0 ; e<nEvents ; e++) {
+      EventPtr inEvent;
+      inBuffer.SetBuffer(frames[e%2]->Buffer(), frames[e%2]->Length(), false);
+      streamer.readEvent(inEvent, inBuffer);
+    }
+    readTimes[format] = std::chrono::duration<double, std::nano>(BenchClock::now() - startTime).count() / nEvents;
+  }
+
+  // streamer plugin allocation on each streamer change, as before the registry
+  startTime = BenchClock::now();
+  for(unsigned int e=0 ; e<nEvents ; e++) {
+    EventStreamerPluginPtr plugin = PluginManager::instance()->create<EventStreamerPlugin>(streamerNames[e%2]);
+  }
+  const double createTime = std::chrono::duration<double, std::nano>(BenchClock::now() - startTime).count() / nEvents;
+
+  const unsigned int compactSize = compactFrames[0]->Length();
+  const unsigned int legacySize = legacyFrames[0]->Length();
+  dqm_info( "[{0} floats] frame: {1} bytes, {2} bytes with streamer and source names ({3:.1f}% saved)",
+    nValues, compactSize, legacySize, 100.*(legacySize-compactSize)/legacySize );
+  dqm_info( "[{0} floats]   write           : {1:.0f} ns/event", nValues, writeTime );
+  dqm_info( "[{0} floats]   read            : {1:.0f} ns/event", nValues, readTimes[0] );
+  dqm_info( "[{0} floats]   read (name)     : {1:.0f} ns/event", nValues, readTimes[1] );
+  dqm_info( "[{0} floats]   plugin creation : {1:.0f} ns/event saved when alternating streamers", nValues, createTime );
+
+  for(unsigned int s=0 ; s<streamerNames.size() ; s++) {
+    delete compactFrames[s];
+    delete legacyFrames[s];
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  Logger::createLogger("bench-event-streamer-registry", {Logger::coloredConsole()});
+  Logger::setMainLogger("bench-event-streamer-registry");
+
+  const unsigned int nEvents = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+  if(0 == nEvents) {
+    dqm_error( "Number of events must be positive" );
+    return 1;
+  }
+
+  const std::vector<unsigned int> nValues = {0, 4, 64};
+
+  for(auto values : nValues) {
+    runBenchmark(values, nEvents);
+  }
+
+  return 0;
+}
@@ -0,0 +1,96 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Logger.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/GenericEvent.h>
+
+// -- std headers
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace dqm4hep::core;
+
+using BenchClock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Time nEvents x nKeys look-ups with the given access function.
+ *          Print the time per look-up
+ */
+template <typename F>
+void runBenchmark(const std::string &name, unsigned int nEvents, unsigned int nKeys, F function) {
+  double sum = 0.;
+  const auto startTime = BenchClock::now();
+  for(unsigned int e=0 ; e<nEvents ; e++) {
+    for(unsigned int k=0 ; k<nKeys ; k++) {
+      sum += function(k);
+    }
+  }
+  const double time = std::chrono::duration<double, std::nano>(BenchClock::now() - startTime).count();
+  dqm_info( "[{0}] {1} keys: {2} ns per look-up (check sum {3})", name, nKeys, time/(nEvents*nKeys), sum );
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  Logger::createLogger("bench-generic-event-access", {Logger::coloredConsole()});
+  Logger::setMainLogger("bench-generic-event-access");
+
+  const unsigned int nEvents = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+  if(0 == nEvents) {
+    dqm_error( "Number of events must be positive" );
+    return 1;
+  }
+
+  // typical monitoring event: a few dozen keys of small vectors
+  const std::vector<unsigned int> nKeys = {4, 16, 64};
+  const unsigned int nValues = 16;
+
+  for(auto keys : nKeys) {
+    EventPtr event = GenericEvent::make_shared();
+    GenericEvent *generic = event->getEvent<GenericEvent>();
+    std::vector<std::string> keyNames;
+    std::vector<GenericEvent::Key> keyHandles;
+    for(unsigned int k=0 ; k<keys ; k++) {
+      keyNames.push_back("Channel/Values" + std::to_string(k));
+      keyHandles.push_back(GenericEvent::Key(keyNames.back()));
+      generic->setValues(keyHandles.back(), FloatVector(nValues, 1.f*k));
+    }
+
+    runBenchmark("STRING-COPY", nEvents, keys, [&](unsigned int k){
+      FloatVector values;
+      generic->getValues(keyNames[k], values);
+      return values[0];
+    });
+    runBenchmark("STRING-VIEW", nEvents, keys, [&](unsigned int k){
+      ArrayView<float> values;
+      generic->getValues(keyNames[k], values);
+      return values[0];
+    });
+    runBenchmark("KEY-VIEW", nEvents, keys, [&](unsigned int k){
+      ArrayView<float> values;
+      generic->getValues(keyHandles[k], values);
+      return values[0];
+    });
+  }
+
+  return 0;
+}
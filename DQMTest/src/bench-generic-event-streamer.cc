@@ -0,0 +1,128 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Logger.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace dqm4hep::core;
+
+using BenchClock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Create a generic event with nKeys float vectors for a total payload of approximately the given size
+ */
+EventPtr createEvent(const std::string &streamerName, unsigned int payloadSize, unsigned int nKeys) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName(streamerName);
+  event->setSource("BenchSource");
+  const unsigned int nValues = payloadSize / (nKeys*sizeof(float));
+  for(unsigned int k=0 ; k<nKeys ; k++) {
+    FloatVector values(nValues, 1.f*k);
+    event->getEvent<GenericEvent>()->setValues("Values" + std::to_string(k), values);
+  }
+  return event;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Serialize, deserialize and sum up all the values of the event N times
+ */
+void runBenchmark(const std::string &streamerName, unsigned int payloadSize, unsigned int nKeys, unsigned int totalSize) {
+  EventPtr event = createEvent(streamerName, payloadSize, nKeys);
+  EventStreamer streamer;
+  TBufferFile outBuffer(TBuffer::kWrite);
+  TBufferFile inBuffer(TBuffer::kRead);
+  streamer.writeEvent(event, outBuffer);
+  const unsigned int frameSize = outBuffer.Length();
+  const unsigned int nEvents = std::max<unsigned int>(1, (totalSize*1024.*1024.) / frameSize);
+  std::vector<std::string> keys;
+  for(unsigned int k=0 ; k<nKeys ; k++) {
+    keys.push_back("Values" + std::to_string(k));
+  }
+
+  // write
+  auto startTime = BenchClock::now();
+  for(unsigned int e=0 ; e<nEvents ; e++) {
+    outBuffer.Reset();
+    streamer.writeEvent(event, outBuffer);
+  }
+  const double writeTime = std::chrono::duration<double>(BenchClock::now() - startTime).count();
+
+  // read + access values
+  double sum = 0.;
+  startTime = BenchClock::now();
+  for(unsigned int e=0 ; e<nEvents ; e++) {
+    EventPtr inEvent;
+    inBuffer.SetBuffer(outBuffer.Buffer(), outBuffer.Length(), false);
+    streamer.readEvent(inEvent, inBuffer);
+    const GenericEvent *generic = inEvent->getEvent<GenericEvent>();
+    for(const auto &key : keys) {
+      ArrayView<float> values;
+      generic->getValues(key, values);
+      for(auto value : values) {
+        sum += value;
+      }
+    }
+  }
+  const double readTime = std::chrono::duration<double>(BenchClock::now() - startTime).count();
+  const double totalMB = (static_cast<double>(nEvents)*frameSize)/(1024.*1024.);
+
+  dqm_info( "[{0}] {1} keys, frame of {2} bytes, {3} events (check sum {4})", streamerName, nKeys, frameSize, nEvents, sum );
+  dqm_info( "[{0}]   write : {1} events/s, {2} MB/s", streamerName, nEvents/writeTime, totalMB/writeTime );
+  dqm_info( "[{0}]   read  : {1} events/s, {2} MB/s", streamerName, nEvents/readTime, totalMB/readTime );
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  Logger::createLogger("bench-generic-event-streamer", {Logger::coloredConsole()});
+  Logger::setMainLogger("bench-generic-event-streamer");
+
+  // total amount of data streamed per configuration (unit MB)
+  const unsigned int totalSize = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 500;
+
+  if(0 == totalSize) {
+    dqm_error( "Total size must be positive" );
+    return 1;
+  }
+
+  const std::vector<unsigned int> payloadSizes = {1024, 100*1024, 1024*1024};
+  const std::vector<unsigned int> nKeys = {4, 64};
+
+  for(auto payloadSize : payloadSizes) {
+    for(auto keys : nKeys) {
+      runBenchmark("GenericEventStreamer", payloadSize, keys, totalSize);
+      runBenchmark("GenericEventColumnarStreamer", payloadSize, keys, totalSize);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,96 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Logger.h>
+#include <dqm4hep/MonitorElement.h>
+#include <dqm4hep/MonitorElementManager.h>
+
+// -- root headers
+#include <TH1.h>
+
+// -- std headers
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace dqm4hep::core;
+
+using BenchClock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  Logger::createLogger("bench-monitor-element-lookup", {Logger::coloredConsole()});
+  Logger::setMainLogger("bench-monitor-element-lookup");
+
+  const unsigned int nElements = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const unsigned int nDirectories = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100;
+
+  if(0 == nElements || 0 == nDirectories) {
+    dqm_error( "Number of elements and directories must be positive" );
+    return 1;
+  }
+
+  // avoid registering the histograms in the ROOT directory, as done online
+  TH1::AddDirectory(false);
+  MonitorElementManager manager;
+  std::vector<std::string> paths, names;
+  paths.reserve(nElements);
+  names.reserve(nElements);
+  for(unsigned int e=0 ; e<nElements ; e++) {
+    paths.push_back("/Calorimeter/Layer" + std::to_string(e % nDirectories));
+    names.push_back("Hits" + std::to_string(e));
+  }
+
+  // booking, including the check for an already booked element
+  auto startTime = BenchClock::now();
+  for(unsigned int e=0 ; e<nElements ; e++) {
+    MonitorElementPtr monitorElement;
+    if(STATUS_CODE_SUCCESS != manager.bookHisto<TH1F>(paths[e], names[e], names[e], monitorElement, 1, 0.f, 1.f)) {
+      dqm_error( "Couldn't book element {0}/{1}", paths[e], names[e] );
+      return 1;
+    }
+  }
+  const double bookTime = std::chrono::duration<double, std::nano>(BenchClock::now() - startTime).count() / nElements;
+
+  // lookup by path and name
+  unsigned int nFound(0);
+  startTime = BenchClock::now();
+  for(unsigned int e=0 ; e<nElements ; e++) {
+    MonitorElementPtr monitorElement;
+    nFound += (STATUS_CODE_SUCCESS == manager.getMonitorElement(paths[e], names[e], monitorElement)) ? 1 : 0;
+  }
+  const double lookupTime = std::chrono::duration<double, std::nano>(BenchClock::now() - startTime).count() / nElements;
+
+  // directory scan, as done before the index. Only a sample, the scan being linear
+  const unsigned int nScans = std::min(nElements, 1000u);
+  unsigned int nScanned(0);
+  startTime = BenchClock::now();
+  for(unsigned int s=0 ; s<nScans ; s++) {
+    const unsigned int e = (s * 7919u) % nElements;
+    const std::string &name(names[e]);
+    nScanned += (nullptr != manager.getStorage().findObject(paths[e], [&name](const MonitorElementPtr &elt) { return (elt->name() == name); })) ? 1 : 0;
+  }
+  const double scanTime = std::chrono::duration<double, std::nano>(BenchClock::now() - startTime).count() / nScans;
+
+  dqm_info( "{0} elements in {1} directories", nElements, nDirectories );
+  dqm_info( "  book            : {0:.0f} ns/element", bookTime );
+  dqm_info( "  lookup (index)  : {0:.0f} ns/element ({1} found)", lookupTime, nFound );
+  dqm_info( "  lookup (scan)   : {0:.0f} ns/element ({1}/{2} found)", scanTime, nScanned, nScans );
+
+  return (nFound == nElements && nScanned == nScans) ? 0 : 1;
+}
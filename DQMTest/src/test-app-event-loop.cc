@@ -0,0 +1,178 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/AppEventLoop.h>
+#include <dqm4hep/AppEvents.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class EventRecorder {
+public:
+  EventRecorder(AppEventLoop &loop, unsigned int nExpected) :
+    m_eventLoop(loop),
+    m_nExpected(nExpected) {
+    m_eventLoop.connectOnEvent(this, &EventRecorder::onEvent);
+  }
+
+  EventRecorder(const EventRecorder&) = delete;
+  EventRecorder& operator=(const EventRecorder&) = delete;
+
+  void onEvent(AppEvent *pAppEvent) {
+    if(pAppEvent->type() != AppEvent::USER) {
+      return;
+    }
+    auto storeEvent = dynamic_cast<StoreEvent<int>*>(pAppEvent);
+    m_priorities.push_back(pAppEvent->priority());
+    m_values.push_back(storeEvent->data());
+    if(m_values.size() == m_nExpected) {
+      m_eventLoop.quit();
+    }
+  }
+
+public:
+  AppEventLoop&           m_eventLoop;
+  const unsigned int      m_nExpected;
+  std::vector<int>        m_priorities = {};
+  std::vector<int>        m_values = {};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+void postEvent(AppEventLoop &loop, int value, int priority) {
+  auto event = new StoreEvent<int>(AppEvent::USER, value);
+  event->setPriority(priority);
+  loop.postEvent(event);
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int /*argc*/, char ** /*argv*/) {
+
+  UnitTest unitTest("test-app-event-loop");
+
+  // priority order and FIFO order within a priority
+  {
+    AppEventLoop loop;
+    EventRecorder recorder(loop, 300);
+
+    for(int i=0 ; i<100 ; i++) {
+      postEvent(loop, i, 30);
+      postEvent(loop, i, 70);
+      postEvent(loop, i, 50);
+    }
+
+    unitTest.test("COUNT_TOTAL", loop.count() == 300);
+    unitTest.test("COUNT_PRIORITY_30", loop.countPriority(30) == 100);
+    unitTest.test("COUNT_PRIORITY_70", loop.countPriority(70) == 100);
+    unitTest.test("COUNT_PRIORITY_EMPTY", loop.countPriority(10) == 0);
+
+    loop.exec();
+
+    unitTest.test("COUNT_AFTER_EXEC", loop.count() == 0);
+    unitTest.test("N_PROCESSED", recorder.m_values.size() == 300);
+
+    bool priorityOrdered = true;
+    bool fifoOrdered = true;
+    for(unsigned int i=0 ; i<recorder.m_values.size() ; i++) {
+      const int expectedPriority = (i < 100) ? 70 : ((i < 200) ? 50 : 30);
+      priorityOrdered = priorityOrdered && (recorder.m_priorities[i] == expectedPriority);
+      fifoOrdered = fifoOrdered && (recorder.m_values[i] == static_cast<int>(i % 100));
+    }
+    unitTest.test("PRIORITY_ORDER", priorityOrdered);
+    unitTest.test("FIFO_ORDER", fifoOrdered);
+  }
+
+  // multiple producers: FIFO order preserved per producer
+  {
+    const int nProducers = 4;
+    const int nEvents = 20000;
+    AppEventLoop loop;
+    EventRecorder recorder(loop, nProducers*nEvents);
+
+    std::vector<std::thread> producers;
+    for(int p=0 ; p<nProducers ; p++) {
+      producers.push_back(std::thread([&loop,p,nEvents](){
+        for(int i=0 ; i<nEvents ; i++) {
+          postEvent(loop, p*nEvents+i, 50);
+        }
+      }));
+    }
+
+    loop.exec();
+
+    for(auto &producer : producers) {
+      producer.join();
+    }
+
+    unitTest.test("N_PROCESSED_MT", recorder.m_values.size() == static_cast<size_t>(nProducers*nEvents));
+
+    std::vector<int> lastValues(nProducers, -1);
+    bool fifoOrdered = true;
+    for(auto value : recorder.m_values) {
+      const int producer = value / nEvents;
+      fifoOrdered = fifoOrdered && (value > lastValues[producer]);
+      lastValues[producer] = value;
+    }
+    unitTest.test("FIFO_ORDER_MT", fifoOrdered);
+  }
+
+  // extreme priorities and lanes on both sides of a bitmap word
+  {
+    AppEventLoop loop;
+    const std::vector<int> priorities = {0, 63, 100, 64, 1, 99};
+    EventRecorder recorder(loop, priorities.size());
+    for(auto priority : priorities) {
+      postEvent(loop, priority, priority);
+    }
+    loop.exec();
+    unitTest.test("EXTREME_PRIORITY_ORDER", recorder.m_priorities == std::vector<int>({100, 99, 64, 63, 1, 0}));
+    unitTest.test("EXTREME_PRIORITY_EMPTY", loop.count() == 0 && loop.countPriority(100) == 0 && loop.countPriority(0) == 0);
+  }
+
+  // event pool: processed events are recycled
+  {
+    AppEventLoop loop;
+    auto &pool = loop.storeEventPool<int>();
+    unitTest.test("SAME_POOL", &pool == &loop.storeEventPool<int>());
+
+    // two runs: the second run re-uses the events of the first one
+    for(int run=0 ; run<2 ; run++) {
+      EventRecorder recorder(loop, 10);
+      for(int i=0 ; i<10 ; i++) {
+        loop.postEvent(pool.create(AppEvent::USER, i));
+      }
+      loop.exec();
+      loop.disconnectOnEvent(&recorder);
+      unitTest.test("N_PROCESSED_POOL", recorder.m_values.size() == 10);
+    }
+
+    unitTest.test("POOL_MISSES", pool.misses() == 10);
+    unitTest.test("POOL_HITS", pool.hits() == 10);
+    unitTest.test("LOOP_POOL_HITS", loop.poolHits() == 10);
+    unitTest.test("LOOP_POOL_MISSES", loop.poolMisses() == 10);
+  }
+
+  return 0;
+}
@@ -0,0 +1,182 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Application.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <vector>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+using TestClock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class TestApplication : public Application {
+public:
+  TestApplication(UnitTest& unitTest, const std::string &appName) :
+    Application(),
+    m_unitTest(unitTest) {
+    setType("test");
+    setName(appName);
+    setLogLevel(spdlog::level::debug);
+    enableStats(false);
+    setNoServer(true);
+  }
+  ~TestApplication() {}
+  virtual void parseCmdLine(int /*argc*/, char ** /*argv*/) override {}
+  virtual void onStop() override {}
+  virtual void onEvent(AppEvent */*pAppEvent*/) override {}
+
+protected:
+  UnitTest&         m_unitTest;
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class JitterTestApp : public TestApplication {
+public:
+  JitterTestApp(UnitTest &test) :
+    TestApplication(test, "jitter") {
+  }
+  JitterTestApp(const JitterTestApp&) = delete;
+  JitterTestApp& operator=(const JitterTestApp&) = delete;
+  ~JitterTestApp() {
+    removeTimer(m_timer);
+  }
+
+  void onInit() override {
+    m_timer = createTimer();
+    m_timer->setSingleShot(false);
+    m_timer->onTimeout().connect(this, &JitterTestApp::timeout);
+  }
+
+  void onStart() override {
+    m_timer->setInterval(m_interval);
+    m_timer->start();
+  }
+
+  void timeout() {
+    m_timeouts.push_back(TestClock::now());
+    if(m_timeouts.size() == m_nTimeouts) {
+      m_timer->stop();
+      exit(0);
+    }
+  }
+
+public:
+  const unsigned int                   m_interval = {20};
+  const unsigned int                   m_nTimeouts = {50};
+  AppTimer*                            m_timer = {nullptr};
+  std::vector<TestClock::time_point>   m_timeouts = {};
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class IdleTestApp : public TestApplication {
+public:
+  IdleTestApp(UnitTest &test) :
+    TestApplication(test, "idle") {
+  }
+  IdleTestApp(const IdleTestApp&) = delete;
+  IdleTestApp& operator=(const IdleTestApp&) = delete;
+  ~IdleTestApp() {
+    for(auto timer : m_idleTimers) {
+      removeTimer(timer);
+    }
+    removeTimer(m_exitTimer);
+  }
+
+  void onInit() override {
+    // 10 timers that never reach their timeout
+    for(unsigned int i=0 ; i<10 ; i++) {
+      auto timer = createTimer();
+      timer->setSingleShot(false);
+      timer->setInterval(60000 + i*1000);
+      m_idleTimers.push_back(timer);
+    }
+    m_exitTimer = createTimer();
+    m_exitTimer->setSingleShot(true);
+    m_exitTimer->onTimeout().connect(this, &IdleTestApp::timeout);
+  }
+
+  void onStart() override {
+    m_startTime = TestClock::now();
+    m_startCpuTime = std::clock();
+    // armed, but never reaching their timeout within the test
+    for(auto timer : m_idleTimers) {
+      timer->start();
+    }
+    m_exitTimer->setInterval(2000);
+    m_exitTimer->start();
+  }
+
+  void timeout() {
+    m_wallTime = std::chrono::duration<double>(TestClock::now() - m_startTime).count();
+    m_cpuTime = static_cast<double>(std::clock() - m_startCpuTime) / CLOCKS_PER_SEC;
+    exit(0);
+  }
+
+public:
+  std::vector<AppTimer*>      m_idleTimers = {};
+  AppTimer*                   m_exitTimer = {nullptr};
+  TestClock::time_point       m_startTime = {};
+  std::clock_t                m_startCpuTime = {0};
+  double                      m_wallTime = {0.};
+  double                      m_cpuTime = {0.};
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  UnitTest unitTest("test-app-timer");
+
+  JitterTestApp jitterApp(unitTest);
+  jitterApp.init(argc, argv);
+  jitterApp.exec();
+  unitTest.test("N_TIMEOUTS", jitterApp.m_timeouts.size() == jitterApp.m_nTimeouts);
+
+  // deviation of each timeout from its ideal deadline,
+  // taking the first timeout as reference (unit ms)
+  std::vector<double> jitters;
+  for(unsigned int i=1 ; i<jitterApp.m_timeouts.size() ; i++) {
+    const auto deadline = jitterApp.m_timeouts[0] + std::chrono::milliseconds(i*jitterApp.m_interval);
+    jitters.push_back(std::fabs(std::chrono::duration<double, std::milli>(jitterApp.m_timeouts[i] - deadline).count()));
+  }
+  std::sort(jitters.begin(), jitters.end());
+  const double medianJitter = jitters[jitters.size()/2];
+  const double p90Jitter = jitters[(jitters.size()*9)/10];
+  dqm_info( "Timer jitter: median {0} ms, 90% {1} ms, max {2} ms", medianJitter, p90Jitter, jitters.back() );
+  // only the median is checked, with a margin for loaded hosts. The tail is informational
+  unitTest.test("MEDIAN_JITTER", medianJitter < 5.);
+
+  IdleTestApp idleApp(unitTest);
+  idleApp.init(argc, argv);
+  idleApp.exec();
+  dqm_info( "Idle app with 10 timers: cpu {0} s for {1} s wall time", idleApp.m_cpuTime, idleApp.m_wallTime );
+  unitTest.test("IDLE_CPU", idleApp.m_cpuTime < 0.05*idleApp.m_wallTime);
+
+  return 0;
+}
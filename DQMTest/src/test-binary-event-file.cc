@@ -0,0 +1,138 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventReader.h>
+#include <dqm4hep/EventWriter.h>
+#include <dqm4hep/BinaryEventFile.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/PluginManager.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <cstdio>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+const unsigned int nEvents = 50;
+const std::string fileName = "test-binary-event-file.dqm";
+
+/**
+ *  @brief  EventCollector class.
+ *          Store the events emitted by the reader
+ */
+class EventCollector {
+public:
+  void receiveEvent(EventPtr event) {
+    m_events.push_back(event);
+  }
+
+public:
+  std::vector<EventPtr>       m_events = {};
+};
+
+EventPtr createEvent(unsigned int eventNumber) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName(0 == eventNumber % 2 ? "GenericEventStreamer" : "GenericEventColumnarStreamer");
+  event->setEventNumber(eventNumber);
+  event->setRunNumber(42);
+  event->setSource("TestSource");
+  event->getEvent<GenericEvent>()->setValues("Values", IntVector(eventNumber % 7, eventNumber));
+  return event;
+}
+
+bool checkEvent(EventPtr event, unsigned int eventNumber) {
+  IntVector values;
+  return (nullptr != event)
+    && (eventNumber == event->getEventNumber())
+    && (42 == event->getRunNumber())
+    && ("TestSource" == event->getSource())
+    && (STATUS_CODE_SUCCESS == event->getEvent<GenericEvent>()->getValues("Values", values))
+    && (IntVector(eventNumber % 7, eventNumber) == values);
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-binary-event-file");
+
+  // write events and run info
+  EventWriterPtr writer = PluginManager::instance()->create<EventWriter>("BinaryEventWriter");
+  unitTest.test("WRITER_PLUGIN", nullptr != writer);
+  unitTest.test("WRITER_OPEN", STATUS_CODE_SUCCESS == writer->open(fileName));
+  bool writeEvents = true;
+  for(unsigned int e=0 ; e<nEvents ; e++) {
+    writeEvents = writeEvents && (STATUS_CODE_SUCCESS == writer->writeEvent(createEvent(e)));
+  }
+  unitTest.test("WRITER_EVENTS", writeEvents);
+  Run run(42, "A test run", "TestDetector");
+  run.setParameter("Energy", "10 GeV");
+  writer->setRunInfo(run);
+  unitTest.test("WRITER_CLOSE", STATUS_CODE_SUCCESS == writer->close());
+
+  // read everything back
+  EventCollector collector;
+  EventReaderPtr reader = PluginManager::instance()->create<EventReader>("BinaryEventReader");
+  unitTest.test("READER_PLUGIN", nullptr != reader);
+  reader->onEventRead().connect(&collector, &EventCollector::receiveEvent);
+  unitTest.test("READER_OPEN", STATUS_CODE_SUCCESS == reader->open(fileName));
+  Run inRun;
+  unitTest.test("READER_RUN_INFO", STATUS_CODE_SUCCESS == reader->runInfo(inRun) && 42 == inRun.runNumber()
+    && "TestDetector" == inRun.detectorName() && 1 == inRun.parameters().count("Energy") && "10 GeV" == inRun.parameters().at("Energy"));
+  while(STATUS_CODE_SUCCESS == reader->readNextEvent());
+  bool readEvents = (nEvents == collector.m_events.size());
+  for(unsigned int e=0 ; readEvents && e<nEvents ; e++) {
+    readEvents = checkEvent(collector.m_events[e], e);
+  }
+  unitTest.test("READER_EVENTS", readEvents);
+  unitTest.test("READER_END_OF_FILE", STATUS_CODE_OUT_OF_RANGE == reader->readNextEvent());
+
+  // skip events
+  collector.m_events.clear();
+  unitTest.test("READER_REOPEN", STATUS_CODE_SUCCESS == reader->open(fileName));
+  unitTest.test("READER_SKIP", STATUS_CODE_SUCCESS == reader->skipNEvents(30));
+  unitTest.test("READER_SKIP_READ", STATUS_CODE_SUCCESS == reader->readNextEvent() && 1 == collector.m_events.size() && checkEvent(collector.m_events[0], 30));
+  unitTest.test("READER_SKIP_OUT_OF_RANGE", STATUS_CODE_OUT_OF_RANGE == reader->skipNEvents(nEvents));
+  reader->close();
+
+  // file not properly closed: drop the index and run info from the header
+  BinaryEventFileHeader header;
+  FILE *file = fopen(fileName.c_str(), "r+b");
+  bool resetHeader = (nullptr != file) && (1 == fread(&header, sizeof(header), 1, file));
+  header.m_indexOffset = 0;
+  header.m_runInfoOffset = 0;
+  header.m_runInfoSize = 0;
+  resetHeader = resetHeader && (0 == fseek(file, 0, SEEK_SET)) && (1 == fwrite(&header, sizeof(header), 1, file));
+  if(nullptr != file) {
+    fclose(file);
+  }
+  unitTest.test("UNINDEXED_HEADER", resetHeader);
+  collector.m_events.clear();
+  unitTest.test("UNINDEXED_OPEN", STATUS_CODE_SUCCESS == reader->open(fileName));
+  unitTest.test("UNINDEXED_NO_RUN_INFO", STATUS_CODE_NOT_FOUND == reader->runInfo(inRun));
+  unitTest.test("UNINDEXED_SKIP", STATUS_CODE_SUCCESS == reader->skipNEvents(nEvents-1));
+  unitTest.test("UNINDEXED_READ", STATUS_CODE_SUCCESS == reader->readNextEvent() && 1 == collector.m_events.size() && checkEvent(collector.m_events[0], nEvents-1));
+  unitTest.test("UNINDEXED_END_OF_FILE", STATUS_CODE_OUT_OF_RANGE == reader->readNextEvent());
+  reader->close();
+
+  // not a binary event file
+  file = fopen(fileName.c_str(), "wb");
+  if(nullptr != file) {
+    fprintf(file, "<dqm4hep><event/></dqm4hep>%64s", "");
+    fclose(file);
+  }
+  unitTest.test("INVALID_FILE", STATUS_CODE_SUCCESS != reader->open(fileName));
+  remove(fileName.c_str());
+
+  return 0;
+}
@@ -0,0 +1,138 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/BoundedQueue.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+
+  UnitTest unitTest("test-bounded-queue");
+
+  // single thread: capacity, order, full and empty queue
+  {
+    BoundedQueue<std::string> queue(3);
+    std::string value;
+    unitTest.test("EMPTY", queue.empty() && not queue.pop(value));
+    
+    for(int i=0 ; i<3 ; i++) {
+      value = std::to_string(i);
+      unitTest.test("PUSH", queue.push(value));
+    }
+    value = "3";
+    unitTest.test("FULL", not queue.push(value) && 3 == queue.size());
+    
+    bool ordered = true;
+    for(int i=0 ; i<3 ; i++) {
+      ordered = ordered && queue.pop(value) && (value == std::to_string(i));
+    }
+    unitTest.test("FIFO_ORDER", ordered);
+    unitTest.test("EMPTY_AFTER_POP", queue.empty() && not queue.pop(value));
+  }
+
+  // one producer, one consumer: all elements received in order
+  {
+    const int nElements = 500000;
+    BoundedQueue<int> queue(64);
+    std::vector<int> received;
+    received.reserve(nElements);
+
+    std::thread consumer([&queue,&received,nElements](){
+      int value = 0;
+      while(received.size() < static_cast<size_t>(nElements)) {
+        if(queue.pop(value)) {
+          received.push_back(value);
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    for(int i=0 ; i<nElements ; i++) {
+      int value = i;
+      while(not queue.push(value)) {
+        std::this_thread::yield();
+      }
+    }
+    consumer.join();
+
+    bool ordered = (received.size() == static_cast<size_t>(nElements));
+    for(int i=0 ; ordered && i<nElements ; i++) {
+      ordered = (received[i] == i);
+    }
+    unitTest.test("SPSC_ORDER", ordered);
+  }
+
+  // producer dropping the oldest element when full, while the consumer pops:
+  // each element is either received or dropped, exactly once
+  {
+    const int nElements = 200000;
+    BoundedQueue<int> queue(16);
+    std::atomic_bool producerDone(false);
+    std::vector<int> received;
+    std::vector<int> dropped;
+
+    std::thread consumer([&queue,&received,&producerDone](){
+      int value = 0;
+      while(true) {
+        if(queue.pop(value)) {
+          received.push_back(value);
+        }
+        else if(producerDone.load() && queue.empty()) {
+          break;
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    for(int i=0 ; i<nElements ; i++) {
+      int value = i;
+      while(not queue.push(value)) {
+        int oldest = 0;
+        if(queue.pop(oldest)) {
+          dropped.push_back(oldest);
+        }
+      }
+    }
+    producerDone = true;
+    consumer.join();
+
+    std::vector<int> counts(nElements, 0);
+    for(auto value : received) counts[value]++;
+    for(auto value : dropped) counts[value]++;
+    bool exactlyOnce = true;
+    for(auto count : counts) {
+      exactlyOnce = exactlyOnce && (1 == count);
+    }
+    bool ordered = true;
+    for(unsigned int i=1 ; i<received.size() ; i++) {
+      ordered = ordered && (received[i] > received[i-1]);
+    }
+    dqm_info( "Drop oldest: {0} received, {1} dropped", received.size(), dropped.size() );
+    unitTest.test("DROP_OLDEST_EXACTLY_ONCE", exactlyOnce);
+    unitTest.test("DROP_OLDEST_ORDER", ordered);
+  }
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/NetBuffer.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <string>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+
+  UnitTest unitTest("test-buffer-pool");
+
+  BufferPool pool(2);
+  const std::string event1(1000, 'a');
+  const std::string event2(500, 'b');
+  const std::string event3(800, 'c');
+  
+  // the retained buffer shares the pooled storage with the response
+  Buffer retained;
+  retained.setModel(pool.copy(event1.c_str(), event1.size()));
+  unitTest.test("COPY_CONTENT", std::string(retained.begin(), retained.size()) == event1);
+  
+  Buffer response;
+  response.setModel(retained.model());
+  unitTest.test("SHARED_STORAGE", response.begin() == retained.begin());
+  unitTest.test("FIRST_MISS", 1 == pool.misses() && 0 == pool.hits());
+  
+  // first model still in use: a new one is allocated
+  const char *firstStorage = retained.begin();
+  retained.setModel(pool.copy(event2.c_str(), event2.size()));
+  unitTest.test("SECOND_MISS", 2 == pool.misses());
+  unitTest.test("RESPONSE_UNCHANGED", std::string(response.begin(), response.size()) == event1);
+  
+  // release the response: the first model is free again and its storage re-used
+  response.setModel(response.createModel());
+  retained.setModel(pool.copy(event3.c_str(), event3.size()));
+  unitTest.test("HIT", 1 == pool.hits() && 2 == pool.misses());
+  unitTest.test("STORAGE_REUSED", retained.begin() == firstStorage);
+  unitTest.test("REUSED_CONTENT", std::string(retained.begin(), retained.size()) == event3);
+  
+  // steady state: one retained buffer, always a free model to re-use
+  for(int i=0 ; i<100 ; i++) {
+    retained.setModel(pool.copy(event2.c_str(), event2.size()));
+  }
+  unitTest.test("STEADY_STATE_HITS", 101 == pool.hits() && 2 == pool.misses());
+  
+  // pool full and all models in use: extra models are not pooled
+  Buffer other;
+  other.setModel(pool.copy(event1.c_str(), event1.size()));
+  Buffer extra;
+  extra.setModel(pool.copy(event1.c_str(), event1.size()));
+  unitTest.test("EXTRA_MODEL", 3 == pool.misses());
+  unitTest.test("EXTRA_CONTENT", std::string(extra.begin(), extra.size()) == event1);
+
+  return 0;
+}
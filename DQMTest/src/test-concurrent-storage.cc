@@ -0,0 +1,232 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/ConcurrentStorage.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+class Object {
+public:
+  Object(const std::string &oname) : m_name(oname), m_entries(0) {
+  }
+  const std::string &name() const {
+    return m_name;
+  }
+  void fill() {
+    ++m_entries;
+  }
+  unsigned int entries() const {
+    return m_entries.load();
+  }
+
+private:
+  const std::string m_name;
+  std::atomic<unsigned int> m_entries;
+};
+
+typedef ConcurrentStorage<Object> Storage_t;
+typedef Storage_t::ObjectList ObjectList;
+typedef Storage_t::ObjectPtr ObjectPtr;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-concurrent-storage");
+
+  // single thread: same behavior as Storage<T>
+  {
+    Storage_t storage;
+    unitTest.test("MKDIR", storage.mkdir("/heroes/best") == STATUS_CODE_SUCCESS && storage.mkdir("heroes/worst") == STATUS_CODE_SUCCESS);
+    unitTest.test("DIR_EXISTS", storage.dirExists("/heroes") && storage.dirExists("/heroes/best/../worst") && !storage.dirExists("/best"));
+    unitTest.test("DIR_ABOVE_ROOT", storage.mkdir("/..") == STATUS_CODE_FAILURE);
+
+    ObjectPtr batman = std::make_shared<Object>("Batman");
+    unitTest.test("ADD", storage.add("/heroes/worst", batman) == STATUS_CODE_SUCCESS);
+    unitTest.test("ADD_MKDIR", storage.add("/villains", std::make_shared<Object>("Joker")) == STATUS_CODE_SUCCESS && storage.dirExists("/villains"));
+    unitTest.test("ADD_TWICE", storage.add("/heroes/worst", batman) == STATUS_CODE_ALREADY_PRESENT);
+    unitTest.test("ADD_NULL", storage.add("/heroes/worst", nullptr) == STATUS_CODE_INVALID_PTR);
+    unitTest.test("FIND_BY_NAME", storage.findObjectByName("/heroes/best/../worst", "Batman") == batman);
+    unitTest.test("FIND_BY_NAME_MISSING", storage.findObjectByName("/heroes/best", "Batman") == nullptr);
+    unitTest.test("FIND_OBJECT", storage.findObject("/villains", [](const ObjectPtr &obj) { return obj->name() == "Joker"; }) != nullptr);
+
+    // same name, the first added object is found by name
+    ObjectPtr otherBatman = std::make_shared<Object>("Batman");
+    unitTest.test("ADD_SAME_NAME", storage.add("/heroes/worst", otherBatman) == STATUS_CODE_SUCCESS);
+    unitTest.test("FIND_SAME_NAME", storage.findObjectByName("/heroes/worst", "Batman") == batman);
+    unitTest.test("REMOVE", storage.remove("/heroes/worst", [&batman](const ObjectPtr &obj) { return obj == batman; }) == STATUS_CODE_SUCCESS);
+    unitTest.test("FIND_AFTER_REMOVE", storage.findObjectByName("/heroes/worst", "Batman") == otherBatman);
+
+    // a snapshot is not modified by the next updates
+    Storage_t::ObjectListPtr snapshot = storage.contents("/heroes/worst");
+    storage.add("/heroes/worst", std::make_shared<Object>("Robin"));
+    unitTest.test("SNAPSHOT", snapshot->size() == 1 && storage.contents("/heroes/worst")->size() == 2);
+
+    ObjectList list;
+    storage.getObjects(list);
+    unitTest.test("GET_OBJECTS", list.size() == 3);
+
+    unitTest.test("RMDIR", storage.rmdir("/heroes") == STATUS_CODE_SUCCESS && !storage.dirExists("/heroes/worst"));
+    unitTest.test("RMDIR_UNINDEX", storage.findObjectByName("/heroes/worst", "Robin") == nullptr);
+    unitTest.test("RMDIR_ROOT", storage.rmdir("/") == STATUS_CODE_NOT_ALLOWED);
+    unitTest.test("RMDIR_MISSING", storage.rmdir("/heroes") == STATUS_CODE_NOT_FOUND);
+
+    storage.clear();
+    list.clear();
+    storage.getObjects(list);
+    unitTest.test("CLEAR", list.empty() && !storage.dirExists("/villains") && storage.findObjectByName("/villains", "Joker") == nullptr);
+  }
+
+  // several threads booking, filling, removing and iterating at the same time
+  {
+    const unsigned int nBookers = 4;
+    const unsigned int nObjects = 500;
+    const unsigned int nDirectories = 10;
+    const unsigned int nFills = 20000;
+    Storage_t storage;
+    std::atomic<unsigned int> nBooked(0);
+    std::atomic_bool stop(false);
+    std::atomic_bool bookingFailed(false), lookupFailed(false), iterationFailed(false), churnFailed(false);
+    std::atomic<unsigned int> nIterations(0);
+    std::vector<std::thread> threads;
+
+    auto dirName = [nDirectories](unsigned int o) {
+      return "/Calorimeter/Layer" + std::to_string(o % nDirectories);
+    };
+    auto objectName = [](unsigned int b, unsigned int o) {
+      return "Hits_" + std::to_string(b) + "_" + std::to_string(o);
+    };
+
+    // bookers: the directories are shared between the threads
+    for (unsigned int b = 0; b < nBookers; b++) {
+      threads.push_back(std::thread([&, b]() {
+        for (unsigned int o = 0; o < nObjects; o++) {
+          if (STATUS_CODE_SUCCESS != storage.add(dirName(o), std::make_shared<Object>(objectName(b, o))))
+            bookingFailed = true;
+
+          ++nBooked;
+        }
+      }));
+    }
+
+    // fillers: look up the booked objects and fill them
+    std::atomic<unsigned int> nFilled(0);
+    for (unsigned int f = 0; f < 2; f++) {
+      threads.push_back(std::thread([&, f]() {
+        unsigned int seed = f + 1;
+        unsigned int fill = 0;
+        while (fill < nFills) {
+          seed = seed * 1103515245u + 12345u;
+          const unsigned int b = (seed >> 16) % nBookers;
+          const unsigned int o = (seed >> 4) % nObjects;
+          ObjectPtr object = storage.findObjectByName(dirName(o), objectName(b, o));
+
+          if (nullptr == object) {
+            // not booked yet
+            if (nBooked.load() == nBookers*nObjects)
+              lookupFailed = true;
+
+            std::this_thread::yield();
+            continue;
+          }
+
+          if (object->name() != objectName(b, o))
+            lookupFailed = true;
+
+          object->fill();
+          ++fill;
+          ++nFilled;
+        }
+      }));
+    }
+
+    // churn: temporary directories and objects created and removed
+    threads.push_back(std::thread([&]() {
+      unsigned int n = 0;
+      while (!stop.load()) {
+        const std::string tmpDir("/Tmp/Run" + std::to_string(n % 5));
+
+        if (STATUS_CODE_SUCCESS != storage.add(tmpDir, std::make_shared<Object>("Tmp")))
+          churnFailed = true;
+
+        if (STATUS_CODE_SUCCESS != storage.remove(tmpDir, [](const ObjectPtr &obj) { return obj->name() == "Tmp"; }))
+          churnFailed = true;
+
+        if (0 == n % 3)
+          storage.rmdir(tmpDir);
+
+        n++;
+      }
+    }));
+
+    // readers: iterate over the whole storage
+    for (unsigned int r = 0; r < 2; r++) {
+      threads.push_back(std::thread([&]() {
+        while (!stop.load()) {
+          unsigned int nFound = 0;
+          storage.iterate([&](const std::string &dirPath, const ObjectPtr &object) {
+            if (nullptr == object || dirPath.empty() || object->name().empty())
+              iterationFailed = true;
+
+            nFound += (object->name() != "Tmp") ? 1 : 0;
+            return true;
+          });
+
+          if (nFound > nBookers*nObjects)
+            iterationFailed = true;
+
+          ++nIterations;
+        }
+      }));
+    }
+
+    // wait for the bookers and fillers, then stop the others
+    for (unsigned int t = 0; t < nBookers + 2; t++)
+      threads[t].join();
+
+    stop = true;
+
+    for (unsigned int t = nBookers + 2; t < threads.size(); t++)
+      threads[t].join();
+
+    ObjectList list;
+    storage.getObjects(list);
+    unsigned int nEntries = 0, nBookedObjects = 0;
+
+    for (const auto &object : list) {
+      nEntries += object->entries();
+      nBookedObjects += (object->name() != "Tmp") ? 1 : 0;
+    }
+
+    bool allFound = true;
+
+    for (unsigned int b = 0; b < nBookers; b++)
+      for (unsigned int o = 0; o < nObjects; o++)
+        allFound = allFound && (nullptr != storage.findObjectByName(dirName(o), objectName(b, o)));
+
+    dqm_info( "{0} objects, {1} entries, {2} iterations", list.size(), nEntries, nIterations.load() );
+    unitTest.test("STRESS_BOOK", !bookingFailed && nBookedObjects == nBookers*nObjects && list.size() == nBookedObjects);
+    unitTest.test("STRESS_LOOKUP", !lookupFailed && allFound);
+    unitTest.test("STRESS_FILL", nEntries == nFilled.load() && nEntries == 2*nFills);
+    unitTest.test("STRESS_ITERATE", !iterationFailed && nIterations.load() > 0);
+    unitTest.test("STRESS_CHURN", !churnFailed);
+  }
+
+  return 0;
+}
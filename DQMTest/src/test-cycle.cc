@@ -17,8 +17,11 @@
 #include <dqm4hep/UnitTesting.h>
 
 // -- std headers
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <signal.h>
+#include <thread>
 
 using namespace dqm4hep::core;
 using namespace dqm4hep::online;
@@ -169,6 +172,101 @@ public:
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 
+class CounterTestApp : public TestApplication {
+public:
+  CounterTestApp(UnitTest &test) :
+    TestApplication(test, "counter", 30, 10, 1000) { 
+    setNoServer(true);
+  }
+  CounterTestApp(const CounterTestApp&) = delete;
+  CounterTestApp& operator=(const CounterTestApp&) = delete;
+  ~CounterTestApp() {
+    if(m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+  
+  void onStart() override {
+    TestApplication::onStart();
+    m_thread = std::thread([this](){
+      // wait for the cycle thread to start the cycle
+      while(not m_cycle.running()) {
+        std::this_thread::yield();
+      }
+      for(unsigned int i=0 ; i<m_cycle.counterLimit() ; i++) {
+        m_cycle.incrementCounter();
+      }
+      m_lastIncrement = std::chrono::steady_clock::now();
+    });
+  }
+  
+  void onEvent(AppEvent *pAppEvent) override {
+    auto* eocEvent = dynamic_cast<StoreEvent<EOCCondition>*>(pAppEvent);
+    if(eocEvent) {
+      const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_lastIncrement.load());
+      dqm_debug("Got an end of cycle: {0}, {1} ms after the last increment", typeToString(eocEvent->data()), latency.count());
+      m_unitTest.test("CHECK_COUNTER5", eocEvent->data().m_counter == 1000);
+      m_unitTest.test("CHECK_TIMEOUT5", not eocEvent->data().m_timeoutReached);
+      m_unitTest.test("EOC_NOT_FORCED5", not eocEvent->data().m_forcedEnd);
+      m_unitTest.test("EOC_LATENCY", latency.count() < 5);
+      exit(0);
+    }
+  }
+  
+private:
+  std::thread                                         m_thread = {};
+  std::atomic<std::chrono::steady_clock::time_point>  m_lastIncrement = {std::chrono::steady_clock::now()};
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class ForceStopTestApp : public TestApplication {
+public:
+  ForceStopTestApp(UnitTest &test) :
+    TestApplication(test, "forcestop", 30, 10, 0) { 
+    setNoServer(true);
+  }
+  ForceStopTestApp(const ForceStopTestApp&) = delete;
+  ForceStopTestApp& operator=(const ForceStopTestApp&) = delete;
+  ~ForceStopTestApp() {
+    removeTimer(m_stopTimer);
+  }
+  
+  void onInit() override {
+    m_stopTimer = createTimer();
+    m_stopTimer->setSingleShot(true);
+    m_stopTimer->onTimeout().connect(this, &ForceStopTestApp::stop);
+  }
+  
+  void onStart() override {
+    TestApplication::onStart();
+    m_stopTimer->setInterval(200);
+    m_stopTimer->start();
+  }
+  
+  void stop() {
+    // stop without end of cycle event
+    m_cycle.forceStopCycle(true, false);
+    m_unitTest.test("CYCLE_STOPPED", not m_cycle.running());
+    exit(0);
+  }
+  
+  void onEvent(AppEvent *pAppEvent) override {
+    auto* eocEvent = dynamic_cast<StoreEvent<EOCCondition>*>(pAppEvent);
+    if(eocEvent) {
+      m_nCycles++;
+    }
+  }
+  
+public:
+  AppTimer*         m_stopTimer = {nullptr};
+  unsigned int      m_nCycles = {0};
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
 int main(int argc, char **argv) {
   
   UnitTest unitTest("test-cycle");
@@ -188,6 +286,15 @@ int main(int argc, char **argv) {
   notimeoutApp.exec();
   unitTest.test("CHECK_COUNTER4", notimeoutApp.m_nCycles == 3);
   
+  CounterTestApp counterApp(unitTest);
+  counterApp.init(argc, argv);
+  counterApp.exec();
+  
+  ForceStopTestApp forceStopApp(unitTest);
+  forceStopApp.init(argc, argv);
+  forceStopApp.exec();
+  unitTest.test("NO_EOC_EMITTED", forceStopApp.m_nCycles == 0);
+  
   return 0;
 }
 
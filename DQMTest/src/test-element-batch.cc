@@ -0,0 +1,97 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/OnlineElement.h>
+#include <dqm4hep/ElementBatch.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TH1.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+OnlineElementPtr createElement(int index) {
+  const std::string name("Histo" + std::to_string(index));
+  OnlineElementPtr element = OnlineElement::make_shared(new TH1F(name.c_str(), "A batched histogram", 100, 0.f, 99.f));
+  element->setPath("/Batch" + std::to_string(index % 2));
+  for(int i=0 ; i<=index ; i++) {
+    element->objectTo<TH1F>()->Fill(i);
+  }
+  element->setRunNumber(42);
+  return element;
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-element-batch");
+
+  ElementBatch batch;
+  unitTest.test("EMPTY_BATCH", batch.empty() && 0 == batch.nElements());
+
+  for(int e=0 ; e<5 ; e++) {
+    unitTest.test("ADD_ELEMENT", STATUS_CODE_SUCCESS == batch.addElement("BatchModule", *createElement(e)));
+  }
+  unitTest.test("N_ELEMENTS", 5 == batch.nElements());
+
+  // unpack the batch frame
+  OnlineElementPtrList elements;
+  unitTest.test("READ_ELEMENTS", STATUS_CODE_SUCCESS == ElementBatch::readElements(batch.buffer(), batch.size(), elements));
+  unitTest.test("N_READ_ELEMENTS", 5 == elements.size());
+
+  bool validElements = (5 == elements.size());
+  for(unsigned int e=0 ; validElements && e<elements.size() ; e++) {
+    validElements = (elements[e]->name() == "Histo" + std::to_string(e)) && (elements[e]->path() == "/Batch" + std::to_string(e % 2))
+      && (nullptr != elements[e]->objectTo<TH1F>()) && (elements[e]->objectTo<TH1F>()->GetEntries() == e+1) && (42 == elements[e]->runNumber());
+  }
+  unitTest.test("VALID_ELEMENTS", validElements);
+
+  // split in frames, without reading the elements
+  std::vector<ElementBatch::Frame> frames;
+  unitTest.test("READ_FRAMES", STATUS_CODE_SUCCESS == ElementBatch::readFrames(batch.buffer(), batch.size(), frames) && 5 == frames.size());
+  bool validFrames = (5 == frames.size());
+  for(unsigned int f=0 ; validFrames && f<frames.size() ; f++) {
+    validFrames = (frames[f].m_moduleName == "BatchModule") && (frames[f].m_name == "Histo" + std::to_string(f))
+      && (frames[f].m_path == "/Batch" + std::to_string(f % 2)) && (frames[f].m_type == "TH1F") && (0 != frames[f].m_size);
+  }
+  unitTest.test("VALID_FRAMES", validFrames);
+
+  // re-pack the odd elements (collector side selection)
+  ElementBatch oddBatch;
+  for(const auto &frame : frames) {
+    if(frame.m_path == "/Batch1") {
+      oddBatch.addElement(frame);
+    }
+  }
+  elements.clear();
+  unitTest.test("READ_REPACKED", STATUS_CODE_SUCCESS == ElementBatch::readElements(oddBatch.buffer(), oddBatch.size(), elements));
+  unitTest.test("REPACKED_ELEMENTS", 2 == elements.size() && "Histo1" == elements[0]->name() && "Histo3" == elements[1]->name()
+    && 4 == elements[1]->objectTo<TH1F>()->GetEntries());
+
+  // a corrupted frame is refused
+  frames.clear();
+  unitTest.test("READ_TRUNCATED", STATUS_CODE_SUCCESS != ElementBatch::readFrames(batch.buffer(), batch.size() / 2, frames));
+  unitTest.test("READ_NULL", STATUS_CODE_SUCCESS != ElementBatch::readFrames(nullptr, 0, frames));
+
+  // re-use after clear
+  batch.clear();
+  unitTest.test("CLEARED_BATCH", batch.empty());
+  elements.clear();
+  unitTest.test("READ_CLEARED", STATUS_CODE_SUCCESS == ElementBatch::readElements(batch.buffer(), batch.size(), elements) && elements.empty());
+  unitTest.test("ADD_AFTER_CLEAR", STATUS_CODE_SUCCESS == batch.addElement("BatchModule", *createElement(7)));
+  unitTest.test("READ_AFTER_CLEAR", STATUS_CODE_SUCCESS == ElementBatch::readElements(batch.buffer(), batch.size(), elements));
+  unitTest.test("N_ELEMENTS_AFTER_CLEAR", 1 == elements.size() && "Histo7" == elements[0]->name());
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/EventBatch.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+EventPtr createEvent(int eventNumber) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName("GenericEventStreamer");
+  event->setSource("BatchSource");
+  event->setEventNumber(eventNumber);
+  event->setRunNumber(42);
+  return event;
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-event-batch");
+
+  EventStreamer streamer;
+  TBufferFile outBuffer(TBuffer::kWrite);
+  EventBatch batch;
+  unitTest.test("EMPTY_BATCH", batch.empty() && 0 == batch.nEvents());
+
+  for(int e=0 ; e<5 ; e++) {
+    outBuffer.Reset();
+    unitTest.test("WRITE_EVENT", STATUS_CODE_SUCCESS == streamer.writeEvent(createEvent(e), outBuffer));
+    batch.addEvent(outBuffer.Buffer(), outBuffer.Length());
+  }
+  unitTest.test("N_EVENTS", 5 == batch.nEvents());
+  unitTest.test("IS_BATCH", EventBatch::isBatch(batch.buffer(), batch.size()));
+  unitTest.test("N_EVENTS_FRAME", 5 == EventBatch::nEvents(batch.buffer(), batch.size()));
+
+  // unpack the batch frame
+  EventList events;
+  unitTest.test("READ_BATCH", STATUS_CODE_SUCCESS == EventBatch::readEvents(streamer, batch.buffer(), batch.size(), events));
+  unitTest.test("N_READ_EVENTS", 5 == events.size());
+  
+  bool validEvents = (5 == events.size());
+  for(unsigned int e=0 ; validEvents && e<events.size() ; e++) {
+    validEvents = (events[e]->getEventNumber() == e) && (events[e]->getRunNumber() == 42)
+      && (events[e]->getSource() == "BatchSource") && (nullptr != events[e]->getEvent<GenericEvent>());
+  }
+  unitTest.test("VALID_EVENTS", validEvents);
+
+  // peek the event headers only
+  std::vector<EventHeader> headers;
+  unitTest.test("READ_HEADERS", STATUS_CODE_SUCCESS == EventBatch::readHeaders(batch.buffer(), batch.size(), headers));
+  bool validHeaders = (5 == headers.size());
+  for(unsigned int e=0 ; validHeaders && e<headers.size() ; e++) {
+    validHeaders = (headers[e].m_eventNumber == e) && (headers[e].m_runNumber == 42) && (headers[e].sourceName() == "BatchSource");
+  }
+  unitTest.test("VALID_HEADERS", validHeaders);
+
+  // split in frames and re-pack the odd events (collector side filtering)
+  std::vector<EventBatch::Frame> frames;
+  unitTest.test("READ_FRAMES", STATUS_CODE_SUCCESS == EventBatch::readFrames(batch.buffer(), batch.size(), frames) && 5 == frames.size());
+  EventBatch oddBatch;
+  for(const auto &frame : frames) {
+    if(1 == frame.m_header.m_eventNumber % 2) {
+      oddBatch.addEvent(frame.m_buffer, frame.m_size);
+    }
+  }
+  events.clear();
+  unitTest.test("READ_REPACKED", STATUS_CODE_SUCCESS == EventBatch::readEvents(streamer, oddBatch.buffer(), oddBatch.size(), events));
+  unitTest.test("REPACKED_EVENTS", 2 == events.size() && 1 == events[0]->getEventNumber() && 3 == events[1]->getEventNumber());
+
+  // a single event frame is still understood
+  unitTest.test("SINGLE_NOT_BATCH", not EventBatch::isBatch(outBuffer.Buffer(), outBuffer.Length()));
+  unitTest.test("SINGLE_N_EVENTS", 1 == EventBatch::nEvents(outBuffer.Buffer(), outBuffer.Length()));
+  events.clear();
+  unitTest.test("READ_SINGLE", STATUS_CODE_SUCCESS == EventBatch::readEvents(streamer, outBuffer.Buffer(), outBuffer.Length(), events));
+  unitTest.test("SINGLE_EVENT", 1 == events.size() && 4 == events.back()->getEventNumber());
+  headers.clear();
+  unitTest.test("SINGLE_HEADER", STATUS_CODE_SUCCESS == EventBatch::readHeaders(outBuffer.Buffer(), outBuffer.Length(), headers) 
+    && 1 == headers.size() && 4 == headers.back().m_eventNumber);
+
+  // re-use after clear
+  batch.clear();
+  unitTest.test("CLEARED_BATCH", batch.empty() && 0 == EventBatch::nEvents(batch.buffer(), batch.size()));
+  batch.addEvent(outBuffer.Buffer(), outBuffer.Length());
+  events.clear();
+  unitTest.test("READ_AFTER_CLEAR", STATUS_CODE_SUCCESS == EventBatch::readEvents(streamer, batch.buffer(), batch.size(), events));
+  unitTest.test("N_EVENTS_AFTER_CLEAR", 1 == events.size());
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventCompression.h>
+#include <dqm4hep/EventHeader.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <algorithm>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+EventPtr createEvent(unsigned int nValues) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName("GenericEventStreamer");
+  event->setSource("CompressionSource");
+  event->setEventNumber(nValues);
+  FloatVector values(nValues);
+  for(unsigned int i=0 ; i<nValues ; i++) {
+    values[i] = static_cast<float>(i % 16);
+  }
+  event->getEvent<GenericEvent>()->setValues("Values", values);
+  return event;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool checkEvent(const char *buffer, unsigned int size, unsigned int nValues) {
+  EventStreamer streamer;
+  EventPtr event;
+  TBufferFile inBuffer(TBuffer::kRead);
+  inBuffer.SetBuffer(const_cast<char*>(buffer), size, false);
+  if(STATUS_CODE_SUCCESS != streamer.readEvent(event, inBuffer) || nullptr == event) {
+    return false;
+  }
+  FloatVector values;
+  if(STATUS_CODE_SUCCESS != event->getEvent<GenericEvent>()->getValues("Values", values) || nValues != values.size()) {
+    return false;
+  }
+  for(unsigned int i=0 ; i<nValues ; i++) {
+    if(values[i] != static_cast<float>(i % 16)) {
+      return false;
+    }
+  }
+  return (nValues == event->getEventNumber()) && ("CompressionSource" == event->getSource());
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-event-compression");
+
+  // settings
+  EventCompression::Algorithm algorithm(EventCompression::NONE);
+  unitTest.test("ALGORITHM_NAME", STATUS_CODE_SUCCESS == EventCompression::algorithmFromName("ZLIB", algorithm) && EventCompression::ZLIB == algorithm);
+  unitTest.test("ALGORITHM_UNKNOWN", STATUS_CODE_SUCCESS != EventCompression::algorithmFromName("bzip2", algorithm));
+  unitTest.test("ZLIB_SUPPORTED", EventCompression::isSupported(EventCompression::ZLIB));
+  unitTest.test("DISABLED", not EventCompression().enabled() && 0 == EventCompression().settings());
+  EventCompression compression(EventCompression::ZLIB, 5, 1024);
+  unitTest.test("SETTINGS", compression.enabled() && 105 == compression.settings());
+
+  // negotiation settings
+  json value;
+  compression.toJson(value);
+  EventCompression remoteCompression;
+  std::string message;
+  unitTest.test("JSON", STATUS_CODE_SUCCESS == remoteCompression.fromJson(value, message) && 105 == remoteCompression.settings() && 1024 == remoteCompression.minSize());
+  json unknownValue = {{"algorithm", "bzip2"}, {"level", 5}};
+  unitTest.test("JSON_UNKNOWN", STATUS_CODE_SUCCESS != remoteCompression.fromJson(unknownValue, message) && not message.empty());
+
+  // small event, below the minimum size: not compressed
+  EventStreamer streamer;
+  streamer.setCompression(compression);
+  TBufferFile outBuffer(TBuffer::kWrite);
+  unitTest.test("WRITE_SMALL", STATUS_CODE_SUCCESS == streamer.writeEvent(createEvent(10), outBuffer));
+  EventHeader header;
+  unitTest.test("PEEK_SMALL", EventHeader::peek(outBuffer.Buffer(), outBuffer.Length(), header) && not header.compressed());
+  unitTest.test("READ_SMALL", checkEvent(outBuffer.Buffer(), outBuffer.Length(), 10));
+
+  // large event: compressed
+  const unsigned int nValues(100000);
+  outBuffer.Reset();
+  unitTest.test("WRITE_LARGE", STATUS_CODE_SUCCESS == streamer.writeEvent(createEvent(nValues), outBuffer));
+  unitTest.test("PEEK_LARGE", EventHeader::peek(outBuffer.Buffer(), outBuffer.Length(), header) && header.compressed());
+  unitTest.test("PEEK_SETTINGS", 105 == header.m_compression);
+  unitTest.test("PEEK_SIZES", header.m_payloadSize < header.m_rawPayloadSize && nValues*sizeof(float) < header.m_rawPayloadSize);
+  unitTest.test("FRAME_SIZE", outBuffer.Length() == static_cast<Int_t>(EventHeader::size + header.m_payloadSize));
+  unitTest.test("READ_LARGE", checkEvent(outBuffer.Buffer(), outBuffer.Length(), nValues));
+
+  // a streamer without compression reads compressed frames
+  TBufferFile uncompressedBuffer(TBuffer::kWrite);
+  EventStreamer plainStreamer;
+  unitTest.test("WRITE_PLAIN", STATUS_CODE_SUCCESS == plainStreamer.writeEvent(createEvent(nValues), uncompressedBuffer));
+  unitTest.test("PLAIN_LARGER", uncompressedBuffer.Length() > outBuffer.Length());
+
+  // direct payload compression
+  std::vector<char> compressed, uncompressed;
+  const char *payload = uncompressedBuffer.Buffer() + EventHeader::size;
+  const unsigned int payloadSize = uncompressedBuffer.Length() - EventHeader::size;
+  unitTest.test("COMPRESS", STATUS_CODE_SUCCESS == compression.compress(payload, payloadSize, compressed));
+  unitTest.test("UNCOMPRESS", STATUS_CODE_SUCCESS == EventCompression::uncompress(compressed.data(), compressed.size(), payloadSize, uncompressed)
+    && std::equal(uncompressed.begin(), uncompressed.end(), payload));
+  unitTest.test("UNCOMPRESS_WRONG_SIZE", STATUS_CODE_SUCCESS != EventCompression::uncompress(compressed.data(), compressed.size(), payloadSize + 1, uncompressed));
+  unitTest.test("UNCOMPRESS_TRUNCATED", STATUS_CODE_SUCCESS != EventCompression::uncompress(compressed.data(), compressed.size() / 2, payloadSize, uncompressed));
+
+  // incompressible payload: kept raw
+  std::vector<char> noise(8192);
+  unsigned int seed(12345);
+  for(auto &c : noise) {
+    seed = seed * 1103515245u + 12345u;
+    c = static_cast<char>(seed >> 24);
+  }
+  unitTest.test("INCOMPRESSIBLE", STATUS_CODE_UNCHANGED == compression.compress(noise.data(), noise.size(), compressed));
+
+  return 0;
+}
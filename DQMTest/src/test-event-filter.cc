@@ -0,0 +1,108 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventFilter.h>
+#include <dqm4hep/EventHeader.h>
+#include <dqm4hep/EventSubscription.h>
+#include <dqm4hep/UnitTesting.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+EventHeader createHeader(EventType type, const std::string &source, uint32_t eventNumber, const time::point &timeStamp) {
+  EventHeader header;
+  header.m_type = static_cast<uint16_t>(type);
+  header.m_sourceId = EventNameTable::hashName(source);
+  header.m_eventNumber = eventNumber;
+  header.m_runNumber = 42;
+  header.m_timeStamp = std::chrono::duration_cast<std::chrono::nanoseconds>(timeStamp.time_since_epoch()).count();
+  return header;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool parse(EventFilter &filter, const std::string &expression) {
+  std::string message;
+  return (STATUS_CODE_SUCCESS == filter.parse(expression, message));
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-event-filter");
+  
+  const time::point now = time::now();
+  const EventHeader raw10 = createHeader(RAW_DATA_EVENT, "Calo", 10, now);
+  const EventHeader raw11 = createHeader(RAW_DATA_EVENT, "Calo", 11, now);
+  const EventHeader reco20 = createHeader(RECONSTRUCTED_EVENT, "Tracker", 20, now - std::chrono::seconds(10));
+  
+  // no filter
+  EventFilter filter;
+  unitTest.test("EMPTY", filter.empty() && filter.match(raw10, now) && filter.match(reco20, now));
+  unitTest.test("BLANK", parse(filter, "  ") && filter.empty());
+  
+  // event type
+  unitTest.test("TYPE_PARSE", parse(filter, "type == raw") && not filter.empty());
+  unitTest.test("TYPE_MATCH", filter.match(raw10, now) && not filter.match(reco20, now));
+  unitTest.test("TYPE_NUMBER", parse(filter, "type == 2") && filter.match(reco20, now) && not filter.match(raw10, now));
+  unitTest.test("TYPE_IN", parse(filter, "type in (raw, physics)") && filter.match(raw10, now) && not filter.match(reco20, now));
+  
+  // source
+  unitTest.test("SOURCE", parse(filter, "source == Tracker") && filter.match(reco20, now) && not filter.match(raw10, now));
+  unitTest.test("SOURCE_QUOTED", parse(filter, "source != \"Calo\"") && filter.match(reco20, now) && not filter.match(raw11, now));
+  unitTest.test("SOURCE_ORDER", not parse(filter, "source < Calo"));
+  
+  // event number
+  unitTest.test("MODULO", parse(filter, "number % 2 == 0") && filter.match(raw10, now) && not filter.match(raw11, now));
+  unitTest.test("NUMBER_RANGE", parse(filter, "number >= 11 && number < 20") && filter.match(raw11, now) && not filter.match(raw10, now) && not filter.match(reco20, now));
+  unitTest.test("RUN", parse(filter, "run == 42") && filter.match(raw10, now));
+  
+  // time stamp window
+  unitTest.test("AGE", parse(filter, "age < 5") && filter.match(raw10, now) && not filter.match(reco20, now));
+  const double nowSeconds = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+  unitTest.test("TIME_WINDOW", parse(filter, "time >= " + std::to_string(nowSeconds - 5) + " and time <= " + std::to_string(nowSeconds + 5)) 
+    && filter.match(raw10, now) && not filter.match(reco20, now));
+  
+  // combined conditions
+  unitTest.test("COMBINED", parse(filter, "type == raw and source == Calo && number % 5 == 1") && filter.match(raw11, now) && not filter.match(raw10, now));
+  
+  // invalid expressions leave the filter unchanged
+  const std::string expression(filter.expression());
+  unitTest.test("UNKNOWN_FIELD", not parse(filter, "energy > 10"));
+  unitTest.test("UNKNOWN_TYPE", not parse(filter, "type == cosmics"));
+  unitTest.test("BAD_MODULO", not parse(filter, "type % 2 == 0") && not parse(filter, "number % 0 == 0"));
+  unitTest.test("BAD_VALUE", not parse(filter, "number == ten") && not parse(filter, "number =="));
+  unitTest.test("BAD_LIST", not parse(filter, "type in (raw physics)") && not parse(filter, "type in raw"));
+  unitTest.test("BAD_CONJUNCTION", not parse(filter, "type == raw ||  number == 1") && not parse(filter, "type == raw &&"));
+  unitTest.test("BAD_CHARACTER", not parse(filter, "number = 1") && not parse(filter, "source == \"Calo"));
+  unitTest.test("UNCHANGED", expression == filter.expression() && filter.match(raw11, now));
+  
+  // subscription settings
+  EventSubscription subscription = EventSubscription::prescaled(2);
+  subscription.setFilter(filter);
+  json value;
+  EventSubscription filtered;
+  filtered.setFilter(filter);
+  unitTest.test("FILTER_SELECTIVE", filtered.selective());
+  subscription.toJson(value);
+  EventSubscription remote;
+  std::string message;
+  unitTest.test("JSON", STATUS_CODE_SUCCESS == remote.fromJson(value, message) && expression == remote.filter().expression() && remote.filter().match(raw11, now));
+  value["filter"] = "type ==";
+  unitTest.test("JSON_INVALID", STATUS_CODE_SUCCESS != remote.fromJson(value, message) && not message.empty());
+  
+  return 0;
+}
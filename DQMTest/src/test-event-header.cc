@@ -0,0 +1,108 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventHeader.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-event-header");
+
+  // source name table
+  EventNameTable *sourceNames = EventNameTable::sourceNames();
+  EventNameTable::Id sourceId(EventNameTable::invalidId);
+  const std::string *sourceName(nullptr);
+  unitTest.test("INTERN", STATUS_CODE_SUCCESS == sourceNames->intern("HeaderSource", sourceId, sourceName));
+  unitTest.test("INTERN_ID", EventNameTable::hashName("HeaderSource") == sourceId && nullptr != sourceName && "HeaderSource" == *sourceName);
+  const std::string *sameName(nullptr);
+  unitTest.test("INTERN_SAME", STATUS_CODE_SUCCESS == sourceNames->intern("HeaderSource", sourceId, sameName) && sameName == sourceName);
+  unitTest.test("NAME", sourceName == sourceNames->name(sourceId));
+  unitTest.test("NAME_UNKNOWN", nullptr == sourceNames->name(EventNameTable::hashName("UnknownSource")));
+
+  // source dictionary exchanged at registration
+  std::string message;
+  json remoteSources = {{"RemoteSource", EventNameTable::hashName("RemoteSource")}};
+  unitTest.test("TABLE_REMOTE", STATUS_CODE_SUCCESS == sourceNames->fromJson(remoteSources, message));
+  unitTest.test("TABLE_REMOTE_NAME", nullptr != sourceNames->name(EventNameTable::hashName("RemoteSource")));
+  json wrongSources = {{"WrongSource", 42}};
+  unitTest.test("TABLE_WRONG_ID", STATUS_CODE_SUCCESS != sourceNames->fromJson(wrongSources, message) && not message.empty());
+  json table;
+  sourceNames->toJson(table);
+  unitTest.test("TABLE", table.is_object() && 1 == table.count("HeaderSource") && 1 == table.count("RemoteSource"));
+
+  // event round trip
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName("GenericEventStreamer");
+  event->setSource("HeaderSource");
+  event->setType(PHYSICS_EVENT);
+  event->setEventNumber(123456);
+  event->setRunNumber(42);
+  const time::point timeStamp = time::now();
+  event->setTimeStamp(timeStamp);
+  event->getEvent<GenericEvent>()->setValues("Values", IntVector(10, 1));
+  unitTest.test("SOURCE_ID", sourceId == event->getSourceId() && "HeaderSource" == event->getSource());
+
+  EventStreamer streamer;
+  TBufferFile outBuffer(TBuffer::kWrite);
+  unitTest.test("WRITE", STATUS_CODE_SUCCESS == streamer.writeEvent(event, outBuffer));
+
+  // peek the header, no payload decoding
+  EventHeader header;
+  unitTest.test("PEEK", EventHeader::peek(outBuffer.Buffer(), outBuffer.Length(), header));
+  unitTest.test("PEEK_VERSION", EventHeader::currentVersion == header.m_version);
+  unitTest.test("PEEK_TYPE", PHYSICS_EVENT == header.m_type);
+  unitTest.test("PEEK_STREAMER", event->getStreamerId() == header.m_streamerId);
+  unitTest.test("PEEK_SOURCE", sourceId == header.m_sourceId && "HeaderSource" == header.sourceName());
+  unitTest.test("PEEK_NUMBERS", 123456 == header.m_eventNumber && 42 == header.m_runNumber);
+  unitTest.test("PEEK_TIME", time::asNanoseconds(timeStamp) == header.m_timeStamp);
+  unitTest.test("PEEK_PAYLOAD_SIZE", outBuffer.Length() == static_cast<Int_t>(EventHeader::size + header.m_payloadSize));
+  unitTest.test("PEEK_TRUNCATED", not EventHeader::peek(outBuffer.Buffer(), EventHeader::size - 1, header));
+
+  // full decoding
+  EventPtr inEvent;
+  TBufferFile inBuffer(TBuffer::kRead);
+  inBuffer.SetBuffer(outBuffer.Buffer(), outBuffer.Length(), false);
+  unitTest.test("READ", STATUS_CODE_SUCCESS == streamer.readEvent(inEvent, inBuffer) && nullptr != inEvent);
+  unitTest.test("READ_SOURCE", inEvent->getSourceId() == sourceId && "HeaderSource" == inEvent->getSource());
+  // interned names, no copy
+  unitTest.test("READ_SOURCE_INTERNED", &inEvent->getSource() == &event->getSource());
+  unitTest.test("READ_STREAMER", "GenericEventStreamer" == inEvent->getStreamerName());
+  unitTest.test("READ_TYPE", PHYSICS_EVENT == inEvent->getType());
+  unitTest.test("READ_NUMBERS", 123456 == inEvent->getEventNumber() && 42 == inEvent->getRunNumber());
+  unitTest.test("READ_TIME", timeStamp == inEvent->getTimeStamp());
+  unitTest.test("READ_SIZE", header.m_payloadSize == inEvent->getEventSize());
+  IntVector values;
+  unitTest.test("READ_PAYLOAD", STATUS_CODE_SUCCESS == inEvent->getEvent<GenericEvent>()->getValues("Values", values) && IntVector(10, 1) == values);
+
+  // unknown source id: event decoded, source name empty
+  outBuffer.SetBufferOffset(sizeof(UChar_t) + sizeof(UChar_t) + sizeof(UShort_t) + sizeof(UInt_t));
+  outBuffer.WriteUInt(EventNameTable::hashName("UnknownSource"));
+  inBuffer.SetBuffer(outBuffer.Buffer(), EventHeader::size + header.m_payloadSize, false);
+  unitTest.test("READ_UNKNOWN_SOURCE", STATUS_CODE_SUCCESS == streamer.readEvent(inEvent, inBuffer) && inEvent->getSource().empty());
+
+  // unsupported header version
+  outBuffer.SetBufferOffset(sizeof(UChar_t));
+  outBuffer.WriteUChar(EventHeader::currentVersion + 1);
+  unitTest.test("PEEK_BAD_VERSION", not EventHeader::peek(outBuffer.Buffer(), EventHeader::size + header.m_payloadSize, header));
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <atomic>
+#include <thread>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+using StreamerId = EventStreamerRegistry::StreamerId;
+
+const unsigned int nThreads = 4;
+const unsigned int nThreadEvents = 2000;
+
+EventPtr createEvent(const std::string &streamerName, unsigned int eventNumber) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName(streamerName);
+  event->setEventNumber(eventNumber);
+  event->getEvent<GenericEvent>()->setValues("Values", IntVector(3, eventNumber));
+  return event;
+}
+
+bool checkEvent(EventPtr event, const std::string &streamerName, unsigned int eventNumber) {
+  IntVector values;
+  return (nullptr != event)
+    && (streamerName == event->getStreamerName())
+    && (eventNumber == event->getEventNumber())
+    && (STATUS_CODE_SUCCESS == event->getEvent<GenericEvent>()->getValues("Values", values))
+    && (IntVector(3, eventNumber) == values);
+}
+
+EventPtr readFrame(const char *frame, unsigned int size) {
+  EventStreamer streamer;
+  EventPtr event;
+  TBufferFile inBuffer(TBuffer::kRead);
+  inBuffer.SetBuffer(const_cast<char*>(frame), size, false);
+  if(STATUS_CODE_SUCCESS != streamer.readEvent(event, inBuffer)) {
+    return nullptr;
+  }
+  return event;
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-event-streamer-registry");
+  EventStreamerRegistry *registry = EventStreamerRegistry::instance();
+
+  // ids
+  StreamerId genericId(EventStreamerRegistry::invalidId), columnarId(EventStreamerRegistry::invalidId);
+  unitTest.test("REGISTER", STATUS_CODE_SUCCESS == registry->registerStreamer("GenericEventStreamer", genericId));
+  unitTest.test("REGISTER_ID", EventNameTable::hashName("GenericEventStreamer") == genericId && EventStreamerRegistry::invalidId != genericId);
+  unitTest.test("REGISTER_UNKNOWN", STATUS_CODE_SUCCESS != registry->registerStreamer("UnknownStreamer", columnarId));
+  unitTest.test("HASH_DIFFERENT", EventNameTable::hashName("GenericEventColumnarStreamer") != genericId);
+  std::string name;
+  unitTest.test("NAME", STATUS_CODE_SUCCESS == registry->streamerName(genericId, name) && "GenericEventStreamer" == name);
+  // not registered yet, found in plugin manager
+  columnarId = EventNameTable::hashName("GenericEventColumnarStreamer");
+  unitTest.test("NAME_FROM_PLUGINS", STATUS_CODE_SUCCESS == registry->streamerName(columnarId, name) && "GenericEventColumnarStreamer" == name);
+  unitTest.test("NAME_NOT_FOUND", STATUS_CODE_NOT_FOUND == registry->streamerName(EventNameTable::hashName("UnknownStreamer"), name));
+
+  // streamer tables exchanged at source registration
+  json table;
+  registry->streamerTable(table);
+  std::string message;
+  unitTest.test("TABLE", table.is_object() && 1 == table.count("GenericEventStreamer") && genericId == table["GenericEventStreamer"].get<StreamerId>());
+  unitTest.test("TABLE_CHECK", STATUS_CODE_SUCCESS == registry->checkStreamerTable(table, message));
+  json remoteTable = {{"RemoteStreamer", EventNameTable::hashName("RemoteStreamer")}};
+  unitTest.test("TABLE_CHECK_REMOTE", STATUS_CODE_SUCCESS == registry->checkStreamerTable(remoteTable, message));
+  json wrongTable = {{"GenericEventStreamer", genericId + 1}};
+  unitTest.test("TABLE_CHECK_WRONG_ID", STATUS_CODE_SUCCESS != registry->checkStreamerTable(wrongTable, message) && not message.empty());
+
+  // compact frame
+  EventStreamer streamer;
+  TBufferFile outBuffer(TBuffer::kWrite);
+  unitTest.test("WRITE", STATUS_CODE_SUCCESS == streamer.writeEvent(createEvent("GenericEventStreamer", 7), outBuffer));
+  const unsigned int compactSize = outBuffer.Length();
+  unitTest.test("READ", checkEvent(readFrame(outBuffer.Buffer(), compactSize), "GenericEventStreamer", 7));
+
+  // older frame format: streamer name and base event data in place of the event header
+  const std::string streamerName("GenericEventStreamer"), sourceName("");
+  TBufferFile legacyBuffer(TBuffer::kWrite);
+  legacyBuffer.WriteStdString(&streamerName);
+  legacyBuffer.WriteInt(UNKNOWN_EVENT);
+  legacyBuffer.WriteStdString(&sourceName);
+  legacyBuffer.WriteInt(0);
+  legacyBuffer.WriteLong64(0);
+  legacyBuffer.WriteInt(7);
+  legacyBuffer.WriteInt(0);
+  legacyBuffer.WriteFastArray(outBuffer.Buffer() + EventHeader::size, compactSize - EventHeader::size);
+  unitTest.test("LEGACY_READ", checkEvent(readFrame(legacyBuffer.Buffer(), legacyBuffer.Length()), "GenericEventStreamer", 7));
+  unitTest.test("COMPACT_SMALLER", compactSize < static_cast<unsigned int>(legacyBuffer.Length()));
+
+  // unknown streamer id
+  outBuffer.SetBufferOffset(sizeof(UChar_t) + sizeof(UChar_t) + sizeof(UShort_t));
+  outBuffer.WriteUInt(EventNameTable::hashName("UnknownStreamer"));
+  unitTest.test("READ_UNKNOWN_ID", nullptr == readFrame(outBuffer.Buffer(), compactSize));
+
+  // one streamer shared by several threads, alternating streamer plugins
+  std::atomic_bool threadSuccess(true);
+  std::vector<std::thread> threads;
+  for(unsigned int t=0 ; t<nThreads ; t++) {
+    threads.push_back(std::thread([&streamer, &threadSuccess](){
+      TBufferFile threadBuffer(TBuffer::kWrite);
+      for(unsigned int e=0 ; e<nThreadEvents ; e++) {
+        const std::string threadStreamerName(0 == e % 2 ? "GenericEventStreamer" : "GenericEventColumnarStreamer");
+        threadBuffer.Reset();
+        EventPtr event;
+        TBufferFile inBuffer(TBuffer::kRead);
+        if(STATUS_CODE_SUCCESS != streamer.writeEvent(createEvent(threadStreamerName, e), threadBuffer)) {
+          threadSuccess = false;
+          return;
+        }
+        inBuffer.SetBuffer(threadBuffer.Buffer(), threadBuffer.Length(), false);
+        if(STATUS_CODE_SUCCESS != streamer.readEvent(event, inBuffer) || not checkEvent(event, threadStreamerName, e)) {
+          threadSuccess = false;
+          return;
+        }
+      }
+    }));
+  }
+  for(auto &thread : threads) {
+    thread.join();
+  }
+  unitTest.test("THREADS", threadSuccess.load());
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/EventSubscription.h>
+#include <dqm4hep/UnitTesting.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-event-subscription");
+  
+  const time::point start = time::now();
+  const auto ms = [&start](int n) { return start + std::chrono::milliseconds(n); };
+  
+  // all updates
+  EventSubscription all;
+  unsigned int nSelected(0);
+  for(int i=0 ; i<10 ; i++) {
+    nSelected += all.select(ms(i)) ? 1 : 0;
+  }
+  unitTest.test("ALL", 10 == nSelected && not all.flushPending(ms(10)));
+  unitTest.test("ALL_NOT_SELECTIVE", not all.selective());
+  
+  // one update every 3
+  EventSubscription prescaled = EventSubscription::prescaled(3);
+  nSelected = 0;
+  for(int i=0 ; i<10 ; i++) {
+    nSelected += prescaled.select(ms(i)) ? 1 : 0;
+  }
+  unitTest.test("PRESCALE", 4 == nSelected);
+  unitTest.test("PRESCALE_ZERO", 1 == EventSubscription::prescaled(0).prescale());
+  unitTest.test("PRESCALE_SELECTIVE", EventSubscription::prescaled(2).selective());
+  
+  // at most 10 Hz, updates every 30 ms: one update out of 4 is selected
+  EventSubscription rateLimited = EventSubscription::rateLimited(10.);
+  nSelected = 0;
+  for(int i=0 ; i<12 ; i++) {
+    nSelected += rateLimited.select(ms(i*30)) ? 1 : 0;
+  }
+  unitTest.test("MAX_RATE", 3 == nSelected);
+  unitTest.test("MAX_RATE_NO_FLUSH", not rateLimited.flushPending(ms(1000)));
+  
+  // latest only at 10 Hz: updates arriving too early are sent later by the flush
+  EventSubscription latest = EventSubscription::latestOnly(10.);
+  unitTest.test("LATEST_FIRST", latest.select(ms(0)));
+  unitTest.test("LATEST_EARLY", not latest.select(ms(30)) && not latest.select(ms(60)));
+  unitTest.test("LATEST_FLUSH_EARLY", not latest.flushPending(ms(90)));
+  unitTest.test("LATEST_FLUSH", latest.flushPending(ms(100)));
+  unitTest.test("LATEST_FLUSH_ONCE", not latest.flushPending(ms(300)));
+  unitTest.test("LATEST_NEXT", latest.select(ms(300)) && not latest.flushPending(ms(500)));
+  
+  // json round trip
+  json value;
+  EventSubscription::latestOnly(5.).toJson(value);
+  EventSubscription remote;
+  std::string message;
+  unitTest.test("JSON", STATUS_CODE_SUCCESS == remote.fromJson(value, message) && EventSubscription::LATEST == remote.mode() && 5. == remote.maxRate());
+  EventSubscription::prescaled(7).toJson(value);
+  unitTest.test("JSON_PRESCALE", STATUS_CODE_SUCCESS == remote.fromJson(value, message) && EventSubscription::PRESCALE == remote.mode() && 7 == remote.prescale());
+  
+  // invalid settings
+  const json unknownMode = {{"mode", "random"}};
+  unitTest.test("JSON_UNKNOWN", STATUS_CODE_SUCCESS != remote.fromJson(unknownMode, message) && not message.empty());
+  const json noRate = {{"mode", "maxrate"}, {"maxRate", 0.}};
+  unitTest.test("JSON_NO_RATE", STATUS_CODE_SUCCESS != remote.fromJson(noRate, message));
+  const json noPrescale = {{"mode", "Prescale"}, {"prescale", 0}};
+  unitTest.test("JSON_NO_PRESCALE", STATUS_CODE_SUCCESS != remote.fromJson(noPrescale, message));
+  unitTest.test("JSON_UNCHANGED", EventSubscription::PRESCALE == remote.mode() && 7 == remote.prescale());
+  bool invalidRateThrows(false);
+  try {
+    EventSubscription::rateLimited(0.);
+  }
+  catch(StatusCodeException &exception) {
+    invalidRateThrows = (STATUS_CODE_INVALID_PARAMETER == exception.getStatusCode());
+  }
+  unitTest.test("MAX_RATE_INVALID", invalidRateThrows);
+  bool invalidLatestThrows(false);
+  try {
+    EventSubscription::latestOnly(-1.);
+  }
+  catch(StatusCodeException &exception) {
+    invalidLatestThrows = (STATUS_CODE_INVALID_PARAMETER == exception.getStatusCode());
+  }
+  unitTest.test("LATEST_INVALID", invalidLatestThrows);
+  
+  return 0;
+}
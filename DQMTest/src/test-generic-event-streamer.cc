@@ -0,0 +1,157 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <algorithm>
+#include <thread>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+const IntVector intValues = {1, -2, 3, 40000};
+const FloatVector floatValues = {0.5f, 1.25f, -3.75f};
+const DoubleVector doubleValues = {3.14159265358979, -1e-12};
+const StringVector stringValues = {"one", "", "three"};
+
+EventPtr createEvent(const std::string &streamerName) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setStreamerName(streamerName);
+  event->setEventNumber(12);
+  GenericEvent *generic = event->getEvent<GenericEvent>();
+  generic->setValues("Ints", intValues);
+  generic->setValues("Floats", floatValues);
+  generic->setValues("SingleFloat", FloatVector(1, 42.f));
+  generic->setValues("EmptyFloats", FloatVector());
+  generic->setValues("Doubles", doubleValues);
+  generic->setValues("Strings", stringValues);
+  return event;
+}
+
+EventPtr roundTrip(EventPtr outEvent, TBufferFile &outBuffer) {
+  EventStreamer streamer;
+  outBuffer.Reset();
+  if(STATUS_CODE_SUCCESS != streamer.writeEvent(outEvent, outBuffer)) {
+    return nullptr;
+  }
+  EventPtr inEvent;
+  TBufferFile inBuffer(TBuffer::kRead);
+  inBuffer.SetBuffer(outBuffer.Buffer(), outBuffer.Length(), false);
+  if(STATUS_CODE_SUCCESS != streamer.readEvent(inEvent, inBuffer)) {
+    return nullptr;
+  }
+  return inEvent;
+}
+
+bool checkEvent(EventPtr event) {
+  GenericEvent *generic = (nullptr == event) ? nullptr : event->getEvent<GenericEvent>();
+  if(nullptr == generic) {
+    return false;
+  }
+  IntVector ints; FloatVector floats, singleFloat, emptyFloats; DoubleVector doubles; StringVector strings;
+  return (12 == event->getEventNumber())
+    && (STATUS_CODE_SUCCESS == generic->getValues("Ints", ints)) && (intValues == ints)
+    && (STATUS_CODE_SUCCESS == generic->getValues("Floats", floats)) && (floatValues == floats)
+    && (STATUS_CODE_SUCCESS == generic->getValues("SingleFloat", singleFloat)) && (FloatVector(1, 42.f) == singleFloat)
+    && (STATUS_CODE_SUCCESS == generic->getValues("EmptyFloats", emptyFloats)) && emptyFloats.empty()
+    && (STATUS_CODE_SUCCESS == generic->getValues("Doubles", doubles)) && (doubleValues == doubles)
+    && (STATUS_CODE_SUCCESS == generic->getValues("Strings", strings)) && (stringValues == strings);
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-generic-event-streamer");
+  TBufferFile outBuffer(TBuffer::kWrite);
+
+  // map based streamer
+  EventPtr inEvent = roundTrip(createEvent("GenericEventStreamer"), outBuffer);
+  unitTest.test("ROUND_TRIP", checkEvent(inEvent));
+
+  // columnar streamer
+  inEvent = roundTrip(createEvent("GenericEventColumnarStreamer"), outBuffer);
+  unitTest.test("COLUMNAR_ROUND_TRIP", checkEvent(inEvent));
+
+  // views on the columnar buffer
+  GenericEvent *generic = inEvent->getEvent<GenericEvent>();
+  ArrayView<float> floatView;
+  ArrayView<double> doubleView;
+  unitTest.test("COLUMNAR_VIEW", STATUS_CODE_SUCCESS == generic->getValues("Floats", floatView));
+  unitTest.test("COLUMNAR_VIEW_CONTENTS", floatView.size() == floatValues.size() && std::equal(floatView.begin(), floatView.end(), floatValues.begin()));
+  unitTest.test("COLUMNAR_VIEW_ALIGNED", 0 == reinterpret_cast<uintptr_t>(floatView.data()) % sizeof(float));
+  unitTest.test("COLUMNAR_DOUBLE_VIEW", STATUS_CODE_SUCCESS == generic->getValues("Doubles", doubleView) && doubleView[0] == doubleValues[0]);
+  unitTest.test("COLUMNAR_VIEW_NOT_FOUND", STATUS_CODE_NOT_FOUND == generic->getValues("Ints", floatView));
+
+  // overriding values from the columnar buffer
+  generic->setValues("Floats", FloatVector(2, 7.f));
+  FloatVector floats;
+  unitTest.test("COLUMNAR_OVERRIDE", STATUS_CODE_SUCCESS == generic->getValues("Floats", floats) && FloatVector(2, 7.f) == floats);
+
+  // event read with the columnar streamer, written back with both streamers
+  inEvent->setStreamerName("GenericEventColumnarStreamer");
+  EventPtr columnarEvent = roundTrip(inEvent, outBuffer);
+  inEvent->setStreamerName("GenericEventStreamer");
+  EventPtr mapEvent = roundTrip(inEvent, outBuffer);
+  FloatVector columnarFloats, mapFloats;
+  DoubleVector mapDoubles;
+  unitTest.test("COLUMNAR_REWRITE", nullptr != columnarEvent && STATUS_CODE_SUCCESS == columnarEvent->getEvent<GenericEvent>()->getValues("Floats", columnarFloats) && FloatVector(2, 7.f) == columnarFloats);
+  unitTest.test("MAP_REWRITE", nullptr != mapEvent && STATUS_CODE_SUCCESS == mapEvent->getEvent<GenericEvent>()->getValues("Floats", mapFloats) && FloatVector(2, 7.f) == mapFloats);
+  unitTest.test("MAP_REWRITE_COLUMNS", STATUS_CODE_SUCCESS == mapEvent->getEvent<GenericEvent>()->getValues("Doubles", mapDoubles) && doubleValues == mapDoubles);
+
+  // key handles, same key with different types, hash table growth
+  EventPtr keyEvent = GenericEvent::make_shared();
+  GenericEvent *keyGeneric = keyEvent->getEvent<GenericEvent>();
+  const GenericEvent::Key valuesKey("Values");
+  unitTest.test("KEY_INTERNED", &valuesKey.name() == &GenericEvent::Key("Values").name());
+  const std::string *threadKeyName = nullptr;
+  std::thread keyThread([&threadKeyName](){ threadKeyName = &GenericEvent::Key("Values").name(); });
+  keyThread.join();
+  unitTest.test("KEY_INTERNED_THREAD", &valuesKey.name() == threadKeyName);
+  unitTest.test("KEY_INVALID", STATUS_CODE_INVALID_PARAMETER == keyGeneric->setValues(GenericEvent::Key(), intValues));
+  keyGeneric->setValues(valuesKey, intValues);
+  keyGeneric->setValues("Values", floatValues);
+  for(unsigned int k=0 ; k<100 ; k++) {
+    keyGeneric->setValues("Key" + std::to_string(k), IntVector(1, k));
+  }
+  ArrayView<int> intView;
+  FloatVector keyFloats;
+  StringVector keyStrings;
+  unitTest.test("KEY_INT_VIEW", STATUS_CODE_SUCCESS == keyGeneric->getValues(valuesKey, intView) && intView.size() == intValues.size() && std::equal(intView.begin(), intView.end(), intValues.begin()));
+  unitTest.test("KEY_FLOAT_VALUES", STATUS_CODE_SUCCESS == keyGeneric->getValues(valuesKey, keyFloats) && floatValues == keyFloats);
+  unitTest.test("KEY_STRING_NOT_FOUND", STATUS_CODE_NOT_FOUND == keyGeneric->getValues(valuesKey, keyStrings) && keyStrings.empty());
+  bool allKeys = true;
+  for(unsigned int k=0 ; k<100 ; k++) {
+    ArrayView<int> view;
+    allKeys = allKeys && STATUS_CODE_SUCCESS == keyGeneric->getValues(GenericEvent::Key("Key" + std::to_string(k)), view) && 1 == view.size() && static_cast<int>(k) == view[0];
+  }
+  unitTest.test("KEY_GROWTH", allKeys);
+  EventPtr keyInEvent = roundTrip(keyEvent, outBuffer);
+  ArrayView<int> inView;
+  unitTest.test("KEY_ROUND_TRIP", nullptr != keyInEvent && STATUS_CODE_SUCCESS == keyInEvent->getEvent<GenericEvent>()->getValues("Key99", inView) && 1 == inView.size() && 99 == inView[0]);
+
+  // corrupted block: the streamer must fail instead of reading out of bounds
+  roundTrip(createEvent("GenericEventColumnarStreamer"), outBuffer);
+  TBufferFile corruptedBuffer(TBuffer::kRead);
+  corruptedBuffer.SetBuffer(outBuffer.Buffer(), outBuffer.Length() - 16, false);
+  EventStreamer streamer;
+  EventPtr corruptedEvent;
+  unitTest.test("COLUMNAR_TRUNCATED", STATUS_CODE_SUCCESS != streamer.readEvent(corruptedEvent, corruptedBuffer));
+
+  return 0;
+}
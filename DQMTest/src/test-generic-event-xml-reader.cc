@@ -0,0 +1,143 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventReader.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/PluginManager.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <cstdio>
+#include <fstream>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+const unsigned int nEvents = 100;
+const std::string fileName = "test-generic-event-xml-reader.xml";
+
+/**
+ *  @brief  EventCollector class.
+ *          Store the events emitted by the reader
+ */
+class EventCollector {
+public:
+  void receiveEvent(EventPtr event) {
+    m_events.push_back(event);
+  }
+
+public:
+  std::vector<EventPtr>       m_events = {};
+};
+
+void writeFile(const std::string &runInfo, unsigned int nFileEvents, bool invalidValues = false) {
+  std::ofstream file(fileName.c_str());
+  file << "<?xml version=\"1.0\" ?>\n";
+  file << "<!-- a <commented> element -->\n";
+  file << "<data version=\"1 > 0\">\n";
+  file << runInfo;
+  for(unsigned int e=0 ; e<nFileEvents ; e++) {
+    file << "  <event>\n";
+    file << "    <!-- 4: custom data -->\n";
+    file << "    <parameter name=\"EventType\">4</parameter>\n";
+    file << "    <parameter name=\"Source\">TestSource</parameter>\n";
+    file << "    <parameter name=\"TimeStamp\">1528291185</parameter>\n";
+    file << "    <parameter name=\"EventNumber\">" << e << "</parameter>\n";
+    file << "    <parameter name=\"RunNumber\">42</parameter>\n";
+    file << "    <field name=\"Ints\" type=\"int\"> " << e << " -2 3 </field>\n";
+    file << "    <field name=\"Floats\" type=\"float\">\n  0.5 1e-3\t-2.25 </field>\n";
+    file << "    <field name=\"Doubles\" type=\"double\"> " << (invalidValues ? "1.5 abc" : "3.14159265358979") << " </field>\n";
+    file << "    <field name=\"Strings\" type=\"string\"><str>hello world</str><str/></field>\n";
+    file << "  </event>\n";
+  }
+  file << "</data>\n";
+}
+
+bool checkEvent(EventPtr event, unsigned int eventNumber) {
+  if(nullptr == event) {
+    return false;
+  }
+  GenericEvent *generic = event->getEvent<GenericEvent>();
+  IntVector ints; FloatVector floats; DoubleVector doubles; StringVector strings;
+  return (eventNumber == event->getEventNumber())
+    && (42 == event->getRunNumber())
+    && ("TestSource" == event->getSource())
+    && (STATUS_CODE_SUCCESS == generic->getValues("Ints", ints)) && (IntVector({static_cast<int>(eventNumber), -2, 3}) == ints)
+    && (STATUS_CODE_SUCCESS == generic->getValues("Floats", floats)) && (FloatVector({0.5f, 1e-3f, -2.25f}) == floats)
+    && (STATUS_CODE_SUCCESS == generic->getValues("Doubles", doubles)) && (DoubleVector(1, 3.14159265358979) == doubles)
+    && (STATUS_CODE_SUCCESS == generic->getValues("Strings", strings)) && (StringVector({"hello world", ""}) == strings);
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-generic-event-xml-reader");
+
+  const std::string runInfo =
+    "  <run>\n"
+    "    <parameter name=\"RunNumber\"> 42 </parameter>\n"
+    "    <parameter name=\"DetectorName\"> TestDetector </parameter>\n"
+    "    <parameters>\n"
+    "      <parameter name=\"Shifter\"> Perceval </parameter>\n"
+    "    </parameters>\n"
+    "  </run>\n";
+  writeFile(runInfo, nEvents);
+
+  EventCollector collector;
+  EventReaderPtr reader = PluginManager::instance()->create<EventReader>("GenericEventXMLReader");
+  unitTest.test("READER_PLUGIN", nullptr != reader);
+  reader->onEventRead().connect(&collector, &EventCollector::receiveEvent);
+
+  // run info and all events
+  unitTest.test("OPEN", STATUS_CODE_SUCCESS == reader->open(fileName));
+  Run run;
+  unitTest.test("RUN_INFO", STATUS_CODE_SUCCESS == reader->runInfo(run) && 42 == run.runNumber()
+    && "TestDetector" == run.detectorName() && 1 == run.parameters().count("Shifter"));
+  while(STATUS_CODE_SUCCESS == reader->readNextEvent());
+  bool readEvents = (nEvents == collector.m_events.size());
+  for(unsigned int e=0 ; readEvents && e<nEvents ; e++) {
+    readEvents = checkEvent(collector.m_events[e], e);
+  }
+  unitTest.test("READ_EVENTS", readEvents);
+  unitTest.test("END_OF_FILE", STATUS_CODE_OUT_OF_RANGE == reader->readNextEvent());
+
+  // skip events
+  collector.m_events.clear();
+  unitTest.test("REOPEN", STATUS_CODE_SUCCESS == reader->open(fileName));
+  unitTest.test("SKIP", STATUS_CODE_SUCCESS == reader->skipNEvents(60));
+  unitTest.test("SKIP_READ", STATUS_CODE_SUCCESS == reader->readNextEvent() && 1 == collector.m_events.size() && checkEvent(collector.m_events[0], 60));
+  unitTest.test("SKIP_OUT_OF_RANGE", STATUS_CODE_OUT_OF_RANGE == reader->skipNEvents(nEvents));
+  reader->close();
+
+  // no run info
+  writeFile("", 2);
+  collector.m_events.clear();
+  unitTest.test("NO_RUN_OPEN", STATUS_CODE_SUCCESS == reader->open(fileName));
+  unitTest.test("NO_RUN_INFO", STATUS_CODE_NOT_FOUND == reader->runInfo(run));
+  unitTest.test("NO_RUN_READ", STATUS_CODE_SUCCESS == reader->readNextEvent() && STATUS_CODE_SUCCESS == reader->readNextEvent()
+    && STATUS_CODE_OUT_OF_RANGE == reader->readNextEvent() && 2 == collector.m_events.size());
+  reader->close();
+
+  // no event at all
+  writeFile(runInfo, 0);
+  unitTest.test("NO_EVENT", STATUS_CODE_SUCCESS != reader->open(fileName));
+
+  // invalid numbers
+  writeFile(runInfo, 1, true);
+  unitTest.test("INVALID_VALUES_OPEN", STATUS_CODE_SUCCESS == reader->open(fileName));
+  unitTest.test("INVALID_VALUES", STATUS_CODE_FAILURE == reader->readNextEvent());
+  reader->close();
+  remove(fileName.c_str());
+
+  return 0;
+}
@@ -0,0 +1,70 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/MonitorElementManager.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/UnitTesting.h>
+
+#include <TH1.h>
+
+// -- std headers
+#include <iostream>
+#include <signal.h>
+
+using namespace std;
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-me-merge");
+
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+  std::unique_ptr<MonitorElementManager> otherMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+
+  MonitorElementPtr histoElement, otherHistoElement;
+  unitTest.test("BOOK_HISTO", STATUS_CODE_SUCCESS == meMgr->bookHisto<TH1F>("/", "TestHisto", "A test histogram", histoElement, 100, 0.f, 99.f));
+  unitTest.test("BOOK_OTHER_HISTO", STATUS_CODE_SUCCESS == otherMgr->bookHisto<TH1F>("/", "TestHisto", "A test histogram", otherHistoElement, 100, 0.f, 99.f));
+  MonitorElementPtr scalarElement, otherScalarElement;
+  unitTest.test("BOOK_SCALAR", STATUS_CODE_SUCCESS == meMgr->bookScalar<int>("/", "TestScalar", "A test scalar", scalarElement, 42));
+  unitTest.test("BOOK_OTHER_SCALAR", STATUS_CODE_SUCCESS == otherMgr->bookScalar<int>("/", "TestScalar", "A test scalar", otherScalarElement, 7));
+  // only in the other manager: skipped
+  MonitorElementPtr otherOnlyElement;
+  unitTest.test("BOOK_OTHER_ONLY", STATUS_CODE_SUCCESS == otherMgr->bookHisto<TH1F>("/", "OtherHisto", "An other histogram", otherOnlyElement, 10, 0.f, 9.f));
+
+  TH1F *histogram = histoElement->objectTo<TH1F>();
+  TH1F *otherHistogram = otherHistoElement->objectTo<TH1F>();
+  histogram->Fill(10);
+  for(unsigned int i=0 ; i<5 ; i++) {
+    otherHistogram->Fill(20);
+  }
+  otherOnlyElement->objectTo<TH1F>()->Fill(5);
+
+  // histograms are added then reset in the other manager
+  unitTest.test("MERGE", STATUS_CODE_SUCCESS == meMgr->mergeMonitorElements(*otherMgr));
+  unitTest.test("MERGE_HISTO_ENTRIES", 6 == histogram->GetEntries());
+  unitTest.test("MERGE_HISTO_BIN", 5 == histogram->GetBinContent(histogram->FindBin(20)));
+  unitTest.test("MERGE_OTHER_HISTO_RESET", 0 == otherHistogram->GetEntries());
+  MonitorElementPtr otherOnlyCopy;
+  unitTest.test("MERGE_OTHER_ONLY_SKIPPED", STATUS_CODE_NOT_FOUND == meMgr->getMonitorElement("/", "OtherHisto", otherOnlyCopy));
+  unitTest.test("MERGE_OTHER_ONLY_KEPT", 1 == otherOnlyElement->objectTo<TH1F>()->GetEntries());
+
+  // scalars can't be merged: both sides are left untouched
+  unitTest.test("MERGE_SCALAR_SKIPPED", 42 == scalarElement->objectTo<TScalarObject<int>>()->Get());
+  unitTest.test("MERGE_OTHER_SCALAR_KEPT", 7 == otherScalarElement->objectTo<TScalarObject<int>>()->Get());
+
+  // merging again adds nothing: the other histogram was reset
+  unitTest.test("MERGE_AGAIN", STATUS_CODE_SUCCESS == meMgr->mergeMonitorElements(*otherMgr));
+  unitTest.test("MERGE_AGAIN_HISTO_ENTRIES", 6 == histogram->GetEntries());
+
+  return 0;
+}
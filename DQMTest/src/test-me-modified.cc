@@ -0,0 +1,124 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/MonitorElementManager.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/UnitTesting.h>
+
+#include <TH1.h>
+#include <TGraph.h>
+#include <TNamed.h>
+
+// -- std headers
+#include <iostream>
+#include <signal.h>
+
+using namespace std;
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-me-modified");
+
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+
+  // histogram: entries and statistics fingerprint
+  MonitorElementPtr histoElement;
+  unitTest.test("BOOK_HISTO", STATUS_CODE_SUCCESS == meMgr->bookHisto<TH1F>("/", "TestHisto", "A test histogram", histoElement, 100, 0.f, 99.f));
+  TH1F *histogram = histoElement->objectTo<TH1F>();
+  unsigned long generation = histoElement->generation();
+  unitTest.test("HISTO_NOT_MODIFIED", generation == histoElement->generation());
+  histogram->Fill(42);
+  unitTest.test("HISTO_FILL", generation < histoElement->generation());
+  generation = histoElement->generation();
+  histoElement->setModified();
+  unitTest.test("HISTO_SET_MODIFIED", generation < histoElement->generation());
+  generation = histoElement->generation();
+  histogram->Reset();
+  unitTest.test("HISTO_RESET", generation < histoElement->generation());
+
+  // graph: number of points and last point fingerprint
+  MonitorElementPtr graphElement;
+  unitTest.test("BOOK_GRAPH", STATUS_CODE_SUCCESS == meMgr->bookMonitorElement("TGraph", "/", "TestGraph", graphElement));
+  generation = graphElement->generation();
+  unitTest.test("GRAPH_NOT_MODIFIED", generation == graphElement->generation());
+  graphElement->objectTo<TGraph>()->SetPoint(0, 1., 2.);
+  unitTest.test("GRAPH_ADD_POINT", generation < graphElement->generation());
+  generation = graphElement->generation();
+  graphElement->objectTo<TGraph>()->SetPoint(0, 1., 3.);
+  unitTest.test("GRAPH_CHANGE_POINT", generation < graphElement->generation());
+
+  // no fingerprint: always modified
+  MonitorElementPtr namedElement = MonitorElement::make_shared(new TNamed("TestNamed", "A named object"));
+  generation = namedElement->generation();
+  unitTest.test("NAMED_ALWAYS_MODIFIED", generation < namedElement->generation());
+
+  // quality test reports re-used while the histogram is not modified
+  PtrHandler<TObject> reference(new TH1F("", "A good reference", 100, 0.f, 99.f), true);
+  for(unsigned int i=0 ; i<100 ; i++) {
+    histogram->Fill(50);
+    static_cast<TH1F*>(reference.ptr())->Fill(50);
+  }
+  histoElement->setReferenceObject(reference);
+  TiXmlElement *qtestElement = new TiXmlElement("qtest");
+  std::shared_ptr<TiXmlElement> sharedQtest(qtestElement);
+  qtestElement->SetAttribute("type", "Chi2Test");
+  qtestElement->SetAttribute("name", "ModifiedChi2");
+  unitTest.test("CREATE_QTEST", STATUS_CODE_SUCCESS == meMgr->createQualityTest(qtestElement));
+  unitTest.test("ADD_QTEST", STATUS_CODE_SUCCESS == meMgr->addQualityTest("/", "TestHisto", "ModifiedChi2"));
+
+  QReport firstReport, secondReport, thirdReport, fourthReport;
+  {
+    QReportStorage storage;
+    unitTest.test("RUN_QTESTS_1", STATUS_CODE_SUCCESS == meMgr->runQualityTests(storage));
+    unitTest.test("GET_REPORT_1", STATUS_CODE_SUCCESS == storage.report("/", "TestHisto", "ModifiedChi2", firstReport));
+  }
+  {
+    QReportStorage storage;
+    unitTest.test("RUN_QTESTS_2", STATUS_CODE_SUCCESS == meMgr->runQualityTests(storage));
+    unitTest.test("GET_REPORT_2", STATUS_CODE_SUCCESS == storage.report("/", "TestHisto", "ModifiedChi2", secondReport));
+  }
+  unitTest.test("REPORT_REUSED", firstReport.m_executionTime == secondReport.m_executionTime && firstReport.m_quality == secondReport.m_quality);
+
+  for(unsigned int i=0 ; i<100 ; i++) {
+    histogram->Fill(20);
+  }
+  {
+    QReportStorage storage;
+    unitTest.test("RUN_QTESTS_3", STATUS_CODE_SUCCESS == meMgr->runQualityTests(storage));
+    unitTest.test("GET_REPORT_3", STATUS_CODE_SUCCESS == storage.report("/", "TestHisto", "ModifiedChi2", thirdReport));
+  }
+  unitTest.test("REPORT_UPDATED", thirdReport.m_quality < secondReport.m_quality);
+
+  // same with the worker pool
+  meMgr->setQualityTestThreads(2);
+  {
+    QReportStorage storage;
+    unitTest.test("RUN_QTESTS_4", STATUS_CODE_SUCCESS == meMgr->runQualityTests(storage));
+    unitTest.test("GET_REPORT_4", STATUS_CODE_SUCCESS == storage.report("/", "TestHisto", "ModifiedChi2", fourthReport));
+  }
+  unitTest.test("REPORT_REUSED_POOL", thirdReport.m_executionTime == fourthReport.m_executionTime && thirdReport.m_quality == fourthReport.m_quality);
+  meMgr->setQualityTestThreads(1);
+
+  // json export of the modified elements only
+  json allElements, modifiedElements, noElements;
+  meMgr->monitorElementsToJson(allElements);
+  meMgr->monitorElementsToJson(noElements, true);
+  histogram->Fill(10);
+  meMgr->monitorElementsToJson(modifiedElements, true);
+  unitTest.test("JSON_ALL", allElements.size() == 2);
+  unitTest.test("JSON_NOT_MODIFIED", noElements.size() == 0);
+  unitTest.test("JSON_MODIFIED", modifiedElements.size() == 1 && modifiedElements[0].value<std::string>("path", "") == histoElement->path());
+
+  return 0;
+}
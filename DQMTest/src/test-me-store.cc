@@ -0,0 +1,92 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/MonitorElementStore.h>
+#include <dqm4hep/UnitTesting.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+bool notified(const MonitorElementStore::NotificationMap &notifications, const std::string &moduleName, const std::string &name, bool subscribe) {
+  auto findIter = notifications.find(moduleName);
+  if(notifications.end() == findIter) {
+    return false;
+  }
+  for(auto &notification : findIter->second) {
+    if(notification.value<std::string>("name", "") == name and notification.value<bool>("sub", not subscribe) == subscribe) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::size_t nSubscribers(const MonitorElementStore &store, const std::string &moduleName, const std::string &name) {
+  auto element = store.findElement(moduleName, StringPair("/", name));
+  return (nullptr == element) ? 0 : element->m_subscribers.size();
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-me-store");
+
+  const int moduleClient(1), firstClient(2), secondClient(3);
+  MonitorElementStore store;
+  unitTest.test("REGISTER_MODULE", store.registerModule("TestModule", moduleClient).empty());
+  unitTest.test("MODULE_CLIENT_ID", moduleClient == store.moduleClientId("TestModule"));
+
+  // the module is notified of the first subscriber only
+  MonitorElementStore::NotificationMap notifications;
+  store.updateSubscription(firstClient, "TestModule", StringPair("/", "Histo"), true, notifications);
+  store.updateSubscription(firstClient, "TestModule", StringPair("/", "OtherHisto"), true, notifications);
+  unitTest.test("SUBSCRIBE_NOTIFY", notified(notifications, "TestModule", "Histo", true) and notified(notifications, "TestModule", "OtherHisto", true));
+  notifications.clear();
+  store.updateSubscription(secondClient, "TestModule", StringPair("/", "Histo"), true, notifications);
+  unitTest.test("SUBSCRIBE_AGAIN_NO_NOTIFY", notifications.empty());
+  unitTest.test("N_SUBSCRIBERS", 2 == nSubscribers(store, "TestModule", "Histo") and 1 == nSubscribers(store, "TestModule", "OtherHisto"));
+
+  // a subscriber exits: the elements it was the last subscriber of are unsubscribed
+  notifications.clear();
+  store.removeClient(firstClient, notifications);
+  unitTest.test("EXIT_SUBSCRIPTIONS_DROPPED", 1 == nSubscribers(store, "TestModule", "Histo") and 0 == nSubscribers(store, "TestModule", "OtherHisto"));
+  unitTest.test("EXIT_NOTIFY_LAST", notified(notifications, "TestModule", "OtherHisto", false));
+  unitTest.test("EXIT_NO_NOTIFY_OTHERS", not notified(notifications, "TestModule", "Histo", false));
+  unitTest.test("EXIT_MODULE_CONNECTED", moduleClient == store.moduleClientId("TestModule"));
+
+  // the module exits: its elements and subscriptions are kept until it registers again
+  store.element("TestModule", StringPair("/", "Histo")).m_buffer = "serialized";
+  notifications.clear();
+  store.removeClient(moduleClient, notifications);
+  unitTest.test("MODULE_EXIT_DISCONNECTED", 0 == store.moduleClientId("TestModule"));
+  unitTest.test("MODULE_EXIT_NO_NOTIFY", notifications.empty());
+  unitTest.test("MODULE_EXIT_ELEMENTS_KEPT", "serialized" == store.findElement("TestModule", StringPair("/", "Histo"))->m_buffer);
+  const json subscriptions = store.registerModule("TestModule", 4);
+  unitTest.test("REGISTER_AGAIN_SUBSCRIPTIONS", 1 == subscriptions.size() and "Histo" == subscriptions[0].value<std::string>("name", ""));
+
+  // the last subscriber exits
+  notifications.clear();
+  store.removeClient(secondClient, notifications);
+  unitTest.test("LAST_EXIT_NOTIFY", notified(notifications, "TestModule", "Histo", false));
+  unitTest.test("LAST_EXIT_NO_SUBSCRIBER", 0 == nSubscribers(store, "TestModule", "Histo"));
+  unitTest.test("LAST_EXIT_NO_SUBSCRIPTION", store.registerModule("TestModule", 5).empty());
+
+  return 0;
+}
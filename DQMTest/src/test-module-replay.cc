@@ -0,0 +1,173 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/EventReader.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/Module.h>
+#include <dqm4hep/ModuleApi.h>
+#include <dqm4hep/ModuleApplication.h>
+#include <dqm4hep/PluginManager.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TH1.h>
+
+// -- std headers
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+const std::string steeringFileName = "test-module-replay.xml";
+const unsigned int nEvents = 1000;
+const unsigned int nWorkers = 4;
+
+// what the modules have seen, filled from the worker threads
+std::mutex                          processedMutex;
+std::vector<unsigned int>           processedEvents(nEvents, 0);
+std::set<const Module*>             processingModules;
+std::map<const Module*, double>     endOfRunEntries;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class ReplayTestReader : public EventReader {
+public:
+  ReplayTestReader() = default;
+  ~ReplayTestReader() = default;
+
+  StatusCode open(const std::string &/*fname*/) override {
+    m_nReadEvents = 0;
+    return STATUS_CODE_SUCCESS;
+  }
+
+  StatusCode skipNEvents(int nSkipEvents) override {
+    m_nReadEvents += nSkipEvents;
+    return STATUS_CODE_SUCCESS;
+  }
+
+  StatusCode runInfo(Run &run) override {
+    run = Run(42, "Replay test run", "ReplayTestDetector");
+    return STATUS_CODE_SUCCESS;
+  }
+
+  StatusCode readNextEvent() override {
+    if(m_nReadEvents >= nEvents) {
+      return STATUS_CODE_OUT_OF_RANGE;
+    }
+    EventPtr event = GenericEvent::make_shared();
+    event->setEventNumber(m_nReadEvents++);
+    event->setRunNumber(42);
+    m_onEventRead.emit(event);
+    return STATUS_CODE_SUCCESS;
+  }
+
+  StatusCode close() override {
+    return STATUS_CODE_SUCCESS;
+  }
+
+private:
+  unsigned int       m_nReadEvents = {0};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+class ReplayTestModule : public AnalysisModule {
+public:
+  ReplayTestModule() = default;
+  ~ReplayTestModule() = default;
+
+private:
+  void readSettings(const TiXmlHandle &/*handle*/) override {}
+
+  void initModule() override {
+    THROW_RESULT_IF(STATUS_CODE_SUCCESS, !=, ModuleApi::bookHisto<TH1I>(this,
+      m_eventHisto, "/", "EventNumber", "The processed event numbers", nEvents, 0, nEvents));
+  }
+
+  void startOfRun(Run &/*run*/) override {}
+  void startOfCycle() override {}
+  void endOfCycle(const EOCCondition &/*condition*/) override {}
+
+  void endOfRun(const Run &/*run*/) override {
+    std::lock_guard<std::mutex> lock(processedMutex);
+    endOfRunEntries[this] = m_eventHisto->objectTo<TH1I>()->GetEntries();
+  }
+
+  void endModule() override {}
+
+  void process(EventPtr event) override {
+    m_eventHisto->objectTo<TH1I>()->Fill(event->getEventNumber());
+    std::lock_guard<std::mutex> lock(processedMutex);
+    processedEvents.at(event->getEventNumber())++;
+    processingModules.insert(this);
+  }
+
+private:
+  OnlineElementPtr       m_eventHisto = {nullptr};
+};
+
+DQM_PLUGIN_DECL(ReplayTestReader, "ReplayTestReader");
+DQM_PLUGIN_DECL(ReplayTestModule, "ReplayTestModule");
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+void writeSteeringFile() {
+  std::ofstream file(steeringFileName.c_str());
+  file << "<dqm4hep>\n";
+  file << "  <settings mode=\"Replay\">\n";
+  file << "    <parameter name=\"EventReader\"> ReplayTestReader </parameter>\n";
+  file << "    <parameter name=\"EventFileName\"> replay-test-events </parameter>\n";
+  file << "    <parameter name=\"ReplayThreads\"> " << nWorkers << " </parameter>\n";
+  file << "    <parameter name=\"EventQueueSize\"> 16 </parameter>\n";
+  file << "  </settings>\n";
+  file << "  <module type=\"ReplayTestModule\" name=\"ReplayTest\"/>\n";
+  file << "</dqm4hep>\n";
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-module-replay");
+
+  writeSteeringFile();
+
+  ModuleApplication application;
+  application.setNoServer(true);
+  const char *argv[] = {"test-module-replay", "-f", steeringFileName.c_str(), "-v", "warning"};
+  application.init(5, const_cast<char**>(argv));
+  unitTest.test("REPLAY_EXEC", 0 == application.exec());
+
+  // every event processed exactly once, by the worker modules only
+  bool processedOnce = true;
+  for(auto nProcessed : processedEvents) {
+    processedOnce = processedOnce && (1 == nProcessed);
+  }
+  unitTest.test("REPLAY_ALL_EVENTS_ONCE", processedOnce);
+  unitTest.test("REPLAY_WORKERS_ONLY", processingModules.end() == processingModules.find(application.module().get()));
+  unitTest.test("REPLAY_N_WORKERS", processingModules.size() <= nWorkers);
+
+  // the main module sees the merged histogram at end of run
+  auto mainEntries = endOfRunEntries.find(application.module().get());
+  unitTest.test("REPLAY_MAIN_END_OF_RUN", endOfRunEntries.end() != mainEntries);
+  unitTest.test("REPLAY_MERGED_ENTRIES", endOfRunEntries.end() != mainEntries and nEvents == mainEntries->second);
+  unitTest.test("REPLAY_END_OF_RUN_CALLS", nWorkers+1 == endOfRunEntries.size());
+
+  return 0;
+}
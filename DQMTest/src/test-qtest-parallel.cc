@@ -0,0 +1,143 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/MonitorElementManager.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/PluginManager.h>
+#include <dqm4hep/UnitTesting.h>
+
+#include <TH1.h>
+#include <TRandom3.h>
+
+// -- std headers
+#include <iostream>
+#include <signal.h>
+
+using namespace std;
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+template <typename T>
+TiXmlElement *createParameter(const std::string &name, const T &value) {
+  TiXmlElement *elt = new TiXmlElement("parameter");
+  elt->SetAttribute("name", name);
+  elt->SetAttribute("value", typeToString(value));
+  return elt;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool sameReports(const QReportContainer &lhs, const QReportContainer &rhs) {
+  if(lhs.size() != rhs.size()) {
+    return false;
+  }
+  for(const auto &iter : lhs) {
+    auto findIter = rhs.find(iter.first);
+    if(rhs.end() == findIter || findIter->second.size() != iter.second.size()) {
+      return false;
+    }
+    for(const auto &iter2 : iter.second) {
+      auto findIter2 = findIter->second.find(iter2.first);
+      if(findIter->second.end() == findIter2) {
+        return false;
+      }
+      const QReport &report(iter2.second), &other(findIter2->second);
+      if(report.m_qualityFlag != other.m_qualityFlag || report.m_quality != other.m_quality || report.m_message != other.m_message) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-qtest-parallel");
+
+  const unsigned int nElements = 200;
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+
+  // quality tests: chi2 with reference (thread safe) and fit (run in the calling thread)
+  TiXmlElement *chi2Element = new TiXmlElement("qtest");
+  std::shared_ptr<TiXmlElement> sharedChi2(chi2Element);
+  chi2Element->SetAttribute("type", "Chi2Test");
+  chi2Element->SetAttribute("name", "ParallelChi2");
+  unitTest.test("CREATE_CHI2", STATUS_CODE_SUCCESS == meMgr->createQualityTest(chi2Element));
+
+  TiXmlElement *fitElement = new TiXmlElement("qtest");
+  std::shared_ptr<TiXmlElement> sharedFit(fitElement);
+  fitElement->SetAttribute("type", "FitParamInRangeTest");
+  fitElement->SetAttribute("name", "ParallelFit");
+  fitElement->LinkEndChild(createParameter("FitFormula", std::string("gaus")));
+  fitElement->LinkEndChild(createParameter("TestParameter", 1));
+  fitElement->LinkEndChild(createParameter("DeviationLower", -0.5));
+  fitElement->LinkEndChild(createParameter("DeviationUpper", 0.5));
+  unitTest.test("CREATE_FIT", STATUS_CODE_SUCCESS == meMgr->createQualityTest(fitElement));
+
+  // book, fill and attach the quality tests
+  TRandom3 random(42);
+  bool booked = true;
+  for(unsigned int e=0 ; e<nElements ; e++) {
+    const std::string path("/Layer" + std::to_string(e % 10));
+    const std::string name("Hits" + std::to_string(e));
+    MonitorElementPtr element;
+    booked = booked && (STATUS_CODE_SUCCESS == meMgr->bookHisto<TH1F>(path, name, name, element, 100, -5.f, 5.f));
+    if(not booked) {
+      break;
+    }
+    PtrHandler<TObject> reference(new TH1F("", "reference", 100, -5.f, 5.f), true);
+    for(unsigned int i=0 ; i<2000 ; i++) {
+      element->objectTo<TH1F>()->Fill(random.Gaus(0.1 * (e % 7), 1.));
+      static_cast<TH1F*>(reference.ptr())->Fill(random.Gaus(0., 1.));
+    }
+    element->setReferenceObject(reference);
+    booked = booked && (STATUS_CODE_SUCCESS == meMgr->addQualityTest(path, name, "ParallelChi2"));
+    booked = booked && (STATUS_CODE_SUCCESS == meMgr->addQualityTest(path, name, "ParallelFit"));
+  }
+  unitTest.test("BOOK_ELEMENTS", booked);
+
+  // serial run
+  QReportStorage serialReports;
+  unitTest.test("N_THREADS_SERIAL", 1 == meMgr->qualityTestThreads());
+  unitTest.test("RUN_SERIAL", STATUS_CODE_SUCCESS == meMgr->runQualityTests(serialReports));
+
+  // parallel run, must give the same reports
+  QReportStorage parallelReports;
+  meMgr->setQualityTestThreads(4);
+  unitTest.test("N_THREADS_PARALLEL", 4 == meMgr->qualityTestThreads());
+  unitTest.test("RUN_PARALLEL", STATUS_CODE_SUCCESS == meMgr->runQualityTests(parallelReports));
+  unitTest.test("N_REPORTS", nElements == parallelReports.reports().size());
+  unitTest.test("SAME_REPORTS", sameReports(serialReports.reports(), parallelReports.reports()));
+
+  // wall time recorded for each test
+  bool timed = true;
+  for(const auto &iter : parallelReports.reports()) {
+    for(const auto &iter2 : iter.second) {
+      timed = timed && (iter2.second.m_executionTime > 0.);
+    }
+  }
+  unitTest.test("EXECUTION_TIME", timed);
+
+  const QReport &report(parallelReports.reports().begin()->second.begin()->second);
+  json jsonReport;
+  report.toJson(jsonReport);
+  DQM4HEP_NO_EXCEPTION( std::cout << jsonReport.dump(2) << std::endl; );
+  unitTest.test("EXECUTION_TIME_JSON", jsonReport.value<double>("executionTime", 0.) == report.m_executionTime);
+
+  // back to serial
+  meMgr->setQualityTestThreads(1);
+  unitTest.test("N_THREADS_BACK_SERIAL", 1 == meMgr->qualityTestThreads());
+
+  return 0;
+}
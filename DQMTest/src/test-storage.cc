@@ -30,6 +30,9 @@ public:
   const std::string &name() {
     return m_name;
   }
+  void setName(const std::string &oname) {
+    m_name = oname;
+  }
 
 private:
   std::string m_name;
@@ -79,7 +82,39 @@ int main(int /*argc*/, char ** /*argv*/) {
   unitTest.test("GO_UP", storage.goUp() == STATUS_CODE_SUCCESS);
   unitTest.test("PWD2", storage.pwd() == "heroes");
 
+  // full path index
+  unitTest.test("FIND_BY_NAME", nullptr != storage.findObjectByName("/heroes/best", "Spiderman"));
+  unitTest.test("FIND_BY_NAME_RELATIVE", nullptr != storage.findObjectByName("best", "Me") && nullptr != storage.findObjectByName("./best/", "Me"));
+  unitTest.test("FIND_BY_NAME_PARENT", nullptr != storage.findObjectByName("best/../worst", "Batman"));
+  unitTest.test("FIND_BY_NAME_WRONG_DIR", nullptr == storage.findObjectByName("/heroes/worst", "Spiderman"));
+  unitTest.test("FIND_BY_NAME_CURRENT", nullptr == storage.findObjectByName("Spiderman") && STATUS_CODE_SUCCESS == storage.cd("best") 
+    && nullptr != storage.findObjectByName("Spiderman"));
+  storage.goUp();
+  unitTest.test("FIND_DIR_INDEX", storage.dirExists("/heroes/best/") && storage.dirExists("best/../worst") && !storage.dirExists("/heroes/average"));
+
+  // duplicated names: the first one is found, the next one after removal
+  std::shared_ptr<Object> firstMe = storage.findObjectByName("/heroes/best", "Me");
+  std::shared_ptr<Object> secondMe = std::make_shared<Object>("Me");
+  unitTest.test("ADD_DUPLICATE", STATUS_CODE_SUCCESS == storage.add("/heroes/best", secondMe) && firstMe == storage.findObjectByName("/heroes/best", "Me"));
+  unitTest.test("ADD_TWICE", STATUS_CODE_ALREADY_PRESENT == storage.add("/heroes/best", firstMe) && STATUS_CODE_ALREADY_PRESENT == storage.add("/heroes/best", secondMe));
+  unitTest.test("REMOVE_DUPLICATE", STATUS_CODE_SUCCESS == storage.remove("/heroes/best", [&firstMe](const std::shared_ptr<Object> &obj) { return obj == firstMe; }) 
+    && secondMe == storage.findObjectByName("/heroes/best", "Me"));
+  unitTest.test("REMOVE", STATUS_CODE_SUCCESS == storage.remove("/heroes/best", [](const std::shared_ptr<Object> &obj) { return obj->name() == "Me"; }) 
+    && nullptr == storage.findObjectByName("/heroes/best", "Me"));
+
+  // rename
+  unitTest.test("RENAME", STATUS_CODE_SUCCESS == storage.rename("/heroes/best", "Superman", "Clark", [](const std::shared_ptr<Object> &obj) { obj->setName("Clark"); })
+    && nullptr == storage.findObjectByName("/heroes/best", "Superman") && nullptr != storage.findObjectByName("/heroes/best", "Clark"));
+  unitTest.test("RENAME_EXISTING", STATUS_CODE_ALREADY_PRESENT == storage.rename("/heroes/best", "Clark", "Spiderman", [](const std::shared_ptr<Object> &obj) { obj->setName("Spiderman"); }));
+  unitTest.test("RENAME_MISSING", STATUS_CODE_NOT_FOUND == storage.rename("/heroes/best", "Superman", "Kal", [](const std::shared_ptr<Object> &obj) { obj->setName("Kal"); }));
+
   unitTest.test("RMDIR", storage.rmdir("/heroes/worst") == STATUS_CODE_SUCCESS);
+  unitTest.test("RMDIR_INDEX", nullptr == storage.findObjectByName("/heroes/worst", "Batman") && !storage.dirExists("/heroes/worst"));
+  unitTest.test("MKDIR_AFTER_RMDIR", STATUS_CODE_SUCCESS == storage.add("/heroes/worst", std::make_shared<Object>("Batman")) 
+    && nullptr != storage.findObjectByName("/heroes/worst", "Batman"));
+
+  storage.clear();
+  unitTest.test("CLEAR_INDEX", nullptr == storage.findObjectByName("/heroes/best", "Spiderman") && !storage.dirExists("/heroes") && storage.dirExists("/"));
 
   return 0;
 }
@@ -0,0 +1,106 @@
+//==========================================================================
+//  DQM4hep a data quality monitoring software for high energy physics
+//--------------------------------------------------------------------------
+//
+// For the licensing terms see $DQM4hep_DIR/LICENSE.
+// For the list of contributors see $DQM4hep_DIR/AUTHORS.
+//
+// Author     : R.Ete
+//====================================================================
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/WorkerPool.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+
+  UnitTest unitTest("test-worker-pool");
+
+  // invalid number of threads
+  bool thrown = false;
+  try {
+    WorkerPool pool(0);
+  }
+  catch(StatusCodeException &) {
+    thrown = true;
+  }
+  unitTest.test("ZERO_THREADS", thrown);
+
+  for(unsigned int nThreads : {1u, 4u}) {
+    const std::string suffix("_" + std::to_string(nThreads));
+    WorkerPool pool(nThreads);
+    unitTest.test("N_THREADS" + suffix, pool.nThreads() == nThreads);
+
+    // each task run exactly once, in several batches
+    bool exactlyOnce = true;
+    for(unsigned int batch=0 ; batch<50 ; batch++) {
+      const std::size_t nTasks = 1 + batch * 37;
+      std::vector<unsigned int> counts(nTasks, 0);
+      pool.run(nTasks, [&counts](std::size_t task) {
+        counts[task]++;
+      });
+      for(auto count : counts) {
+        exactlyOnce = exactlyOnce && (1 == count);
+      }
+    }
+    unitTest.test("EXACTLY_ONCE" + suffix, exactlyOnce);
+
+    // empty batch
+    bool called = false;
+    pool.run(0, [&called](std::size_t) {
+      called = true;
+    });
+    unitTest.test("EMPTY_BATCH" + suffix, not called);
+
+    // tasks spread over the threads
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    pool.run(200, [&](std::size_t) {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      std::lock_guard<std::mutex> lock(mutex);
+      threadIds.insert(std::this_thread::get_id());
+    });
+    dqm_info( "{0} threads used out of {1}", threadIds.size(), nThreads );
+    unitTest.test("THREADS_USED" + suffix, threadIds.size() > (nThreads > 1 ? 1u : 0u) && threadIds.size() <= nThreads);
+
+    // an exception is re-thrown, the other tasks are still processed
+    std::atomic<unsigned int> nProcessed(0);
+    thrown = false;
+    try {
+      pool.run(100, [&nProcessed](std::size_t task) {
+        if(42 == task) {
+          throw std::runtime_error("task failed");
+        }
+        ++nProcessed;
+      });
+    }
+    catch(std::runtime_error &) {
+      thrown = true;
+    }
+    unitTest.test("EXCEPTION" + suffix, thrown && 99 == nProcessed.load());
+
+    // still usable after an exception
+    nProcessed = 0;
+    pool.run(100, [&nProcessed](std::size_t) {
+      ++nProcessed;
+    });
+    unitTest.test("AFTER_EXCEPTION" + suffix, 100 == nProcessed.load());
+  }
+
+  return 0;
+}
@@ -0,0 +1,39 @@
+#!/bin/bash
+#
+# Benchmark of the event source sending rate against a local DIM DNS.
+# Runs dqm4hep-start-random-event-source without sleep time, first with the
+# collector liveness checked on every event (the DIM DNS is browsed for each
+# event and collector) and then with the cached liveness (default TTL).
+#
+# Usage: bench-event-source.sh <bin-dir> [n-events]
+#
+
+if [ $# -lt 1 ]; then
+  echo "Usage: $0 <bin-dir> [n-events]"
+  exit 1
+fi
+
+BIN_DIR=$1
+NEVENTS=${2:-20000}
+COLLECTOR=bench-collector
+
+export DIM_DNS_NODE=localhost
+
+${BIN_DIR}/dns > /dev/null 2>&1 &
+DNS_PID=$!
+sleep 1
+
+${BIN_DIR}/dqm4hep-start-event-collector -c ${COLLECTOR} -v warning > /dev/null 2>&1 &
+COLLECTOR_PID=$!
+sleep 2
+
+for TTL in 0 1000; do
+  echo "=== Liveness TTL: ${TTL} ms ==="
+  ${BIN_DIR}/dqm4hep-start-random-event-source -n bench-source -c ${COLLECTOR} \
+    --sleep 0 --max-events ${NEVENTS} --liveness-ttl ${TTL} -v info | grep "events/s"
+done
+
+kill -INT ${COLLECTOR_PID}
+wait ${COLLECTOR_PID}
+kill ${DNS_PID}
+wait ${DNS_PID} 2>/dev/null